@@ -4,6 +4,7 @@
 namespace onnxruntime {
 class IExecutionFrame;
 class Stream;
+struct ConfigOptions;
 namespace concurrency {
 class ThreadPool;
 }
@@ -180,6 +181,13 @@ class OpKernelContext {
     return true;
   }
 
+  /**
+  Returns the config options of the RunOptions of the current Run, or nullptr if there are none.
+  */
+  virtual const ConfigOptions* GetRunConfigOptions() const {
+    return nullptr;
+  }
+
   /**
   Returns Allocator from a specific OrtMemoryInfo object.
   TODO(leca): Replace GetTempSpaceAllocator() and GetTempSpaceCPUAllocator() with this API in the future
@@ -189,6 +197,13 @@ class OpKernelContext {
  protected:
   OpKernelContext(concurrency::ThreadPool* threadpool, const logging::Logger& logger, Stream* stream);
 
+  // Construct with the offsets of the inputs, implicit inputs and outputs of the node in the execution frame
+  // already resolved by the caller.
+  OpKernelContext(_Inout_ IExecutionFrame* frame, _In_ const OpKernel* kernel,
+                  _In_ Stream* stream,
+                  _In_opt_ concurrency::ThreadPool* threadpool, _In_ const logging::Logger& logger,
+                  int node_input_start_index, int node_implicit_input_start_index, int node_output_start_index);
+
   onnxruntime::NodeIndex GetNodeIndex() const;
 
   virtual const OrtValue* GetInputMLValue(int index) const;
@@ -397,9 +397,13 @@ class Node {
   /** Remove the specified attribute from this Node */
   bool ClearAttribute(const std::string& attr_name);
 
-  /** Gets the Node's mutable attributes. */
+  /** Gets the Node's mutable attributes.
+  Call MarkAttributesChanged after modifying them so the inferred types of the Node are not reused by Resolve. */
   NodeAttributes& GetMutableAttributes() noexcept { return attributes_; }
 
+  /** Records that the attributes were modified through GetMutableAttributes. */
+  void MarkAttributesChanged();
+
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
   /**
@@ -647,6 +651,10 @@ class Node {
   // Node::ToProto when running onnx::check_node in the first Graph::Resolve. At that point we know all the nodes are
   // unchanged from the original model.
   const ONNX_NAMESPACE::NodeProto* original_node_proto_ = nullptr;
+
+  // Fingerprint of the op, attributes and input/output types seen when type and shape inferencing last succeeded
+  // for this node. 0 if the node has not been inferred. Graph::Resolve skips nodes whose fingerprint is unchanged.
+  size_t inferred_types_fingerprint_ = 0;
 #endif
 
   // Execution priority, lower value for higher priority
@@ -676,6 +684,9 @@ class Node {
   // This allows attribute adding and removing.
   NodeAttributes attributes_;
 
+  // Incremented whenever attributes_ is modified.
+  uint32_t attributes_version_ = 0;
+
   // Graph that contains this Node
   Graph* graph_ = nullptr;
 
@@ -1695,6 +1706,10 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
     return *this;
   }
 
+  // Record that the value of the initializer `name` may have changed so type and shape inferencing of its consumers,
+  // which may read the value, is not skipped by the next Resolve.
+  void MarkInitializerChanged(const std::string& name);
+
   // During the Resolve of a Graph it is necessary to recursively descend into subgraphs (created from GraphProto
   // Node attributes in the Graph) if present.
   // The ResolveContext holds the collection of values for the current Graph instance, be it the main graph
@@ -1754,6 +1769,14 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
 
   common::Status InferAndVerifyTypeMatch(Node& node, const ONNX_NAMESPACE::OpSchema& op, const ResolveOptions& options);
 
+  // Sets the op schema of the node by looking it up in the provided schema registry. Returns false if not found.
+  bool SetOpSchemaFromRegistryForNode(Node& node, const ONNX_NAMESPACE::ISchemaRegistry& schema_registry);
+
+  // Compute the fingerprint of everything type and shape inferencing of `node` depends on: the op, the attributes,
+  // and the input/output NodeArgs with their types, shapes and initializer status.
+  // Returns 0 if the node must always be inferred.
+  size_t ComputeInferredTypesFingerprint(const Node& node) const;
+
   // perform type and shape inferencing on the subgraph and Resolve to validate
   static common::Status InferAndVerifySubgraphTypes(const Node& node, Graph& subgraph,
                                                     const std::vector<const ONNX_NAMESPACE::TypeProto*>& input_types,
@@ -130,5 +130,8 @@ class NodeArg {
 
   // Flag indicates whether <*this> node arg exists or not.
   bool exists_;
+
+  // Incremented by Graph whenever the initializer with this name is added, removed or replaced.
+  uint32_t initializer_version_ = 0;
 };
 }  // namespace onnxruntime
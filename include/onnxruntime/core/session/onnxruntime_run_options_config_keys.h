@@ -51,4 +51,18 @@ static const char* const kOrtRunOptionsConfigQnnLoraConfig = "qnn.lora_config";
 // ORT session only captures one cuda graph before another capture is requested.
 // If the value is set to -1, cuda graph capture/replay is disabled in that run.
 // User are not expected to set the value to 0 as it is reserved for internal use.
+// The value is also used by the CPU graph capture (kOrtSessionOptionsConfigEnableCpuGraphCapture), where every id
+// including 0 identifies a captured graph.
 static const char* const kOrtRunOptionsConfigCudaGraphAnnotation = "gpu_graph_id";
+
+// Identifies the audio stream that the inputs of this Run belong to, for the STFT operator of the CPU EP.
+// When set, the STFT kernel treats its signal input as the continuation of the signal of the previous Run with the
+// same id: the samples that did not complete a frame are kept by the kernel between Runs, and only the frames that
+// the new samples complete are computed and returned (so the number of output frames varies between Runs).
+// The batch size, frame_step and signal type must not change during a stream.
+// By default the value is empty and every Run transforms its signal input on its own.
+static const char* const kOrtRunOptionsConfigStftStreamId = "stft.stream_id";
+
+// Set to '1' in the last Run of a stream to release the samples kept for "stft.stream_id" after the Run.
+// An id can be reused for a new stream afterwards. Defaults to '0'.
+static const char* const kOrtRunOptionsConfigStftStreamEnd = "stft.stream_end";
@@ -20,6 +20,51 @@
 // If the config value is set to "1" then the prepacking is disabled, otherwise prepacking is enabled (default value)
 static const char* const kOrtSessionOptionsConfigDisablePrepacking = "session.disable_prepacking";
 
+// If the config value is set to "1", session initialization uses the intra-op thread pool to deserialize in-memory
+// CPU initializers, create the CPU kernels and pre-pack their constant weights concurrently. Kernels of custom ops
+// and of other execution providers are created sequentially.
+// The resulting session state is the same as with sequential initialization. Errors are reported for the first
+// failing initializer or node in the sequential order.
+// "0": sequential initialization (default).
+// "1": parallel initialization.
+static const char* const kOrtSessionOptionsConfigParallelInitialization = "session.parallel_initialization";
+
+// Read the external data of the initializers that are memory mapped on CPU while the session state is being
+// initialized, instead of when it is first accessed, e.g. by PrePack or by the first Run. The mapped data is read in
+// chunks on the intra-op thread pool when parallel initialization is enabled, concurrently with the decoding of the
+// in-memory initializers. The mapped external data stays resident in memory.
+// "0": read external data on first access (default).
+// "1": read external data during session initialization.
+static const char* const kOrtSessionOptionsConfigPrefetchExternalInitializers =
+    "session.prefetch_external_initializers";
+
+// Defer the initialization of the subgraphs of If, Loop and Scan nodes (kernel creation, initializer loading,
+// pre-packing and memory planning) until the node first executes them, so that branches which are never taken do not
+// add to the session initialization time and memory usage.
+// "0": initialize all subgraphs during session initialization (default).
+// "1": initialize each subgraph the first time it is executed.
+// "2": as "1", and initialize the remaining subgraphs in the background on the intra-op thread pool once session
+//      initialization has completed.
+// Subgraphs are always initialized eagerly when pre-packed weights are being saved.
+static const char* const kOrtSessionOptionsConfigLazySubgraphInitialization = "session.lazy_subgraph_initialization";
+
+// Maximum number of feed shape signatures for which the results of the shape computation nodes of the main graph are
+// cached. Shape computation nodes are CPU nodes such as Shape, and the Gather/Concat/Unsqueeze chains that consume
+// their output, whose results only depend on the shapes of the feeds. A Run with feed shapes seen before writes the
+// cached results instead of executing these nodes. The least recently used signature is evicted when the cache is full.
+// "0": disabled (default).
+static const char* const kOrtSessionOptionsConfigShapePlanCacheSize = "session.shape_plan_cache_size";
+
+// Capture and replay the kernel invocations of the main graph on CPU. The graph must not have control flow nodes and
+// all its nodes must be assigned to the CPU EP. The first Run for a graph annotation id
+// (kOrtRunOptionsConfigCudaGraphAnnotation) captures the graph, and later Runs with the same feed names, feed shapes
+// and output names replay it without allocating the node outputs or setting up the kernel contexts again. The buffers
+// of all node outputs are kept alive between Runs. A kernel whose output shape depends on the values of its inputs
+// disables the replay for that graph annotation id if the shape changes.
+// "0": disabled (default).
+// "1": enabled.
+static const char* const kOrtSessionOptionsConfigEnableCpuGraphCapture = "session.enable_cpu_graph_capture";
+
 // A value of "1" means allocators registered in the env will be used. "0" means the allocators created in the session
 // will be used. Use this to override the usage of env allocators on a per session level.
 static const char* const kOrtSessionOptionsConfigUseEnvAllocators = "session.use_env_allocators";
@@ -304,6 +349,31 @@ static const char* const kOrtSessionOptionsModelExternalInitializersFileFolderPa
 static const char* const kOrtSessionOptionsSavePrePackedConstantInitializers =
     "session.save_external_prepacked_constant_initializers";
 
+// Directory of a persistent cache of optimized models.
+// The first session that initializes an ONNX model loaded from a file saves the optimized model in this directory
+// with its initializers and pre-packed constant initializers in an external data file, as with
+// kOrtSessionOptionsSavePrePackedConstantInitializers. Later sessions load the cached model instead, skip the graph
+// optimizations and memory map the initializers and pre-packed weights.
+// The cache entries are keyed by a hash of the model file, the size and modification time of its external data
+// files, the custom op schemas the model uses, the ORT version, the execution providers, the graph optimization level
+// and disabled optimizers, the free dimension overrides, the session config entries and the CPU features.
+// Sessions of different processes may share the directory. An entry is published once it is completely written and
+// is not overwritten by other sessions.
+// The cache is not used when the model is loaded from memory or in ORT format, when saving an optimized model, when
+// initializers are provided through the session options, or when the graph contains compiled nodes.
+// Sample usage: sess_options.add_session_config_entry(kOrtSessionOptionsSessionCacheDir, "/path/to/cache")
+static const char* const kOrtSessionOptionsSessionCacheDir = "session.cache_dir";
+
+// Directory of pre-packed constant initializers shared by sessions in different processes.
+// Each pre-packed weight is written to a file of this directory named after its op type and a hash of its content
+// by the first session that pre-packs it. Sessions memory map the file instead of keeping the pre-packed weight on
+// the heap, so processes that run the same model on the same host share the physical pages of the pre-packed weights.
+// Pre-packed weights of initializers provided through the session options with a PrepackedWeightsContainer, and
+// pre-packed weights loaded from the external data file of the model, are not written to this directory.
+// Remove the files of the directory to reclaim the disk space when no session uses them.
+// Sample usage: sess_options.add_session_config_entry(kOrtSessionOptionsSharedPrePackedWeightsDir, "/dev/shm/ort")
+static const char* const kOrtSessionOptionsSharedPrePackedWeightsDir = "session.shared_prepacked_weights_dir";
+
 // Use this config when you want to collect memory stats for each node in the graph.
 // The file format is a CSV file with the following columns:
 // The file will be created if it does not exist, and will be overwritten if it does.
@@ -374,6 +444,15 @@ static const char* const kOrtSessionOptionsEpContextModelExternalInitializersFil
 // - "1": Gemm FastMath mode is enabled.
 static const char* const kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16 = "mlas.enable_gemm_fastmath_arm64_bfloat16";
 
+// Platform independent variant of "mlas.enable_gemm_fastmath_arm64_bfloat16". The fastmath mode is used on
+// ARM64 processors with the BF16 extension and on x86-64 processors with the AVX512-BF16 or AMX-BF16 extensions.
+// Setting either option enables the mode. The fp32 inputs are rounded to bfloat16, so results may differ from the
+// default fp32 kernels.
+// Option values:
+// - "0": Gemm FastMath mode is not enabled. [DEFAULT]
+// - "1": Gemm FastMath mode is enabled.
+static const char* const kOrtSessionOptionsMlasGemmFastMathBfloat16 = "mlas.enable_gemm_fastmath_bfloat16";
+
 // When converting DQ + MatMul -> MatMulNBits, the accuracy level of the MatMulNBits is controlled by this option.
 // Refer to MatMulNBits op schema for more details.
 // If not provided, default is 4.
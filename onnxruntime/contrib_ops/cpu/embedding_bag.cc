@@ -0,0 +1,273 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/narrow.h"
+#include "core/common/float16.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "contrib_ops/cpu/quantization/gather_block_quantized_helper.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+using gather_block_quantized_helper::Get4BitElement;
+using gather_block_quantized_helper::GetUInt8ZeroPoint;
+
+// Pooled embedding lookup: every bag of indices selects rows of a [num_rows, embedding_dim] table and the rows are
+// summed (optionally weighted) or averaged into one output row. The rows are accumulated straight from the table, so
+// the [num_bags, bag_size, embedding_dim] tensor that Gather followed by ReduceSum/ReduceMean materializes is never
+// created. The table is either float/float16 or uint8 quantized row-wise in blocks with the GatherBlockQuantized
+// layout, in which case each row is dequantized while it is accumulated.
+template <typename T, typename Tind>
+class EmbeddingBag final : public OpKernel {
+ public:
+  explicit EmbeddingBag(const OpKernelInfo& info) : OpKernel(info) {
+    const std::string mode = info.GetAttrOrDefault<std::string>("mode", "sum");
+    ORT_ENFORCE(mode == "sum" || mode == "mean", "EmbeddingBag only supports mode 'sum' or 'mean', got ", mode);
+    mean_ = mode == "mean";
+
+    block_size_ = info.GetAttrOrDefault<int64_t>("block_size", 128);
+    ORT_ENFORCE(block_size_ >= 16 && ((block_size_ - 1) & block_size_) == 0,
+                "'block_size' must be a power of 2 and not less than 16.");
+
+    bits_ = info.GetAttrOrDefault<int64_t>("bits", 8);
+    ORT_ENFORCE(bits_ == 4 || bits_ == 8, "EmbeddingBag only support bits==4 or 8");
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  struct Table {
+    const void* data;
+    int64_t num_rows;
+    int64_t embedding_dim;
+    // Quantized tables only
+    bool quantized;
+    int64_t row_bytes;
+    int64_t blocks_per_row;
+    const T* scales;
+    const uint8_t* zero_points;
+  };
+
+  // acc[0:embedding_dim] += weight * table[row]. `row_buffer` holds embedding_dim floats for float16 tables.
+  void AccumulateRow(const Table& table, int64_t row, float weight, float* acc, float* row_buffer) const;
+
+  bool mean_;
+  int64_t block_size_;
+  int64_t bits_;
+};
+
+template <typename T, typename Tind>
+void EmbeddingBag<T, Tind>::AccumulateRow(const Table& table, int64_t row, float weight, float* acc,
+                                          float* row_buffer) const {
+  const int64_t dim = table.embedding_dim;
+  if (!table.quantized) {
+    const T* row_data = static_cast<const T*>(table.data) + row * dim;
+    const float* values;
+    if constexpr (std::is_same_v<T, MLFloat16>) {
+      MlasConvertHalfToFloatBuffer(row_data, row_buffer, narrow<size_t>(dim));
+      values = row_buffer;
+    } else {
+      ORT_UNUSED_PARAMETER(row_buffer);
+      values = row_data;
+    }
+    for (int64_t d = 0; d < dim; ++d) {
+      acc[d] += weight * values[d];
+    }
+    return;
+  }
+
+  const uint8_t* row_data = static_cast<const uint8_t*>(table.data) + row * table.row_bytes;
+  for (int64_t block = 0; block < table.blocks_per_row; ++block) {
+    const int64_t scale_idx = row * table.blocks_per_row + block;
+    const float scale = weight * static_cast<float>(table.scales[scale_idx]);
+    const float offset = -scale * static_cast<float>(GetUInt8ZeroPoint(table.zero_points, scale_idx, bits_));
+    const int64_t begin = block * block_size_;
+    const int64_t end = std::min(begin + block_size_, dim);
+    if (bits_ == 8) {
+      for (int64_t d = begin; d < end; ++d) {
+        acc[d] += scale * static_cast<float>(row_data[d]) + offset;
+      }
+    } else {
+      for (int64_t d = begin; d < end; ++d) {
+        acc[d] += scale * static_cast<float>(Get4BitElement(row_data, d)) + offset;
+      }
+    }
+  }
+}
+
+template <typename T, typename Tind>
+Status EmbeddingBag<T, Tind>::Compute(OpKernelContext* context) const {
+  const Tensor* data = context->Input<Tensor>(0);
+  const Tensor* indices = context->Input<Tensor>(1);
+  const Tensor* offsets = context->Input<Tensor>(2);
+  const Tensor* per_sample_weights = context->Input<Tensor>(3);
+  const Tensor* scales = context->Input<Tensor>(4);
+  const Tensor* zero_points = context->Input<Tensor>(5);
+
+  const auto& data_shape = data->Shape();
+  ORT_RETURN_IF_NOT(data_shape.NumDimensions() == 2, "data must be a 2D table. Got shape ", data_shape);
+
+  Table table{};
+  table.data = data->DataRaw();
+  table.num_rows = data_shape[0];
+  table.quantized = data->IsDataType<uint8_t>();
+  table.embedding_dim = data_shape[1];
+
+  if (table.quantized) {
+    ORT_RETURN_IF_NOT(scales != nullptr, "scales is required for uint8 data.");
+    // 4 bit values are packed two per byte, so the embedding dimension is twice the last dimension of data
+    const int64_t components = 8 / bits_;
+    table.row_bytes = data_shape[1];
+    table.embedding_dim = data_shape[1] * components;
+    table.blocks_per_row = (table.embedding_dim + block_size_ - 1) / block_size_;
+    ORT_RETURN_IF_NOT(scales->Shape() == TensorShape({table.num_rows, table.blocks_per_row}),
+                      "scales must have shape [", table.num_rows, ",", table.blocks_per_row, "]. Got ",
+                      scales->Shape());
+    table.scales = scales->Data<T>();
+    if (zero_points) {
+      const int64_t zero_point_cols = (table.blocks_per_row + components - 1) / components;
+      ORT_RETURN_IF_NOT(zero_points->Shape() == TensorShape({table.num_rows, zero_point_cols}),
+                        "zero_points must have shape [", table.num_rows, ",", zero_point_cols, "]. Got ",
+                        zero_points->Shape());
+      table.zero_points = zero_points->Data<uint8_t>();
+    }
+  } else {
+    ORT_RETURN_IF_NOT(data->IsDataType<T>(), "data must be uint8 or have the type of the output.");
+    ORT_RETURN_IF_NOT(scales == nullptr && zero_points == nullptr,
+                      "scales and zero_points are only valid for uint8 data.");
+  }
+
+  // Bag b holds the indices [bag_starts[b], bag_starts[b + 1]).
+  const auto& indices_shape = indices->Shape();
+  const int64_t num_indices = indices_shape.Size();
+  int64_t num_bags = 0;
+  std::vector<int64_t> bag_starts;
+  if (offsets) {
+    ORT_RETURN_IF_NOT(indices_shape.NumDimensions() == 1, "indices must be 1D when offsets is provided.");
+    ORT_RETURN_IF_NOT(offsets->Shape().NumDimensions() == 1, "offsets must be 1D.");
+    num_bags = offsets->Shape()[0];
+    const Tind* offsets_data = offsets->Data<Tind>();
+    bag_starts.resize(narrow<size_t>(num_bags + 1));
+    for (int64_t b = 0; b < num_bags; ++b) {
+      const int64_t start = static_cast<int64_t>(offsets_data[b]);
+      const int64_t previous = b == 0 ? 0 : bag_starts[narrow<size_t>(b - 1)];
+      ORT_RETURN_IF_NOT(b == 0 ? start == 0 : (start >= previous && start <= num_indices),
+                        "offsets must start at 0 and be non-decreasing and not greater than the number of indices. "
+                        "Got offsets[", b, "]=", start);
+      bag_starts[narrow<size_t>(b)] = start;
+    }
+    bag_starts[narrow<size_t>(num_bags)] = num_indices;
+  } else {
+    ORT_RETURN_IF_NOT(indices_shape.NumDimensions() == 2,
+                      "indices must be 2D [num_bags, bag_size] when offsets is not provided.");
+    num_bags = indices_shape[0];
+    const int64_t bag_size = indices_shape[1];
+    bag_starts.resize(narrow<size_t>(num_bags + 1));
+    for (int64_t b = 0; b <= num_bags; ++b) {
+      bag_starts[narrow<size_t>(b)] = b * bag_size;
+    }
+  }
+
+  const T* weights = nullptr;
+  if (per_sample_weights) {
+    ORT_RETURN_IF_NOT(!mean_, "per_sample_weights is only supported with mode 'sum'.");
+    ORT_RETURN_IF_NOT(per_sample_weights->Shape() == indices_shape,
+                      "per_sample_weights must have the same shape as indices.");
+    weights = per_sample_weights->Data<T>();
+  }
+
+  // Validate every index up front so the parallel accumulation cannot fail half way.
+  const Tind* indices_data = indices->Data<Tind>();
+  const int64_t num_rows = table.num_rows;
+  for (int64_t i = 0; i < num_indices; ++i) {
+    const int64_t idx = static_cast<int64_t>(indices_data[i]);
+    ORT_RETURN_IF_NOT(idx >= -num_rows && idx < num_rows,
+                      "indices element out of data bounds, idx=", idx,
+                      " must be within the inclusive range [", -num_rows, ",", num_rows - 1, "]");
+  }
+
+  const int64_t dim = table.embedding_dim;
+  Tensor* output = context->Output(0, {num_bags, dim});
+  if (num_bags == 0 || dim == 0) {
+    return Status::OK();
+  }
+  T* output_data = output->MutableData<T>();
+
+  const double row_bytes = table.quantized ? static_cast<double>(table.row_bytes)
+                                           : static_cast<double>(dim) * sizeof(T);
+  const double average_bag_size = static_cast<double>(std::max<int64_t>(num_indices, 1)) / num_bags;
+  const TensorOpCost cost{average_bag_size * row_bytes, static_cast<double>(dim) * sizeof(T),
+                          average_bag_size * static_cast<double>(dim) * 2.0};
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), narrow<std::ptrdiff_t>(num_bags), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> acc_buffer;
+        std::vector<float> row_buffer;
+        if constexpr (std::is_same_v<T, MLFloat16>) {
+          acc_buffer.resize(narrow<size_t>(dim));
+          row_buffer.resize(narrow<size_t>(dim));
+        }
+
+        for (std::ptrdiff_t b = first; b < last; ++b) {
+          T* out = output_data + b * dim;
+          // float outputs are accumulated in place, float16 outputs in a float buffer that is converted at the end
+          float* acc;
+          if constexpr (std::is_same_v<T, MLFloat16>) {
+            acc = acc_buffer.data();
+          } else {
+            acc = out;
+          }
+          std::fill_n(acc, narrow<size_t>(dim), 0.0f);
+
+          const int64_t begin = bag_starts[narrow<size_t>(b)];
+          const int64_t end = bag_starts[narrow<size_t>(b + 1)];
+          for (int64_t i = begin; i < end; ++i) {
+            int64_t row = static_cast<int64_t>(indices_data[i]);
+            row = row < 0 ? row + num_rows : row;
+            const float weight = weights ? static_cast<float>(weights[i]) : 1.0f;
+            AccumulateRow(table, row, weight, acc, row_buffer.data());
+          }
+
+          if (mean_ && end - begin > 1) {
+            const float inv_count = 1.0f / static_cast<float>(end - begin);
+            for (int64_t d = 0; d < dim; ++d) {
+              acc[d] *= inv_count;
+            }
+          }
+
+          if constexpr (std::is_same_v<T, MLFloat16>) {
+            MlasConvertFloatToHalfBuffer(acc, out, narrow<size_t>(dim));
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+#define REGISTER_EMBEDDINGBAG(T, Tind)                                                                       \
+  ONNX_OPERATOR_TWO_TYPED_KERNEL_EX(                                                                         \
+      EmbeddingBag,                                                                                          \
+      kMSDomain, 1,                                                                                          \
+      T, Tind,                                                                                               \
+      kCpuExecutionProvider,                                                                                 \
+      KernelDefBuilder()                                                                                     \
+          .TypeConstraint("T1", {DataTypeImpl::GetTensorType<T>(), DataTypeImpl::GetTensorType<uint8_t>()}) \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())                                             \
+          .TypeConstraint("Tind", DataTypeImpl::GetTensorType<Tind>()),                                      \
+      EmbeddingBag<T, Tind>);
+
+REGISTER_EMBEDDINGBAG(float, int32_t);
+REGISTER_EMBEDDINGBAG(float, int64_t);
+REGISTER_EMBEDDINGBAG(MLFloat16, int32_t);
+REGISTER_EMBEDDINGBAG(MLFloat16, int64_t);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -12,25 +12,13 @@
 #include "core/framework/op_kernel.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
+#include "contrib_ops/cpu/quantization/gather_block_quantized_helper.h"
 
 namespace onnxruntime {
 namespace contrib {
 
-namespace {
-template <typename T1>
-int32_t Get4BitElement(const T1* data_ptr, int64_t data_idx) {
-  return static_cast<int32_t>(data_ptr[data_idx >> 1].GetElem(narrow<size_t>(data_idx & 1)));
-}
-
-template <>
-int32_t Get4BitElement<uint8_t>(const uint8_t* data_ptr, int64_t data_idx) {
-  const uint8_t data_val_u8 = data_ptr[data_idx >> 1];
-  // Weights are stored as (nibble2)(nibble1) in uint8_t.
-  auto data_val = static_cast<int32_t>((data_idx & 1) ? ((data_val_u8 >> 4) & 0x0F) : (data_val_u8 & 0x0F));
-  return data_val;
-}
-
-}  // namespace
+using gather_block_quantized_helper::Get4BitElement;
+using gather_block_quantized_helper::GetUInt8ZeroPoint;
 
 template <typename T1, typename Tind>
 class GatherBlockQuantized : public OpKernel {
@@ -237,21 +225,7 @@ Status GatherBlockQuantized<T1, Tind>::CopyDataAndDequantize(const T1* data_ptr,
       int32_t zp_val;
 
       if constexpr (std::is_same_v<T1, uint8_t>) {
-        if (zero_points_ptr) {
-          if (bits_ == 4) {
-            uint8_t packed = zero_points_ptr[scale_idx >> 1];
-            if (scale_idx & 1) {
-              zp_val = static_cast<int32_t>((packed >> 4) & 0x0F);
-            } else {
-              zp_val = static_cast<int32_t>(packed & 0x0F);
-            }
-          } else {  // bits_ == 8
-            zp_val = static_cast<int32_t>(zero_points_ptr[scale_idx]);
-          }
-        } else {
-          const int32_t default_zero_point = bits_ == 4 ? 8 : 128;
-          zp_val = default_zero_point;
-        }
+        zp_val = GetUInt8ZeroPoint(zero_points_ptr, scale_idx, bits_);
       } else {
         zp_val = zero_points_ptr
                      ? static_cast<int32_t>(zero_points_ptr[scale_idx >> 1].GetElem(narrow<size_t>(scale_idx & 1)))
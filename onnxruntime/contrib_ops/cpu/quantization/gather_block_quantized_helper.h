@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+
+#include "core/common/narrow.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace gather_block_quantized_helper {
+
+// Element access shared by the kernels that read GatherBlockQuantized style block-wise quantized tables.
+
+template <typename T1>
+inline int32_t Get4BitElement(const T1* data_ptr, int64_t data_idx) {
+  return static_cast<int32_t>(data_ptr[data_idx >> 1].GetElem(narrow<size_t>(data_idx & 1)));
+}
+
+template <>
+inline int32_t Get4BitElement<uint8_t>(const uint8_t* data_ptr, int64_t data_idx) {
+  const uint8_t data_val_u8 = data_ptr[data_idx >> 1];
+  // Weights are stored as (nibble2)(nibble1) in uint8_t.
+  auto data_val = static_cast<int32_t>((data_idx & 1) ? ((data_val_u8 >> 4) & 0x0F) : (data_val_u8 & 0x0F));
+  return data_val;
+}
+
+// Zero point of the block `scale_idx` for uint8 data, following MatMulNBits conventions: 4 bit zero points are
+// packed two per byte and the default is 2^(bits-1) when no zero points are given.
+inline int32_t GetUInt8ZeroPoint(const uint8_t* zero_points_ptr, int64_t scale_idx, int64_t bits) {
+  if (!zero_points_ptr) {
+    return bits == 4 ? 8 : 128;
+  }
+  if (bits == 4) {
+    return Get4BitElement(zero_points_ptr, scale_idx);
+  }
+  return static_cast<int32_t>(zero_points_ptr[scale_idx]);
+}
+
+}  // namespace gather_block_quantized_helper
+}  // namespace contrib
+}  // namespace onnxruntime
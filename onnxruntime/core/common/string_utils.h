@@ -5,6 +5,8 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -103,5 +105,68 @@ inline std::string GetLowercaseString(std::string str) {
   return str;
 }
 
+namespace detail {
+
+// Per-byte case flip mask for the 7-bit ASCII letters in [first, last] of the 8 bytes in `word`.
+// Bytes with the high bit set (UTF-8 lead/continuation bytes) are never selected.
+inline uint64_t AsciiCaseFlipMask(uint64_t word, char first, char last) {
+  constexpr uint64_t kOnes = 0x0101010101010101ull;
+  constexpr uint64_t kHighBits = 0x8080808080808080ull;
+  const uint64_t low_bits = word & ~kHighBits;
+  const uint64_t at_or_above_first = low_bits + kOnes * static_cast<uint64_t>(0x80 - first);
+  const uint64_t above_last = low_bits + kOnes * static_cast<uint64_t>(0x80 - last - 1);
+  return ((at_or_above_first & ~above_last & ~word & kHighBits) >> 2);
+}
+
+inline void AsciiChangeCase(std::string_view src, char* dst, char first, char last) {
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= src.size(); i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, src.data() + i, sizeof(word));
+    word ^= AsciiCaseFlipMask(word, first, last);
+    memcpy(dst + i, &word, sizeof(word));
+  }
+  for (; i < src.size(); ++i) {
+    const char ch = src[i];
+    dst[i] = (ch >= first && ch <= last) ? static_cast<char>(ch ^ 0x20) : ch;
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Returns true if the string only holds 7-bit ASCII characters.
+ * Checks 8 bytes at a time.
+ */
+inline bool IsAsciiString(std::string_view str) {
+  uint64_t bits = 0;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= str.size(); i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, str.data() + i, sizeof(word));
+    bits |= word;
+  }
+  for (; i < str.size(); ++i) {
+    bits |= static_cast<unsigned char>(str[i]);
+  }
+  return (bits & 0x8080808080808080ull) == 0;
+}
+
+/**
+ * Lowercases the ASCII letters of `src` into `dst` (which must hold src.size() characters) 8 bytes at a time.
+ * Non-ASCII bytes are copied unchanged, so UTF-8 input stays valid.
+ */
+inline void AsciiToLower(std::string_view src, char* dst) {
+  detail::AsciiChangeCase(src, dst, 'A', 'Z');
+}
+
+/**
+ * Uppercases the ASCII letters of `src` into `dst` (which must hold src.size() characters) 8 bytes at a time.
+ * Non-ASCII bytes are copied unchanged, so UTF-8 input stays valid.
+ */
+inline void AsciiToUpper(std::string_view src, char* dst) {
+  detail::AsciiChangeCase(src, dst, 'a', 'z');
+}
+
 }  // namespace utils
 }  // namespace onnxruntime
@@ -0,0 +1,330 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/cpu_graph.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "core/framework/config_options.h"
+#include "core/framework/execution_frame.h"
+#include "core/framework/feeds_fetches_manager.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/sequential_execution_plan.h"
+#include "core/framework/session_state.h"
+#include "core/graph/constants.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+struct CpuGraph::CapturedGraph {
+  InlinedVector<int> feed_idxs;
+  InlinedVector<int> fetch_idxs;
+  // Buffers the feeds of a Run are copied to. They are passed to the execution frame as its feeds.
+  std::vector<OrtValue> feeds;
+  std::unique_ptr<ExecutionFrame> frame;
+  // Contexts of the nodes in the order of CpuGraph::node_execution_order_. They refer to frame.
+  std::vector<std::unique_ptr<OpKernelContextInternal>> kernel_contexts;
+  // The contexts refer to this flag, which is set to the terminate flag of the Run that uses them.
+  bool terminate_flag = false;
+  // The contexts refer to these options, which are set to the config options of the RunOptions of the Run that
+  // uses them, so kernels read the run config entries of the current Run when they are replayed.
+  ConfigOptions run_config_options;
+
+  std::atomic<bool> captured{false};
+  // Set if a replay failed. The Runs use the regular execution from then on.
+  bool disabled = false;
+  // Held by the Run that captures or replays the graph.
+  std::mutex mutex;
+
+  void Reset() {
+    captured.store(false, std::memory_order_release);
+    kernel_contexts.clear();
+    frame.reset();
+    feeds.clear();
+  }
+};
+
+namespace {
+
+bool IsCpuTensor(const OrtValue& value) {
+  return value.IsTensor() && value.Get<Tensor>().Location().device.Type() == OrtDevice::CPU;
+}
+
+Status ComputeKernel(const OpKernel& kernel, OpKernelContextInternal& kernel_ctx) {
+  Status status;
+  ORT_TRY {
+    status = kernel.Compute(&kernel_ctx);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+    });
+  }
+
+  if (!status.IsOK()) {
+    const auto& node = kernel.Node();
+    return Status(status.Category(), status.Code(),
+                  MakeString("Non-zero status code returned while running ", node.OpType(), " node. Name:'",
+                             node.Name(), "' Status Message: ", status.ErrorMessage()));
+  }
+
+  return Status::OK();
+}
+
+Status TerminateStatus() {
+  return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+}
+
+}  // namespace
+
+Status CpuGraph::Create(const SessionState& session_state, std::unique_ptr<CpuGraph>& cpu_graph) {
+  const GraphViewer& graph_viewer = session_state.GetGraphViewer();
+  for (const auto& node : graph_viewer.Nodes()) {
+    ORT_RETURN_IF(node.ContainsSubgraph(), "CPU graph capture does not support control flow nodes. Node:'",
+                  node.Name(), "'");
+    ORT_RETURN_IF(node.GetExecutionProviderType() != kCpuExecutionProvider,
+                  "CPU graph capture requires all nodes to be assigned to the CPU execution provider. Node:'",
+                  node.Name(), "' is assigned to '", node.GetExecutionProviderType(), "'");
+
+    // The outputs of a replayed node are written to the values allocated when it was captured, which is only
+    // possible for tensors.
+    for (const auto* output : node.OutputDefs()) {
+      const auto* type = output->TypeAsProto();
+      ORT_RETURN_IF(output->Exists() && (type == nullptr || !type->has_tensor_type()),
+                    "CPU graph capture only supports tensor outputs. Output '", output->Name(), "' of node:'",
+                    node.Name(), "' is not a tensor.");
+    }
+
+    const OpKernel* kernel = session_state.GetKernel(node.Index());
+    ORT_RETURN_IF(kernel == nullptr || kernel->IsAsync(), "CPU graph capture does not support the kernel of node:'",
+                  node.Name(), "'");
+  }
+
+  // All the nodes are on one stream, so all the steps of the execution plan launch kernels.
+  const SequentialExecutionPlan& execution_plan = *session_state.GetExecutionPlan();
+  ORT_RETURN_IF(execution_plan.NumberOfValidStreams() > 1 || !execution_plan.notification_owner_stream.empty() ||
+                    execution_plan.num_barriers > 0,
+                "CPU graph capture requires the nodes to be executed on a single stream.");
+
+  InlinedVector<NodeIndex> node_execution_order;
+  for (const auto& stream : execution_plan.execution_plan) {
+    for (const auto& step : stream->steps_) {
+      node_execution_order.push_back(step->GetNodeIndex());
+    }
+  }
+
+  cpu_graph.reset(new CpuGraph(session_state, std::move(node_execution_order)));
+  return Status::OK();
+}
+
+CpuGraph::CpuGraph(const SessionState& session_state, InlinedVector<NodeIndex>&& node_execution_order)
+    : session_state_(session_state), node_execution_order_(std::move(node_execution_order)) {
+}
+
+CpuGraph::~CpuGraph() = default;
+
+bool CpuGraph::IsGraphCaptured(int graph_annotation_id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto entry = graphs_.find(graph_annotation_id);
+  return entry != graphs_.end() && entry->second->captured.load(std::memory_order_acquire);
+}
+
+Status CpuGraph::Run(int graph_annotation_id, const FeedsFetchesInfo& feeds_fetches_info,
+                     gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches,
+                     const ConfigOptions& run_config_options, const bool& terminate_flag, bool& executed) {
+  executed = false;
+
+  std::shared_ptr<CapturedGraph> graph;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entry = graphs_[graph_annotation_id];
+    if (!entry) {
+      entry = std::make_shared<CapturedGraph>();
+    }
+    graph = entry;
+  }
+
+  std::unique_lock<std::mutex> graph_lock(graph->mutex, std::try_to_lock);
+  if (!graph_lock.owns_lock() || graph->disabled) {
+    return Status::OK();
+  }
+
+  if (!graph->captured.load(std::memory_order_relaxed)) {
+    return Capture(*graph, feeds_fetches_info, feeds, fetches, run_config_options, terminate_flag, executed);
+  }
+
+  // The graph is only replayed for the feeds, feed shapes and fetches it was captured for.
+  if (!std::equal(graph->feed_idxs.begin(), graph->feed_idxs.end(),
+                  feeds_fetches_info.feeds_mlvalue_idxs.begin(), feeds_fetches_info.feeds_mlvalue_idxs.end()) ||
+      !std::equal(graph->fetch_idxs.begin(), graph->fetch_idxs.end(),
+                  feeds_fetches_info.fetches_mlvalue_idxs.begin(), feeds_fetches_info.fetches_mlvalue_idxs.end())) {
+    return Status::OK();
+  }
+
+  for (size_t i = 0, end = feeds.size(); i < end; ++i) {
+    if (!IsCpuTensor(feeds[i])) {
+      return Status::OK();
+    }
+
+    const Tensor& feed = feeds[i].Get<Tensor>();
+    const Tensor& captured_feed = graph->feeds[i].Get<Tensor>();
+    if (feed.DataType() != captured_feed.DataType() || feed.Shape() != captured_feed.Shape()) {
+      return Status::OK();
+    }
+  }
+
+  for (const auto& fetch : fetches) {
+    if (fetch.IsAllocated() && !IsCpuTensor(fetch)) {
+      return Status::OK();
+    }
+  }
+
+  executed = true;
+  Status status = Replay(*graph, feeds, fetches, run_config_options, terminate_flag);
+  if (!status.IsOK() && !terminate_flag) {
+    // The buffers the replay wrote to are owned by the captured graph, so the Run can still use the regular
+    // execution, which returns the error if the replay did not fail because of a changed output shape.
+    LOGS(session_state_.Logger(), WARNING) << "Replay of the CPU graph with graph annotation id "
+                                           << graph_annotation_id << " failed. It is no longer replayed. "
+                                           << status.ErrorMessage();
+    graph->disabled = true;
+    graph->Reset();
+    executed = false;
+    return Status::OK();
+  }
+
+  return status;
+}
+
+Status CpuGraph::Capture(CapturedGraph& graph, const FeedsFetchesInfo& feeds_fetches_info,
+                         gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches,
+                         const ConfigOptions& run_config_options, const bool& terminate_flag,
+                         bool& executed) const {
+  for (const auto& feed : feeds) {
+    if (!IsCpuTensor(feed)) {
+      return Status::OK();
+    }
+  }
+
+  for (const auto& fetch : fetches) {
+    if (fetch.IsAllocated() && !IsCpuTensor(fetch)) {
+      return Status::OK();
+    }
+  }
+
+  executed = true;
+
+  const auto& data_transfer_mgr = session_state_.GetDataTransferMgr();
+  AllocatorPtr cpu_allocator = session_state_.GetAllocator(OrtDevice());
+  graph.feed_idxs = feeds_fetches_info.feeds_mlvalue_idxs;
+  graph.fetch_idxs = feeds_fetches_info.fetches_mlvalue_idxs;
+  graph.feeds.reserve(feeds.size());
+  for (const auto& feed : feeds) {
+    const Tensor& tensor = feed.Get<Tensor>();
+    OrtValue copy;
+    Tensor::InitOrtValue(tensor.DataType(), tensor.Shape(), cpu_allocator, copy);
+    ORT_RETURN_IF_ERROR(data_transfer_mgr.CopyTensor(tensor, *copy.GetMutable<Tensor>()));
+    graph.feeds.push_back(std::move(copy));
+  }
+
+  graph.frame = std::make_unique<ExecutionFrame>(graph.feed_idxs, graph.feeds, graph.fetch_idxs,
+                                                 gsl::span<const OrtValue>(),
+                                                 std::unordered_map<size_t, IExecutor::CustomAllocator>(),
+#ifdef ORT_ENABLE_STREAM
+                                                 nullptr,
+#endif
+                                                 session_state_);
+
+  // The values are not released after their last use, so the replays find them allocated.
+  graph.terminate_flag = terminate_flag;
+  graph.run_config_options = run_config_options;
+  graph.kernel_contexts.reserve(node_execution_order_.size());
+  Status status;
+  for (NodeIndex node_index : node_execution_order_) {
+    if (terminate_flag) {
+      status = TerminateStatus();
+      break;
+    }
+
+    const OpKernel& kernel = *session_state_.GetKernel(node_index);
+    // The logger of the session is used as the contexts outlive the Run.
+    auto kernel_ctx = std::make_unique<OpKernelContextInternal>(session_state_, *graph.frame, kernel,
+                                                                session_state_.Logger(), graph.terminate_flag,
+                                                                /*stream*/ nullptr, &graph.run_config_options);
+    status = ComputeKernel(kernel, *kernel_ctx);
+    if (!status.IsOK()) {
+      break;
+    }
+
+    graph.kernel_contexts.push_back(std::move(kernel_ctx));
+  }
+
+  if (status.IsOK()) {
+    status = CopyFetches(graph, fetches);
+  }
+
+  if (status.IsOK()) {
+    graph.captured.store(true, std::memory_order_release);
+  } else {
+    graph.Reset();
+  }
+
+  return status;
+}
+
+Status CpuGraph::Replay(CapturedGraph& graph, gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches,
+                        const ConfigOptions& run_config_options, const bool& terminate_flag) const {
+  const auto& data_transfer_mgr = session_state_.GetDataTransferMgr();
+  for (size_t i = 0, end = feeds.size(); i < end; ++i) {
+    ORT_RETURN_IF_ERROR(data_transfer_mgr.CopyTensor(feeds[i].Get<Tensor>(), *graph.feeds[i].GetMutable<Tensor>()));
+  }
+
+  graph.terminate_flag = terminate_flag;
+  graph.run_config_options = run_config_options;
+  for (size_t i = 0, end = graph.kernel_contexts.size(); i < end; ++i) {
+    if (terminate_flag) {
+      return TerminateStatus();
+    }
+
+    ORT_RETURN_IF_ERROR(ComputeKernel(*session_state_.GetKernel(node_execution_order_[i]),
+                                      *graph.kernel_contexts[i]));
+  }
+
+  return CopyFetches(graph, fetches);
+}
+
+Status CpuGraph::CopyFetches(CapturedGraph& graph, std::vector<OrtValue>& fetches) const {
+  // The fetches are copied as the buffers of the frame are overwritten by the next replay.
+  std::vector<OrtValue> outputs;
+  ORT_RETURN_IF_ERROR(graph.frame->GetOutputs(outputs));
+  if (fetches.empty()) {
+    fetches.resize(outputs.size());
+  }
+
+  ORT_RETURN_IF(fetches.size() != outputs.size(), "Expected ", outputs.size(), " fetches but got ", fetches.size());
+
+  const auto& data_transfer_mgr = session_state_.GetDataTransferMgr();
+  AllocatorPtr cpu_allocator = session_state_.GetAllocator(OrtDevice());
+  for (size_t i = 0, end = outputs.size(); i < end; ++i) {
+    if (!outputs[i].IsAllocated()) {
+      continue;
+    }
+
+    const Tensor& output = outputs[i].Get<Tensor>();
+    if (!fetches[i].IsAllocated()) {
+      Tensor::InitOrtValue(output.DataType(), output.Shape(), cpu_allocator, fetches[i]);
+    } else {
+      const Tensor& fetch = fetches[i].Get<Tensor>();
+      ORT_RETURN_IF(fetch.DataType() != output.DataType() || fetch.Shape() != output.Shape(),
+                    "Pre-allocated fetch ", i, " with shape ", fetch.Shape(), " does not match the output shape ",
+                    output.Shape());
+    }
+
+    ORT_RETURN_IF_ERROR(data_transfer_mgr.CopyTensor(output, *fetches[i].GetMutable<Tensor>()));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/ort_value.h"
+#include "core/graph/basic_types.h"
+
+namespace onnxruntime {
+
+struct ConfigOptions;
+class SessionState;
+struct FeedsFetchesInfo;
+
+/**
+Capture and replay of the kernel invocations of a graph whose nodes are all assigned to the CPU execution provider.
+
+Capturing a graph executes its nodes in the order of the execution plan in an execution frame that is kept after the
+Run, together with the OpKernelContext of every node. No value is released, so every node output keeps the buffer
+the allocation plan gave it. The feeds are copied to buffers owned by the captured graph.
+
+A replay copies the feeds to the captured feed buffers and calls Compute of each kernel with its captured context.
+The node outputs are already allocated with the captured shapes, so the kernels write to them without allocating.
+The fetches are copied out of the execution frame at the end of the replay.
+
+The kernels still compute the shapes of their outputs when they are replayed. If the shape of an output differs from
+the captured one the replay fails, and the graph annotation id is no longer captured or replayed. Replayed nodes are
+not profiled.
+
+A captured graph is used by one Run at a time. A concurrent Run with the same graph annotation id uses the regular
+execution.
+*/
+class CpuGraph {
+ public:
+  // Returns an error if the graph of session_state cannot be captured.
+  static Status Create(const SessionState& session_state, std::unique_ptr<CpuGraph>& cpu_graph);
+
+  ~CpuGraph();
+
+  // Replay the graph captured for graph_annotation_id, or capture it if there is none yet.
+  // executed is false if the Run has to use the regular execution instead, e.g. if the feed shapes or the names of
+  // the feeds and fetches differ from the captured ones.
+  // The kernels read the run config entries of run_config_options whether they are captured or replayed.
+  Status Run(int graph_annotation_id, const FeedsFetchesInfo& feeds_fetches_info, gsl::span<const OrtValue> feeds,
+             std::vector<OrtValue>& fetches, const ConfigOptions& run_config_options, const bool& terminate_flag,
+             bool& executed);
+
+  bool IsGraphCaptured(int graph_annotation_id) const;
+
+ private:
+  struct CapturedGraph;
+
+  explicit CpuGraph(const SessionState& session_state, InlinedVector<NodeIndex>&& node_execution_order);
+
+  Status Capture(CapturedGraph& graph, const FeedsFetchesInfo& feeds_fetches_info, gsl::span<const OrtValue> feeds,
+                 std::vector<OrtValue>& fetches, const ConfigOptions& run_config_options, const bool& terminate_flag,
+                 bool& executed) const;
+
+  Status Replay(CapturedGraph& graph, gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches,
+                const ConfigOptions& run_config_options, const bool& terminate_flag) const;
+
+  Status CopyFetches(CapturedGraph& graph, std::vector<OrtValue>& fetches) const;
+
+  const SessionState& session_state_;
+  // LaunchKernelStep nodes of the execution plan in execution order.
+  const InlinedVector<NodeIndex> node_execution_order_;
+
+  mutable std::mutex mutex_;
+  InlinedHashMap<int, std::shared_ptr<CapturedGraph>> graphs_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CpuGraph);
+};
+
+}  // namespace onnxruntime
@@ -37,6 +37,21 @@ OpKernelContext::OpKernelContext(_Inout_ IExecutionFrame* frame, _In_ const OpKe
   node_output_start_index_ = node_implicit_input_start_index_ + ImplicitInputCount();
 }
 
+OpKernelContext::OpKernelContext(_Inout_ IExecutionFrame* frame, _In_ const OpKernel* kernel,
+                                 _In_ Stream* stream,
+                                 _In_opt_ concurrency::ThreadPool* threadpool, _In_ const logging::Logger& logger,
+                                 int node_input_start_index, int node_implicit_input_start_index,
+                                 int node_output_start_index)
+    : execution_frame_(frame),
+      kernel_(kernel),
+      threadpool_(threadpool),
+      logger_(&logger),
+      node_input_start_index_(node_input_start_index),
+      node_implicit_input_start_index_(node_implicit_input_start_index),
+      node_output_start_index_(node_output_start_index),
+      stream_(stream) {
+}
+
 OpKernelContext::OpKernelContext(concurrency::ThreadPool* threadpool,
                                  const logging::Logger& logger,
                                  Stream* stream) : threadpool_(threadpool), logger_(&logger), stream_(stream) {}
@@ -22,29 +22,30 @@ class OpKernelContextInternal : public OpKernelContext {
                                    const OpKernel& kernel,
                                    const logging::Logger& logger,
                                    const bool& terminate_flag,
-                                   Stream* stream)
+                                   Stream* stream,
+                                   const ConfigOptions* run_config_options = nullptr)
       : OpKernelContext(&frame, &kernel, stream, session_state.GetThreadPool(), logger),
         session_state_(session_state),
-        terminate_flag_(terminate_flag) {
-    const auto& implicit_inputs = kernel.Node().ImplicitInputDefs();
-    int num_implicit_inputs = static_cast<int>(implicit_inputs.size());
-    implicit_input_values_.reserve(num_implicit_inputs);
-
-    for (int i = 0; i < num_implicit_inputs; ++i) {
-      const auto* entry = GetImplicitInputMLValue(i);
-      ORT_ENFORCE(entry != nullptr, "All implicit inputs should have OrtValue instances by now. ",
-                  implicit_inputs[i]->Name(), " does not.");
-      implicit_input_values_.push_back(entry);
-    }
+        terminate_flag_(terminate_flag),
+        run_config_options_(run_config_options) {
+    Init(kernel);
+  }
 
-#if !defined(ORT_MINIMAL_BUILD)
-    if (session_state_.GetNodeStatsRecorder() != nullptr) {
-      auto alloc = OpKernelContext::GetAllocator(kernel.GetDevice(OrtMemTypeDefault));
-      if (alloc != nullptr) {
-        accounting_allocator_ = std::make_shared<AccountingAllocator>(std::move(alloc));
-      }
-    }
-#endif
+  // Use the offsets of the arguments of the node resolved when the kernels were created.
+  explicit OpKernelContextInternal(const SessionState& session_state,
+                                   IExecutionFrame& frame,
+                                   const SessionState::KernelDispatchInfo& dispatch_info,
+                                   const logging::Logger& logger,
+                                   const bool& terminate_flag,
+                                   Stream* stream,
+                                   const ConfigOptions* run_config_options = nullptr)
+      : OpKernelContext(&frame, dispatch_info.kernel, stream, session_state.GetThreadPool(), logger,
+                        dispatch_info.node_input_start_index, dispatch_info.node_implicit_input_start_index,
+                        dispatch_info.node_output_start_index),
+        session_state_(session_state),
+        terminate_flag_(terminate_flag),
+        run_config_options_(run_config_options) {
+    Init(*dispatch_info.kernel);
   }
 
   bool GetUseDeterministicCompute() const override {
@@ -55,6 +56,11 @@ class OpKernelContextInternal : public OpKernelContext {
     return session_state_.GetSubgraphSessionState(GetNodeIndex(), attribute_name);
   }
 
+  // Finalize the SessionState of the subgraph if its initialization was deferred until first use.
+  Status FinalizeSubgraphSessionState(const std::string& attribute_name) {
+    return session_state_.FinalizeDeferredSubgraphSessionState(GetNodeIndex(), attribute_name);
+  }
+
   const OrtValue* GetInputMLValue(int index) const override {
     return OpKernelContext::GetInputMLValue(index);
   }
@@ -104,7 +110,32 @@ class OpKernelContextInternal : public OpKernelContext {
 
   const bool& GetTerminateFlag() const noexcept { return terminate_flag_; }
 
+  // Config options of the RunOptions of the current Run, or nullptr if there are none (e.g. in a subgraph).
+  const ConfigOptions* GetRunConfigOptions() const override { return run_config_options_; }
+
  private:
+  void Init(const OpKernel& kernel) {
+    const auto& implicit_inputs = kernel.Node().ImplicitInputDefs();
+    int num_implicit_inputs = static_cast<int>(implicit_inputs.size());
+    implicit_input_values_.reserve(num_implicit_inputs);
+
+    for (int i = 0; i < num_implicit_inputs; ++i) {
+      const auto* entry = GetImplicitInputMLValue(i);
+      ORT_ENFORCE(entry != nullptr, "All implicit inputs should have OrtValue instances by now. ",
+                  implicit_inputs[i]->Name(), " does not.");
+      implicit_input_values_.push_back(entry);
+    }
+
+#if !defined(ORT_MINIMAL_BUILD)
+    if (session_state_.GetNodeStatsRecorder() != nullptr) {
+      auto alloc = OpKernelContext::GetAllocator(kernel.GetDevice(OrtMemTypeDefault));
+      if (alloc != nullptr) {
+        accounting_allocator_ = std::make_shared<AccountingAllocator>(std::move(alloc));
+      }
+    }
+#endif
+  }
+
 #if !defined(ORT_MINIMAL_BUILD)
   class AccountingAllocator : public IAllocator {
    public:
@@ -137,6 +168,7 @@ class OpKernelContextInternal : public OpKernelContext {
 
   const SessionState& session_state_;
   const bool& terminate_flag_;
+  const ConfigOptions* run_config_options_;
   std::vector<const OrtValue*> implicit_input_values_;
 };
 
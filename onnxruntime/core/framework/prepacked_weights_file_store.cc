@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_file_store.h"
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/safeint.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+namespace {
+// Buffers start at page aligned offsets so the mapped buffers have the alignment of the page size.
+constexpr size_t kBufferAlignment = 4096;
+
+size_t AlignBufferOffset(size_t offset) {
+  return (SafeInt<size_t>(offset) + kBufferAlignment - 1) / kBufferAlignment * kBufferAlignment;
+}
+
+Status WriteWeightsFile(const Env& env, const std::filesystem::path& file_path,
+                        const PrePackedWeights& prepacked_weights) {
+  static std::atomic<size_t> temp_file_counter{0};
+
+  std::filesystem::path temp_file_path = file_path;
+  temp_file_path += "." + std::to_string(env.GetSelfPid()) + "." + std::to_string(temp_file_counter++) + ".tmp";
+
+  {
+    std::ofstream out(temp_file_path, std::ios::binary | std::ios::trunc);
+    ORT_RETURN_IF(!out.is_open(), "Failed to create the pre-packed weights file ", temp_file_path);
+
+    const std::vector<char> padding(kBufferAlignment, 0);
+    size_t offset = 0;
+    for (size_t i = 0; i < prepacked_weights.buffers_.size(); ++i) {
+      const size_t buffer_size = prepacked_weights.buffer_sizes_[i];
+      if (prepacked_weights.buffers_[i] == nullptr || buffer_size == 0) {
+        continue;
+      }
+      const size_t buffer_offset = AlignBufferOffset(offset);
+      out.write(padding.data(), static_cast<std::streamsize>(buffer_offset - offset));
+      out.write(static_cast<const char*>(prepacked_weights.buffers_[i].get()),
+                static_cast<std::streamsize>(buffer_size));
+      offset = buffer_offset + buffer_size;
+    }
+
+    out.close();
+    if (out.fail()) {
+      std::error_code ec;
+      std::filesystem::remove(temp_file_path, ec);
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write the pre-packed weights file ", temp_file_path);
+    }
+  }
+
+  // another process writing the same key concurrently writes the same content, so whichever rename comes last wins
+  std::error_code ec;
+  std::filesystem::rename(temp_file_path, file_path, ec);
+  if (ec) {
+    std::error_code remove_ec;
+    std::filesystem::remove(temp_file_path, remove_ec);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to rename ", temp_file_path, " to ", file_path, ": ",
+                           ec.message());
+  }
+
+  return Status::OK();
+}
+}  // namespace
+
+std::filesystem::path PrepackedWeightsFileStore::GetFilePath(const std::string& key) const {
+  std::string file_name = key;
+  for (char& c : file_name) {
+    const bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                       c == '_' || c == '-' || c == '+';
+    if (!valid) {
+      c = '_';
+    }
+  }
+  return directory_ / (file_name + ".bin");
+}
+
+Status PrepackedWeightsFileStore::MapWeights(const Env& env, const std::string& key,
+                                             const PrePackedWeights& prepacked_weights,
+                                             PrePackedWeights& mapped_weights) const {
+  ORT_RETURN_IF(prepacked_weights.buffers_.size() != prepacked_weights.buffer_sizes_.size(),
+                "The number of pre-packed buffers and buffer sizes differ for ", key);
+
+  std::vector<size_t> buffer_offsets;
+  buffer_offsets.reserve(prepacked_weights.buffers_.size());
+  size_t file_size = 0;
+  for (size_t i = 0; i < prepacked_weights.buffers_.size(); ++i) {
+    if (prepacked_weights.buffers_[i] == nullptr || prepacked_weights.buffer_sizes_[i] == 0) {
+      buffer_offsets.push_back(0);
+      continue;
+    }
+    buffer_offsets.push_back(AlignBufferOffset(file_size));
+    file_size = SafeInt<size_t>(buffer_offsets.back()) + prepacked_weights.buffer_sizes_[i];
+  }
+
+  const std::filesystem::path file_path = GetFilePath(key);
+  std::error_code ec;
+  const auto existing_file_size = std::filesystem::file_size(file_path, ec);
+  if (ec) {
+    std::filesystem::create_directories(directory_, ec);
+    ORT_RETURN_IF(ec, "Failed to create the pre-packed weights directory ", directory_, ": ", ec.message());
+    ORT_RETURN_IF_ERROR(WriteWeightsFile(env, file_path, prepacked_weights));
+  } else {
+    ORT_RETURN_IF(existing_file_size != file_size, "The pre-packed weights file ", file_path, " has ",
+                  existing_file_size, " bytes, expected ", file_size);
+  }
+
+  PrePackedWeights result;
+  result.buffers_.reserve(prepacked_weights.buffers_.size());
+  result.buffer_sizes_.reserve(prepacked_weights.buffers_.size());
+  for (size_t i = 0; i < prepacked_weights.buffers_.size(); ++i) {
+    const size_t buffer_size = prepacked_weights.buffer_sizes_[i];
+    if (prepacked_weights.buffers_[i] == nullptr || buffer_size == 0) {
+      result.buffers_.emplace_back(nullptr);
+      result.buffer_sizes_.push_back(buffer_size);
+      continue;
+    }
+
+    Env::MappedMemoryPtr mapped_memory;
+    ORT_RETURN_IF_ERROR(env.MapFileIntoMemory(file_path.native().c_str(),
+                                              static_cast<FileOffsetType>(buffer_offsets[i]), buffer_size,
+                                              mapped_memory));
+    // the key only holds a hash of the content, so the content is compared before the mapped copy replaces it
+    ORT_RETURN_IF(std::memcmp(mapped_memory.get(), prepacked_weights.buffers_[i].get(), buffer_size) != 0,
+                  "The content of the pre-packed weights file ", file_path, " differs from the pre-packed weights");
+
+    result.buffers_.emplace_back(mapped_memory.release(), mapped_memory.get_deleter());
+    result.buffer_sizes_.push_back(buffer_size);
+  }
+
+  mapped_weights = std::move(result);
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+#include "core/common/status.h"
+#include "core/framework/prepacked_weights.h"
+
+namespace onnxruntime {
+
+class Env;
+
+/**
+Directory of pre-packed weights shared by the sessions of different processes.
+
+A pre-packed weight is stored in a file named after its key, op_type + "+" + hash of the pre-packed buffers, so the
+files are keyed by content. Each buffer starts at a page aligned offset of the file. The files are memory mapped and
+never written to after they are created, so all the processes that map the same file use the same physical pages.
+
+The first process that pre-packs a weight writes the file. The file is written to a temporary file which is renamed
+once it is complete, so a process never maps a partially written file.
+*/
+class PrepackedWeightsFileStore {
+ public:
+  explicit PrepackedWeightsFileStore(std::filesystem::path directory) : directory_(std::move(directory)) {}
+
+  // Sets mapped_weights to buffers mapped from the file of key in the directory. The file is created from
+  // prepacked_weights if it does not exist yet. Returns an error if the file cannot be written or mapped, or if the
+  // content of an existing file differs from prepacked_weights.
+  Status MapWeights(const Env& env, const std::string& key, const PrePackedWeights& prepacked_weights,
+                    PrePackedWeights& mapped_weights) const;
+
+ private:
+  std::filesystem::path GetFilePath(const std::string& key) const;
+
+  const std::filesystem::path directory_;
+};
+
+}  // namespace onnxruntime
@@ -156,7 +156,8 @@ class SessionScope {
  public:
   friend class KernelScope;
   SessionScope(const SessionState& session_state, const ExecutionFrame& frame)
-      : session_state_(session_state)
+      : session_state_(session_state),
+        profiling_enabled_(session_state.Profiler().IsEnabled())
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
         ,
         frame_(frame)
@@ -177,7 +178,7 @@ class SessionScope {
             session_state_.GetGraphExecutionCounter(), 0}
 #endif
   {
-    if (session_state_.Profiler().IsEnabled()) {
+    if (profiling_enabled_) {
       session_start_ = session_state.Profiler().Start();
     }
 
@@ -225,7 +226,7 @@ class SessionScope {
     }
 #endif
 
-    if (session_state_.Profiler().IsEnabled()) {
+    if (profiling_enabled_) {
       session_state_.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", session_start_);
     }
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
@@ -254,6 +255,8 @@ class SessionScope {
 
  private:
   const SessionState& session_state_;
+  // Checked once per execution rather than for every kernel.
+  const bool profiling_enabled_;
   TimePoint session_start_;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   const ExecutionFrame& frame_;
@@ -344,7 +347,7 @@ class KernelScope {
     node_compute_range_.Begin();
 #endif
 
-    if (session_state_.Profiler().IsEnabled()) {
+    if (session_scope_.profiling_enabled_) {
       auto& node = kernel.Node();
       node_name_ = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
       concurrency::ThreadPool::StartProfiling(session_state_.GetThreadPool());
@@ -363,7 +366,7 @@ class KernelScope {
     node_compute_range_.End();
 #endif
 
-    if (session_state_.Profiler().IsEnabled()) {
+    if (session_scope_.profiling_enabled_) {
       auto& profiler = session_state_.Profiler();
       std::string output_type_shape_;
       CalculateTotalOutputSizes(&kernel_context_, total_output_sizes_, node_name_, output_type_shape_);
@@ -435,8 +438,9 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
                                   size_t stream_idx,
                                   const bool& terminate_flag,
                                   SessionScope& session_scope) {
-  auto* p_kernel = ctx.GetSessionState().GetKernel(idx);
-  if (p_kernel->KernelDef().OpName() == "YieldOp") {
+  const auto& dispatch_info = ctx.GetSessionState().GetKernelDispatchInfo(idx);
+  auto* p_kernel = dispatch_info.kernel;
+  if (dispatch_info.is_yield_op) {
     // Do not execute YieldOp (it is an no-op anyways).
     // Decrement the reference count of tensors that are not needed beyond this point.
     // REVIEW(codemzs): The current model assumes the intermediate tensors that are exported
@@ -448,12 +452,25 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
   // TODO: set terminate flag from run_option
   OpKernelContextInternal kernel_ctx(ctx.GetSessionState(),
                                      ctx.GetExecutionFrame(),
-                                     *p_kernel,
+                                     dispatch_info,
                                      ctx.GetLogger(),
                                      terminate_flag,
-                                     ctx.GetDeviceStream(stream_idx));
+                                     ctx.GetDeviceStream(stream_idx),
+                                     ctx.GetRunConfigOptions());
   onnxruntime::Status status;
   auto& logger = ctx.GetLogger();
+
+  // The outputs of shape computation nodes may be known from an earlier Run with the same feed shapes.
+  ShapePlanCache::Run* shape_plan_run = ctx.GetShapePlanRun();
+  if (shape_plan_run != nullptr) {
+    bool replayed = false;
+    ORT_RETURN_IF_ERROR(shape_plan_run->TryReplay(idx, kernel_ctx, replayed));
+    if (replayed) {
+      ctx.RecycleNodeInputs(idx);
+      return Status::OK();
+    }
+  }
+
   if (p_kernel->IsAsync()) {
     ORT_THROW("Async Kernel Support is not implemented yet.");
   } else {
@@ -573,6 +590,10 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
     return Status(status.Category(), status.Code(), msg_string);
   }
 
+  if (shape_plan_run != nullptr) {
+    shape_plan_run->Record(idx, kernel_ctx);
+  }
+
   ctx.RecycleNodeInputs(idx);
   VLOGS(logger, 0) << "stream " << stream_idx << " launch kernel with idx " << idx;
   return Status::OK();
@@ -588,9 +609,16 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
 #endif
                                    const bool& terminate_flag,
                                    const bool only_execute_path_to_fetches,
-                                   bool single_thread_mode) {
+                                   bool single_thread_mode,
+                                   const ConfigOptions* run_config_options) {
   auto* execution_plan = session_state.GetExecutionPlan();
   VLOGS(logger, 0) << "Number of streams: " << execution_plan->execution_plan.size();
+
+  std::unique_ptr<ShapePlanCache::Run> shape_plan_run;
+  if (const auto* shape_plan_cache = session_state.GetShapePlanCache(); shape_plan_cache != nullptr) {
+    shape_plan_run = shape_plan_cache->BeginRun(feed_mlvalue_idxs, feeds);
+  }
+
   int32_t valid_streams = 0;
   for (auto& stream : execution_plan->execution_plan) {
     if (stream && stream->steps_.size() > 0)
@@ -630,6 +658,8 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
 #else
   ORT_UNUSED_PARAMETER(only_execute_path_to_fetches);
 #endif
+  ctx.SetRunConfigOptions(run_config_options);
+  ctx.SetShapePlanRun(shape_plan_run.get());
 
   SessionScope session_scope(session_state, ctx.GetExecutionFrame());
 
@@ -651,6 +681,10 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
   ctx.WaitAll();
   ORT_RETURN_IF_ERROR(ctx.TaskStatus());
   ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GetOutputs(fetches));
+  if (shape_plan_run) {
+    shape_plan_run->Commit();
+  }
+
   if (ctx.GetExecutionFrame().HasMemoryPatternPlanner()) {
     bool all_tensors = true;
     for (const auto& feed : feeds) {
@@ -6,7 +6,10 @@
 #include <sstream>
 
 #include <mutex>
+#include <optional>
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
+#include "core/common/path_string.h"
 #include "core/common/safeint.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/allocator.h"
@@ -14,6 +17,7 @@
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/prepacked_weights_file_store.h"
 #include "core/framework/session_state_utils.h"
 #include "core/framework/utils.h"
 #include "core/providers/cpu/controlflow/utils.h"
@@ -271,7 +275,8 @@ const KernelCreateInfo& SessionState::GetNodeKernelCreateInfo(NodeIndex node_ind
   return *entry->second;
 }
 
-Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager) {
+Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager,
+                                   concurrency::ThreadPool* thread_pool) {
   const auto& nodes = graph_viewer_->Nodes();
   if (!nodes.empty()) {
     size_t max_nodeid = 0;
@@ -280,8 +285,8 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
     }
     session_kernels_.clear();
     session_kernels_.resize(max_nodeid + 1);
-    for (const auto& node : nodes) {
-      // construct and save the kernels
+
+    auto create_kernel = [this, &kernel_registry_manager](const Node& node) -> Status {
       const KernelCreateInfo& kci = GetNodeKernelCreateInfo(node.Index());
 
       // the execution provider was required to be valid to find the KernelCreateInfo so we don't need to check it here
@@ -289,10 +294,73 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
       const IExecutionProvider& exec_provider = *execution_providers_.Get(exec_provider_name);
 
       // assumes vector is already resize()'ed to the number of nodes in the graph
-      ORT_RETURN_IF_ERROR(kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]));
+      return kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]);
+    };
+
+    // The kernels of the CPU execution provider's own registry only read the session state while they are
+    // constructed, so they can be created concurrently. Kernels of other execution providers may register compiled
+    // functions, and custom op kernels run user code that is not required to be thread safe, so they are created
+    // sequentially below.
+    InlinedHashMap<NodeIndex, Status> cpu_kernel_statuses;
+    concurrent_kernel_nodes_.clear();
+    const auto* cpu_provider = execution_providers_.Get(kCpuExecutionProvider);
+    const auto cpu_kernel_registry = cpu_provider != nullptr ? cpu_provider->GetKernelRegistry() : nullptr;
+    if (thread_pool != nullptr && cpu_kernel_registry != nullptr) {
+      InlinedVector<const Node*> cpu_nodes;
+      for (const auto& node : nodes) {
+        if (node.GetExecutionProviderType() != kCpuExecutionProvider) {
+          continue;
+        }
+        const KernelCreateInfo* cpu_kci = nullptr;
+        if (cpu_kernel_registry->TryFindKernel(node, kCpuExecutionProvider,
+                                               kernel_registry_manager.GetKernelTypeStrResolver(), logger_,
+                                               &cpu_kci)
+                .IsOK() &&
+            cpu_kci == &GetNodeKernelCreateInfo(node.Index())) {
+          cpu_nodes.push_back(&node);
+          concurrent_kernel_nodes_.insert(node.Index());
+        }
+      }
+
+      std::vector<Status> statuses = session_state_utils::RunInitializationTasks(
+          thread_pool, cpu_nodes.size(), [&](size_t i) { return create_kernel(*cpu_nodes[i]); });
+
+      cpu_kernel_statuses.reserve(cpu_nodes.size());
+      for (size_t i = 0; i < cpu_nodes.size(); ++i) {
+        cpu_kernel_statuses.emplace(cpu_nodes[i]->Index(), std::move(statuses[i]));
+      }
+    }
+
+    for (const auto& node : nodes) {
+      // construct and save the kernels, reporting the failures of the ones created above in node order
+      auto status_it = cpu_kernel_statuses.find(node.Index());
+      if (status_it != cpu_kernel_statuses.end()) {
+        ORT_RETURN_IF_ERROR(status_it->second);
+      } else {
+        ORT_RETURN_IF_ERROR(create_kernel(node));
+      }
     }
   }
   node_index_info_.emplace(*graph_viewer_, ort_value_name_idx_map_);
+
+  kernel_dispatch_infos_.clear();
+  kernel_dispatch_infos_.resize(session_kernels_.size());
+  for (const auto& node : nodes) {
+    const OpKernel* kernel = GetKernel(node.Index());
+    if (kernel == nullptr) {
+      continue;
+    }
+
+    KernelDispatchInfo& dispatch_info = kernel_dispatch_infos_[node.Index()];
+    dispatch_info.kernel = kernel;
+    dispatch_info.node_input_start_index = node_index_info_->GetNodeOffset(node.Index());
+    dispatch_info.node_implicit_input_start_index =
+        dispatch_info.node_input_start_index + static_cast<int>(node.InputDefs().size());
+    dispatch_info.node_output_start_index =
+        dispatch_info.node_implicit_input_start_index + static_cast<int>(node.ImplicitInputDefs().size());
+    dispatch_info.is_yield_op = kernel->KernelDef().OpName() == "YieldOp";
+  }
+
   return Status::OK();
 }
 
@@ -452,17 +520,153 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
   return ss_1.str();
 }
 
+namespace {
+// The result of a PrePack call made ahead of the sequential pass of PrepackConstantInitializedTensors.
+struct PrecomputedPrePack {
+  int input_idx;
+  // the session state owning the constant initializer and its index there
+  const SessionState* owner;
+  int ort_value_idx;
+  Status status;
+  bool is_packed = false;
+  PrePackedWeights weights;
+};
+}  // namespace
+
+SessionState* SessionState::FindConstantInitializedTensorOwner(const std::string& input_name, int& ort_value_idx) {
+  SessionState* st = this;
+  do {
+    if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
+      if (st->constant_initialized_tensors_.count(ort_value_idx)) {
+        return st;
+      }
+      if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
+        return nullptr;
+      }
+    }
+    st = st->Parent();
+  } while (st);
+
+  return nullptr;
+}
+
 Status SessionState::PrepackConstantInitializedTensors(
     InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
-    const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
-  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
+    const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+    concurrency::ThreadPool* thread_pool) {
+  // Runs the PrePack calls of the CPU kernels concurrently, one task per node. The kernel may swap in shared
+  // pre-packed buffers after an input was packed, which could affect how the next inputs are packed, so a task stops
+  // at the first input that produced pre-packed buffers and leaves the remaining inputs to the sequential pass.
+  auto precompute_prepacks = [this, &initializers_to_share_map, thread_pool](
+                                 bool should_cache_prepacked_weights_for_shared_initializers)
+      -> InlinedHashMap<NodeIndex, std::vector<PrecomputedPrePack>> {
+    struct PrePackInput {
+      int input_idx;
+      SessionState* owner;
+      int ort_value_idx;
+      AllocatorPtr allocator;
+    };
+
+    AllocatorPtr allocator_for_caching;
+    InlinedVector<const Node*> nodes;
+    std::vector<std::vector<PrePackInput>> node_inputs;
+    for (auto& node : GetGraphViewer().Nodes()) {
+      if (concurrent_kernel_nodes_.count(node.Index()) == 0) {
+        continue;
+      }
+
+      const OpKernel* kernel = GetKernel(node.Index());
+      std::vector<PrePackInput> inputs;
+      int input_idx = 0;
+      for (auto& input_def : node.InputDefs()) {
+        int ort_value_idx = -1;
+        SessionState* owner = input_def->Exists()
+                                  ? FindConstantInitializedTensorOwner(input_def->Name(), ort_value_idx)
+                                  : nullptr;
+        if (owner != nullptr) {
+          AllocatorPtr allocator;
+          if (should_cache_prepacked_weights_for_shared_initializers &&
+              initializers_to_share_map.count(input_def->Name()) > 0) {
+            if (allocator_for_caching == nullptr) {
+              allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
+              ORT_ENFORCE(allocator_for_caching.get() != nullptr);
+            }
+            allocator = allocator_for_caching;
+          } else {
+            allocator = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+          }
+          inputs.push_back({input_idx, owner, ort_value_idx, std::move(allocator)});
+        }
+        input_idx++;
+      }
+
+      if (!inputs.empty()) {
+        nodes.push_back(&node);
+        node_inputs.push_back(std::move(inputs));
+      }
+    }
+
+    std::vector<std::vector<PrecomputedPrePack>> results(nodes.size());
+    std::ignore = session_state_utils::RunInitializationTasks(thread_pool, nodes.size(), [&](size_t i) -> Status {
+      OpKernel* kernel = GetMutableKernel(nodes[i]->Index());
+      for (const auto& input : node_inputs[i]) {
+        if (sess_options_.IsLoadCancellationFlagSet()) {
+          break;
+        }
+
+        const Tensor& tensor = input.owner->constant_initialized_tensors_.at(input.ort_value_idx).Get<Tensor>();
+        PrecomputedPrePack& result = results[i].emplace_back();
+        result.input_idx = input.input_idx;
+        result.owner = input.owner;
+        result.ort_value_idx = input.ort_value_idx;
+        ORT_TRY {
+          result.status = kernel->PrePack(tensor, input.input_idx, input.allocator, result.is_packed,
+                                          &result.weights);
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            result.status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+          });
+        }
+
+        if (!result.status.IsOK() || (result.is_packed && !result.weights.buffers_.empty())) {
+          break;
+        }
+      }
+      return Status::OK();
+    });
+
+    InlinedHashMap<NodeIndex, std::vector<PrecomputedPrePack>> precomputed;
+    precomputed.reserve(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      precomputed.emplace(nodes[i]->Index(), std::move(results[i]));
+    }
+    return precomputed;
+  };
+
+  // pre-packed weights shared with other processes through memory mapped files
+  std::optional<PrepackedWeightsFileStore> prepacked_weights_file_store;
+  const std::string shared_prepacked_weights_dir =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsSharedPrePackedWeightsDir, "");
+  if (!shared_prepacked_weights_dir.empty()) {
+    prepacked_weights_file_store.emplace(ToPathString(shared_prepacked_weights_dir));
+  }
+
+  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map,
+                                     &precompute_prepacks, &prepacked_weights_file_store, thread_pool](
                                         bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
+    InlinedHashMap<NodeIndex, std::vector<PrecomputedPrePack>> precomputed;
+    if (thread_pool != nullptr) {
+      precomputed = precompute_prepacks(should_cache_prepacked_weights_for_shared_initializers);
+    }
+
     for (auto& node : GetGraphViewer().Nodes()) {
       if (sess_options_.IsLoadCancellationFlagSet()) {
         return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
                                "Weight pre-packing was canceled due to user request.");
       }
       auto kernel = GetMutableKernel(node.Index());
+      auto precomputed_it = precomputed.find(node.Index());
       int input_idx = 0;
       for (auto& input_def : node.InputDefs()) {
         if (input_def->Exists()) {
@@ -480,6 +684,22 @@ Status SessionState::PrepackConstantInitializedTensors(
                 bool is_packed = false;
                 const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
 
+                // uses the result of the PrePack call made for this input by precompute_prepacks if there is one
+                auto pre_pack = [&](const AllocatorPtr& alloc, bool& packed, PrePackedWeights& weights) -> Status {
+                  if (precomputed_it != precomputed.end()) {
+                    for (PrecomputedPrePack& result : precomputed_it->second) {
+                      if (result.input_idx == input_idx && result.owner == st &&
+                          result.ort_value_idx == ort_value_idx) {
+                        result.owner = nullptr;  // consumed
+                        packed = result.is_packed;
+                        weights = std::move(result.weights);
+                        return result.status;
+                      }
+                    }
+                  }
+                  return kernel->PrePack(const_initialized_tensor, input_idx, alloc, packed, &weights);
+                };
+
                 auto iter = initializers_to_share_map.find(input_name);
                 bool is_shared_initializer = (iter != initializers_to_share_map.end());
 
@@ -498,9 +718,7 @@ Status SessionState::PrepackConstantInitializedTensors(
                   // pre-packed  weight with the pre-packed weight generated by this instance of the same op_type
                   // because other static properties of the node like node attributes could play a role in the
                   // pre-packed weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
+                  ORT_RETURN_IF_ERROR(pre_pack(allocator_for_caching, is_packed, weights_to_be_filled_in));
 
                   if (is_packed) {
                     // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight
@@ -596,9 +814,7 @@ Status SessionState::PrepackConstantInitializedTensors(
                   // pre-packed weight with the pre-packed weight generated by this instance of the same op_type because
                   // other static properties of the node like node attributes could play a role in the pre-packed
                   // weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, session_cpu_alloc,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
+                  ORT_RETURN_IF_ERROR(pre_pack(session_cpu_alloc, is_packed, weights_to_be_filled_in));
 
                   // Some kernels (matmul_nbits and non-CPU related kernels) do not share their pre-packed results
                   // even though they set is_packed = true so we leave it up to them.
@@ -616,6 +832,19 @@ Status SessionState::PrepackConstantInitializedTensors(
                         prepacked_weights_container_key);
 
                     if (weights_to_use == nullptr) {
+                      if (prepacked_weights_file_store.has_value()) {
+                        PrePackedWeights mapped_weights;
+                        Status status = prepacked_weights_file_store->MapWeights(
+                            Env::Default(), prepacked_weights_container_key, weights_to_be_filled_in, mapped_weights);
+                        if (status.IsOK()) {
+                          // releases the heap copy of the pre-packed weight
+                          weights_to_be_filled_in = std::move(mapped_weights);
+                        } else {
+                          LOGS(logger_, WARNING) << "Pre-packed weight of the node " << node.Name()
+                                                 << " is not shared with other processes: " << status.ErrorMessage();
+                        }
+                      }
+
                       // In this case pre-packed container owns the data
                       prepacked_for_graph->WritePackedMaybeForSave(input_name, prepacked_weights_container_key,
                                                                    std::move(weights_to_be_filled_in));
@@ -1325,7 +1554,8 @@ static Status VerifyEachNodeIsAssignedToAnEp(const Graph& graph, const logging::
 Status SessionState::FinalizeSessionState(const std::basic_string<PATH_CHAR_TYPE>& graph_location,
                                           const KernelRegistryManager& kernel_registry_manager,
                                           bool remove_initializers,
-                                          bool saving_ort_format) {
+                                          bool saving_ort_format,
+                                          bool save_prepacked_constant_initializers) {
   // recursively create the subgraph session state instances and populate the kernel create info in them.
   // it's simpler to handle the kernel create info recursively when deserializing,
   // so also do it recursively when calling PopulateKernelCreateInfo for consistency.
@@ -1338,7 +1568,8 @@ Status SessionState::FinalizeSessionState(const std::basic_string<PATH_CHAR_TYPE
   ComputeConstantInitializerUseCount(graph_, constant_initializers_use_count);
   return FinalizeSessionStateImpl(graph_location, kernel_registry_manager, nullptr, sess_options_,
                                   remove_initializers,
-                                  GetSaveModeForPrepacks(!remove_initializers, saving_ort_format),
+                                  save_prepacked_constant_initializers ||
+                                      GetSaveModeForPrepacks(!remove_initializers, saving_ort_format),
                                   constant_initializers_use_count);
 }
 
@@ -1488,6 +1719,25 @@ static void AccumulateAllNestedSubgraphsInfo(
   }
 }
 
+struct SessionState::DeferredSubgraphFinalization {
+  DeferredSubgraphFinalization(const std::basic_string<PATH_CHAR_TYPE>& graph_location_in,
+                               const KernelRegistryManager& kernel_registry_manager_in,
+                               const SessionOptions& subgraph_session_options_in,
+                               bool remove_initializers_in)
+      : graph_location(graph_location_in),
+        kernel_registry_manager(kernel_registry_manager_in),
+        subgraph_session_options(subgraph_session_options_in),
+        remove_initializers(remove_initializers_in) {
+    // Deferred finalization runs while the session may be executing on the intra-op thread pool.
+    subgraph_session_options.config_options.configurations.erase(kOrtSessionOptionsConfigParallelInitialization);
+  }
+
+  const std::basic_string<PATH_CHAR_TYPE> graph_location;
+  const KernelRegistryManager& kernel_registry_manager;
+  SessionOptions subgraph_session_options;
+  const bool remove_initializers;
+};
+
 Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_TYPE>& graph_location,
                                               const KernelRegistryManager& kernel_registry_manager,
                                               _In_opt_ const Node* parent_node,
@@ -1652,6 +1902,18 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   }
 #endif
 
+  // Session initialization may use the intra-op thread pool to do the work of the phases below concurrently.
+  concurrency::ThreadPool* initialization_thread_pool =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigParallelInitialization, "0") == "1"
+          ? thread_pool_
+          : nullptr;
+
+  const bool profile_initialization = profiler_.IsEnabled();
+  TimePoint phase_start;
+  if (profile_initialization) {
+    phase_start = profiler_.Start();
+  }
+
   ORT_RETURN_IF_ERROR(session_state_utils::SaveInitializedTensors(
       Env::Default(), graph_location, *graph_viewer_,
       GetAllocator(OrtDevice()),
@@ -1665,7 +1927,11 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
         return Status::OK();
       },
       logger_, data_transfer_mgr_, external_data_loader_mgr_, *p_seq_exec_plan_, session_options,
-      memory_profile_func, graph_.GetPrepacked()));
+      memory_profile_func, graph_.GetPrepacked(), initialization_thread_pool));
+
+  if (profile_initialization) {
+    profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_state_save_initialized_tensors", phase_start);
+  }
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
@@ -1679,16 +1945,45 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
     CleanInitializedTensorsFromGraph();
   }
 
-  ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
+  if (profile_initialization) {
+    phase_start = profiler_.Start();
+  }
+
+  ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager, initialization_thread_pool));
+
+  if (profile_initialization) {
+    profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_state_create_kernels", phase_start);
+  }
 
   if (!disable_prepacking) {
+    if (profile_initialization) {
+      phase_start = profiler_.Start();
+    }
+
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
-                                                          session_options.initializers_to_share_map));
+                                                          session_options.initializers_to_share_map,
+                                                          initialization_thread_pool));
+
+    if (profile_initialization) {
+      profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_state_prepack", phase_start);
+    }
   }
 
   ORT_RETURN_IF_ERROR(
       session_state_utils::SaveInputOutputNamesToNodeMapping(*graph_viewer_, *this, valid_outer_scope_node_args));
 
+  // Runs of the main graph with feed shapes seen before may reuse the results of its shape computations.
+  if (parent_node == nullptr) {
+    const size_t shape_plan_cache_size = ParseStringWithClassicLocale<size_t>(
+        session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigShapePlanCacheSize, "0"));
+    if (shape_plan_cache_size > 0) {
+      shape_plan_cache_ = std::make_unique<ShapePlanCache>(*this, shape_plan_cache_size);
+      if (!shape_plan_cache_->HasShapeComputationNodes()) {
+        shape_plan_cache_.reset();
+      }
+    }
+  }
+
   // Need to recurse into subgraph session state instances to finalize them and add the execution info
 
   // Currently all subgraphs need to be executed using the sequential EP due to potential deadlock with the current
@@ -1696,8 +1991,17 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   SessionOptions subgraph_session_options(session_options);
   subgraph_session_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
 
+  // The subgraphs of If, Loop and Scan nodes may be finalized on first use instead. Pre-packed weights of all
+  // subgraphs need to be available when they are saved, so that always happens eagerly.
+  const bool lazy_subgraph_initialization =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigLazySubgraphInitialization, "0") !=
+          "0" &&
+      !save_prepacked_initializers;
+
   for (const auto& node_to_subgraph_ss : subgraph_session_states_) {
     Node& node = *graph_.GetNode(node_to_subgraph_ss.first);
+    const bool defer_finalization = lazy_subgraph_initialization && node.Domain() == kOnnxDomain &&
+                                    (node.OpType() == "If" || node.OpType() == "Loop" || node.OpType() == "Scan");
 
     for (const auto& attr_subgraph_pair : node.GetAttributeNameToMutableSubgraphMap()) {
       auto& attr_name = attr_subgraph_pair.first;
@@ -1715,25 +2019,20 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
       // is used in OuterScopeNodeArgLocationAccumulator()
       subgraph_session_state.CreateGraphInfo(save_prepacked_initializers);
 
-      InlinedHashMap<OrtValueName, OrtDevice> subgraph_outer_scope_node_arg_to_location_map;
-      ORT_RETURN_IF_ERROR(OuterScopeNodeArgLocationAccumulator(*p_seq_exec_plan_, GetOrtValueNameIdxMap(),
-                                                               node,
-                                                               subgraph_session_state.GetGraphViewer(),
-                                                               subgraph_outer_scope_node_arg_to_location_map));
-
-      ORT_RETURN_IF_ERROR(subgraph_session_state.FinalizeSessionStateImpl(
-          graph_location, kernel_registry_manager, &node, subgraph_session_options, remove_initializers,
-          save_prepacked_initializers,
-          constant_initializers_use_count, subgraph_outer_scope_node_arg_to_location_map, true));
-
-      // setup all the info for handling the feeds and fetches used in subgraph execution
-      auto* p_op_kernel = GetMutableKernel(node.Index());
-      ORT_ENFORCE(p_op_kernel);
-
-      // Downcast is safe, since only control flow nodes have subgraphs
-      // (node.GetAttributeNameToMutableSubgraphMap() is non-empty)
-      auto& control_flow_kernel = static_cast<controlflow::IControlFlowKernel&>(*p_op_kernel);
-      ORT_RETURN_IF_ERROR(control_flow_kernel.SetupSubgraphExecutionInfo(*this, attr_name, subgraph_session_state));
+      if (defer_finalization) {
+        if (!deferred_subgraph_finalization_) {
+          deferred_subgraph_finalization_ = std::make_shared<DeferredSubgraphFinalization>(
+              graph_location, kernel_registry_manager, subgraph_session_options, remove_initializers);
+        }
+
+        subgraph_session_state.finalization_deferred_.store(true, std::memory_order_release);
+        continue;
+      }
+
+      ORT_RETURN_IF_ERROR(FinalizeSubgraphSessionState(node, attr_name, subgraph_session_state, graph_location,
+                                                       kernel_registry_manager, subgraph_session_options,
+                                                       remove_initializers, save_prepacked_initializers,
+                                                       constant_initializers_use_count));
     }
 
     // TODO: Once the subgraph session states have been finalized, can we go back and plan the location of implicit
@@ -1744,6 +2043,87 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   return Status::OK();
 }
 
+Status SessionState::FinalizeSubgraphSessionState(Node& node, const std::string& attr_name,
+                                                  SessionState& subgraph_session_state,
+                                                  const std::basic_string<PATH_CHAR_TYPE>& graph_location,
+                                                  const KernelRegistryManager& kernel_registry_manager,
+                                                  const SessionOptions& subgraph_session_options,
+                                                  bool remove_initializers,
+                                                  bool save_prepacked_initializers,
+                                                  InlinedHashMap<std::string, size_t>& constant_initializers_use_count) {
+  InlinedHashMap<OrtValueName, OrtDevice> subgraph_outer_scope_node_arg_to_location_map;
+  ORT_RETURN_IF_ERROR(OuterScopeNodeArgLocationAccumulator(*p_seq_exec_plan_, GetOrtValueNameIdxMap(),
+                                                           node,
+                                                           subgraph_session_state.GetGraphViewer(),
+                                                           subgraph_outer_scope_node_arg_to_location_map));
+
+  ORT_RETURN_IF_ERROR(subgraph_session_state.FinalizeSessionStateImpl(
+      graph_location, kernel_registry_manager, &node, subgraph_session_options, remove_initializers,
+      save_prepacked_initializers,
+      constant_initializers_use_count, subgraph_outer_scope_node_arg_to_location_map, true));
+
+  // setup all the info for handling the feeds and fetches used in subgraph execution
+  auto* p_op_kernel = GetMutableKernel(node.Index());
+  ORT_ENFORCE(p_op_kernel);
+
+  // Downcast is safe, since only control flow nodes have subgraphs
+  // (node.GetAttributeNameToMutableSubgraphMap() is non-empty)
+  auto& control_flow_kernel = static_cast<controlflow::IControlFlowKernel&>(*p_op_kernel);
+  return control_flow_kernel.SetupSubgraphExecutionInfo(*this, attr_name, subgraph_session_state);
+}
+
+Status SessionState::FinalizeDeferredSubgraphSessionState(NodeIndex index, const std::string& attribute_name) const {
+  const SessionState* subgraph_session_state = GetSubgraphSessionState(index, attribute_name);
+  if (subgraph_session_state == nullptr || !subgraph_session_state->IsFinalizationDeferred()) {
+    return Status::OK();
+  }
+
+  // Finalization may be requested concurrently by Run calls and the background initialization, and it reads the
+  // parent session states, so it is serialized session-wide.
+  const SessionState* root_session_state = this;
+  while (root_session_state->parent_ != nullptr) {
+    root_session_state = root_session_state->parent_;
+  }
+
+  std::lock_guard<std::mutex> lock(const_cast<SessionState*>(root_session_state)->deferred_finalization_mutex_);
+  if (!subgraph_session_state->IsFinalizationDeferred()) {
+    return Status::OK();
+  }
+
+  ORT_ENFORCE(deferred_subgraph_finalization_, "Subgraph finalization was deferred without its arguments.");
+  const DeferredSubgraphFinalization& args = *deferred_subgraph_finalization_;
+
+  // The constant initializers of the outer scopes were handled when they were finalized, so an empty use count is
+  // used here. It ensures no outer scope initializer is released on behalf of this subgraph.
+  InlinedHashMap<std::string, size_t> constant_initializers_use_count;
+  auto& session_state = const_cast<SessionState&>(*this);
+  auto& subgraph = const_cast<SessionState&>(*subgraph_session_state);
+  ORT_RETURN_IF_ERROR(session_state.FinalizeSubgraphSessionState(
+      *session_state.graph_.GetNode(index), attribute_name, subgraph, args.graph_location,
+      args.kernel_registry_manager, args.subgraph_session_options, args.remove_initializers,
+      /*save_prepacked_initializers*/ false, constant_initializers_use_count));
+
+  subgraph.ResolveMemoryPatternFlag();
+  subgraph.finalization_deferred_.store(false, std::memory_order_release);
+
+  return Status::OK();
+}
+
+Status SessionState::FinalizeDeferredSubgraphSessionStates(const std::function<bool()>& is_canceled) const {
+  for (const auto& node_to_subgraph_ss : subgraph_session_states_) {
+    for (const auto& attr_subgraph_pair : node_to_subgraph_ss.second) {
+      if (is_canceled()) {
+        return Status::OK();
+      }
+
+      ORT_RETURN_IF_ERROR(FinalizeDeferredSubgraphSessionState(node_to_subgraph_ss.first, attr_subgraph_pair.first));
+      ORT_RETURN_IF_ERROR(attr_subgraph_pair.second->FinalizeDeferredSubgraphSessionStates(is_canceled));
+    }
+  }
+
+  return Status::OK();
+}
+
 #ifdef ORT_ENABLE_STREAM
 static void BindToDeviceStream(const SequentialExecutionPlan& execution_plan,
                                DeviceStreamCollection& device_stream_map,
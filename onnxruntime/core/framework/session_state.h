@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <map>
 #include <unordered_map>
@@ -41,6 +43,7 @@
 #include "core/framework/memory_info.h"
 #endif
 
+#include "core/framework/shape_plan_cache.h"
 #include "core/framework/stream_handles.h"
 #ifdef ENABLE_TRAINING
 #include "core/framework/program_region.h"
@@ -118,6 +121,23 @@ class SessionState {
     return (node_id < session_kernels_.size()) ? session_kernels_[node_id].get() : nullptr;
   }
 
+  // What the executor needs to execute the kernel of a node, resolved once the kernels are created so it is not
+  // looked up for every execution.
+  struct KernelDispatchInfo {
+    const OpKernel* kernel = nullptr;
+    // Offsets of the inputs, implicit inputs and outputs of the node in the NodeIndexInfo.
+    int node_input_start_index = NodeIndexInfo::kInvalidEntry;
+    int node_implicit_input_start_index = NodeIndexInfo::kInvalidEntry;
+    int node_output_start_index = NodeIndexInfo::kInvalidEntry;
+    // YieldOp nodes are not executed.
+    bool is_yield_op = false;
+  };
+
+  // Get the dispatch info of the kernel for the specified node. The kernels must have been created.
+  const KernelDispatchInfo& GetKernelDispatchInfo(NodeIndex node_index) const {
+    return kernel_dispatch_infos_[node_index];
+  }
+
   const ExecutionProviders& GetExecutionProviders() const noexcept { return execution_providers_; }
 
   /**
@@ -240,6 +260,12 @@ class SessionState {
   Status UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                        MemoryPatternGroup mem_patterns) const;
 
+  /**
+  Get the cache of the results of the shape computation nodes keyed by the feed shapes.
+  nullptr if it is not enabled or the graph has no shape computation nodes.
+  */
+  const ShapePlanCache* GetShapePlanCache() const noexcept { return shape_plan_cache_.get(); }
+
   bool GetUseDeterministicCompute() const { return sess_options_.use_deterministic_compute; }
 
   /**
@@ -294,6 +320,22 @@ class SessionState {
   /// Return SessionState for the given Node index and attribute name if found.
   const SessionState* GetSubgraphSessionState(NodeIndex index, const std::string& attribute_name) const;
 
+  /**
+  Finalize the SessionState of the subgraph for the given Node index and attribute name if its finalization was
+  deferred by kOrtSessionOptionsConfigLazySubgraphInitialization. Control flow kernels call this before executing
+  the subgraph. Thread-safe, and a no-op once the subgraph SessionState is finalized.
+  */
+  Status FinalizeDeferredSubgraphSessionState(NodeIndex index, const std::string& attribute_name) const;
+
+  /**
+  Finalize all subgraph SessionState instances, including nested ones, whose finalization was deferred.
+  @param is_canceled Checked before each subgraph. Returns early if it returns true.
+  */
+  Status FinalizeDeferredSubgraphSessionStates(const std::function<bool()>& is_canceled) const;
+
+  /// Return true if this is a subgraph SessionState whose finalization was deferred and has not run yet.
+  bool IsFinalizationDeferred() const noexcept { return finalization_deferred_.load(std::memory_order_acquire); }
+
   concurrency::ThreadPool* GetThreadPool() const noexcept { return thread_pool_; }
   concurrency::ThreadPool* GetInterOpThreadPool() const noexcept { return inter_op_thread_pool_; }
 
@@ -315,7 +357,10 @@ class SessionState {
   Status FinalizeSessionState(const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
                               const KernelRegistryManager& kernel_registry_manager,
                               bool remove_initializers = true,
-                              bool saving_ort_format = false);
+                              bool saving_ort_format = false,
+                              // save the pre-packed constant initializers with the model regardless of
+                              // kOrtSessionOptionsSavePrePackedConstantInitializers (session cache)
+                              bool save_prepacked_constant_initializers = false);
 
   SessionState* Parent() {
     return parent_;
@@ -397,8 +442,10 @@ class SessionState {
   // Populate OrtValueNameIdxMap and create the graph viewer.
   void CreateGraphInfo(bool save_prepacked_on);
 
-  // create kernels using info in kernel_create_info_map_
-  Status CreateKernels(const KernelRegistryManager& custom_registry_manager);
+  // create kernels using info in kernel_create_info_map_.
+  // if thread_pool is given the kernels of the CPU execution provider's registry are created concurrently.
+  Status CreateKernels(const KernelRegistryManager& custom_registry_manager,
+                       concurrency::ThreadPool* thread_pool = nullptr);
 
   // remove TensorProto versions of initializers from Graph instance
   // (replaced byOrtValue instances in initialized_tensors_)
@@ -407,9 +454,16 @@ class SessionState {
   /**
    * Prepack the constant initialized tensors for better performance.
    * The original constant initialized tensors will be removed to save memory.
+   * If thread_pool is given the PrePack calls of the kernels created concurrently by CreateKernels run concurrently,
+   * one task per node, and their results are consumed in node order.
    */
   Status PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
-                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
+                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+                                           concurrency::ThreadPool* thread_pool = nullptr);
+
+  // Finds the constant initialized tensor consumed by a node input, looking into the outer scopes for a subgraph.
+  // Returns the session state owning it, or nullptr if the input is not a constant initializer.
+  SessionState* FindConstantInitializedTensorOwner(const std::string& input_name, int& ort_value_idx);
 
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
@@ -431,6 +485,19 @@ class SessionState {
                                   const InlinedHashMap<OrtValueName, OrtDevice>& outer_scope_node_arg_to_location_map = {},
                                   bool graph_info_already_created = false);
 
+  // Finalize the SessionState of the subgraph in attribute attr_name of node, and set up the execution info of the
+  // control flow kernel for it. The graph info of the subgraph SessionState must have been created.
+  Status FinalizeSubgraphSessionState(Node& node, const std::string& attr_name, SessionState& subgraph_session_state,
+                                      const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
+                                      const KernelRegistryManager& kernel_registry_manager,
+                                      const SessionOptions& subgraph_session_options,
+                                      bool remove_initializers,
+                                      bool save_prepacked_initializers,
+                                      InlinedHashMap<std::string, size_t>& constant_initializers_use_count);
+
+  // Arguments to finalize the subgraph SessionState instances of this SessionState when that is deferred.
+  struct DeferredSubgraphFinalization;
+
 #ifdef ENABLE_TRAINING
   Status GeneratePatternGroupCache(
       gsl::span<const OrtValue> inputs,
@@ -447,6 +514,10 @@ class SessionState {
 
   // cache of the constructed kernels to avoid spending construction time per executor
   std::vector<std::unique_ptr<OpKernel>> session_kernels_;
+
+  // Nodes whose kernels are from the CPU execution provider's registry. Set by CreateKernels if it is given a thread
+  // pool. Only these kernels are created and pre-packed concurrently.
+  InlinedHashSet<NodeIndex> concurrent_kernel_nodes_;
   Graph& graph_;
   std::optional<GraphViewer> graph_viewer_;  // GraphViewer for const access to Graph
 
@@ -531,11 +602,23 @@ class SessionState {
   NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
 #endif
 
+  // Results of the shape computation nodes by feed shapes. Set if enabled by kOrtSessionOptionsConfigShapePlanCacheSize.
+  std::unique_ptr<ShapePlanCache> shape_plan_cache_;
+
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
 
   SubgraphSessionStateMap subgraph_session_states_;
 
+  // Set if finalization of the subgraph SessionState instances of If, Loop and Scan nodes is deferred.
+  std::shared_ptr<const DeferredSubgraphFinalization> deferred_subgraph_finalization_;
+
+  // True for a subgraph SessionState until its deferred finalization has run.
+  std::atomic<bool> finalization_deferred_{false};
+
+  // Serializes deferred subgraph finalization. Only the one in the root SessionState is used.
+  std::mutex deferred_finalization_mutex_;
+
   // either threadpool could be nullptr
   concurrency::ThreadPool* const thread_pool_{};
   concurrency::ThreadPool* const inter_op_thread_pool_{};
@@ -548,6 +631,9 @@ class SessionState {
 
   std::optional<NodeIndexInfo> node_index_info_;
 
+  // Indexed by NodeIndex. Set by CreateKernels.
+  std::vector<KernelDispatchInfo> kernel_dispatch_infos_;
+
   // Container to store pre-packed weights to share between sessions.
   // The life-cycle of the cache itself is maintained by the user and the user will ensure
   // the cache is valid until any session reliant on it is still in scope.
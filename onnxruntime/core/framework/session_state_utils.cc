@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -27,6 +28,7 @@
 #include "core/framework/bfc_arena.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/mem_buffer.h"
+#include "core/platform/threadpool.h"
 #include "core/framework/tensor_allocator.h"
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
@@ -72,6 +74,8 @@ static common::Status AllocateBufferUsingDeviceAllocatorFromShapeAndType(const T
  * @param prepacked_for_graph Reference to an object managing prepacked weights for the graph.
  * @param use_device_allocator_for_initializers A flag indicating whether to use the device-specific allocator
  *                                              directly for initializers, potentially bypassing arenas.
+ * @param[out] is_memory_mapped Optional. Set to whether the data of the tensor is memory mapped from the external
+ *                              data file.
  * @return common::Status indicating success or failure of the deserialization process.
  *         Returns an error status if both `memory_buffer` and `alloc` are provided or if both are null (unless external data on CPU allows mmap),
  *         if string tensors are attempted to be copied to non-CPU devices, or if any underlying
@@ -84,7 +88,8 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
                                              OrtValue& ort_value, const DataTransferManager& data_transfer_mgr,
                                              const ExternalDataLoaderManager& external_data_loader_mgr,
                                              PrepackedWeightsForGraph& prepacked_for_graph,
-                                             bool use_device_allocator_for_initializers = false) {
+                                             bool use_device_allocator_for_initializers = false,
+                                             bool* is_memory_mapped = nullptr) {
   if (alloc != nullptr && memory_buffer != nullptr) {
     return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
                   "DeserializeTensorProto() takes either pre-allocated buffer or an allocator!");
@@ -116,7 +121,7 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
       // utilize the mmap'd buffer directly.
       ORT_RETURN_IF_ERROR(utils::GetExtDataFromTensorProto(env, proto_path, tensor_proto,
                                                            ort_value,
-                                                           &prepacked_for_graph));
+                                                           &prepacked_for_graph, is_memory_mapped));
       return common::Status::OK();
     } else {  // non-cpu tensor or tensor in a cpu accessible memory
       if (utils::HasString(tensor_proto)) {
@@ -226,6 +231,41 @@ common::Status CopyTensorFromCPUToDevice(
   }
 }
 
+// Reads length bytes of memory mapped data so the pages are loaded from the file. One byte is read per 4KB, the
+// smallest page size, which faults in every page of the range.
+static void PrefetchMappedData(const void* data, size_t length) {
+  constexpr size_t kStride = 4096;
+  const volatile char* bytes = static_cast<const volatile char*>(data);
+  char checksum = 0;
+  for (size_t offset = 0; offset < length; offset += kStride) {
+    checksum ^= bytes[offset];
+  }
+  if (length > 0) {
+    checksum ^= bytes[length - 1];
+  }
+  ORT_UNUSED_PARAMETER(checksum);
+}
+
+std::vector<Status> RunInitializationTasks(concurrency::ThreadPool* thread_pool, size_t num_tasks,
+                                           const std::function<Status(size_t)>& task) {
+  std::vector<Status> statuses(num_tasks);
+  concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, static_cast<std::ptrdiff_t>(num_tasks),
+                                                [&](std::ptrdiff_t i) {
+                                                  Status status;
+                                                  ORT_TRY {
+                                                    status = task(static_cast<size_t>(i));
+                                                  }
+                                                  ORT_CATCH(const std::exception& ex) {
+                                                    ORT_HANDLE_EXCEPTION([&]() {
+                                                      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION,
+                                                                               ex.what());
+                                                    });
+                                                  }
+                                                  statuses[static_cast<size_t>(i)] = std::move(status);
+                                                });
+  return statuses;
+}
+
 common::Status SaveInitializedTensors(
     const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
     const GraphViewer& graph, const AllocatorPtr& default_cpu_alloc,
@@ -239,7 +279,8 @@ common::Status SaveInitializedTensors(
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
     const MemoryProfileFunction& memory_profile_func,
-    PrepackedWeightsForGraph& prepacked_for_graph) {
+    PrepackedWeightsForGraph& prepacked_for_graph,
+    concurrency::ThreadPool* thread_pool) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -346,30 +387,88 @@ common::Status SaveInitializedTensors(
                        << i.second << " bytes for " << i.first.ToString() << std::endl;
   }
 
-  // 3. create weight tensors based on weights buffer
-  for (const auto& entry : id_to_initialized_tensor) {
-    // We check for cancellation for every initializer since mapping from disk can be costly
-    if (session_options.IsLoadCancellationFlagSet()) {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
-                             "Saving session state weights is canceled due to user request.");
-    }
+  auto save_tensor = [&](int ort_value_index, const std::string& name, const OrtValue& ort_value) -> Status {
+    // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
+    // so we need to output this message prior to calling save_tensor_func
+    VLOGS(logger, 1) << "Adding weight with name : " << name << " with index: " << ort_value_index;
 
-    int ort_value_index = entry.first;
-    const std::string& name = entry.second->name();
+    // any outer scope value is shadowed by a local value and can't override it.
+    // due to that check_outer_scope is false
+    const bool constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
+#if !defined(DISABLE_SPARSE_TENSORS)
+    const bool sparse = graph.GetGraph().IsSparseInitializer(name);
+    return save_tensor_func(name, ort_value_index, ort_value, constant, sparse);
+#else
+    return save_tensor_func(name, ort_value_index, ort_value, constant, false);
+#endif
+  };
 
-    if (name.empty()) {
-      LOGS(logger, INFO) << "Skipping entry for missing optional value at idx " << ort_value_index;
-      continue;
+  // With a thread pool, in-memory initializers that are deserialized into CPU tensors are allocated in the loop below
+  // but decoded concurrently in batches. A batch is saved in the order its entries were added once all of them are
+  // decoded. The batch size is bounded so the TensorProtos that save_tensor_func may release are not all kept alive.
+  struct PendingInitializer {
+    int ort_value_index;
+    const ONNX_NAMESPACE::TensorProto* tensor_proto;
+    Tensor tensor;
+  };
+  constexpr size_t kMaxPendingInitializerBytes = 256 * 1024 * 1024;
+  std::vector<PendingInitializer> pending_initializers;
+  size_t pending_initializer_bytes = 0;
+
+  // External initializers that are memory mapped on CPU are saved right away. If prefetching is enabled their data is
+  // read with the next batch, split in chunks so that a large initializer is read by several threads.
+  struct PendingPrefetch {
+    OrtValue ort_value;  // keeps the mapping alive
+    const void* data;
+    size_t length;
+  };
+  constexpr size_t kPrefetchChunkBytes = 4 * 1024 * 1024;
+  const bool prefetch_external_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigPrefetchExternalInitializers,
+                                                        "0") == "1";
+  std::vector<PendingPrefetch> pending_prefetches;
+
+  auto save_pending_initializers = [&]() -> Status {
+    const std::vector<Status> statuses = RunInitializationTasks(
+        thread_pool, pending_initializers.size() + pending_prefetches.size(), [&](size_t i) {
+          if (i >= pending_initializers.size()) {
+            const auto& prefetch = pending_prefetches[i - pending_initializers.size()];
+            PrefetchMappedData(prefetch.data, prefetch.length);
+            return Status::OK();
+          }
+          auto& pending = pending_initializers[i];
+          return utils::TensorProtoToTensor(env, graph_loc.c_str(), *pending.tensor_proto, pending.tensor);
+        });
+
+    for (size_t i = 0; i < pending_initializers.size(); ++i) {
+      auto& pending = pending_initializers[i];
+      const std::string& name = pending.tensor_proto->name();
+      if (!statuses[i].IsOK()) {
+        std::ostringstream oss;
+        oss << "Deserialize tensor " << name << " failed." << statuses[i].ErrorMessage();
+        return Status(statuses[i].Category(), statuses[i].Code(), oss.str());
+      }
+
+      OrtValue ort_value;
+      Tensor::InitOrtValue(std::move(pending.tensor), ort_value);
+      ORT_RETURN_IF_ERROR(save_tensor(pending.ort_value_index, name, ort_value));
     }
 
+    pending_initializers.clear();
+    pending_prefetches.clear();
+    pending_initializer_bytes = 0;
+    return Status::OK();
+  };
+
+  // Saves the initializer, or adds it to the pending initializers if it is decoded concurrently.
+  auto save_initializer = [&](int ort_value_index, const std::string& name,
+                              const ONNX_NAMESPACE::TensorProto& tensor_proto) -> Status {
     OrtValue ort_value;
 
-    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
+    if (user_supplied_initializer_ids.find(ort_value_index) != user_supplied_initializer_ids.end()) {
       ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
     } else {
-      const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
-
       std::optional<MemBuffer> memory_buffer;
       AllocatorPtr alloc;
       // TODO: if the tensor need be copied, does it have enough room?
@@ -405,36 +504,83 @@ common::Status SaveInitializedTensors(
         // if in memory we were expecting to find it above.
         ORT_ENFORCE(!utils::HasExternalDataInMemory(tensor_proto));
 
+        const auto& memory_info = (alloc != nullptr) ? alloc->Info() : memory_buffer->GetAllocInfo();
+        if (thread_pool != nullptr && memory_info.device == default_cpu_device &&
+            !utils::HasExternalData(tensor_proto)) {
+          // allocate now so the planned buffers are used as in DeserializeTensorProto, and decode it later
+          TensorShape tensor_shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
+          const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(
+                                               tensor_proto.data_type())
+                                               ->GetElementType();
+          Tensor tensor;
+          ORT_RETURN_IF_ERROR(AllocateTensor((memory_buffer) ? &*memory_buffer : nullptr, tensor, type,
+                                             tensor_shape, use_device_allocator_for_initializers,
+                                             alloc));
+          pending_initializer_bytes += tensor.SizeInBytes();
+          pending_initializers.push_back({ort_value_index, &tensor_proto, std::move(tensor)});
+          return Status::OK();
+        }
+
         // We need to deserialize the tensor proto into an OrtValue
         // using the preallocated buffer or allocator.
+        bool is_memory_mapped = false;
         Status st = DeserializeTensorProto(env, graph_loc, tensor_proto,
                                            (memory_buffer.has_value()) ? &*memory_buffer : nullptr,
                                            alloc, default_cpu_alloc, ort_value, data_transfer_mgr,
                                            external_data_loader_mgr, prepacked_for_graph,
-                                           use_device_allocator_for_initializers);
+                                           use_device_allocator_for_initializers, &is_memory_mapped);
         if (!st.IsOK()) {
           std::ostringstream oss;
           oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
           return Status(st.Category(), st.Code(), oss.str());
         }
+
+        // data that was read into memory is already resident
+        if (prefetch_external_initializers && is_memory_mapped) {
+          const Tensor& tensor = ort_value.Get<Tensor>();
+          const char* data = static_cast<const char*>(tensor.DataRaw());
+          const size_t length = tensor.SizeInBytes();
+          for (size_t offset = 0; offset < length; offset += kPrefetchChunkBytes) {
+            pending_prefetches.push_back({ort_value, data + offset, std::min(kPrefetchChunkBytes, length - offset)});
+          }
+          pending_initializer_bytes += length;
+        }
       }
     }
 
-    // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
-    // so we need to output this message prior to calling save_tensor_func
-    VLOGS(logger, 1) << "Adding weight with name : " << name << " with index: " << ort_value_index;
+    return save_tensor(ort_value_index, name, ort_value);
+  };
 
-    // any outer scope value is shadowed by a local value and can't override it.
-    // due to that check_outer_scope is false
-    const bool constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
-#if !defined(DISABLE_SPARSE_TENSORS)
-    const bool sparse = graph.GetGraph().IsSparseInitializer(name);
-    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, ort_value, constant, sparse));
-#else
-    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, ort_value, constant, false));
-#endif
+  // 3. create weight tensors based on weights buffer
+  for (const auto& entry : id_to_initialized_tensor) {
+    // We check for cancellation for every initializer since mapping from disk can be costly
+    if (session_options.IsLoadCancellationFlagSet()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
+                             "Saving session state weights is canceled due to user request.");
+    }
+
+    int ort_value_index = entry.first;
+    const std::string& name = entry.second->name();
+
+    if (name.empty()) {
+      LOGS(logger, INFO) << "Skipping entry for missing optional value at idx " << ort_value_index;
+      continue;
+    }
+
+    Status status = save_initializer(ort_value_index, name, *entry.second);
+    if (!status.IsOK()) {
+      // the pending initializers precede this one, so their failures are reported first as in the sequential order
+      ORT_RETURN_IF_ERROR(save_pending_initializers());
+      return status;
+    }
+
+    if (pending_initializer_bytes >= kMaxPendingInitializerBytes) {
+      ORT_RETURN_IF_ERROR(save_pending_initializers());
+    }
   }
 
+  ORT_RETURN_IF_ERROR(save_pending_initializers());
+
   LOGS(logger, INFO) << "Done saving initialized tensors";
   return common::Status::OK();
 }
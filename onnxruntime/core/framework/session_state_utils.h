@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "core/common/const_pointer_container.h"
 #include "core/framework/allocator.h"
@@ -34,11 +35,23 @@ namespace logging {
 class Logger;
 }
 
+namespace concurrency {
+class ThreadPool;
+}
+
 namespace session_state_utils {
 using SaveTensorFunction = std::function<Status(const std::string& name, int idx, const OrtValue& value,
                                                 bool constant, bool sparse)>;
 using MemoryProfileFunction = std::function<void(ITensorAllocator& planner)>;
 
+/**
+ * Runs task(i) for every i in [0, num_tasks) on the thread pool, or sequentially if thread_pool is null.
+ * An exception thrown by a task is converted into a RUNTIME_EXCEPTION status.
+ * @return The status of every task, indexed like the tasks so the caller can report failures in a deterministic order.
+ */
+std::vector<Status> RunInitializationTasks(concurrency::ThreadPool* thread_pool, size_t num_tasks,
+                                           const std::function<Status(size_t)>& task);
+
 common::Status SaveInitializedTensors(
     const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
     const GraphViewer& graph, const AllocatorPtr& default_cpu_memory_info,
@@ -51,7 +64,9 @@ common::Status SaveInitializedTensors(
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
     const MemoryProfileFunction& memory_profile_func,
-    PrepackedWeightsForGraph& prepacked_for_graph);
+    PrepackedWeightsForGraph& prepacked_for_graph,
+    // when given, the in-memory initializers that are placed on CPU are deserialized concurrently
+    concurrency::ThreadPool* thread_pool = nullptr);
 
 common::Status AllocateTensor(
     const onnxruntime::MemBuffer* memory_buffer,
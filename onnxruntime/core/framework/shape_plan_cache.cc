@@ -0,0 +1,328 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shape_plan_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+#include "core/common/hash_combine.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/session_state.h"
+#include "core/graph/constants.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsShapeOp(const Node& node) {
+  return node.Domain() == kOnnxDomain && (node.OpType() == "Shape" || node.OpType() == "Size");
+}
+
+// The outputs of these ops are not determined by their inputs.
+bool IsNonDeterministicOp(const Node& node) {
+  static const InlinedHashSet<std::string_view> non_deterministic_ops{
+      "Bernoulli", "Multinomial", "RandomNormal", "RandomNormalLike", "RandomUniform", "RandomUniformLike"};
+  return non_deterministic_ops.count(node.OpType()) > 0;
+}
+
+bool HasShapeValueType(const NodeArg& node_arg) {
+  const auto* type = node_arg.TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type()) {
+    return false;
+  }
+
+  const auto elem_type = type->tensor_type().elem_type();
+  return elem_type == ONNX_NAMESPACE::TensorProto_DataType_INT64 ||
+         elem_type == ONNX_NAMESPACE::TensorProto_DataType_INT32 ||
+         elem_type == ONNX_NAMESPACE::TensorProto_DataType_BOOL;
+}
+
+size_t HashSignature(gsl::span<const int64_t> signature) {
+  size_t hash = 0;
+  for (int64_t value : signature) {
+    HashCombine(value, hash);
+  }
+  return hash;
+}
+
+}  // namespace
+
+ShapePlanCache::ShapePlanCache(const SessionState& session_state, size_t capacity)
+    : logger_(session_state.Logger()),
+      cpu_allocator_(session_state.GetAllocator(OrtDevice())),
+      capacity_(capacity) {
+  const GraphViewer& graph_viewer = session_state.GetGraphViewer();
+  const OrtValueNameIdxMap& name_idx_map = session_state.GetOrtValueNameIdxMap();
+  const auto& alloc_plan = session_state.GetPerValueAllocPlan();
+  const auto& initializers = session_state.GetInitializedTensors();
+  const auto& constant_initializers = session_state.GetConstantInitializedTensors();
+
+  InlinedHashSet<int> graph_inputs;
+  for (const auto* input : graph_viewer.GetInputsIncludingInitializers()) {
+    int idx;
+    if (name_idx_map.GetIdx(input->Name(), idx).IsOK()) {
+      graph_inputs.insert(idx);
+    }
+  }
+
+  InlinedHashSet<std::string_view> graph_outputs;
+  for (const auto* output : graph_viewer.GetOutputs()) {
+    graph_outputs.insert(output->Name());
+  }
+
+  is_shape_node_.resize(static_cast<size_t>(graph_viewer.MaxNodeIndex()), false);
+  InlinedHashSet<int> shape_values;
+
+  for (NodeIndex node_index : graph_viewer.GetNodesInTopologicalOrder()) {
+    const Node* node = graph_viewer.GetNode(node_index);
+    if (node == nullptr || node->GetExecutionProviderType() != kCpuExecutionProvider ||
+        !node->ImplicitInputDefs().empty() || IsNonDeterministicOp(*node)) {
+      continue;
+    }
+
+    const bool is_shape_op = IsShapeOp(*node);
+    bool uses_shape_value = false;
+    bool is_shape_node = true;
+    for (const auto* input : node->InputDefs()) {
+      int idx;
+      if (!input->Exists()) {
+        continue;
+      }
+
+      if (!name_idx_map.GetIdx(input->Name(), idx).IsOK()) {
+        is_shape_node = false;
+      } else if (shape_values.count(idx) > 0 ||
+                 (is_shape_op && (graph_inputs.count(idx) > 0 || initializers.count(idx) > 0))) {
+        uses_shape_value = true;
+      } else if (constant_initializers.count(idx) == 0) {
+        is_shape_node = false;
+      }
+
+      if (!is_shape_node) {
+        break;
+      }
+    }
+
+    // nodes that only use constant initializers are left to constant folding
+    if (!is_shape_node || !uses_shape_value) {
+      continue;
+    }
+
+    // The outputs are written to buffers of their own when they are replayed, so they must not share the buffer of
+    // another value.
+    InlinedVector<int> output_idxs;
+    for (const auto* output : node->OutputDefs()) {
+      int idx = -1;
+      if (output->Exists()) {
+        if (!HasShapeValueType(*output) || !name_idx_map.GetIdx(output->Name(), idx).IsOK() ||
+            alloc_plan[idx].alloc_kind == AllocKind::kShare) {
+          is_shape_node = false;
+          break;
+        }
+      }
+
+      output_idxs.push_back(idx);
+    }
+
+    if (!is_shape_node) {
+      continue;
+    }
+
+    is_shape_node_[node_index] = true;
+    ++num_shape_nodes_;
+    for (int idx : output_idxs) {
+      if (idx >= 0) {
+        shape_values.insert(idx);
+      }
+    }
+  }
+
+  // Outputs that only shape computation nodes consume are not needed when the nodes are replayed.
+  for (NodeIndex node_index = 0; node_index < is_shape_node_.size(); ++node_index) {
+    if (!is_shape_node_[node_index]) {
+      continue;
+    }
+
+    const Node& node = *graph_viewer.GetNode(node_index);
+    InlinedVector<int> outputs;
+    const auto output_defs = node.OutputDefs();
+    for (int i = 0, end = static_cast<int>(output_defs.size()); i < end; ++i) {
+      if (output_defs[i]->Exists() && graph_outputs.count(output_defs[i]->Name()) > 0) {
+        outputs.push_back(i);
+      }
+    }
+
+    for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+      const int src_idx = it->GetSrcArgIndex();
+      if (!IsShapeComputationNode(it->GetNode().Index()) &&
+          std::find(outputs.begin(), outputs.end(), src_idx) == outputs.end()) {
+        outputs.push_back(src_idx);
+      }
+    }
+
+    if (!outputs.empty()) {
+      recorded_outputs_.emplace(node_index, std::move(outputs));
+    }
+  }
+}
+
+ShapePlanCache::~ShapePlanCache() {
+  const Stats stats = GetStats();
+  LOGS(logger_, VERBOSE) << "Shape plan cache for " << num_shape_nodes_ << " node(s): " << stats.hits
+                         << " hit(s), " << stats.misses << " miss(es), " << stats.evictions << " eviction(s), "
+                         << stats.entries << " entries";
+}
+
+std::unique_ptr<ShapePlanCache::Run> ShapePlanCache::BeginRun(gsl::span<const int> feed_mlvalue_idxs,
+                                                              gsl::span<const OrtValue> feeds) const {
+  InlinedVector<int64_t> signature;
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (!feeds[i].IsTensor()) {
+      return nullptr;
+    }
+
+    const auto dims = feeds[i].Get<Tensor>().Shape().GetDims();
+    signature.push_back(feed_mlvalue_idxs[i]);
+    signature.push_back(static_cast<int64_t>(dims.size()));
+    signature.insert(signature.end(), dims.begin(), dims.end());
+  }
+
+  std::shared_ptr<const Plan> plan;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entry = plans_.find(HashSignature(signature));
+    if (entry != plans_.end() && (*entry->second)->signature == signature) {
+      lru_.splice(lru_.begin(), lru_, entry->second);
+      plan = *entry->second;
+      ++stats_.hits;
+    } else {
+      ++stats_.misses;
+    }
+  }
+
+  return std::make_unique<Run>(*this, std::move(signature), std::move(plan));
+}
+
+ShapePlanCache::Stats ShapePlanCache::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stats stats = stats_;
+  stats.entries = lru_.size();
+  return stats;
+}
+
+void ShapePlanCache::Insert(std::shared_ptr<const Plan> plan) const {
+  const size_t hash = HashSignature(plan->signature);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto entry = plans_.find(hash);
+  if (entry != plans_.end()) {
+    // another Run recorded the same signature, or a signature with the same hash is replaced
+    *entry->second = std::move(plan);
+    lru_.splice(lru_.begin(), lru_, entry->second);
+    return;
+  }
+
+  if (lru_.size() == capacity_) {
+    plans_.erase(HashSignature(lru_.back()->signature));
+    lru_.pop_back();
+    ++stats_.evictions;
+  }
+
+  lru_.push_front(std::move(plan));
+  plans_.emplace(hash, lru_.begin());
+}
+
+ShapePlanCache::Run::Run(const ShapePlanCache& cache, InlinedVector<int64_t>&& signature,
+                         std::shared_ptr<const Plan> plan)
+    : cache_(cache), plan_(std::move(plan)) {
+  if (!plan_) {
+    recorded_plan_ = std::make_unique<Plan>();
+    recorded_plan_->signature = std::move(signature);
+  }
+}
+
+Status ShapePlanCache::Run::TryReplay(NodeIndex node_index, OpKernelContextInternal& kernel_ctx,
+                                      bool& replayed) const {
+  replayed = false;
+  if (!plan_ || !plan_->replayable || !cache_.IsShapeComputationNode(node_index)) {
+    return Status::OK();
+  }
+
+  auto outputs = cache_.recorded_outputs_.find(node_index);
+  if (outputs != cache_.recorded_outputs_.end()) {
+    for (int output_idx : outputs->second) {
+      auto value = plan_->values.find(kernel_ctx.GetOrtValueIndexForOutput(output_idx));
+      if (value == plan_->values.end()) {
+        // optional output that was not produced
+        continue;
+      }
+
+      const Tensor& recorded = value->second.Get<Tensor>();
+      Tensor* output = kernel_ctx.Output(output_idx, recorded.Shape());
+      ORT_RETURN_IF(output == nullptr, "Failed to allocate output ", output_idx, " of node ", node_index,
+                    " for the cached shape plan.");
+      if (recorded.SizeInBytes() > 0) {
+        memcpy(output->MutableDataRaw(), recorded.DataRaw(), recorded.SizeInBytes());
+      }
+    }
+  }
+
+  replayed = true;
+  return Status::OK();
+}
+
+void ShapePlanCache::Run::Record(NodeIndex node_index, OpKernelContextInternal& kernel_ctx) {
+  if (!recorded_plan_ || !cache_.IsShapeComputationNode(node_index)) {
+    return;
+  }
+
+  InlinedVector<std::pair<int, OrtValue>> values;
+  bool replayable = true;
+  auto outputs = cache_.recorded_outputs_.find(node_index);
+  if (outputs != cache_.recorded_outputs_.end()) {
+    for (int output_idx : outputs->second) {
+      const OrtValue* output = kernel_ctx.GetOutputMLValue(output_idx);
+      if (output == nullptr || !output->IsAllocated()) {
+        continue;
+      }
+
+      if (!output->IsTensor() || output->Get<Tensor>().SizeInBytes() > kMaxRecordedValueBytes) {
+        replayable = false;
+        break;
+      }
+
+      const Tensor& tensor = output->Get<Tensor>();
+      OrtValue copy;
+      Tensor::InitOrtValue(tensor.DataType(), tensor.Shape(), cache_.cpu_allocator_, copy);
+      if (tensor.SizeInBytes() > 0) {
+        memcpy(copy.GetMutable<Tensor>()->MutableDataRaw(), tensor.DataRaw(), tensor.SizeInBytes());
+      }
+
+      values.emplace_back(kernel_ctx.GetOrtValueIndexForOutput(output_idx), std::move(copy));
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++num_recorded_nodes_;
+  if (!replayable) {
+    recorded_plan_->replayable = false;
+    recorded_plan_->values.clear();
+  } else if (recorded_plan_->replayable) {
+    for (auto& value : values) {
+      recorded_plan_->values.insert_or_assign(value.first, std::move(value.second));
+    }
+  }
+}
+
+void ShapePlanCache::Run::Commit() {
+  // A plan can only be replayed if all shape computation nodes were recorded. Runs that only execute part of the
+  // graph do not add a plan.
+  if (recorded_plan_ && num_recorded_nodes_ == cache_.num_shape_nodes_) {
+    cache_.Insert(std::move(recorded_plan_));
+  }
+}
+
+}  // namespace onnxruntime
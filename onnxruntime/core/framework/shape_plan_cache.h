@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/graph/basic_types.h"
+
+namespace onnxruntime {
+
+class OpKernelContextInternal;
+class SessionState;
+
+/**
+Cache of the values computed by the shape computation nodes of a graph, keyed by the shapes of the feeds.
+
+A shape computation node is a CPU node with integer or bool outputs whose inputs are constant initializers or
+outputs of other shape computation nodes. A Shape or Size node may read any graph input or initializer as it only
+uses its shape. The outputs of these nodes therefore only depend on the shapes of the feeds.
+
+The first Run with a given feed shape signature executes the nodes and records their outputs that are consumed by
+other nodes or are graph outputs. Later Runs with the same signature write the recorded values to the execution
+frame instead of executing the nodes. The cache holds a bounded number of signatures and evicts the least recently
+used one.
+*/
+class ShapePlanCache {
+ public:
+  struct Stats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+    size_t entries = 0;
+  };
+
+  // Recorded outputs of the shape computation nodes for one feed shape signature.
+  struct Plan {
+    InlinedVector<int64_t> signature;
+    // Copies of the recorded outputs, by OrtValue index.
+    InlinedHashMap<int, OrtValue> values;
+    // False if an output was too large or not a tensor. The nodes are executed as usual for this signature.
+    bool replayable = true;
+  };
+
+  // Use of the cache by one Run. Either replays a cached plan or records a new one.
+  class Run {
+   public:
+    Run(const ShapePlanCache& cache, InlinedVector<int64_t>&& signature, std::shared_ptr<const Plan> plan);
+
+    // Write the recorded outputs of the node to the execution frame if the node is a shape computation node and
+    // there is a replayable plan for the feed shapes. If so the node does not need to be executed.
+    Status TryReplay(NodeIndex node_index, OpKernelContextInternal& kernel_ctx, bool& replayed) const;
+
+    // Record the outputs of the node if it is a shape computation node and a plan is being recorded.
+    void Record(NodeIndex node_index, OpKernelContextInternal& kernel_ctx);
+
+    // Add the recorded plan to the cache. Called once the Run succeeded.
+    void Commit();
+
+   private:
+    const ShapePlanCache& cache_;
+    std::shared_ptr<const Plan> plan_;
+    std::unique_ptr<Plan> recorded_plan_;
+    size_t num_recorded_nodes_ = 0;
+    // nodes of different streams may be recorded concurrently
+    std::mutex mutex_;
+
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Run);
+  };
+
+  // Analyzes the finalized graph of session_state. capacity is the maximum number of cached signatures.
+  ShapePlanCache(const SessionState& session_state, size_t capacity);
+  ~ShapePlanCache();
+
+  bool HasShapeComputationNodes() const noexcept { return num_shape_nodes_ > 0; }
+
+  // Start a Run with the given feeds. Returns nullptr if the cache does not apply to them.
+  std::unique_ptr<Run> BeginRun(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds) const;
+
+  Stats GetStats() const;
+
+ private:
+  bool IsShapeComputationNode(NodeIndex node_index) const noexcept {
+    return node_index < is_shape_node_.size() && is_shape_node_[node_index];
+  }
+
+  void Insert(std::shared_ptr<const Plan> plan) const;
+
+  // Outputs larger than this are not recorded.
+  static constexpr size_t kMaxRecordedValueBytes = 64 * 1024;
+
+  const logging::Logger& logger_;
+  AllocatorPtr cpu_allocator_;
+  const size_t capacity_;
+
+  std::vector<bool> is_shape_node_;
+  size_t num_shape_nodes_ = 0;
+  // Indices of the outputs of each shape computation node that are needed by other nodes or are graph outputs.
+  InlinedHashMap<NodeIndex, InlinedVector<int>> recorded_outputs_;
+
+  mutable std::mutex mutex_;
+  // most recently used plan first
+  mutable std::list<std::shared_ptr<const Plan>> lru_;
+  mutable InlinedHashMap<size_t, std::list<std::shared_ptr<const Plan>>::iterator> plans_;
+  mutable Stats stats_;
+};
+
+}  // namespace onnxruntime
@@ -10,12 +10,14 @@
 #include "core/graph/basic_types.h"
 #include "core/common/inlined_containers.h"
 #include "core/framework/memory_info.h"
+#include "core/framework/shape_plan_cache.h"
 #ifdef ENABLE_TRAINING
 #include "core/framework/partial_graph_execution_state.h"
 #endif
 
 namespace onnxruntime {
 class SessionState;
+struct ConfigOptions;
 
 class SessionScope;
 typedef InlinedHashMap<std::string, OrtValue> OrtValueCache;
@@ -84,6 +86,16 @@ class StreamExecutionContext {
     logger_ = &current_logger;
   }
 
+  // Config options of the RunOptions of the current Run. nullptr when the graph is not run by InferenceSession::Run,
+  // e.g. for subgraphs.
+  const ConfigOptions* GetRunConfigOptions() const { return run_config_options_; }
+
+  void SetRunConfigOptions(const ConfigOptions* run_config_options) { run_config_options_ = run_config_options; }
+
+  // Use of the shape plan cache of the session state by the current Run. nullptr if it is not used.
+  ShapePlanCache::Run* GetShapePlanRun() const { return shape_plan_run_; }
+  void SetShapePlanRun(ShapePlanCache::Run* shape_plan_run) { shape_plan_run_ = shape_plan_run; }
+
   // Get status of the execution.
   // if one of the stream got non-OK status, the whole task status will be set as that non-OK status.
   const Status& TaskStatus() const;
@@ -160,6 +172,9 @@ class StreamExecutionContext {
 
   Status task_status_{Status::OK()};
 
+  const ConfigOptions* run_config_options_{nullptr};
+  ShapePlanCache::Run* shape_plan_run_{nullptr};
+
 #ifdef ENABLE_TRAINING
   const ProgramRegion* program_range_{nullptr};
 
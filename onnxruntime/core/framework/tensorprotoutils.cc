@@ -1097,7 +1097,8 @@ ORT_API(void, OrtUninitializeBuffer, _In_opt_ void* input, size_t input_len, enu
 
 #if !defined(__wasm__)
 static Status GetFileContent(const Env& env, const std::filesystem::path& file_path, FileOffsetType offset,
-                             size_t length, IAllocatorUniquePtr<void>& external_data) {
+                             size_t length, IAllocatorUniquePtr<void>& external_data,
+                             bool* is_memory_mapped = nullptr) {
   // query length if it is 0
   if (length == 0) {
     // The return type of std::filesystem::file_size is uintmax_t which could be bigger than size_t
@@ -1112,6 +1113,9 @@ static Status GetFileContent(const Env& env, const std::filesystem::path& file_p
       IAllocatorUniquePtr<void> raw_buffer(mapped_memory.release(),
                                            mapped_memory.get_deleter());
       external_data.swap(raw_buffer);
+      if (is_memory_mapped != nullptr) {
+        *is_memory_mapped = true;
+      }
       return Status::OK();
     }
   }
@@ -1130,9 +1134,13 @@ static Status GetFileContent(const Env& env, const std::filesystem::path& file_p
 Status GetExtDataFromTensorProto(const Env& env,
                                  const std::filesystem::path& model_path,
                                  const ONNX_NAMESPACE::TensorProto& tensor_proto,
-                                 OrtValue& ort_value, PrepackedWeightsForGraph* prepacked_info) {
+                                 OrtValue& ort_value, PrepackedWeightsForGraph* prepacked_info,
+                                 bool* is_memory_mapped) {
   ORT_ENFORCE(HasExternalData(tensor_proto), "TensorProto for: ",
               tensor_proto.name(), "Expected to have external data");
+  if (is_memory_mapped != nullptr) {
+    *is_memory_mapped = false;
+  }
 
   std::basic_string<ORTCHAR_T> tensor_proto_dir;
   if (!model_path.empty()) {
@@ -1204,7 +1212,7 @@ Status GetExtDataFromTensorProto(const Env& env,
 
     IAllocatorUniquePtr<void> ext_data_buf;
     ORT_RETURN_IF_ERROR(GetFileContent(env, external_data_file_path, file_offset, raw_data_safe_len,
-                                       ext_data_buf));
+                                       ext_data_buf, is_memory_mapped));
 
     // Data on disk is little endian
     if constexpr (endian::native != endian::little) {
@@ -3792,6 +3792,107 @@ GatherBlockQuantized is a Gather with data quantized. It is similar to Gather (h
         }
       });
 
+  static const char* EmbeddingBag_ver1_doc = R"DOC(
+EmbeddingBag computes sums or means of bags of embeddings without materializing the gathered embeddings.
+It is equivalent to a Gather on axis 0 of the 2D `data` table followed by a ReduceSum/ReduceMean over each bag:
+  1. Bags are either the rows of a 2D `indices` tensor of shape [num_bags, bag_size], or, when `offsets` is provided,
+     the ranges [offsets[b], offsets[b + 1]) of a 1D `indices` tensor. `offsets` must start at 0 and be non-decreasing.
+     The last bag ends at the end of `indices`. Empty bags produce zeros.
+  2. With `mode` "sum", each row can be scaled by the matching element of `per_sample_weights` before it is added.
+     `per_sample_weights` is not supported with `mode` "mean".
+  3. `data` is either float/float16 with the same type as the output, or uint8 quantized block-wise along its last
+     dimension like the uint8 `data` of GatherBlockQuantized. For 4 bits two values are packed in each byte, so the
+     embedding dimension is twice the last dimension of `data`. `scales` has shape
+     [num_rows, ceil(embedding_dim / block_size)] and is required for uint8 data. If `zero_points` is not provided,
+     the default value is 2^(bits-1).
+)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(EmbeddingBag)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(EmbeddingBag_ver1_doc)
+      .Attr("mode",
+            "(Optional) How the embeddings of a bag are reduced. Must be either 'sum' or 'mean'.",
+            AttributeProto::STRING, std::string("sum"))
+      .Attr("block_size",
+            "(Optional) block size used for the quantization of uint8 data. It needs to be a power of 2 and not "
+            "smaller than 16.",
+            AttributeProto::INT,
+            static_cast<int64_t>(128))
+      .Attr("bits",
+            "(Optional) Number of bits used for the quantization of uint8 data. Must be either 4 or 8.",
+            AttributeProto::INT,
+            static_cast<int64_t>(8))
+      .Input(0, "data", "2D embedding table of shape [num_rows, embedding_dim], or block-wise quantized.", "T1")
+      .Input(1,
+             "indices",
+             "2D tensor of shape [num_bags, bag_size], or 1D when offsets is provided. All index values are expected "
+             "to be within bounds [-num_rows, num_rows-1]. It is an error if any of the index values are out of bounds.",
+             "Tind")
+      .Input(2, "offsets", "1D tensor with the start of each bag in indices.", "Tind", OpSchema::Optional)
+      .Input(3, "per_sample_weights", "Weights of the indices. Same shape as indices.", "T", OpSchema::Optional)
+      .Input(4, "scales", "quantization scale. Required for uint8 data.", "T", OpSchema::Optional)
+      .Input(5, "zero_points", "quantization zero points", "T1", OpSchema::Optional)
+      .Output(0, "output", "Tensor of shape [num_bags, embedding_dim].", "T")
+      .TypeConstraint("T1", {"tensor(float)", "tensor(float16)", "tensor(uint8)"},
+                      "Constrain the table to float types or uint8 for quantized tables.")
+      .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain output types to float tensors.")
+      .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"}, "Constrain indices to integer types.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        // Type inference
+        const bool quantized =
+            ctx.getInputType(0)->tensor_type().elem_type() == onnx::TensorProto_DataType_UINT8;
+        if (quantized) {
+          if (!ctx.hasInput(4)) {
+            fail_type_inference("scales is required for uint8 data");
+          }
+          propagateElemTypeFromInputToOutput(ctx, 4, 0);
+        } else {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        }
+
+        if (!hasNInputShapes(ctx, 2)) {
+          return;
+        }
+        const TensorShapeProto& data_shape = ctx.getInputType(0)->tensor_type().shape();
+        const TensorShapeProto& indices_shape = ctx.getInputType(1)->tensor_type().shape();
+        if (data_shape.dim_size() != 2) {
+          fail_shape_inference("data must be a 2D tensor");
+        }
+
+        auto* output_shape = ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
+        output_shape->clear_dim();
+        if (ctx.hasInput(2)) {
+          if (indices_shape.dim_size() != 1) {
+            fail_shape_inference("indices must be 1D when offsets is provided");
+          }
+          if (!hasInputShape(ctx, 2)) {
+            output_shape->add_dim();
+          } else {
+            const auto& offsets_shape = getInputShape(ctx, 2);
+            if (offsets_shape.dim_size() != 1) {
+              fail_shape_inference("offsets must be 1D");
+            }
+            *output_shape->add_dim() = offsets_shape.dim(0);
+          }
+        } else {
+          if (indices_shape.dim_size() != 2) {
+            fail_shape_inference("indices must be 2D when offsets is not provided");
+          }
+          *output_shape->add_dim() = indices_shape.dim(0);
+        }
+
+        auto* embedding_dim = output_shape->add_dim();
+        *embedding_dim = data_shape.dim(1);
+        if (quantized && embedding_dim->has_dim_value()) {
+          const int64_t bits = getAttribute(ctx, "bits", 8);
+          if (bits != 4 && bits != 8) {
+            fail_shape_inference("bits must be 4 or 8");
+          }
+          embedding_dim->set_dim_value(embedding_dim->dim_value() * (8 / bits));
+        }
+      });
+
 #ifdef ENABLE_ATEN
   ONNX_CONTRIB_OPERATOR_SCHEMA(ATen)
       .SetDomain(kPytorchAtenDomain)
@@ -13,6 +13,7 @@
 #include <gsl/gsl>
 
 #include "core/common/common.h"
+#include "core/common/hash_combine.h"
 #include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
 #include "core/common/narrow.h"
@@ -990,6 +991,7 @@ void Node::CreateSubgraph(const std::string& attr_name) {
 
 void Node::AddAttributeProto(AttributeProto value) {
   utils::SetNodeAttribute(std::move(value), attributes_);
+  ++attributes_version_;
   if (graph_) {
     graph_->SetGraphResolveNeeded();
     graph_->SetGraphProtoSyncNeeded();
@@ -1040,9 +1042,16 @@ void Node::AddAttribute(std::string attr_name, GraphProto value) {
 bool Node::ClearAttribute(const std::string& attr_name) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  ++attributes_version_;
   return attributes_.erase(attr_name) > 0;
 }
 
+void Node::MarkAttributesChanged() {
+  graph_->SetGraphResolveNeeded();
+  graph_->SetGraphProtoSyncNeeded();
+  ++attributes_version_;
+}
+
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
 int Node::PruneRemovableAttributes(gsl::span<const std::string> removable_attributes) {
@@ -1052,6 +1061,7 @@ int Node::PruneRemovableAttributes(gsl::span<const std::string> removable_attrib
   for (const auto& name : removable_attributes) {
     n_removed += static_cast<int>(attributes_.erase(name));
   }
+  ++attributes_version_;
   can_be_saved_ = can_be_saved_ && n_removed == 0;
   return n_removed;
 }
@@ -3142,11 +3152,112 @@ common::Status Graph::TypeCheckInputsAndInitializers() {
   return Status::OK();
 }
 
+size_t Graph::ComputeInferredTypesFingerprint(const Node& node) const {
+  // the types of a subgraph depend on outer scope values that are not part of the fingerprint
+  if (IsSubgraph() || node.ContainsSubgraph()) {
+    return 0;
+  }
+
+  size_t fingerprint = 0;
+  HashCombine(reinterpret_cast<uintptr_t>(node.Op()), fingerprint);
+  HashCombine(node.SinceVersion(), fingerprint);
+  HashCombine(node.attributes_version_, fingerprint);
+  for (int count : node.InputArgCount()) {
+    HashCombine(count, fingerprint);
+  }
+
+  // returns false if the type of `node_arg` can not be fingerprinted, e.g. a sequence whose element shape matters
+  auto add_node_arg = [&fingerprint](const NodeArg& node_arg) {
+    HashCombine(reinterpret_cast<uintptr_t>(&node_arg), fingerprint);
+    HashCombine(node_arg.initializer_version_, fingerprint);
+
+    const TypeProto* type = node_arg.TypeAsProto();
+    if (!node_arg.Exists() || type == nullptr) {
+      return true;
+    }
+
+    bool is_tensor = node_arg.HasTensorOrScalarShape();
+#if !defined(DISABLE_OPTIONAL_TYPE)
+    is_tensor = is_tensor || utils::HasOptionalTensorType(*type);
+#endif
+    if (!is_tensor) {
+      return false;
+    }
+
+    HashCombine(reinterpret_cast<uintptr_t>(node_arg.Type()), fingerprint);
+    const TensorShapeProto* shape = node_arg.Shape();
+    HashCombine(shape != nullptr ? shape->dim_size() : -1, fingerprint);
+    if (shape != nullptr) {
+      for (const auto& dim : shape->dim()) {
+        HashCombine(static_cast<int>(dim.value_case()), fingerprint);
+        if (utils::HasDimValue(dim)) {
+          HashCombine(dim.dim_value(), fingerprint);
+        } else if (utils::HasDimParam(dim)) {
+          HashCombine(dim.dim_param(), fingerprint);
+        }
+      }
+    }
+
+    return true;
+  };
+
+  for (const auto* input_def : node.InputDefs()) {
+    if (!add_node_arg(*input_def)) {
+      return 0;
+    }
+  }
+
+  for (const auto* output_def : node.OutputDefs()) {
+    if (!add_node_arg(*output_def)) {
+      return 0;
+    }
+  }
+
+  // 0 is reserved for 'not inferred'
+  return fingerprint != 0 ? fingerprint : 1;
+}
+
+namespace {
+// Memoizes the schema lookups of a schema registry. Looking up a schema in the schema registries searches the
+// custom registries and the ONNX registry by op type, domain and version, and is done for every node both by the
+// ONNX checker and to set the schema of the node. A graph usually has few distinct op types, so the lookups are
+// only done once per op type while verifying the nodes of a graph.
+class CachingSchemaRegistry final : public ONNX_NAMESPACE::ISchemaRegistry {
+ public:
+  explicit CachingSchemaRegistry(const ONNX_NAMESPACE::ISchemaRegistry& schema_registry)
+      : schema_registry_{schema_registry} {}
+
+  const ONNX_NAMESPACE::OpSchema* GetSchema(const std::string& key, const int maxInclusiveVersion,
+                                            const std::string& domain) const override {
+    // a graph imports a single opset version per domain so there is usually one entry per op type
+    auto& versions = schemas_[domain][key];
+    for (const auto& [version, schema] : versions) {
+      if (version == maxInclusiveVersion) {
+        return schema;
+      }
+    }
+
+    const ONNX_NAMESPACE::OpSchema* schema = schema_registry_.GetSchema(key, maxInclusiveVersion, domain);
+    versions.emplace_back(maxInclusiveVersion, schema);
+    return schema;
+  }
+
+ private:
+  using SchemaVersions = InlinedVector<std::pair<int, const ONNX_NAMESPACE::OpSchema*>, 1>;
+
+  const ONNX_NAMESPACE::ISchemaRegistry& schema_registry_;
+  // domain -> op type -> (max inclusive version, schema)
+  mutable std::unordered_map<std::string, std::unordered_map<std::string, SchemaVersions>> schemas_;
+};
+}  // namespace
+
 Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
+  const CachingSchemaRegistry schema_registry{*schema_registry_};
+
   CheckerContext ctx;
   ctx.set_ir_version(gsl::narrow_cast<int>(IrVersion()));
   ctx.set_opset_imports(DomainToVersionMap());
-  ctx.set_schema_registry(schema_registry_.get());
+  ctx.set_schema_registry(&schema_registry);
   // Set the parent directory of model path to load external tensors if exist
   // ONNX expects a UTF-8 string here.
   ctx.set_model_dir(ToUTF8String(ModelPath().parent_path().native()));
@@ -3205,7 +3316,7 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
         ORT_RETURN_IF_ERROR(status);
       }
 
-      SetOpSchemaFromRegistryForNode(node);
+      SetOpSchemaFromRegistryForNode(node, schema_registry);
 
       if (!node.op_) {
         // check whether it refer to a function.
@@ -3263,7 +3374,16 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
       }
     }
 
-    NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
+    // Skip type and shape inferencing if nothing it depends on has changed since it last succeeded, so that
+    // re-resolving after a graph transformation only infers the modified nodes and the nodes downstream of them
+    // whose input types or shapes changed as a result.
+    // options.override_types is intended to update existing types so always infer in that case.
+    if (options.override_types || node.inferred_types_fingerprint_ == 0 ||
+        node.inferred_types_fingerprint_ != ComputeInferredTypesFingerprint(node)) {
+      node.inferred_types_fingerprint_ = 0;
+      NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
+      node.inferred_types_fingerprint_ = options.override_types ? 0 : ComputeInferredTypesFingerprint(node);
+    }
 
     // Accumulate output names of the iterated Node
     for (const auto& output : node.OutputDefs()) {
@@ -3493,6 +3613,7 @@ void Graph::AddInitializedTensor(const TensorProto& tensor) {
   const gsl::not_null<TensorProto*> tensor_added{graph_proto_->add_initializer()};
   *(tensor_added) = tensor;
   name_to_initial_tensor_.emplace(tensor.name(), tensor_added);
+  MarkInitializerChanged(tensor.name());
 
   if (!is_loaded_from_model_file_ && GetNodeArg(tensor.name()) == nullptr) {
     // make sure there is a NodeArg for the initializer as SetGraphInputsOutputs may add it to the graph inputs.
@@ -3513,6 +3634,7 @@ Status Graph::AddInitializedOrtValue(const ONNX_NAMESPACE::TensorProto& tensor_p
   const gsl::not_null<TensorProto*> tensor_added{graph_proto_->add_initializer()};
   *(tensor_added) = tensor_proto;
   name_to_initial_tensor_.emplace(tensor_proto.name(), tensor_added);
+  MarkInitializerChanged(tensor_proto.name());
 
   if (ortvalue_initializer.IsAllocated()) {
     const bool has_data_in_memory = utils::HasExternalDataInMemory(tensor_proto);
@@ -3609,6 +3731,12 @@ bool Graph::IsInitializedTensor(const std::string& name) const {
   return name_to_initial_tensor_.count(name) > 0;
 }
 
+void Graph::MarkInitializerChanged(const std::string& name) {
+  if (NodeArg* node_arg = GetNodeArg(name); node_arg != nullptr) {
+    ++node_arg->initializer_version_;
+  }
+}
+
 #if !defined(DISABLE_SPARSE_TENSORS)
 bool Graph::IsSparseInitializer(const std::string& name) const {
   return sparse_tensor_names_.count(name) > 0;
@@ -3624,6 +3752,7 @@ void Graph::RemoveInitializedTensor(const std::string& tensor_name) {
 #if !defined(DISABLE_SPARSE_TENSORS)
     sparse_tensor_names_.erase(tensor_name);
 #endif
+    MarkInitializerChanged(tensor_name);
 
     // doesn't matter if it existed or not
     ORT_IGNORE_RETURN_VALUE(ortvalue_initializers_.erase(tensor_name));
@@ -3712,6 +3841,8 @@ Status Graph::ReplaceInitializedTensorImpl(ONNX_NAMESPACE::TensorProto new_initi
     sparse_tensor_names_.insert((**existing_entry).name());
   }
 
+  MarkInitializerChanged((**existing_entry).name());
+
   return Status::OK();
 }
 
@@ -5126,6 +5257,10 @@ IOnnxRuntimeOpSchemaCollectionPtr Graph::GetSchemaRegistry() const {
 }
 
 bool Graph::SetOpSchemaFromRegistryForNode(Node& node) {
+  return SetOpSchemaFromRegistryForNode(node, *schema_registry_);
+}
+
+bool Graph::SetOpSchemaFromRegistryForNode(Node& node, const ONNX_NAMESPACE::ISchemaRegistry& schema_registry) {
   if (node.op_ != nullptr) return true;
 
   node.op_ = [&]() -> const ONNX_NAMESPACE::OpSchema* {
@@ -5134,7 +5269,7 @@ bool Graph::SetOpSchemaFromRegistryForNode(Node& node) {
       return nullptr;
     }
     const auto max_inclusive_version = domain_to_version_it->second;
-    return schema_registry_->GetSchema(node.OpType(), max_inclusive_version, node.Domain());
+    return schema_registry.GetSchema(node.OpType(), max_inclusive_version, node.Domain());
   }();
 
   if (node.op_) {
@@ -5510,6 +5645,7 @@ Status Graph::InlineIfSubgraph(bool condition_value, Node& if_node, const loggin
     auto insert_result = name_to_initial_tensor_.emplace(tensor->name(), tensor);
     ORT_ENFORCE(insert_result.second, "Initializer name: ", tensor->name(), " from graph: ",
                 graph_to_inline.Name(), " conflicts with graph initializer. Check name generation above.");
+    MarkInitializerChanged(tensor->name());
 
 #if !defined(DISABLE_SPARSE_TENSORS)
     if (has_sparse_origin) {
@@ -5674,6 +5810,7 @@ Status Graph::InlineIfSubgraph(bool condition_value, Node& if_node, const loggin
     }
 
     new_node.GetMutableAttributes() = std::move(node->GetMutableAttributes());
+    new_node.MarkAttributesChanged();
   }
 
   // Let's rebuild local connections, so next time a GraphViewer is able to perform topological sort.
@@ -5841,6 +5978,18 @@ Status Graph::InlineFunction(Node& callnode) {
 }
 
 void Graph::SetInputs(gsl::span<const NodeArg* const> inputs) {
+  // an initializer with a matching graph input is not constant, so consumers of initializers that are added to or
+  // removed from the graph inputs need to be inferred again.
+  auto mark_initializer_inputs = [this](gsl::span<const NodeArg* const> args) {
+    for (const auto* arg : args) {
+      if (IsInitializedTensor(arg->Name())) {
+        MarkInitializerChanged(arg->Name());
+      }
+    }
+  };
+  mark_initializer_inputs(graph_inputs_including_initializers_);
+  mark_initializer_inputs(inputs);
+
   graph_inputs_including_initializers_.clear();
   graph_inputs_excluding_initializers_.clear();
 
@@ -101,6 +101,17 @@ Abstract:
 #endif // ARM64
 #endif // Visual Studio 16 or earlier does not support fp16 intrinsic
 
+//
+// The bfloat16 precision GEMM (SBGEMM) is implemented with the ARM64 BF16
+// extension and with the x86 AVX512-BF16/AMX-BF16 extensions. The x86 kernels
+// use inline assembly for the AMX tile instructions and are only built for
+// Linux targets.
+//
+
+#if (defined(MLAS_TARGET_ARM64) || defined(MLAS_TARGET_AMD64)) && defined(__linux__)
+#define MLAS_SBGEMM_SUPPORTED
+#endif
+
 //
 // Basic Linear Algebra Subprograms (BLAS) types.
 //
@@ -1125,6 +1136,47 @@ MlasComputeTanh(
     size_t N
     );
 
+//
+// Reduction routines.
+//
+// The input is viewed as a [OuterCount, ReduceCount, InnerCount] tensor that
+// is reduced along the middle axis to an [OuterCount, InnerCount] output.
+//
+
+enum MLAS_REDUCE_KIND {
+    MlasReduceSum,
+    MlasReduceMean,
+    MlasReduceMaximum,
+    MlasReduceMinimum,
+    MlasReduceLogSumExp,
+    MlasReduceKindCount,
+};
+
+void
+MLASCALL
+MlasReduce(
+    MLAS_REDUCE_KIND ReduceKind,
+    const float* Input,
+    float* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasArgReduce(
+    bool IsMaximum,
+    bool SelectLastIndex,
+    const float* Input,
+    int64_t* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Transpose routines.
 //
@@ -1140,6 +1192,81 @@ MlasTranspose(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Transposes a tensor of up to MLAS_TRANSPOSE_MAXIMUM_RANK axes, where output
+// axis i is input axis Permutation[i]. Supported for 1, 2, 4, and 8 byte
+// unsigned element types.
+//
+
+constexpr size_t MLAS_TRANSPOSE_MAXIMUM_RANK = 8;
+
+template<typename DataType>
+void
+MLASCALL
+MlasTranspose(
+    const DataType* Input,
+    DataType* Output,
+    const size_t* InputShape,
+    const size_t* Permutation,
+    size_t Rank,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Interpolation routines.
+//
+// Computes Output[n] = sum(Weights[k] * Rows[k][n]) over RowCount rows, which
+// is the vertical pass of a separable linear or cubic resize.
+//
+
+void
+MLASCALL
+MlasInterpolateRows(
+    const float* const* Rows,
+    const float* Weights,
+    size_t RowCount,
+    float* Output,
+    size_t N
+    );
+
+//
+// Computes Output[n] = sum(Weights[k * N + n] * Input[Offsets[k * N + n]])
+// over TapCount taps, where a tap with a negative offset reads zero. The
+// offset and weight tables are stored tap major and are typically shared by
+// all channels of a gather based resampling (GridSample, RoiAlign).
+//
+
+void
+MLASCALL
+MlasGatherInterpolate(
+    const float* Input,
+    const int32_t* Offsets,
+    const float* Weights,
+    size_t TapCount,
+    float* Output,
+    size_t N
+    );
+
+//
+// Bounding box routines.
+//
+// Returns true if the intersection over union of Box and any of the Count
+// boxes exceeds IouThreshold, which is the suppression test of non-maximum
+// suppression. Box holds {xmin, ymin, xmax, ymax, area}; Boxes holds the same
+// five fields as planes of Stride elements. Boxes with an empty intersection
+// or a non-positive area never suppress each other.
+//
+
+bool
+MLASCALL
+MlasIouExceedsThreshold(
+    const float* Box,
+    const float* Boxes,
+    size_t Count,
+    size_t Stride,
+    float IouThreshold
+    );
+
 //
 // Buffer reordering routines.
 //
@@ -1877,7 +2004,7 @@ MlasHalfGemmConvertPackB(
     void* PackedB
     );
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
 /**
  * @brief Whether current CPU supports Bfloat16(bf16) acceleration.
  */
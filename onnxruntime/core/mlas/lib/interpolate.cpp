@@ -0,0 +1,220 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    interpolate.cpp
+
+Abstract:
+
+    This module implements routines used by image resize and resampling
+    operations:
+
+        - The weighted sum of rows for separable linear or cubic resize.
+        - The gather interpolate used by GridSample and RoiAlign.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasInterpolateRows(
+    const float* const* Rows,
+    const float* Weights,
+    size_t RowCount,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the weighted sum of a set of rows:
+
+        Output[n] = Weights[0] * Rows[0][n] + ... + Weights[k] * Rows[k][n]
+
+Arguments:
+
+    Rows - Supplies the array of RowCount input row pointers.
+
+    Weights - Supplies the array of RowCount weights.
+
+    RowCount - Supplies the number of input rows.
+
+    Output - Supplies the output buffer. The buffer may alias one of the
+        input rows.
+
+    N - Supplies the number of elements in each row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (RowCount == 0) {
+        std::fill_n(Output, N, 0.0f);
+        return;
+    }
+
+    size_t n = 0;
+
+    while (n + 16 <= N) {
+
+        MLAS_FLOAT32X4 Weight = MlasBroadcastFloat32x4(Weights[0]);
+        MLAS_FLOAT32X4 Accumulator0 = MlasMultiplyFloat32x4(MlasLoadFloat32x4(Rows[0] + n), Weight);
+        MLAS_FLOAT32X4 Accumulator1 = MlasMultiplyFloat32x4(MlasLoadFloat32x4(Rows[0] + n + 4), Weight);
+        MLAS_FLOAT32X4 Accumulator2 = MlasMultiplyFloat32x4(MlasLoadFloat32x4(Rows[0] + n + 8), Weight);
+        MLAS_FLOAT32X4 Accumulator3 = MlasMultiplyFloat32x4(MlasLoadFloat32x4(Rows[0] + n + 12), Weight);
+
+        for (size_t k = 1; k < RowCount; k++) {
+
+            const float* Row = Rows[k] + n;
+            Weight = MlasBroadcastFloat32x4(Weights[k]);
+
+            Accumulator0 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Row), Weight, Accumulator0);
+            Accumulator1 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Row + 4), Weight, Accumulator1);
+            Accumulator2 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Row + 8), Weight, Accumulator2);
+            Accumulator3 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Row + 12), Weight, Accumulator3);
+        }
+
+        MlasStoreFloat32x4(Output + n, Accumulator0);
+        MlasStoreFloat32x4(Output + n + 4, Accumulator1);
+        MlasStoreFloat32x4(Output + n + 8, Accumulator2);
+        MlasStoreFloat32x4(Output + n + 12, Accumulator3);
+
+        n += 16;
+    }
+
+    while (n + 4 <= N) {
+
+        MLAS_FLOAT32X4 Accumulator = MlasMultiplyFloat32x4(MlasLoadFloat32x4(Rows[0] + n),
+                                                           MlasBroadcastFloat32x4(Weights[0]));
+
+        for (size_t k = 1; k < RowCount; k++) {
+            Accumulator = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Rows[k] + n),
+                                                   MlasBroadcastFloat32x4(Weights[k]), Accumulator);
+        }
+
+        MlasStoreFloat32x4(Output + n, Accumulator);
+
+        n += 4;
+    }
+
+    for (; n < N; n++) {
+
+        float Accumulator = Rows[0][n] * Weights[0];
+
+        for (size_t k = 1; k < RowCount; k++) {
+            Accumulator += Rows[k][n] * Weights[k];
+        }
+
+        Output[n] = Accumulator;
+    }
+}
+
+void
+MLASCALL
+MlasGatherInterpolateF32Kernel(
+    const float* Input,
+    const int32_t* Offsets,
+    const float* Weights,
+    size_t TapCount,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the gather interpolate
+    operation.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Offsets - Supplies the TapCount x N table of input offsets. A negative
+        offset selects a zero value.
+
+    Weights - Supplies the TapCount x N table of weights.
+
+    TapCount - Supplies the number of taps for each output element.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of output elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    std::fill_n(Output, N, 0.0f);
+
+    for (size_t k = 0; k < TapCount; k++) {
+
+        const int32_t* TapOffsets = Offsets + k * N;
+        const float* TapWeights = Weights + k * N;
+
+        for (size_t n = 0; n < N; n++) {
+            if (TapOffsets[n] >= 0) {
+                Output[n] += TapWeights[n] * Input[TapOffsets[n]];
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasGatherInterpolate(
+    const float* Input,
+    const int32_t* Offsets,
+    const float* Weights,
+    size_t TapCount,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the weighted sum of TapCount gathered input
+    elements for each output element:
+
+        Output[n] = Weights[0 * N + n] * Input[Offsets[0 * N + n]] + ...
+
+    A tap with a negative offset contributes zero, which implements zero
+    padding without reading outside of the input.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Offsets - Supplies the TapCount x N table of input offsets.
+
+    Weights - Supplies the TapCount x N table of weights.
+
+    TapCount - Supplies the number of taps for each output element.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of output elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().GatherInterpolateF32Kernel(Input, Offsets, Weights, TapCount, Output, N);
+#else
+    MlasGatherInterpolateF32Kernel(Input, Offsets, Weights, TapCount, Output, N);
+#endif
+}
@@ -0,0 +1,81 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    interpolate_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the gather interpolate kernel for AVX2 supported
+    h/w.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasGatherInterpolateF32KernelAvx2(
+    const float* Input,
+    const int32_t* Offsets,
+    const float* Weights,
+    size_t TapCount,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the gather interpolate kernel using AVX2 gathers.
+    Taps with a negative offset are masked out of the gather.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Offsets - Supplies the TapCount x N table of input offsets.
+
+    Weights - Supplies the TapCount x N table of weights.
+
+    TapCount - Supplies the number of taps for each output element.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of output elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const __m256i NegativeOne = _mm256_set1_epi32(-1);
+
+    for (size_t n = 0; n < N; n += 8) {
+
+        const size_t Count = std::min<size_t>(8, N - n);
+        const __m256i CountMask = _mm256_cmpgt_epi32(_mm256_set1_epi32(int32_t(Count)),
+                                                     _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+
+        __m256 Accumulator = _mm256_setzero_ps();
+
+        for (size_t k = 0; k < TapCount; k++) {
+
+            const __m256i Offset = _mm256_maskload_epi32(Offsets + k * N + n, CountMask);
+            const __m256 Weight = _mm256_maskload_ps(Weights + k * N + n, CountMask);
+            const __m256 GatherMask = _mm256_castsi256_ps(
+                _mm256_and_si256(_mm256_cmpgt_epi32(Offset, NegativeOne), CountMask));
+
+            const __m256 Value = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), Input, Offset, GatherMask, sizeof(float));
+
+            Accumulator = _mm256_fmadd_ps(Weight, Value, Accumulator);
+        }
+
+        _mm256_maskstore_ps(Output + n, CountMask, Accumulator);
+    }
+}
@@ -0,0 +1,79 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    interpolate_kernel_avx512f.cpp
+
+Abstract:
+
+    This module implements the gather interpolate kernel for AVX512F
+    supported h/w.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasGatherInterpolateF32KernelAvx512F(
+    const float* Input,
+    const int32_t* Offsets,
+    const float* Weights,
+    size_t TapCount,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the gather interpolate kernel using AVX512F
+    gathers. Taps with a negative offset are masked out of the gather.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Offsets - Supplies the TapCount x N table of input offsets.
+
+    Weights - Supplies the TapCount x N table of weights.
+
+    TapCount - Supplies the number of taps for each output element.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of output elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const __m512i NegativeOne = _mm512_set1_epi32(-1);
+
+    for (size_t n = 0; n < N; n += 16) {
+
+        const size_t Count = std::min<size_t>(16, N - n);
+        const __mmask16 CountMask = __mmask16((uint32_t(1) << Count) - 1);
+
+        __m512 Accumulator = _mm512_setzero_ps();
+
+        for (size_t k = 0; k < TapCount; k++) {
+
+            const __m512i Offset = _mm512_maskz_loadu_epi32(CountMask, Offsets + k * N + n);
+            const __m512 Weight = _mm512_maskz_loadu_ps(CountMask, Weights + k * N + n);
+            const __mmask16 GatherMask = _mm512_mask_cmpgt_epi32_mask(CountMask, Offset, NegativeOne);
+
+            const __m512 Value = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), GatherMask, Offset, Input, sizeof(float));
+
+            Accumulator = _mm512_fmadd_ps(Weight, Value, Accumulator);
+        }
+
+        _mm512_mask_storeu_ps(Output + n, CountMask, Accumulator);
+    }
+}
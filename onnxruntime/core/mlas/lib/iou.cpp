@@ -0,0 +1,187 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    iou.cpp
+
+Abstract:
+
+    This module implements the intersection over union test used by
+    non-maximum suppression.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Stores the offsets of the fields within a box and within the planes of the
+// box array.
+//
+
+enum MLAS_BOX_FIELD {
+    MlasBoxXMin = 0,
+    MlasBoxYMin = 1,
+    MlasBoxXMax = 2,
+    MlasBoxYMax = 3,
+    MlasBoxArea = 4,
+};
+
+MLAS_FORCEINLINE
+bool
+MlasIouExceedsThresholdSingle(
+    const float* Box,
+    const float* Boxes,
+    size_t Index,
+    size_t Stride,
+    float IouThreshold
+    )
+/*++
+
+Routine Description:
+
+    This routine tests a single pair of boxes. The comparisons are written to
+    match the vectorized form lane for lane.
+
+Arguments:
+
+    Box - Supplies the box to test.
+
+    Boxes - Supplies the array of boxes.
+
+    Index - Supplies the index of the box within the array of boxes.
+
+    Stride - Supplies the number of elements in each plane of the array.
+
+    IouThreshold - Supplies the intersection over union threshold.
+
+Return Value:
+
+    Returns true if the intersection over union exceeds the threshold.
+
+--*/
+{
+    const float IntersectionXMin = std::max(Box[MlasBoxXMin], Boxes[MlasBoxXMin * Stride + Index]);
+    const float IntersectionXMax = std::min(Box[MlasBoxXMax], Boxes[MlasBoxXMax * Stride + Index]);
+    const float IntersectionYMin = std::max(Box[MlasBoxYMin], Boxes[MlasBoxYMin * Stride + Index]);
+    const float IntersectionYMax = std::min(Box[MlasBoxYMax], Boxes[MlasBoxYMax * Stride + Index]);
+
+    if (IntersectionXMax <= IntersectionXMin || IntersectionYMax <= IntersectionYMin) {
+        return false;
+    }
+
+    const float Area1 = Box[MlasBoxArea];
+    const float Area2 = Boxes[MlasBoxArea * Stride + Index];
+    const float IntersectionArea = (IntersectionXMax - IntersectionXMin) * (IntersectionYMax - IntersectionYMin);
+    const float UnionArea = Area1 + Area2 - IntersectionArea;
+
+    if (IntersectionArea <= 0.0f || Area1 <= 0.0f || Area2 <= 0.0f || UnionArea <= 0.0f) {
+        return false;
+    }
+
+    return IntersectionArea / UnionArea > IouThreshold;
+}
+
+bool
+MLASCALL
+MlasIouExceedsThreshold(
+    const float* Box,
+    const float* Boxes,
+    size_t Count,
+    size_t Stride,
+    float IouThreshold
+    )
+/*++
+
+Routine Description:
+
+    This routine tests whether the intersection over union of a box and any
+    box of an array exceeds a threshold.
+
+    The array is processed four boxes at a time. A lane is suppressed only if
+    none of the rejection tests of the scalar form hold and the intersection
+    over union exceeds the threshold, so both forms agree. The routine returns
+    as soon as any block contains a suppressing box.
+
+Arguments:
+
+    Box - Supplies the box to test as {xmin, ymin, xmax, ymax, area}.
+
+    Boxes - Supplies the array of boxes as five planes of Stride elements in
+        the same field order.
+
+    Count - Supplies the number of boxes in the array.
+
+    Stride - Supplies the number of elements in each plane of the array.
+
+    IouThreshold - Supplies the intersection over union threshold.
+
+Return Value:
+
+    Returns true if any box of the array exceeds the threshold.
+
+--*/
+{
+    const MLAS_FLOAT32X4 XMin1 = MlasBroadcastFloat32x4(Box[MlasBoxXMin]);
+    const MLAS_FLOAT32X4 YMin1 = MlasBroadcastFloat32x4(Box[MlasBoxYMin]);
+    const MLAS_FLOAT32X4 XMax1 = MlasBroadcastFloat32x4(Box[MlasBoxXMax]);
+    const MLAS_FLOAT32X4 YMax1 = MlasBroadcastFloat32x4(Box[MlasBoxYMax]);
+    const MLAS_FLOAT32X4 Area1 = MlasBroadcastFloat32x4(Box[MlasBoxArea]);
+    const MLAS_FLOAT32X4 Threshold = MlasBroadcastFloat32x4(IouThreshold);
+    const MLAS_FLOAT32X4 Zero = MlasZeroFloat32x4();
+    const MLAS_FLOAT32X4 One = MlasBroadcastFloat32x4(1.0f);
+
+    //
+    // A box whose area is not positive cannot suppress or be suppressed.
+    //
+
+    if (!(Box[MlasBoxArea] > 0.0f)) {
+        return false;
+    }
+
+    size_t i = 0;
+
+    for (; i + 4 <= Count; i += 4) {
+
+        //
+        // The operand order of the minimum and maximum matches std::min and
+        // std::max with the box to test as the first argument.
+        //
+
+        MLAS_FLOAT32X4 IntersectionXMin = MlasMaximumFloat32x4(MlasLoadFloat32x4(Boxes + MlasBoxXMin * Stride + i), XMin1);
+        MLAS_FLOAT32X4 IntersectionXMax = MlasMinimumFloat32x4(MlasLoadFloat32x4(Boxes + MlasBoxXMax * Stride + i), XMax1);
+        MLAS_FLOAT32X4 IntersectionYMin = MlasMaximumFloat32x4(MlasLoadFloat32x4(Boxes + MlasBoxYMin * Stride + i), YMin1);
+        MLAS_FLOAT32X4 IntersectionYMax = MlasMinimumFloat32x4(MlasLoadFloat32x4(Boxes + MlasBoxYMax * Stride + i), YMax1);
+        MLAS_FLOAT32X4 Area2 = MlasLoadFloat32x4(Boxes + MlasBoxArea * Stride + i);
+
+        MLAS_FLOAT32X4 IntersectionArea = MlasMultiplyFloat32x4(
+            MlasSubtractFloat32x4(IntersectionXMax, IntersectionXMin),
+            MlasSubtractFloat32x4(IntersectionYMax, IntersectionYMin));
+        MLAS_FLOAT32X4 UnionArea = MlasSubtractFloat32x4(MlasAddFloat32x4(Area1, Area2), IntersectionArea);
+
+        MLAS_FLOAT32X4 Rejected = MlasOrFloat32x4(
+            MlasGreaterThanOrEqualFloat32x4(IntersectionXMin, IntersectionXMax),
+            MlasGreaterThanOrEqualFloat32x4(IntersectionYMin, IntersectionYMax));
+        Rejected = MlasOrFloat32x4(Rejected, MlasGreaterThanOrEqualFloat32x4(Zero, IntersectionArea));
+        Rejected = MlasOrFloat32x4(Rejected, MlasGreaterThanOrEqualFloat32x4(Zero, Area2));
+        Rejected = MlasOrFloat32x4(Rejected, MlasGreaterThanOrEqualFloat32x4(Zero, UnionArea));
+
+        MLAS_FLOAT32X4 Suppressed = MlasAndNotFloat32x4(Rejected,
+            MlasGreaterThanFloat32x4(MlasDivideFloat32x4(IntersectionArea, UnionArea), Threshold));
+
+        if (MlasReduceMaximumFloat32x4(MlasAndFloat32x4(Suppressed, One)) != 0.0f) {
+            return true;
+        }
+    }
+
+    for (; i < Count; i++) {
+        if (MlasIouExceedsThresholdSingle(Box, Boxes, i, Stride, IouThreshold)) {
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -288,6 +288,7 @@ Return Value:
     this->ComputeLogSoftmaxOutputF32Kernel = MlasComputeLogSoftmaxOutputF32Kernel;
     this->ReduceMaximumF32Kernel = MlasReduceMaximumF32Kernel;
     this->ReduceMinimumMaximumF32Kernel = MlasReduceMinimumMaximumF32Kernel;
+    this->GatherInterpolateF32Kernel = MlasGatherInterpolateF32Kernel;
     this->QLinearAddS8Kernel = MlasQLinearAddS8Kernel;
     this->QLinearAddU8Kernel = MlasQLinearAddU8Kernel;
     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8Kernel;
@@ -417,6 +418,8 @@ Return Value:
                 this->CastF16ToF32Kernel = &MlasCastF16ToF32KernelAvx2;
                 this->CastF32ToF16Kernel = &MlasCastF32ToF16KernelAvx2;
                 this->RopeDispatch = &MlasRopeDispatchAvx2;
+                this->ReduceDispatch = &MlasReduceDispatchAvx2;
+                this->GatherInterpolateF32Kernel = MlasGatherInterpolateF32KernelAvx2;
 
 
                 //
@@ -468,6 +471,8 @@ Return Value:
                     this->ComputeExpF32Kernel = MlasComputeExpF32KernelAvx512F;
                     this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelAvx512F;
                     this->ReduceMaximumF32Kernel = MlasReduceMaximumF32KernelAvx512F;
+                    this->ReduceDispatch = &MlasReduceDispatchAvx512F;
+                    this->GatherInterpolateF32Kernel = MlasGatherInterpolateF32KernelAvx512F;
                     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8KernelAvx512F;
                     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8KernelAvx512F;
                     this->NchwcBlockSize = 16;
@@ -502,6 +507,16 @@ Return Value:
                             this->Q8Q4GemmDispatch = &MlasQ8Q4GemmDispatchAvx512vnni;
                             this->QNBitGemmDispatch = &MlasSQNBitGemmDispatchAvx512vnni;
                         }
+
+#if defined(MLAS_SBGEMM_SUPPORTED) && defined(MLAS_USE_AVX512BF16)
+                        //
+                        // Check if the processor supports AVX512BF16.
+                        //
+
+                        if ((Cpuid7_1[0] & 0x20) != 0) {
+                            this->SBGemmDispatch = &MlasSBGemmDispatchAvx512Bf16;
+                        }
+#endif
                     }
                 }
 
@@ -539,6 +554,22 @@ Return Value:
                         this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAmx;
                     }
                 }
+
+#if defined(MLAS_SBGEMM_SUPPORTED) && defined(MLAS_USE_AVX512BF16)
+                //
+                // Check if the processor supports AMX-TILE and AMX-BF16
+                // features. The AMX kernel relies on the AVX512BF16 kernel to
+                // handle the leftover rows.
+                //
+                if ((Cpuid7[3] & 0b1 << 24) != 0 &&
+                    (Cpuid7[3] & 0b1 << 22) != 0 &&
+                    (xcr0 & XFEATURE_MASK_XTILE) == XFEATURE_MASK_XTILE &&
+                    this->SBGemmDispatch != nullptr) {
+                    if (MlasInitAMX()) {
+                        this->SBGemmDispatch = &MlasSBGemmDispatchAmx;
+                    }
+                }
+#endif
 #endif // __APPLE__
 
 #endif // ORT_MINIMAL_BUILD
@@ -651,6 +682,12 @@ Return Value:
     this->CastF32ToF16Kernel = &MlasCastF32ToF16KernelNeon;
 #endif
 
+#if defined(MLAS_SBGEMM_SUPPORTED)
+    if (MLAS_CPUIDINFO::GetCPUIDInfo().HasArmNeon_BF16()) {
+        this->SBGemmDispatch = &MlasSBGemmDispatchNeon;
+    }
+#endif
+
 #endif // MLAS_TARGET_ARM64
 #if defined(MLAS_TARGET_POWER)
     this->GemmFloatKernel = MlasSgemmKernel;
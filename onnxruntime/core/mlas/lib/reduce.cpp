@@ -0,0 +1,622 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce.cpp
+
+Abstract:
+
+    This module implements the single precision floating point reduction
+    routines: sum, mean, maximum, minimum, log-sum-exp, and the index of the
+    maximum or minimum element.
+
+    The input is viewed as a [OuterCount, ReduceCount, InnerCount] tensor. A
+    contiguous reduction (InnerCount == 1) reduces each row to a scalar and a
+    strided reduction (InnerCount > 1) reduces columns by accumulating rows.
+    Reductions over multiple axes are expressed by the caller as one or two
+    passes over this canonical form.
+
+    Work is partitioned over the outer dimension and over blocks of inner
+    columns that fit the L1 cache. When that yields too few tasks to occupy
+    the thread pool, the reduced dimension is split into segments whose
+    partial results are combined in a second pass.
+
+--*/
+
+#include "reduce.h"
+
+#include <limits>
+#include <vector>
+
+//
+// Portable kernels built on the MLAS_FLOAT32X4 wrappers. These are the NEON
+// kernels on ARM64 and the SSE2 kernels on x86.
+//
+
+struct MLAS_REDUCE_FLOAT32X4_TRAITS {
+    typedef MLAS_FLOAT32X4 Vector;
+    typedef MLAS_FLOAT32X4 Mask;
+
+    static constexpr size_t Width = 4;
+
+    static MLAS_FORCEINLINE Vector Load(const float* Input) { return MlasLoadFloat32x4(Input); }
+
+    static MLAS_FORCEINLINE Vector LoadPartial(const float* Input, size_t N)
+    {
+        float Buffer[Width] = {};
+        for (size_t n = 0; n < N; n++) {
+            Buffer[n] = Input[n];
+        }
+        return MlasLoadFloat32x4(Buffer);
+    }
+
+    static MLAS_FORCEINLINE void Store(float* Output, Vector V) { MlasStoreFloat32x4(Output, V); }
+
+    static MLAS_FORCEINLINE void StorePartial(float* Output, Vector V, size_t N)
+    {
+        float Buffer[Width];
+        MlasStoreFloat32x4(Buffer, V);
+        for (size_t n = 0; n < N; n++) {
+            Output[n] = Buffer[n];
+        }
+    }
+
+    static MLAS_FORCEINLINE Vector Broadcast(float Value) { return MlasBroadcastFloat32x4(Value); }
+    static MLAS_FORCEINLINE Vector Zero() { return MlasZeroFloat32x4(); }
+    static MLAS_FORCEINLINE Vector Add(Vector V1, Vector V2) { return MlasAddFloat32x4(V1, V2); }
+    static MLAS_FORCEINLINE Vector Maximum(Vector V1, Vector V2) { return MlasMaximumFloat32x4(V1, V2); }
+    static MLAS_FORCEINLINE Vector Minimum(Vector V1, Vector V2) { return MlasMinimumFloat32x4(V1, V2); }
+    static MLAS_FORCEINLINE Mask GreaterThan(Vector V1, Vector V2) { return MlasGreaterThanFloat32x4(V1, V2); }
+    static MLAS_FORCEINLINE Mask GreaterThanOrEqual(Vector V1, Vector V2) { return MlasGreaterThanOrEqualFloat32x4(V1, V2); }
+    static MLAS_FORCEINLINE Vector Blend(Vector V1, Vector V2, Mask Selection) { return MlasBlendFloat32x4(V1, V2, Selection); }
+    static MLAS_FORCEINLINE float ReduceAdd(Vector V) { return MlasReduceAddFloat32x4(V); }
+    static MLAS_FORCEINLINE float ReduceMaximum(Vector V) { return MlasReduceMaximumFloat32x4(V); }
+    static MLAS_FORCEINLINE float ReduceMinimum(Vector V) { return MlasReduceMinimumFloat32x4(V); }
+};
+
+const MLAS_REDUCE_DISPATCH MlasReduceDispatchDefault = []() {
+    return MlasReduceMakeDispatch<MLAS_REDUCE_FLOAT32X4_TRAITS>();
+}();
+
+//
+// Try to keep each thread processing a minimum number of elements before
+// using another thread.
+//
+
+constexpr size_t MLAS_REDUCE_MINIMUM_ELEMENTS_PER_THREAD = 16384;
+
+//
+// Number of inner columns reduced by one task. The column kernels use the
+// output block as the accumulator, so 4KB keeps it resident in the L1 cache.
+//
+
+constexpr size_t MLAS_REDUCE_COLUMN_BLOCK_SIZE = 1024;
+
+struct MLAS_REDUCE_PARTITION {
+    size_t OuterCount;
+    size_t ReduceCount;
+    size_t InnerCount;
+    size_t BlockN;
+    size_t BlockCountN;
+    size_t SegmentSize;
+    size_t SegmentCount;
+    ptrdiff_t ThreadCount;
+};
+
+static
+MLAS_REDUCE_PARTITION
+MlasReducePartition(
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    bool AllowSegments,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    MLAS_REDUCE_PARTITION Partition;
+
+    Partition.OuterCount = OuterCount;
+    Partition.ReduceCount = ReduceCount;
+    Partition.InnerCount = InnerCount;
+    Partition.BlockN = std::min(InnerCount, MLAS_REDUCE_COLUMN_BLOCK_SIZE);
+    Partition.BlockCountN = MlasDivRoundup(InnerCount, Partition.BlockN);
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    const size_t BlockCount = (OuterCount * ReduceCount * InnerCount) / MLAS_REDUCE_MINIMUM_ELEMENTS_PER_THREAD + 1;
+
+    if (size_t(ThreadCount) > BlockCount) {
+        ThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    //
+    // Split the reduced dimension when there are fewer output blocks than
+    // threads, as for full reductions or reductions to a few columns.
+    //
+
+    const size_t TaskCount = OuterCount * Partition.BlockCountN;
+    size_t SegmentCount = 1;
+
+    if (AllowSegments && TaskCount < size_t(ThreadCount)) {
+        SegmentCount = MlasDivRoundup(size_t(ThreadCount), TaskCount);
+
+        const size_t MaximumSegmentCount =
+            (ReduceCount * Partition.BlockN) / MLAS_REDUCE_MINIMUM_ELEMENTS_PER_THREAD + 1;
+
+        SegmentCount = std::min(SegmentCount, MaximumSegmentCount);
+    }
+
+    Partition.SegmentSize = MlasDivRoundup(ReduceCount, SegmentCount);
+    Partition.SegmentCount = MlasDivRoundup(ReduceCount, Partition.SegmentSize);
+    Partition.ThreadCount = ThreadCount;
+
+    return Partition;
+}
+
+/*++
+
+Routine Description:
+
+    This routine executes a reduction over the partitioned work.
+
+Arguments:
+
+    Partition - Supplies the work partition.
+
+    CombineRoutine - Supplies the column kernel used to combine the partial
+        results of the segments of the reduced dimension.
+
+    Output - Supplies the output buffer.
+
+    ReduceSegment - Supplies the routine that reduces rows [r, r + CountR) of
+        columns [n, n + CountN) of outer index o to the destination.
+
+    Finalize - Supplies the routine that transforms the reduced values of
+        the output block at the supplied offset.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+--*/
+template <typename ReduceSegmentRoutine, typename FinalizeRoutine>
+static
+void
+MlasReduceExecute(
+    const MLAS_REDUCE_PARTITION& Partition,
+    MLAS_REDUCE_DISPATCH::ReduceColumns_Fn* CombineRoutine,
+    float* Output,
+    const ReduceSegmentRoutine& ReduceSegment,
+    const FinalizeRoutine& Finalize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    const size_t InnerCount = Partition.InnerCount;
+    const size_t TaskCount = Partition.OuterCount * Partition.BlockCountN;
+
+    if (Partition.SegmentCount == 1) {
+        MlasTrySimpleParallel(ThreadPool, Partition.ThreadCount, [&](ptrdiff_t tid) {
+            size_t TaskIndex;
+            size_t TaskRemaining;
+            MlasPartitionWork(tid, Partition.ThreadCount, TaskCount, &TaskIndex, &TaskRemaining);
+
+            for (; TaskRemaining > 0; TaskIndex++, TaskRemaining--) {
+                const size_t o = TaskIndex / Partition.BlockCountN;
+                const size_t n = (TaskIndex % Partition.BlockCountN) * Partition.BlockN;
+                const size_t CountN = std::min(InnerCount - n, Partition.BlockN);
+                const size_t Offset = o * InnerCount + n;
+
+                ReduceSegment(o, n, CountN, size_t(0), Partition.ReduceCount, Output + Offset);
+                Finalize(Output + Offset, Offset, CountN);
+            }
+        });
+        return;
+    }
+
+    //
+    // Reduce each segment to a partial result laid out as
+    // [OuterCount, SegmentCount, InnerCount], then reduce the partial results
+    // along the segment dimension.
+    //
+
+    const size_t SegmentCount = Partition.SegmentCount;
+    std::vector<float> PartialBuffer(Partition.OuterCount * SegmentCount * InnerCount);
+    float* Partial = PartialBuffer.data();
+
+    MlasTrySimpleParallel(ThreadPool, Partition.ThreadCount, [&](ptrdiff_t tid) {
+        size_t TaskIndex;
+        size_t TaskRemaining;
+        MlasPartitionWork(tid, Partition.ThreadCount, TaskCount * SegmentCount, &TaskIndex, &TaskRemaining);
+
+        for (; TaskRemaining > 0; TaskIndex++, TaskRemaining--) {
+            const size_t s = TaskIndex % SegmentCount;
+            const size_t o = (TaskIndex / SegmentCount) / Partition.BlockCountN;
+            const size_t n = ((TaskIndex / SegmentCount) % Partition.BlockCountN) * Partition.BlockN;
+            const size_t CountN = std::min(InnerCount - n, Partition.BlockN);
+            const size_t r = s * Partition.SegmentSize;
+            const size_t CountR = std::min(Partition.ReduceCount - r, Partition.SegmentSize);
+
+            ReduceSegment(o, n, CountN, r, CountR, Partial + (o * SegmentCount + s) * InnerCount + n);
+        }
+    });
+
+    MlasTrySimpleParallel(ThreadPool, Partition.ThreadCount, [&](ptrdiff_t tid) {
+        size_t TaskIndex;
+        size_t TaskRemaining;
+        MlasPartitionWork(tid, Partition.ThreadCount, TaskCount, &TaskIndex, &TaskRemaining);
+
+        for (; TaskRemaining > 0; TaskIndex++, TaskRemaining--) {
+            const size_t o = TaskIndex / Partition.BlockCountN;
+            const size_t n = (TaskIndex % Partition.BlockCountN) * Partition.BlockN;
+            const size_t CountN = std::min(InnerCount - n, Partition.BlockN);
+            const size_t Offset = o * InnerCount + n;
+
+            CombineRoutine(Partial + o * SegmentCount * InnerCount + n, InnerCount, SegmentCount, Output + Offset, CountN);
+            Finalize(Output + Offset, Offset, CountN);
+        }
+    });
+}
+
+static
+float
+MlasReduceSumExp(
+    const float* Input,
+    size_t N,
+    float NegativeMaximum
+    )
+{
+#if defined(MLAS_TARGET_AMD64) || defined(MLAS_USE_SVE)
+    return GetMlasPlatform().ComputeSumExpF32Kernel(Input, nullptr, N, &NegativeMaximum);
+#else
+    return MlasComputeSumExpF32Kernel(Input, nullptr, N, &NegativeMaximum);
+#endif
+}
+
+static
+void
+MlasReduceSumExpColumns(
+    const float* Input,
+    size_t ldInput,
+    size_t CountR,
+    const float* Shift,
+    float* Output,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the sum of exp(Input - Shift) along the rows of a
+    block of columns.
+
+    Rows are gathered into a temporary buffer so that each call to the
+    exponential kernel processes a full block even for narrow columns.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float Temp[MLAS_REDUCE_COLUMN_BLOCK_SIZE], 64);
+
+    const size_t RowsPerBatch = MLAS_REDUCE_COLUMN_BLOCK_SIZE / CountN;
+
+    for (size_t n = 0; n < CountN; n++) {
+        Output[n] = 0.0f;
+    }
+
+    while (CountR > 0) {
+        const size_t CountBatch = std::min(CountR, RowsPerBatch);
+
+        float* temp = Temp;
+
+        for (size_t r = 0; r < CountBatch; r++) {
+            size_t n = 0;
+
+            for (; n + 4 <= CountN; n += 4) {
+                MlasStoreFloat32x4(temp + n, MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + n), MlasLoadFloat32x4(Shift + n)));
+            }
+
+            for (; n < CountN; n++) {
+                temp[n] = Input[n] - Shift[n];
+            }
+
+            Input += ldInput;
+            temp += CountN;
+        }
+
+        MlasComputeExp(Temp, Temp, CountBatch * CountN);
+
+        temp = Temp;
+
+        for (size_t r = 0; r < CountBatch; r++) {
+            size_t n = 0;
+
+            for (; n + 4 <= CountN; n += 4) {
+                MlasStoreFloat32x4(Output + n, MlasAddFloat32x4(MlasLoadFloat32x4(Output + n), MlasLoadFloat32x4(temp + n)));
+            }
+
+            for (; n < CountN; n++) {
+                Output[n] += temp[n];
+            }
+
+            temp += CountN;
+        }
+
+        CountR -= CountBatch;
+    }
+}
+
+static
+void
+MlasComputeLogSumExp(
+    const MLAS_REDUCE_DISPATCH* Dispatch,
+    const float* Input,
+    float* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes log(sum(exp(x))) in two passes: the first finds the
+    maximum that is used to shift the exponentials into range and the second
+    accumulates the shifted exponentials without storing them.
+
+    A maximum that is not finite is replaced by zero so that all -infinity
+    inputs produce -infinity and any +infinity input produces +infinity.
+
+--*/
+{
+    const auto Partition = MlasReducePartition(OuterCount, ReduceCount, InnerCount, true, ThreadPool);
+
+    MlasReduceExecute(
+        Partition, Dispatch->ReduceColumnsMaximum, Output,
+        [&](size_t o, size_t n, size_t CountN, size_t r, size_t CountR, float* Destination) {
+            const float* input = Input + (o * ReduceCount + r) * InnerCount + n;
+            if (InnerCount == 1) {
+                *Destination = Dispatch->ReduceMaximum(input, CountR);
+            } else {
+                Dispatch->ReduceColumnsMaximum(input, InnerCount, CountR, Destination, CountN);
+            }
+        },
+        [](float*, size_t, size_t) {},
+        ThreadPool);
+
+    std::vector<float> ShiftBuffer(OuterCount * InnerCount);
+    float* Shift = ShiftBuffer.data();
+
+    for (size_t i = 0; i < OuterCount * InnerCount; i++) {
+        Shift[i] = std::isfinite(Output[i]) ? Output[i] : 0.0f;
+    }
+
+    MlasReduceExecute(
+        Partition, Dispatch->ReduceColumnsSum, Output,
+        [&](size_t o, size_t n, size_t CountN, size_t r, size_t CountR, float* Destination) {
+            const float* input = Input + (o * ReduceCount + r) * InnerCount + n;
+            const float* shift = Shift + o * InnerCount + n;
+            if (InnerCount == 1) {
+                *Destination = MlasReduceSumExp(input, CountR, -shift[0]);
+            } else {
+                MlasReduceSumExpColumns(input, InnerCount, CountR, shift, Destination, CountN);
+            }
+        },
+        [&](float* Destination, size_t Offset, size_t CountN) {
+            for (size_t n = 0; n < CountN; n++) {
+                Destination[n] = std::log(Destination[n]) + Shift[Offset + n];
+            }
+        },
+        ThreadPool);
+}
+
+void
+MLASCALL
+MlasReduce(
+    MLAS_REDUCE_KIND ReduceKind,
+    const float* Input,
+    float* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces a [OuterCount, ReduceCount, InnerCount] tensor along
+    its middle axis.
+
+Arguments:
+
+    ReduceKind - Supplies the reduction to compute.
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the [OuterCount, InnerCount] output buffer.
+
+    OuterCount - Supplies the number of independent reductions.
+
+    ReduceCount - Supplies the number of elements to reduce.
+
+    InnerCount - Supplies the stride between the reduced elements, which is
+        also the number of output elements per outer index.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t OutputCount = OuterCount * InnerCount;
+
+    if (OutputCount == 0) {
+        return;
+    }
+
+    if (ReduceCount == 0) {
+        float Value;
+        switch (ReduceKind) {
+            case MlasReduceSum:
+                Value = 0.0f;
+                break;
+            case MlasReduceMaximum:
+            case MlasReduceLogSumExp:
+                Value = -std::numeric_limits<float>::infinity();
+                break;
+            case MlasReduceMinimum:
+                Value = std::numeric_limits<float>::infinity();
+                break;
+            default:
+                Value = std::numeric_limits<float>::quiet_NaN();
+                break;
+        }
+        std::fill_n(Output, OutputCount, Value);
+        return;
+    }
+
+    const MLAS_REDUCE_DISPATCH* Dispatch = GetMlasPlatform().ReduceDispatch;
+
+    if (ReduceKind == MlasReduceLogSumExp) {
+        MlasComputeLogSumExp(Dispatch, Input, Output, OuterCount, ReduceCount, InnerCount, ThreadPool);
+        return;
+    }
+
+    MLAS_REDUCE_DISPATCH::ReduceVector_Fn* VectorRoutine;
+    MLAS_REDUCE_DISPATCH::ReduceColumns_Fn* ColumnsRoutine;
+
+    switch (ReduceKind) {
+        case MlasReduceSum:
+        case MlasReduceMean:
+            VectorRoutine = Dispatch->ReduceSum;
+            ColumnsRoutine = Dispatch->ReduceColumnsSum;
+            break;
+        case MlasReduceMaximum:
+            VectorRoutine = Dispatch->ReduceMaximum;
+            ColumnsRoutine = Dispatch->ReduceColumnsMaximum;
+            break;
+        case MlasReduceMinimum:
+            VectorRoutine = Dispatch->ReduceMinimum;
+            ColumnsRoutine = Dispatch->ReduceColumnsMinimum;
+            break;
+        default:
+            MLAS_THROW_EX(std::invalid_argument, "Unsupported reduction kind.");
+    }
+
+    const auto Partition = MlasReducePartition(OuterCount, ReduceCount, InnerCount, true, ThreadPool);
+    const bool IsMean = (ReduceKind == MlasReduceMean);
+    const float Divisor = float(ReduceCount);
+
+    MlasReduceExecute(
+        Partition, ColumnsRoutine, Output,
+        [&](size_t o, size_t n, size_t CountN, size_t r, size_t CountR, float* Destination) {
+            const float* input = Input + (o * ReduceCount + r) * InnerCount + n;
+            if (InnerCount == 1) {
+                *Destination = VectorRoutine(input, CountR);
+            } else {
+                ColumnsRoutine(input, InnerCount, CountR, Destination, CountN);
+            }
+        },
+        [&](float* Destination, size_t, size_t CountN) {
+            if (IsMean) {
+                for (size_t n = 0; n < CountN; n++) {
+                    Destination[n] /= Divisor;
+                }
+            }
+        },
+        ThreadPool);
+}
+
+void
+MLASCALL
+MlasArgReduce(
+    bool IsMaximum,
+    bool SelectLastIndex,
+    const float* Input,
+    int64_t* Output,
+    size_t OuterCount,
+    size_t ReduceCount,
+    size_t InnerCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the index of the maximum or minimum element along
+    the middle axis of a [OuterCount, ReduceCount, InnerCount] tensor.
+
+    The selection follows the sequential rule of ArgMax/ArgMin: a candidate
+    replaces the current selection only if it compares greater (less), or
+    greater (less) or equal when SelectLastIndex is set. NaN elements are
+    therefore never selected unless they are first.
+
+Arguments:
+
+    IsMaximum - Supplies true to find the maximum, else the minimum.
+
+    SelectLastIndex - Supplies true to select the last index of repeated
+        extreme values, else the first.
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the [OuterCount, InnerCount] output buffer.
+
+    OuterCount - Supplies the number of independent reductions.
+
+    ReduceCount - Supplies the number of elements to reduce.
+
+    InnerCount - Supplies the stride between the reduced elements.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t OutputCount = OuterCount * InnerCount;
+
+    if (OutputCount == 0) {
+        return;
+    }
+
+    if (ReduceCount == 0) {
+        std::fill_n(Output, OutputCount, int64_t(0));
+        return;
+    }
+
+    const MLAS_REDUCE_DISPATCH* Dispatch = GetMlasPlatform().ReduceDispatch;
+    auto* VectorRoutine = IsMaximum ? Dispatch->ArgMaximum : Dispatch->ArgMinimum;
+    auto* ColumnsRoutine = IsMaximum ? Dispatch->ArgMaximumColumns : Dispatch->ArgMinimumColumns;
+
+    const auto Partition = MlasReducePartition(OuterCount, ReduceCount, InnerCount, false, ThreadPool);
+    const size_t TaskCount = OuterCount * Partition.BlockCountN;
+
+    MlasTrySimpleParallel(ThreadPool, Partition.ThreadCount, [&](ptrdiff_t tid) {
+        size_t TaskIndex;
+        size_t TaskRemaining;
+        MlasPartitionWork(tid, Partition.ThreadCount, TaskCount, &TaskIndex, &TaskRemaining);
+
+        for (; TaskRemaining > 0; TaskIndex++, TaskRemaining--) {
+            const size_t o = TaskIndex / Partition.BlockCountN;
+            const size_t n = (TaskIndex % Partition.BlockCountN) * Partition.BlockN;
+            const size_t CountN = std::min(InnerCount - n, Partition.BlockN);
+            const float* input = Input + o * ReduceCount * InnerCount + n;
+
+            if (InnerCount == 1) {
+                Output[o] = int64_t(VectorRoutine(input, ReduceCount, SelectLastIndex));
+            } else {
+                ColumnsRoutine(input, InnerCount, ReduceCount, Output + o * InnerCount + n, CountN, SelectLastIndex);
+            }
+        }
+    });
+}
@@ -0,0 +1,548 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce.h
+
+Abstract:
+
+    This module includes the dispatch structure and the kernel templates for
+    the single precision floating point reduction routines.
+
+    The kernel templates are parameterized by a vector traits type so that
+    each instruction set builds the same algorithms at its native vector
+    width. A traits type supplies:
+
+        Vector, Mask, Width
+        Load, LoadPartial, Store, StorePartial, Broadcast, Zero
+        Add, Maximum, Minimum, GreaterThan, GreaterThanOrEqual, Blend
+        ReduceAdd, ReduceMaximum, ReduceMinimum
+
+    N.B. Every helper in this module is templated on the traits type so that
+    code built with different instruction set flags is never merged by the
+    linker.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+struct MLAS_REDUCE_DISPATCH {
+    //
+    // Reduces a contiguous vector of N (> 0) elements to a single value.
+    //
+    typedef float(ReduceVector_Fn)(
+        const float* Input,
+        size_t N
+    );
+
+    ReduceVector_Fn* ReduceSum = nullptr;
+    ReduceVector_Fn* ReduceMaximum = nullptr;
+    ReduceVector_Fn* ReduceMinimum = nullptr;
+
+    //
+    // Reduces CountN columns of a row major matrix along its CountR (> 0)
+    // rows. The output buffer is also used as the accumulator, so it should
+    // be sized to stay resident in the L1 cache.
+    //
+    typedef void(ReduceColumns_Fn)(
+        const float* Input,
+        size_t ldInput,
+        size_t CountR,
+        float* Output,
+        size_t CountN
+    );
+
+    ReduceColumns_Fn* ReduceColumnsSum = nullptr;
+    ReduceColumns_Fn* ReduceColumnsMaximum = nullptr;
+    ReduceColumns_Fn* ReduceColumnsMinimum = nullptr;
+
+    //
+    // Returns the index of the maximum or minimum element of a contiguous
+    // vector of N (> 0) elements.
+    //
+    typedef size_t(ArgReduceVector_Fn)(
+        const float* Input,
+        size_t N,
+        bool SelectLastIndex
+    );
+
+    ArgReduceVector_Fn* ArgMaximum = nullptr;
+    ArgReduceVector_Fn* ArgMinimum = nullptr;
+
+    //
+    // Computes the row index of the maximum or minimum element for CountN
+    // columns of a row major matrix with CountR (> 0) rows.
+    //
+    typedef void(ArgReduceColumns_Fn)(
+        const float* Input,
+        size_t ldInput,
+        size_t CountR,
+        int64_t* Output,
+        size_t CountN,
+        bool SelectLastIndex
+    );
+
+    ArgReduceColumns_Fn* ArgMaximumColumns = nullptr;
+    ArgReduceColumns_Fn* ArgMinimumColumns = nullptr;
+};
+
+enum class MLAS_REDUCE_OPERATION {
+    Sum,
+    Maximum,
+    Minimum,
+};
+
+template <typename Traits, MLAS_REDUCE_OPERATION Operation>
+MLAS_FORCEINLINE
+typename Traits::Vector
+MlasReduceCombine(
+    typename Traits::Vector Vector1,
+    typename Traits::Vector Vector2
+    )
+{
+    if constexpr (Operation == MLAS_REDUCE_OPERATION::Sum) {
+        return Traits::Add(Vector1, Vector2);
+    } else if constexpr (Operation == MLAS_REDUCE_OPERATION::Maximum) {
+        return Traits::Maximum(Vector1, Vector2);
+    } else {
+        return Traits::Minimum(Vector1, Vector2);
+    }
+}
+
+template <typename Traits, MLAS_REDUCE_OPERATION Operation>
+MLAS_FORCEINLINE
+float
+MlasReduceCombineScalar(
+    float Value1,
+    float Value2
+    )
+{
+    if constexpr (Operation == MLAS_REDUCE_OPERATION::Sum) {
+        return Value1 + Value2;
+    } else if constexpr (Operation == MLAS_REDUCE_OPERATION::Maximum) {
+        return (Value2 > Value1) ? Value2 : Value1;
+    } else {
+        return (Value2 < Value1) ? Value2 : Value1;
+    }
+}
+
+template <typename Traits, MLAS_REDUCE_OPERATION Operation>
+MLAS_FORCEINLINE
+float
+MlasReduceHorizontal(
+    typename Traits::Vector Vector
+    )
+{
+    if constexpr (Operation == MLAS_REDUCE_OPERATION::Sum) {
+        return Traits::ReduceAdd(Vector);
+    } else if constexpr (Operation == MLAS_REDUCE_OPERATION::Maximum) {
+        return Traits::ReduceMaximum(Vector);
+    } else {
+        return Traits::ReduceMinimum(Vector);
+    }
+}
+
+template <typename Traits, MLAS_REDUCE_OPERATION Operation>
+float
+MLASCALL
+MlasReduceVectorKernel(
+    const float* Input,
+    size_t N
+    )
+{
+    using Vector = typename Traits::Vector;
+    constexpr size_t Width = Traits::Width;
+
+    if (N < Width) {
+        float Value = (Operation == MLAS_REDUCE_OPERATION::Sum) ? 0.0f : Input[0];
+        for (size_t n = 0; n < N; n++) {
+            Value = MlasReduceCombineScalar<Traits, Operation>(Value, Input[n]);
+        }
+        return Value;
+    }
+
+    const float* InputEnd = Input + N;
+
+    Vector Accumulator0 = Traits::Load(Input);
+    Input += Width;
+    N -= Width;
+
+    if (N >= 4 * Width) {
+        //
+        // Use independent accumulators to hide the latency of the combining
+        // instruction.
+        //
+
+        Vector Accumulator1 = (Operation == MLAS_REDUCE_OPERATION::Sum) ? Traits::Zero() : Accumulator0;
+        Vector Accumulator2 = Accumulator1;
+        Vector Accumulator3 = Accumulator1;
+
+        while (N >= 4 * Width) {
+            Accumulator0 = MlasReduceCombine<Traits, Operation>(Accumulator0, Traits::Load(Input));
+            Accumulator1 = MlasReduceCombine<Traits, Operation>(Accumulator1, Traits::Load(Input + Width));
+            Accumulator2 = MlasReduceCombine<Traits, Operation>(Accumulator2, Traits::Load(Input + 2 * Width));
+            Accumulator3 = MlasReduceCombine<Traits, Operation>(Accumulator3, Traits::Load(Input + 3 * Width));
+
+            Input += 4 * Width;
+            N -= 4 * Width;
+        }
+
+        Accumulator0 = MlasReduceCombine<Traits, Operation>(Accumulator0, Accumulator1);
+        Accumulator2 = MlasReduceCombine<Traits, Operation>(Accumulator2, Accumulator3);
+        Accumulator0 = MlasReduceCombine<Traits, Operation>(Accumulator0, Accumulator2);
+    }
+
+    while (N >= Width) {
+        Accumulator0 = MlasReduceCombine<Traits, Operation>(Accumulator0, Traits::Load(Input));
+
+        Input += Width;
+        N -= Width;
+    }
+
+    if (N > 0) {
+        if constexpr (Operation == MLAS_REDUCE_OPERATION::Sum) {
+            Accumulator0 = Traits::Add(Accumulator0, Traits::LoadPartial(Input, N));
+        } else {
+            //
+            // The maximum and minimum are idempotent, so reload the last full
+            // vector instead of masking the remaining elements.
+            //
+            Accumulator0 = MlasReduceCombine<Traits, Operation>(Accumulator0, Traits::Load(InputEnd - Width));
+        }
+    }
+
+    return MlasReduceHorizontal<Traits, Operation>(Accumulator0);
+}
+
+template <typename Traits, MLAS_REDUCE_OPERATION Operation>
+void
+MLASCALL
+MlasReduceColumnsKernel(
+    const float* Input,
+    size_t ldInput,
+    size_t CountR,
+    float* Output,
+    size_t CountN
+    )
+{
+    using Vector = typename Traits::Vector;
+    constexpr size_t Width = Traits::Width;
+
+    for (size_t n = 0; n < CountN; n++) {
+        Output[n] = Input[n];
+    }
+
+    Input += ldInput;
+    CountR -= 1;
+
+    //
+    // Fold four rows into the output per pass so that the accumulator is read
+    // and written once for every four input vectors while the input rows are
+    // streamed sequentially.
+    //
+
+    while (CountR >= 4) {
+        const float* Input0 = Input;
+        const float* Input1 = Input0 + ldInput;
+        const float* Input2 = Input1 + ldInput;
+        const float* Input3 = Input2 + ldInput;
+
+        size_t n = 0;
+
+        for (; n + Width <= CountN; n += Width) {
+            Vector Vector01 = MlasReduceCombine<Traits, Operation>(Traits::Load(Input0 + n), Traits::Load(Input1 + n));
+            Vector Vector23 = MlasReduceCombine<Traits, Operation>(Traits::Load(Input2 + n), Traits::Load(Input3 + n));
+            Vector Accumulator = MlasReduceCombine<Traits, Operation>(Vector01, Vector23);
+            Traits::Store(Output + n, MlasReduceCombine<Traits, Operation>(Traits::Load(Output + n), Accumulator));
+        }
+
+        if (n < CountN) {
+            const size_t Remaining = CountN - n;
+            Vector Vector01 = MlasReduceCombine<Traits, Operation>(
+                Traits::LoadPartial(Input0 + n, Remaining), Traits::LoadPartial(Input1 + n, Remaining));
+            Vector Vector23 = MlasReduceCombine<Traits, Operation>(
+                Traits::LoadPartial(Input2 + n, Remaining), Traits::LoadPartial(Input3 + n, Remaining));
+            Vector Accumulator = MlasReduceCombine<Traits, Operation>(Vector01, Vector23);
+            Accumulator = MlasReduceCombine<Traits, Operation>(Traits::LoadPartial(Output + n, Remaining), Accumulator);
+            Traits::StorePartial(Output + n, Accumulator, Remaining);
+        }
+
+        Input += 4 * ldInput;
+        CountR -= 4;
+    }
+
+    while (CountR > 0) {
+        size_t n = 0;
+
+        for (; n + Width <= CountN; n += Width) {
+            Traits::Store(Output + n, MlasReduceCombine<Traits, Operation>(Traits::Load(Output + n), Traits::Load(Input + n)));
+        }
+
+        if (n < CountN) {
+            const size_t Remaining = CountN - n;
+            Vector Accumulator = MlasReduceCombine<Traits, Operation>(
+                Traits::LoadPartial(Output + n, Remaining), Traits::LoadPartial(Input + n, Remaining));
+            Traits::StorePartial(Output + n, Accumulator, Remaining);
+        }
+
+        Input += ldInput;
+        CountR -= 1;
+    }
+}
+
+template <typename Traits, bool IsMaximum, bool SelectLastIndex>
+MLAS_FORCEINLINE
+bool
+MlasArgReduceCompare(
+    float Value,
+    float Candidate
+    )
+{
+    //
+    // Matches the sequential update rule: NaN never replaces the current
+    // selection and a NaN selection is never replaced.
+    //
+    if constexpr (IsMaximum) {
+        return SelectLastIndex ? (Candidate >= Value) : (Candidate > Value);
+    } else {
+        return SelectLastIndex ? (Candidate <= Value) : (Candidate < Value);
+    }
+}
+
+template <typename Traits, bool IsMaximum, bool SelectLastIndex>
+size_t
+MlasArgReduceVectorKernelScalar(
+    const float* Input,
+    size_t N
+    )
+{
+    float Value = Input[0];
+    size_t Index = 0;
+
+    for (size_t n = 1; n < N; n++) {
+        if (MlasArgReduceCompare<Traits, IsMaximum, SelectLastIndex>(Value, Input[n])) {
+            Value = Input[n];
+            Index = n;
+        }
+    }
+
+    return Index;
+}
+
+template <typename Traits, bool IsMaximum, bool SelectLastIndex>
+size_t
+MlasArgReduceVectorKernelImpl(
+    const float* Input,
+    size_t N
+    )
+{
+    using Vector = typename Traits::Vector;
+    constexpr size_t Width = Traits::Width;
+
+    const float First = Input[0];
+
+    if (std::isnan(First)) {
+        return 0;
+    }
+
+    //
+    // Find the extreme value with the candidate as the first operand so that
+    // instructions that return the second operand for unordered inputs skip
+    // NaN elements. The accumulators start from a non-NaN value.
+    //
+
+    float Value = First;
+    size_t n = 0;
+
+    if (N >= 4 * Width) {
+        Vector Accumulator0 = Traits::Broadcast(First);
+        Vector Accumulator1 = Accumulator0;
+        Vector Accumulator2 = Accumulator0;
+        Vector Accumulator3 = Accumulator0;
+
+        for (; n + 4 * Width <= N; n += 4 * Width) {
+            if constexpr (IsMaximum) {
+                Accumulator0 = Traits::Maximum(Traits::Load(Input + n), Accumulator0);
+                Accumulator1 = Traits::Maximum(Traits::Load(Input + n + Width), Accumulator1);
+                Accumulator2 = Traits::Maximum(Traits::Load(Input + n + 2 * Width), Accumulator2);
+                Accumulator3 = Traits::Maximum(Traits::Load(Input + n + 3 * Width), Accumulator3);
+            } else {
+                Accumulator0 = Traits::Minimum(Traits::Load(Input + n), Accumulator0);
+                Accumulator1 = Traits::Minimum(Traits::Load(Input + n + Width), Accumulator1);
+                Accumulator2 = Traits::Minimum(Traits::Load(Input + n + 2 * Width), Accumulator2);
+                Accumulator3 = Traits::Minimum(Traits::Load(Input + n + 3 * Width), Accumulator3);
+            }
+        }
+
+        if constexpr (IsMaximum) {
+            Accumulator0 = Traits::Maximum(Accumulator0, Accumulator1);
+            Accumulator2 = Traits::Maximum(Accumulator2, Accumulator3);
+            Value = Traits::ReduceMaximum(Traits::Maximum(Accumulator0, Accumulator2));
+        } else {
+            Accumulator0 = Traits::Minimum(Accumulator0, Accumulator1);
+            Accumulator2 = Traits::Minimum(Accumulator2, Accumulator3);
+            Value = Traits::ReduceMinimum(Traits::Minimum(Accumulator0, Accumulator2));
+        }
+    }
+
+    for (; n < N; n++) {
+        if (IsMaximum ? (Input[n] > Value) : (Input[n] < Value)) {
+            Value = Input[n];
+        }
+    }
+
+    //
+    // Locate the first or last occurrence of the extreme value.
+    //
+
+    if constexpr (SelectLastIndex) {
+        for (size_t i = N; i > 0; i--) {
+            if (Input[i - 1] == Value) {
+                return i - 1;
+            }
+        }
+    } else {
+        for (size_t i = 0; i < N; i++) {
+            if (Input[i] == Value) {
+                return i;
+            }
+        }
+    }
+
+    //
+    // The vector instructions propagated a NaN on this platform, so fall back
+    // to the sequential rule.
+    //
+
+    return MlasArgReduceVectorKernelScalar<Traits, IsMaximum, SelectLastIndex>(Input, N);
+}
+
+template <typename Traits, bool IsMaximum>
+size_t
+MLASCALL
+MlasArgReduceVectorKernel(
+    const float* Input,
+    size_t N,
+    bool SelectLastIndex
+    )
+{
+    if (SelectLastIndex) {
+        return MlasArgReduceVectorKernelImpl<Traits, IsMaximum, true>(Input, N);
+    } else {
+        return MlasArgReduceVectorKernelImpl<Traits, IsMaximum, false>(Input, N);
+    }
+}
+
+template <typename Traits, bool IsMaximum, bool SelectLastIndex>
+void
+MlasArgReduceColumnsKernelImpl(
+    const float* Input,
+    size_t ldInput,
+    size_t CountR,
+    int64_t* Output,
+    size_t CountN
+    )
+{
+    using Vector = typename Traits::Vector;
+    using Mask = typename Traits::Mask;
+    constexpr size_t Width = Traits::Width;
+
+    //
+    // Row indices are tracked as floating point values, which are exact up to
+    // 2^24. Taller matrices use the sequential rule.
+    //
+
+    if (CountR > (size_t(1) << 24)) {
+        for (size_t n = 0; n < CountN; n++) {
+            float Value = Input[n];
+            int64_t Index = 0;
+            for (size_t r = 1; r < CountR; r++) {
+                const float Candidate = Input[r * ldInput + n];
+                if (MlasArgReduceCompare<Traits, IsMaximum, SelectLastIndex>(Value, Candidate)) {
+                    Value = Candidate;
+                    Index = int64_t(r);
+                }
+            }
+            Output[n] = Index;
+        }
+        return;
+    }
+
+    for (size_t n = 0; n < CountN; n += Width) {
+        const size_t Count = std::min(Width, CountN - n);
+        const float* input = Input + n;
+
+        Vector Value = (Count == Width) ? Traits::Load(input) : Traits::LoadPartial(input, Count);
+        Vector Index = Traits::Zero();
+
+        for (size_t r = 1; r < CountR; r++) {
+            input += ldInput;
+
+            Vector Candidate = (Count == Width) ? Traits::Load(input) : Traits::LoadPartial(input, Count);
+            Mask Selection;
+
+            if constexpr (IsMaximum) {
+                Selection = SelectLastIndex ? Traits::GreaterThanOrEqual(Candidate, Value) : Traits::GreaterThan(Candidate, Value);
+            } else {
+                Selection = SelectLastIndex ? Traits::GreaterThanOrEqual(Value, Candidate) : Traits::GreaterThan(Value, Candidate);
+            }
+
+            Value = Traits::Blend(Value, Candidate, Selection);
+            Index = Traits::Blend(Index, Traits::Broadcast(float(r)), Selection);
+        }
+
+        float Indices[Width];
+        Traits::Store(Indices, Index);
+
+        for (size_t i = 0; i < Count; i++) {
+            Output[n + i] = int64_t(Indices[i]);
+        }
+    }
+}
+
+template <typename Traits, bool IsMaximum>
+void
+MLASCALL
+MlasArgReduceColumnsKernel(
+    const float* Input,
+    size_t ldInput,
+    size_t CountR,
+    int64_t* Output,
+    size_t CountN,
+    bool SelectLastIndex
+    )
+{
+    if (SelectLastIndex) {
+        MlasArgReduceColumnsKernelImpl<Traits, IsMaximum, true>(Input, ldInput, CountR, Output, CountN);
+    } else {
+        MlasArgReduceColumnsKernelImpl<Traits, IsMaximum, false>(Input, ldInput, CountR, Output, CountN);
+    }
+}
+
+//
+// Builds the dispatch structure for a vector traits type.
+//
+
+template <typename Traits>
+MLAS_REDUCE_DISPATCH
+MlasReduceMakeDispatch()
+{
+    MLAS_REDUCE_DISPATCH d;
+    d.ReduceSum = MlasReduceVectorKernel<Traits, MLAS_REDUCE_OPERATION::Sum>;
+    d.ReduceMaximum = MlasReduceVectorKernel<Traits, MLAS_REDUCE_OPERATION::Maximum>;
+    d.ReduceMinimum = MlasReduceVectorKernel<Traits, MLAS_REDUCE_OPERATION::Minimum>;
+    d.ReduceColumnsSum = MlasReduceColumnsKernel<Traits, MLAS_REDUCE_OPERATION::Sum>;
+    d.ReduceColumnsMaximum = MlasReduceColumnsKernel<Traits, MLAS_REDUCE_OPERATION::Maximum>;
+    d.ReduceColumnsMinimum = MlasReduceColumnsKernel<Traits, MLAS_REDUCE_OPERATION::Minimum>;
+    d.ArgMaximum = MlasArgReduceVectorKernel<Traits, true>;
+    d.ArgMinimum = MlasArgReduceVectorKernel<Traits, false>;
+    d.ArgMaximumColumns = MlasArgReduceColumnsKernel<Traits, true>;
+    d.ArgMinimumColumns = MlasArgReduceColumnsKernel<Traits, false>;
+    return d;
+}
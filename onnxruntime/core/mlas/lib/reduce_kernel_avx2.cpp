@@ -0,0 +1,78 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the single precision floating point reduction
+    kernels for AVX2 supported h/w.
+
+--*/
+
+#include "reduce.h"
+
+namespace reduce_avx2 {
+
+struct Traits {
+    typedef __m256 Vector;
+    typedef __m256 Mask;
+
+    static constexpr size_t Width = 8;
+
+    static MLAS_FORCEINLINE __m256i PartialMask(size_t N)
+    {
+        return _mm256_cmpgt_epi32(_mm256_set1_epi32(int(N)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    }
+
+    static MLAS_FORCEINLINE Vector Load(const float* Input) { return _mm256_loadu_ps(Input); }
+    static MLAS_FORCEINLINE Vector LoadPartial(const float* Input, size_t N) { return _mm256_maskload_ps(Input, PartialMask(N)); }
+    static MLAS_FORCEINLINE void Store(float* Output, Vector V) { _mm256_storeu_ps(Output, V); }
+    static MLAS_FORCEINLINE void StorePartial(float* Output, Vector V, size_t N) { _mm256_maskstore_ps(Output, PartialMask(N), V); }
+    static MLAS_FORCEINLINE Vector Broadcast(float Value) { return _mm256_set1_ps(Value); }
+    static MLAS_FORCEINLINE Vector Zero() { return _mm256_setzero_ps(); }
+    static MLAS_FORCEINLINE Vector Add(Vector V1, Vector V2) { return _mm256_add_ps(V1, V2); }
+    static MLAS_FORCEINLINE Vector Maximum(Vector V1, Vector V2) { return _mm256_max_ps(V1, V2); }
+    static MLAS_FORCEINLINE Vector Minimum(Vector V1, Vector V2) { return _mm256_min_ps(V1, V2); }
+    static MLAS_FORCEINLINE Mask GreaterThan(Vector V1, Vector V2) { return _mm256_cmp_ps(V1, V2, _CMP_GT_OQ); }
+    static MLAS_FORCEINLINE Mask GreaterThanOrEqual(Vector V1, Vector V2) { return _mm256_cmp_ps(V1, V2, _CMP_GE_OQ); }
+    static MLAS_FORCEINLINE Vector Blend(Vector V1, Vector V2, Mask Selection) { return _mm256_blendv_ps(V1, V2, Selection); }
+
+    static MLAS_FORCEINLINE float ReduceAdd(Vector V)
+    {
+        __m128 v = _mm_add_ps(_mm256_castps256_ps128(V), _mm256_extractf128_ps(V, 1));
+        v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        v = _mm_add_ss(v, _mm_movehdup_ps(v));
+        return _mm_cvtss_f32(v);
+    }
+
+    static MLAS_FORCEINLINE float ReduceMaximum(Vector V)
+    {
+        __m128 v = _mm_max_ps(_mm256_castps256_ps128(V), _mm256_extractf128_ps(V, 1));
+        v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+        v = _mm_max_ss(v, _mm_movehdup_ps(v));
+        return _mm_cvtss_f32(v);
+    }
+
+    static MLAS_FORCEINLINE float ReduceMinimum(Vector V)
+    {
+        __m128 v = _mm_min_ps(_mm256_castps256_ps128(V), _mm256_extractf128_ps(V, 1));
+        v = _mm_min_ps(v, _mm_movehl_ps(v, v));
+        v = _mm_min_ss(v, _mm_movehdup_ps(v));
+        return _mm_cvtss_f32(v);
+    }
+};
+
+}  // namespace reduce_avx2
+
+//
+// Kernel dispatch structure definition.
+//
+const MLAS_REDUCE_DISPATCH MlasReduceDispatchAvx2 = []() {
+    return MlasReduceMakeDispatch<reduce_avx2::Traits>();
+}();
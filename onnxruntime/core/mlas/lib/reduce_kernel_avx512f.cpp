@@ -0,0 +1,54 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce_kernel_avx512f.cpp
+
+Abstract:
+
+    This module implements the single precision floating point reduction
+    kernels for AVX512F supported h/w.
+
+--*/
+
+#include "reduce.h"
+
+namespace reduce_avx512f {
+
+struct Traits {
+    typedef __m512 Vector;
+    typedef __mmask16 Mask;
+
+    static constexpr size_t Width = 16;
+
+    static MLAS_FORCEINLINE __mmask16 PartialMask(size_t N) { return __mmask16((1u << N) - 1); }
+
+    static MLAS_FORCEINLINE Vector Load(const float* Input) { return _mm512_loadu_ps(Input); }
+    static MLAS_FORCEINLINE Vector LoadPartial(const float* Input, size_t N) { return _mm512_maskz_loadu_ps(PartialMask(N), Input); }
+    static MLAS_FORCEINLINE void Store(float* Output, Vector V) { _mm512_storeu_ps(Output, V); }
+    static MLAS_FORCEINLINE void StorePartial(float* Output, Vector V, size_t N) { _mm512_mask_storeu_ps(Output, PartialMask(N), V); }
+    static MLAS_FORCEINLINE Vector Broadcast(float Value) { return _mm512_set1_ps(Value); }
+    static MLAS_FORCEINLINE Vector Zero() { return _mm512_setzero_ps(); }
+    static MLAS_FORCEINLINE Vector Add(Vector V1, Vector V2) { return _mm512_add_ps(V1, V2); }
+    static MLAS_FORCEINLINE Vector Maximum(Vector V1, Vector V2) { return _mm512_max_ps(V1, V2); }
+    static MLAS_FORCEINLINE Vector Minimum(Vector V1, Vector V2) { return _mm512_min_ps(V1, V2); }
+    static MLAS_FORCEINLINE Mask GreaterThan(Vector V1, Vector V2) { return _mm512_cmp_ps_mask(V1, V2, _CMP_GT_OQ); }
+    static MLAS_FORCEINLINE Mask GreaterThanOrEqual(Vector V1, Vector V2) { return _mm512_cmp_ps_mask(V1, V2, _CMP_GE_OQ); }
+    static MLAS_FORCEINLINE Vector Blend(Vector V1, Vector V2, Mask Selection) { return _mm512_mask_blend_ps(Selection, V1, V2); }
+    static MLAS_FORCEINLINE float ReduceAdd(Vector V) { return _mm512_reduce_add_ps(V); }
+    static MLAS_FORCEINLINE float ReduceMaximum(Vector V) { return _mm512_reduce_max_ps(V); }
+    static MLAS_FORCEINLINE float ReduceMinimum(Vector V) { return _mm512_reduce_min_ps(V); }
+};
+
+}  // namespace reduce_avx512f
+
+//
+// Kernel dispatch structure definition.
+//
+const MLAS_REDUCE_DISPATCH MlasReduceDispatchAvx512F = []() {
+    return MlasReduceMakeDispatch<reduce_avx512f::Traits>();
+}();
@@ -30,8 +30,6 @@ Abstract:
         MLAS_SBGEMM_STRIDES Strides{128, 128, 256};
 --*/
 
-#if defined(__aarch64__) && defined(__linux__)
-
 #pragma once
 
 #include <cassert>
@@ -39,6 +37,45 @@ Abstract:
 
 #include "mlasi.h"
 
+#if defined(MLAS_SBGEMM_SUPPORTED)
+
+#if defined(MLAS_TARGET_AMD64)
+//
+// The x86 kernels treat bfloat16 values as raw 16-bit patterns.
+//
+typedef uint16_t bfloat16_t;
+
+//
+// Routines shared by the AVX512BF16 and AMX kernels. Matrix B is packed into
+// column panels of 16 columns where each row of a panel holds the interleaved
+// values of two consecutive K rows, matching the AMX-BF16 tile layout.
+//
+void
+MlasSBGemmConvertPackBAvx512Bf16(
+    bfloat16_t* D, const float* B, size_t ldb, size_t CountN, size_t CountK, size_t PackedK
+);
+
+void
+MlasSBGemmConvertAAvx512Bf16(
+    bfloat16_t* D, size_t ldd, const float* A, size_t lda, size_t CountM, size_t CountK, size_t AlignedK
+);
+
+void
+MlasSBGemmKernelAvx512Bf16(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    const float* A,
+    size_t lda,
+    const bfloat16_t* B,
+    size_t PackedK,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    bool ZeroMode
+);
+#endif
+
 /**
  * @brief Define the default striding parameters for
  *        the bfloat16 precision gemm operation
@@ -134,7 +171,12 @@ MlasSBGemmPackedOperation(size_t M, size_t RangeStartN, size_t RangeCountN, size
             bool ZeroMode = (k == 0);
             CountK = std::min(K - k, PackedStrideK);
 
-            const bfloat16_t* pb = (const bfloat16_t*)PackedB + AlignedN * k + CountK * SliceStartN;
+            //
+            // Each column panel of the packed buffer is padded to a multiple
+            // of PackedK along the K dimension.
+            //
+            const size_t AlignedCountK = (CountK + KernelType::PackedK - 1) & ~(KernelType::PackedK - 1);
+            const bfloat16_t* pb = (const bfloat16_t*)PackedB + AlignedN * k + AlignedCountK * SliceStartN;
             float* c = C + n;
             const float* pbias = ((nullptr == Bias) ? nullptr : Bias + RangeStartN + n);
             MlasSBGemmKernel<KernelType>(M, CountN, CountK, A + k, lda, pb, c, ldc, ZeroMode ? pbias : nullptr, ZeroMode);
@@ -173,7 +215,15 @@ MlasSBGemmNonPackedOperation(size_t M, size_t N, size_t K, const float* A, size_
         }
     }
 
-    constexpr size_t packBSize = UpAlignSize(Strides.N * Strides.K * sizeof(bfloat16_t));
+    //
+    // The packing routine pads each column panel to PackedN columns and each
+    // block of Strides.K rows to PackedK rows, so size the local buffer from
+    // the aligned strides.
+    //
+    static_assert((Strides.K & (KernelType::PackedK - 1)) == 0, "K stride must be a multiple of PackedK");
+    const size_t AlignedStrideN = (StrideN + KernelType::PackedN - 1) & ~(KernelType::PackedN - 1);
+    const size_t AlignedStrideK = (StrideK + KernelType::PackedK - 1) & ~(KernelType::PackedK - 1);
+    const size_t packBSize = UpAlignSize(AlignedStrideN * AlignedStrideK * sizeof(bfloat16_t));
     MlasThreadedBufAlloc(packBSize);
     uint8_t* p = ThreadedBufHolder.get();
     auto* PanelB = reinterpret_cast<bfloat16_t*>(p);
@@ -184,9 +234,10 @@ MlasSBGemmNonPackedOperation(size_t M, size_t N, size_t K, const float* A, size_
     size_t CountN;
     for (size_t n = 0; n < N; n += CountN) {
         CountN = std::min(N - n, StrideN);
+        const size_t AlignedCountN = (CountN + KernelType::PackedN - 1) & ~(KernelType::PackedN - 1);
 
         //
-        // Step through each slice of matrix B along the N dimension.
+        // Step through each slice of matrix B along the K dimension.
         //
         size_t CountK;
         for (size_t k = 0; k < K; k += CountK) {
@@ -201,8 +252,16 @@ MlasSBGemmNonPackedOperation(size_t M, size_t N, size_t K, const float* A, size_
             const float* pbias =
                 ((nullptr == Bias) ? nullptr : Bias + n);  // TODO: check the SliceNStart
 
-            bool ZeroMode = (k == 0);
-            MlasSBGemmKernel<KernelType>(M, CountN, CountK, A + k, lda, PanelB, c, ldc, ZeroMode ? pbias : nullptr, ZeroMode);
+            //
+            // The packing routine lays out the panel in blocks of Strides.K
+            // rows, so an expanded K stride is consumed one block at a time.
+            //
+            size_t BlockK;
+            for (size_t kk = 0; kk < CountK; kk += BlockK) {
+                BlockK = std::min(CountK - kk, Strides.K);
+                bool ZeroMode = (k + kk == 0);
+                MlasSBGemmKernel<KernelType>(M, CountN, BlockK, A + k + kk, lda, PanelB + AlignedCountN * kk, c, ldc, ZeroMode ? pbias : nullptr, ZeroMode);
+            }
         }
         if (PostProcessor != nullptr) {
             ((MLAS_SBGEMM_POSTPROCESSOR*)PostProcessor)->Process(C + n, M, N, M, CountN, ldc);
@@ -283,117 +342,11 @@ struct MLAS_SBGEMM_DISPATCH {
     size_t BufOverRead;
 };
 
-extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchNeon;
-
 MLAS_FORCEINLINE
 const MLAS_SBGEMM_DISPATCH*
 MlasSBGemmGetDispatch()
 {
-#if defined(MLAS_TARGET_ARM64)
-    return &MlasSBGemmDispatchNeon;
-#else
-    std::cerr << "SBGemm Kernel is supported only on ARM64 platform.";
-    exit(1);
-#endif
-}
-
-size_t MLASCALL
-MlasSBGemmPackBSize(size_t N, size_t K)
-{
-    //
-    // Compute the number of bytes required to hold the packed buffer.
-    //
-    const auto* dispatch = MlasSBGemmGetDispatch();
-    if (dispatch == nullptr) return 0;
-
-    const auto padding = dispatch->BufOverRead;
-    const auto PackedK = dispatch->PackedK;
-    const auto PackedN = dispatch->PackedN;
-
-    const size_t AlignedK = (K + PackedK - 1) & ~(PackedK - 1);
-    const size_t AlignedN = (N + PackedN - 1) & ~(PackedN - 1);
-    const size_t BytesRequired = AlignedN * AlignedK * sizeof(bfloat16_t) + padding;
-    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
-    const size_t AlignedBytesRequired =
-        (BytesRequired + BufferAlignment - 1) & ~(BufferAlignment - 1);
-
-    return AlignedBytesRequired;
-}
-
-void MLASCALL
-MlasSBGemmConvertPackB(size_t N, size_t K, const float* B, size_t ldb, void* PackedB)
-{
-    const auto* dispatch = MlasSBGemmGetDispatch();
-    if (dispatch == nullptr) return;
-
-    dispatch->ConvertPackBRoutine((bfloat16_t*)PackedB, B, ldb, N, K);
+    return GetMlasPlatform().SBGemmDispatch;
 }
 
-void MLASCALL
-MlasSBGemmBatch(const size_t M, const size_t N, const size_t K, const size_t BatchN, const MLAS_SBGEMM_DATA_PARAMS* Data, MLAS_THREADPOOL* ThreadPool)
-{
-    const MLAS_SBGEMM_DISPATCH* dispatch = MlasSBGemmGetDispatch();
-    if (dispatch == nullptr) return;
-
-    MLAS_SBGEMM_OPERATION* operation = dispatch->Operation;
-
-    //
-    // Compute the number of target threads given the complexity of the SGEMM
-    // operation. Small requests should run using the single threaded path.
-    //
-
-    const double Complexity = double(M) * double(N) * double(K);
-
-    ptrdiff_t TargetThreadCount;
-
-    if (Complexity < double(MLAS_SBGEMM_THREAD_COMPLEXITY * GetMlasPlatform().MaximumThreadCount)) {
-        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
-    } else {
-        TargetThreadCount = GetMlasPlatform().MaximumThreadCount;
-    }
-
-    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
-
-    if (TargetThreadCount >= MaximumThreadCount) {
-        TargetThreadCount = MaximumThreadCount;
-    }
-
-    //
-    // Segment the operation across multiple threads.
-    //
-    // N.B. Currently, the operation is segmented as a 1D partition, which
-    // works okay for operations involving skinny matrices.
-    //
-    ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchN - 1) / BatchN;
-    ptrdiff_t ThreadCountM;
-    ptrdiff_t ThreadCountN;
-
-    if (N > M) {
-        const size_t BlockedN =
-            (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) / MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
-
-        if (size_t(ThreadsPerGemm) > BlockedN) {
-            ThreadsPerGemm = ptrdiff_t(BlockedN);
-        }
-
-        ThreadCountM = 1;
-        ThreadCountN = ThreadsPerGemm;
-
-    } else {
-        if (size_t(ThreadsPerGemm) > M) {
-            ThreadsPerGemm = ptrdiff_t(M);
-        }
-
-        ThreadCountM = ThreadsPerGemm;
-        ThreadCountN = 1;
-    }
-
-    MlasTrySimpleParallel(
-        ThreadPool, ThreadsPerGemm * static_cast<ptrdiff_t>(BatchN), [=](ptrdiff_t tid) {
-            ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
-            ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
-            operation(ThreadCountM, ThreadCountN, M, N, K, &(Data[GemmIdx]), ThreadIdx);
-        }
-    );
-}
-#endif  // defined(__aarch64__) && defined(__linux__)
+#endif  // defined(MLAS_SBGEMM_SUPPORTED)
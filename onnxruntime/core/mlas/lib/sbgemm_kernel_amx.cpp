@@ -0,0 +1,373 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_amx.cpp
+
+Abstract:
+
+    This module implements bfloat16 precision GEMM kernels for processors
+    supporting the AMX-BF16 instruction set extension.
+
+--*/
+
+#include "mlasi.h"
+#include "sbgemm.h"
+#include "amx_common.h"
+
+#if defined(MLAS_SBGEMM_SUPPORTED) && defined(MLAS_TARGET_AMD64)
+
+#include <immintrin.h>
+
+#define TMM0 0
+#define TMM1 1
+#define TMM2 2
+#define TMM3 3
+#define TMM4 4
+#define TMM5 5
+#define TMM6 6
+#define TMM7 7
+
+#define TILE_M 16
+#define TILE_N 16
+#define TILE_K 32
+
+struct MLAS_SBGEMM_KERNEL_AMX {
+    static constexpr bool PackNeeded = true;
+    static constexpr size_t KernelMaxM = 2 * TILE_M;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = TILE_K;
+    static constexpr size_t PackedN = MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+    static constexpr MLAS_SBGEMM_STRIDES Strides{128, 128, 256};  // M:N:K
+};
+
+static_assert(MLAS_SBGEMM_KERNEL_AMX::PackedN == TILE_N, "packed panels must match the tile width");
+
+//
+// Number of K values converted from matrix A per pass through the kernel.
+//
+constexpr size_t MLAS_SBGEMM_AMX_KCHUNK = 256;
+
+//
+// The tile instructions are emitted as inline assembly that does not describe
+// its memory operands, so fence the compiler around buffers shared with the
+// tile registers.
+//
+MLAS_FORCEINLINE
+void
+MlasSBGemmAmxCompilerBarrier()
+{
+    __asm__ volatile("" ::: "memory");
+}
+
+MLAS_FORCEINLINE
+void
+MlasSBGemmAmxThreadInit()
+{
+    static thread_local struct tileconfig_t tc = {0};
+    struct tileconfig_t current_tc = {0};
+
+    if (tc.palette_id == 0) {
+        tc.palette_id = 1;
+        for (int t = 0; t < 8; t++) {
+            tc.rows[t] = TILE_M;
+            tc.colb[t] = 64;
+        }
+    }
+
+    tile_storeconfig(&current_tc);
+    MlasSBGemmAmxCompilerBarrier();
+
+    if (std::memcmp(&current_tc, &tc, sizeof(tc)) != 0) {
+        tile_loadconfig(&tc);
+    }
+}
+
+/**
+ * @brief Prepare the initial value of an accumulator tile.
+ *
+ * @return Address to load the tile from, or nullptr if the tile should be
+ *         zeroed. Stride receives the row stride in bytes.
+ */
+MLAS_FORCEINLINE
+const float*
+MlasSBGemmAmxPrepareAccumulator(
+    const float* C, size_t ldc, size_t CountN, const float* Bias, bool AddC, float* Temp, size_t* Stride
+)
+{
+    MlasSBGemmAmxCompilerBarrier();
+
+    if (AddC) {
+        if (CountN == TILE_N) {
+            *Stride = ldc * sizeof(float);
+            return C;
+        }
+        const __mmask16 mask = __mmask16((1u << CountN) - 1);
+        for (size_t r = 0; r < TILE_M; r++) {
+            _mm512_store_ps(Temp + r * TILE_N, _mm512_maskz_loadu_ps(mask, C + r * ldc));
+        }
+        *Stride = TILE_N * sizeof(float);
+        MlasSBGemmAmxCompilerBarrier();
+        return Temp;
+    }
+
+    if (Bias != nullptr) {
+        //
+        // Broadcast the bias row to every row of the tile with a zero stride.
+        //
+        const __mmask16 mask = __mmask16((1u << CountN) - 1);
+        _mm512_store_ps(Temp, _mm512_maskz_loadu_ps(mask, Bias));
+        *Stride = 0;
+        MlasSBGemmAmxCompilerBarrier();
+        return Temp;
+    }
+
+    return nullptr;
+}
+
+MLAS_FORCEINLINE
+void
+MlasSBGemmAmxStoreAccumulatorTail(float* C, size_t ldc, size_t CountN, const float* Temp)
+{
+    MlasSBGemmAmxCompilerBarrier();
+    const __mmask16 mask = __mmask16((1u << CountN) - 1);
+    for (size_t r = 0; r < TILE_M; r++) {
+        _mm512_mask_storeu_ps(C + r * ldc, mask, _mm512_load_ps(Temp + r * TILE_N));
+    }
+    MlasSBGemmAmxCompilerBarrier();
+}
+
+#define MLAS_SBGEMM_AMX_INIT_TILE(tmm, c, cols, bias)                                          \
+    {                                                                                          \
+        size_t Stride;                                                                         \
+        const float* Source = MlasSBGemmAmxPrepareAccumulator(c, ldc, cols, bias, AddC, Temp, &Stride); \
+        if (Source == nullptr) {                                                               \
+            tile_zero(tmm);                                                                    \
+        } else {                                                                               \
+            tile_loadd(tmm, Source, Stride);                                                   \
+        }                                                                                      \
+    }
+
+#define MLAS_SBGEMM_AMX_STORE_TILE(tmm, c, cols)                        \
+    {                                                                   \
+        if (cols == TILE_N) {                                           \
+            tile_stored(tmm, c, ldc * sizeof(float));                   \
+        } else {                                                        \
+            tile_stored(tmm, Temp, TILE_N * sizeof(float));             \
+            MlasSBGemmAmxStoreAccumulatorTail(c, ldc, cols, Temp);      \
+        }                                                               \
+    }
+
+/**
+ * @brief Compute a block of up to 32 rows by 32 columns with the accumulators
+ *        held in TMM4-TMM7.
+ *
+ * @tparam TwoRows  Whether the block spans two row tiles
+ * @tparam TwoCols  Whether the block spans two column tiles
+ */
+template <bool TwoRows, bool TwoCols>
+MLAS_FORCEINLINE
+void
+MlasSBGemmAmxComputeBlock(
+    const bfloat16_t* A,
+    size_t StrideA,
+    const bfloat16_t* B,
+    size_t PanelStride,
+    size_t CountK,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    const float* Bias,
+    bool AddC,
+    float* Temp
+)
+{
+    const size_t cols0 = std::min(CountN, size_t{TILE_N});
+    const size_t cols1 = CountN - cols0;
+    const float* bias1 = (Bias == nullptr) ? nullptr : Bias + TILE_N;
+    float* c1 = C + TILE_M * ldc;
+
+    MLAS_SBGEMM_AMX_INIT_TILE(TMM4, C, cols0, Bias);
+    if constexpr (TwoCols) {
+        MLAS_SBGEMM_AMX_INIT_TILE(TMM5, C + TILE_N, cols1, bias1);
+    }
+    if constexpr (TwoRows) {
+        MLAS_SBGEMM_AMX_INIT_TILE(TMM6, c1, cols0, Bias);
+        if constexpr (TwoCols) {
+            MLAS_SBGEMM_AMX_INIT_TILE(TMM7, c1 + TILE_N, cols1, bias1);
+        }
+    }
+
+    const size_t StrideABytes = StrideA * sizeof(bfloat16_t);
+    const bfloat16_t* a1 = A + TILE_M * StrideA;
+
+    for (size_t k = 0; k < CountK; k += TILE_K) {
+        tile_loadd(TMM2, A + k, StrideABytes);
+        tile_loadd(TMM0, B + k * TILE_N, 64);
+        tile_dpbf16ps(TMM4, TMM2, TMM0);
+        if constexpr (TwoCols) {
+            tile_loadd(TMM1, B + PanelStride + k * TILE_N, 64);
+            tile_dpbf16ps(TMM5, TMM2, TMM1);
+        }
+        if constexpr (TwoRows) {
+            tile_loadd(TMM3, a1 + k, StrideABytes);
+            tile_dpbf16ps(TMM6, TMM3, TMM0);
+            if constexpr (TwoCols) {
+                tile_dpbf16ps(TMM7, TMM3, TMM1);
+            }
+        }
+    }
+
+    MLAS_SBGEMM_AMX_STORE_TILE(TMM4, C, cols0);
+    if constexpr (TwoCols) {
+        MLAS_SBGEMM_AMX_STORE_TILE(TMM5, C + TILE_N, cols1);
+    }
+    if constexpr (TwoRows) {
+        MLAS_SBGEMM_AMX_STORE_TILE(TMM6, c1, cols0);
+        if constexpr (TwoCols) {
+            MLAS_SBGEMM_AMX_STORE_TILE(TMM7, c1 + TILE_N, cols1);
+        }
+    }
+}
+
+void
+MlasSBGemmKernelAmx(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    const float* A,
+    size_t lda,
+    const bfloat16_t* B,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    bool ZeroMode
+)
+/*++
+
+Routine Description:
+
+    This routine computes C (+)= A * B for a block of matrix A and a packed
+    block of matrix B. Rows are processed in multiples of the tile height and
+    the remaining rows are handled by the AVX512BF16 kernel.
+
+--*/
+{
+    constexpr size_t PackedK = MLAS_SBGEMM_KERNEL_AMX::PackedK;
+    constexpr size_t KChunk = MLAS_SBGEMM_AMX_KCHUNK;
+    constexpr size_t RowBlock = MLAS_SBGEMM_KERNEL_AMX::KernelMaxM;
+
+    const size_t AlignedK = (CountK + PackedK - 1) & ~(PackedK - 1);
+    const size_t PanelStride = AlignedK * TILE_N;
+    const size_t TileCountM = CountM & ~(TILE_M - 1);
+
+    if (TileCountM > 0) {
+        MLAS_DECLSPEC_ALIGN(bfloat16_t PanelA[RowBlock * KChunk], 64);
+        MLAS_DECLSPEC_ALIGN(float Temp[TILE_M * TILE_N], 64);
+
+        MlasSBGemmAmxThreadInit();
+
+        for (size_t k = 0; k < AlignedK; k += KChunk) {
+            const size_t ChunkK = std::min(AlignedK - k, KChunk);
+            const size_t ValidK = std::min(CountK - k, ChunkK);
+            const bool AddC = !ZeroMode || k != 0;
+            const float* bias = AddC ? nullptr : Bias;
+
+            for (size_t m = 0; m < TileCountM; m += RowBlock) {
+                const size_t rows = std::min(TileCountM - m, RowBlock);
+
+                MlasSBGemmConvertAAvx512Bf16(PanelA, KChunk, A + m * lda + k, lda, rows, ValidK, ChunkK);
+                MlasSBGemmAmxCompilerBarrier();
+
+                float* c = C + m * ldc;
+                const bfloat16_t* b = B + k * TILE_N;
+
+                for (size_t n = 0; n < CountN; n += 2 * TILE_N) {
+                    const size_t cols = std::min(CountN - n, size_t{2 * TILE_N});
+                    const float* pbias = (bias == nullptr) ? nullptr : bias + n;
+
+                    if (rows > TILE_M) {
+                        if (cols > TILE_N) {
+                            MlasSBGemmAmxComputeBlock<true, true>(PanelA, KChunk, b, PanelStride, ChunkK, c + n, ldc, cols, pbias, AddC, Temp);
+                        } else {
+                            MlasSBGemmAmxComputeBlock<true, false>(PanelA, KChunk, b, PanelStride, ChunkK, c + n, ldc, cols, pbias, AddC, Temp);
+                        }
+                    } else {
+                        if (cols > TILE_N) {
+                            MlasSBGemmAmxComputeBlock<false, true>(PanelA, KChunk, b, PanelStride, ChunkK, c + n, ldc, cols, pbias, AddC, Temp);
+                        } else {
+                            MlasSBGemmAmxComputeBlock<false, false>(PanelA, KChunk, b, PanelStride, ChunkK, c + n, ldc, cols, pbias, AddC, Temp);
+                        }
+                    }
+                    b += 2 * PanelStride;
+                }
+            }
+        }
+
+        MlasSBGemmAmxCompilerBarrier();
+    }
+
+    if (TileCountM < CountM) {
+        MlasSBGemmKernelAvx512Bf16(
+            CountM - TileCountM, CountN, CountK, A + TileCountM * lda, lda, B, PackedK,
+            C + TileCountM * ldc, ldc, Bias, ZeroMode
+        );
+    }
+}
+
+template <>
+void
+MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AMX>(
+    bfloat16_t* PackedB, const float* B, size_t ldb, size_t CountN, size_t CountK
+)
+{
+    constexpr size_t PackedK = MLAS_SBGEMM_KERNEL_AMX::PackedK;
+    constexpr size_t PackedN = MLAS_SBGEMM_KERNEL_AMX::PackedN;
+    constexpr MLAS_SBGEMM_STRIDES Strides = MLAS_SBGEMM_KERNEL_AMX::Strides;
+
+    const size_t AlignedN = (CountN + PackedN - 1) & ~(PackedN - 1);
+
+    //
+    // Step through each slice of matrix B along the K dimension.
+    //
+    size_t K_block_size;
+    for (size_t k = 0; k < CountK; k += K_block_size) {
+        K_block_size = std::min(CountK - k, Strides.K);
+        const size_t AlignedBlockK = (K_block_size + PackedK - 1) & ~(PackedK - 1);
+
+        MlasSBGemmConvertPackBAvx512Bf16(PackedB, B + k * ldb, ldb, CountN, K_block_size, PackedK);
+        PackedB += AlignedN * AlignedBlockK;
+    }
+}
+
+template <>
+MLAS_FORCEINLINE void
+MlasSBGemmKernel<MLAS_SBGEMM_KERNEL_AMX>(
+    const size_t CountM,
+    const size_t CountN,
+    const size_t CountK,
+    const float* A,
+    const size_t lda,
+    const bfloat16_t* B,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    const bool ZeroMode
+)
+{
+    MlasSBGemmKernelAmx(CountM, CountN, CountK, A, lda, B, C, ldc, Bias, ZeroMode);
+}
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAmx = {
+    MlasSBGemmOperation<MLAS_SBGEMM_KERNEL_AMX>,
+    MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AMX>,
+    MLAS_SBGEMM_KERNEL_AMX::PackedK,
+    MLAS_SBGEMM_KERNEL_AMX::PackedN,
+    MLAS_SBGEMM_KERNEL_AMX::KernelMaxM,
+    0  // kernel does not read beyond the packed buffer
+};
+
+#endif  // defined(MLAS_SBGEMM_SUPPORTED) && defined(MLAS_TARGET_AMD64)
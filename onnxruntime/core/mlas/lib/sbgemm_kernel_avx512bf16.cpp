@@ -0,0 +1,413 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_avx512bf16.cpp
+
+Abstract:
+
+    This module implements bfloat16 precision GEMM kernels for processors
+    supporting the AVX512-BF16 instruction set extension.
+
+--*/
+
+#include "mlasi.h"
+#include "sbgemm.h"
+
+#if defined(MLAS_SBGEMM_SUPPORTED) && defined(MLAS_TARGET_AMD64)
+
+#include <immintrin.h>
+
+struct MLAS_SBGEMM_KERNEL_AVX512BF16 {
+    static constexpr bool PackNeeded = true;
+    static constexpr size_t KernelMaxM = 8;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 2;
+    static constexpr size_t PackedN = MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+    static constexpr MLAS_SBGEMM_STRIDES Strides{128, 128, 256};  // M:N:K
+};
+
+//
+// Number of K values converted from matrix A per pass through the kernel.
+//
+constexpr size_t MLAS_SBGEMM_AVX512BF16_KCHUNK = 256;
+
+void
+MlasSBGemmConvertPackBAvx512Bf16(
+    bfloat16_t* D, const float* B, size_t ldb, size_t CountN, size_t CountK, size_t PackedK
+)
+/*++
+
+Routine Description:
+
+    This routine converts a block of matrix B to bfloat16 and packs it into
+    panels of 16 columns. Each 64 byte row of a panel holds the interleaved
+    values of two consecutive K rows. The K dimension is zero padded to a
+    multiple of PackedK and the N dimension is zero padded to a multiple of 16.
+
+Arguments:
+
+    D - Supplies the address of the packing buffer.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    CountN - Supplies the number of columns of matrix B to pack.
+
+    CountK - Supplies the number of rows of matrix B to pack.
+
+    PackedK - Supplies the K alignment of the packed buffer.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t AlignedK = (CountK + PackedK - 1) & ~(PackedK - 1);
+
+    //
+    // Permutation that interleaves the low and high halves of the converted
+    // vector: output pair j holds the values from rows k and k+1.
+    //
+    const __m512i InterleaveIndex = _mm512_set_epi16(
+        31, 15, 30, 14, 29, 13, 28, 12, 27, 11, 26, 10, 25, 9, 24, 8,
+        23, 7, 22, 6, 21, 5, 20, 4, 19, 3, 18, 2, 17, 1, 16, 0
+    );
+
+    for (size_t n = 0; n < CountN; n += 16) {
+        const size_t cols = std::min(CountN - n, size_t{16});
+        const __mmask16 mask = __mmask16((1u << cols) - 1);
+        const float* b = B + n;
+
+        for (size_t k = 0; k < AlignedK; k += 2) {
+            __m512 Row0 = _mm512_setzero_ps();
+            __m512 Row1 = _mm512_setzero_ps();
+            if (k < CountK) {
+                Row0 = _mm512_maskz_loadu_ps(mask, b + k * ldb);
+            }
+            if (k + 1 < CountK) {
+                Row1 = _mm512_maskz_loadu_ps(mask, b + (k + 1) * ldb);
+            }
+            __m512bh Converted = _mm512_cvtne2ps_pbh(Row1, Row0);
+            __m512i Packed = _mm512_permutexvar_epi16(InterleaveIndex, (__m512i)Converted);
+            _mm512_storeu_si512(D, Packed);
+            D += 32;
+        }
+    }
+}
+
+void
+MlasSBGemmConvertAAvx512Bf16(
+    bfloat16_t* D, size_t ldd, const float* A, size_t lda, size_t CountM, size_t CountK, size_t AlignedK
+)
+/*++
+
+Routine Description:
+
+    This routine converts a block of matrix A to bfloat16. The K dimension is
+    zero padded to AlignedK, which must be a multiple of 2.
+
+Arguments:
+
+    D - Supplies the address of the conversion buffer.
+
+    ldd - Supplies the first dimension of the conversion buffer.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    CountM - Supplies the number of rows of matrix A to convert.
+
+    CountK - Supplies the number of columns of matrix A to convert.
+
+    AlignedK - Supplies the number of columns to write to the buffer.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t m = 0; m < CountM; m++) {
+        size_t k = 0;
+        for (; k + 32 <= AlignedK; k += 32) {
+            const size_t remaining = (k < CountK) ? std::min(CountK - k, size_t{32}) : 0;
+            const __mmask16 mask0 = __mmask16((1u << std::min(remaining, size_t{16})) - 1);
+            const __mmask16 mask1 = __mmask16((1u << (remaining > 16 ? remaining - 16 : 0)) - 1);
+            __m512 Lo = _mm512_maskz_loadu_ps(mask0, A + k);
+            __m512 Hi = _mm512_maskz_loadu_ps(mask1, A + k + 16);
+            __m512bh Converted = _mm512_cvtne2ps_pbh(Hi, Lo);
+            _mm512_storeu_si512(D + k, (__m512i)Converted);
+        }
+        if (k < AlignedK) {
+            const size_t remaining = (k < CountK) ? std::min(CountK - k, size_t{32}) : 0;
+            const size_t tail = AlignedK - k;
+            const __mmask16 mask0 = __mmask16((1u << std::min(remaining, size_t{16})) - 1);
+            const __mmask16 mask1 = __mmask16((1u << (remaining > 16 ? remaining - 16 : 0)) - 1);
+            __m512 Lo = _mm512_maskz_loadu_ps(mask0, A + k);
+            __m512 Hi = _mm512_maskz_loadu_ps(mask1, A + k + 16);
+            __m512bh Converted = _mm512_cvtne2ps_pbh(Hi, Lo);
+            _mm512_mask_storeu_epi16(D + k, __mmask32((uint64_t{1} << tail) - 1), (__m512i)Converted);
+        }
+        A += lda;
+        D += ldd;
+    }
+}
+
+template <size_t RowCount, size_t PanelCount>
+MLAS_FORCEINLINE
+void
+MlasSBGemmComputeBlockAvx512Bf16(
+    const uint32_t* A,
+    size_t ldd,
+    const bfloat16_t* B,
+    size_t PanelStride,
+    size_t PairCount,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    const float* Bias,
+    bool AddC
+)
+{
+    __m512 Accumulators[RowCount][PanelCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t p = 0; p < PanelCount; p++) {
+            Accumulators[r][p] = _mm512_setzero_ps();
+        }
+    }
+
+    for (size_t kp = 0; kp < PairCount; kp++) {
+        __m512bh BElements[PanelCount];
+        for (size_t p = 0; p < PanelCount; p++) {
+            BElements[p] = (__m512bh)_mm512_loadu_si512(B + p * PanelStride + kp * 32);
+        }
+        for (size_t r = 0; r < RowCount; r++) {
+            __m512bh ABroadcast = (__m512bh)_mm512_set1_epi32(int(A[r * ldd + kp]));
+            for (size_t p = 0; p < PanelCount; p++) {
+                Accumulators[r][p] = _mm512_dpbf16_ps(Accumulators[r][p], ABroadcast, BElements[p]);
+            }
+        }
+    }
+
+    for (size_t p = 0; p < PanelCount; p++) {
+        const size_t cols = std::min(CountN - p * 16, size_t{16});
+        const __mmask16 mask = __mmask16((1u << cols) - 1);
+
+        __m512 BiasElements = _mm512_setzero_ps();
+        if (Bias != nullptr) {
+            BiasElements = _mm512_maskz_loadu_ps(mask, Bias + p * 16);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            float* c = C + r * ldc + p * 16;
+            __m512 Result = _mm512_add_ps(Accumulators[r][p], BiasElements);
+            if (AddC) {
+                Result = _mm512_add_ps(Result, _mm512_maskz_loadu_ps(mask, c));
+            }
+            _mm512_mask_storeu_ps(c, mask, Result);
+        }
+    }
+}
+
+template <size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasSBGemmComputeRowsAvx512Bf16(
+    const uint32_t* A,
+    size_t ldd,
+    const bfloat16_t* B,
+    size_t PanelStride,
+    size_t PairCount,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    const float* Bias,
+    bool AddC
+)
+{
+    for (size_t n = 0; n < CountN; n += 32) {
+        const size_t cols = std::min(CountN - n, size_t{32});
+        const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
+        if (cols > 16) {
+            MlasSBGemmComputeBlockAvx512Bf16<RowCount, 2>(A, ldd, B, PanelStride, PairCount, C + n, ldc, cols, bias, AddC);
+        } else {
+            MlasSBGemmComputeBlockAvx512Bf16<RowCount, 1>(A, ldd, B, PanelStride, PairCount, C + n, ldc, cols, bias, AddC);
+        }
+        B += 2 * PanelStride;
+    }
+}
+
+void
+MlasSBGemmKernelAvx512Bf16(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    const float* A,
+    size_t lda,
+    const bfloat16_t* B,
+    size_t PackedK,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    bool ZeroMode
+)
+/*++
+
+Routine Description:
+
+    This routine computes C (+)= A * B for a block of matrix A and a packed
+    block of matrix B produced by MlasSBGemmConvertPackBAvx512Bf16.
+
+Arguments:
+
+    CountM - Supplies the number of rows of matrix A and matrix C.
+
+    CountN - Supplies the number of columns of matrix B and matrix C.
+
+    CountK - Supplies the number of columns of matrix A and rows of matrix B.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of the packed matrix B.
+
+    PackedK - Supplies the K alignment of the packed matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    Bias - Optionally supplies the address of the bias vector, only used when
+        ZeroMode is true.
+
+    ZeroMode - Supplies true if the output matrix must be overwritten instead
+        of accumulated.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t RowBlock = MLAS_SBGEMM_KERNEL_AVX512BF16::KernelMaxM;
+    constexpr size_t KChunk = MLAS_SBGEMM_AVX512BF16_KCHUNK;
+
+    MLAS_DECLSPEC_ALIGN(uint32_t PanelA[RowBlock * KChunk / 2], 64);
+    bfloat16_t* PanelABf16 = reinterpret_cast<bfloat16_t*>(PanelA);
+
+    const size_t AlignedK = (CountK + PackedK - 1) & ~(PackedK - 1);
+    const size_t PanelStride = AlignedK * 16;
+
+    //
+    // Step through matrix A and the packed matrix B along the K dimension.
+    // Partial results are accumulated into matrix C after the first chunk.
+    //
+    for (size_t k = 0; k < AlignedK; k += KChunk) {
+        const size_t ChunkK = std::min(AlignedK - k, KChunk);
+        const size_t ValidK = (k < CountK) ? std::min(CountK - k, ChunkK) : 0;
+        const bool AddC = !ZeroMode || k != 0;
+        const float* bias = AddC ? nullptr : Bias;
+        const bfloat16_t* b = B + k * 16;
+
+        for (size_t m = 0; m < CountM; m += RowBlock) {
+            const size_t rows = std::min(CountM - m, RowBlock);
+
+            MlasSBGemmConvertAAvx512Bf16(PanelABf16, KChunk, A + m * lda + k, lda, rows, ValidK, ChunkK);
+
+            float* c = C + m * ldc;
+            const size_t PairCount = ChunkK / 2;
+
+            switch (rows) {
+                case 1:
+                    MlasSBGemmComputeRowsAvx512Bf16<1>(PanelA, KChunk / 2, b, PanelStride, PairCount, c, ldc, CountN, bias, AddC);
+                    break;
+                case 2:
+                    MlasSBGemmComputeRowsAvx512Bf16<2>(PanelA, KChunk / 2, b, PanelStride, PairCount, c, ldc, CountN, bias, AddC);
+                    break;
+                case 3:
+                    MlasSBGemmComputeRowsAvx512Bf16<3>(PanelA, KChunk / 2, b, PanelStride, PairCount, c, ldc, CountN, bias, AddC);
+                    break;
+                case 4:
+                    MlasSBGemmComputeRowsAvx512Bf16<4>(PanelA, KChunk / 2, b, PanelStride, PairCount, c, ldc, CountN, bias, AddC);
+                    break;
+                case 5:
+                    MlasSBGemmComputeRowsAvx512Bf16<5>(PanelA, KChunk / 2, b, PanelStride, PairCount, c, ldc, CountN, bias, AddC);
+                    break;
+                case 6:
+                    MlasSBGemmComputeRowsAvx512Bf16<6>(PanelA, KChunk / 2, b, PanelStride, PairCount, c, ldc, CountN, bias, AddC);
+                    break;
+                case 7:
+                    MlasSBGemmComputeRowsAvx512Bf16<7>(PanelA, KChunk / 2, b, PanelStride, PairCount, c, ldc, CountN, bias, AddC);
+                    break;
+                default:
+                    MlasSBGemmComputeRowsAvx512Bf16<8>(PanelA, KChunk / 2, b, PanelStride, PairCount, c, ldc, CountN, bias, AddC);
+                    break;
+            }
+        }
+    }
+}
+
+template <>
+void
+MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX512BF16>(
+    bfloat16_t* PackedB, const float* B, size_t ldb, size_t CountN, size_t CountK
+)
+{
+    constexpr size_t PackedK = MLAS_SBGEMM_KERNEL_AVX512BF16::PackedK;
+    constexpr size_t PackedN = MLAS_SBGEMM_KERNEL_AVX512BF16::PackedN;
+    constexpr MLAS_SBGEMM_STRIDES Strides = MLAS_SBGEMM_KERNEL_AVX512BF16::Strides;
+
+    const size_t AlignedN = (CountN + PackedN - 1) & ~(PackedN - 1);
+
+    //
+    // Step through each slice of matrix B along the K dimension.
+    //
+    size_t K_block_size;
+    for (size_t k = 0; k < CountK; k += K_block_size) {
+        K_block_size = std::min(CountK - k, Strides.K);
+        const size_t AlignedBlockK = (K_block_size + PackedK - 1) & ~(PackedK - 1);
+
+        MlasSBGemmConvertPackBAvx512Bf16(PackedB, B + k * ldb, ldb, CountN, K_block_size, PackedK);
+        PackedB += AlignedN * AlignedBlockK;
+    }
+}
+
+template <>
+MLAS_FORCEINLINE void
+MlasSBGemmKernel<MLAS_SBGEMM_KERNEL_AVX512BF16>(
+    const size_t CountM,
+    const size_t CountN,
+    const size_t CountK,
+    const float* A,
+    const size_t lda,
+    const bfloat16_t* B,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    const bool ZeroMode
+)
+{
+    MlasSBGemmKernelAvx512Bf16(
+        CountM, CountN, CountK, A, lda, B, MLAS_SBGEMM_KERNEL_AVX512BF16::PackedK, C, ldc, Bias, ZeroMode
+    );
+}
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16 = {
+    MlasSBGemmOperation<MLAS_SBGEMM_KERNEL_AVX512BF16>,
+    MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX512BF16>,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::PackedK,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::PackedN,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::KernelMaxM,
+    0  // kernel does not read beyond the packed buffer
+};
+
+#endif  // defined(MLAS_SBGEMM_SUPPORTED) && defined(MLAS_TARGET_AMD64)
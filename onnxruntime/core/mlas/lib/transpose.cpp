@@ -16,20 +16,6 @@ Abstract:
 
 #include "mlasi.h"
 
-//
-// Define the parameters to execute segments of a transpose operation on worker
-// threads.
-//
-
-template<typename ElementType>
-struct MLAS_TRANPOSE_WORK_BLOCK {
-    ptrdiff_t ThreadCountM;
-    const ElementType* Input;
-    ElementType* Output;
-    size_t M;
-    size_t N;
-};
-
 #if defined(MLAS_SSE2_INTRINSICS)
 
 MLAS_FORCEINLINE
@@ -135,6 +121,52 @@ MlasTranspose8x8Block(
     _mm_storeh_pi((__m64*)&Output[OutputStride * 7], d3);
 }
 
+MLAS_FORCEINLINE
+void
+MlasTranspose8x8Block(
+    const uint16_t* Input,
+    size_t InputStride,
+    uint16_t* Output,
+    size_t OutputStride
+    )
+{
+    __m128i a0 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 0]);
+    __m128i a1 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 1]);
+    __m128i a2 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 2]);
+    __m128i a3 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 3]);
+    __m128i a4 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 4]);
+    __m128i a5 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 5]);
+    __m128i a6 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 6]);
+    __m128i a7 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 7]);
+
+    __m128i b0 = _mm_unpacklo_epi16(a0, a1);
+    __m128i b1 = _mm_unpackhi_epi16(a0, a1);
+    __m128i b2 = _mm_unpacklo_epi16(a2, a3);
+    __m128i b3 = _mm_unpackhi_epi16(a2, a3);
+    __m128i b4 = _mm_unpacklo_epi16(a4, a5);
+    __m128i b5 = _mm_unpackhi_epi16(a4, a5);
+    __m128i b6 = _mm_unpacklo_epi16(a6, a7);
+    __m128i b7 = _mm_unpackhi_epi16(a6, a7);
+
+    __m128i c0 = _mm_unpacklo_epi32(b0, b2);
+    __m128i c1 = _mm_unpackhi_epi32(b0, b2);
+    __m128i c2 = _mm_unpacklo_epi32(b1, b3);
+    __m128i c3 = _mm_unpackhi_epi32(b1, b3);
+    __m128i c4 = _mm_unpacklo_epi32(b4, b6);
+    __m128i c5 = _mm_unpackhi_epi32(b4, b6);
+    __m128i c6 = _mm_unpacklo_epi32(b5, b7);
+    __m128i c7 = _mm_unpackhi_epi32(b5, b7);
+
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 0], _mm_unpacklo_epi64(c0, c4));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 1], _mm_unpackhi_epi64(c0, c4));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 2], _mm_unpacklo_epi64(c1, c5));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 3], _mm_unpackhi_epi64(c1, c5));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 4], _mm_unpacklo_epi64(c2, c6));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 5], _mm_unpackhi_epi64(c2, c6));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 6], _mm_unpacklo_epi64(c3, c7));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 7], _mm_unpackhi_epi64(c3, c7));
+}
+
 #elif defined(MLAS_NEON_INTRINSICS)
 
 MLAS_FORCEINLINE
@@ -729,57 +761,106 @@ MlasTranspose8xNVector(
     MlasTranspose4xNVector(&Input[InputStride * 4], InputStride, &Output[OutputStride * 4], OutputStride);
 }
 
-template <typename ElementType>
+template<typename ElementType>
+MLAS_FORCEINLINE
 void
-MlasTransposeThreaded(
-    void* Context,
-    ptrdiff_t ThreadId
-);
+MlasTransposeKernel(
+    const ElementType* Input,
+    size_t InputStride,
+    ElementType* Output,
+    size_t OutputStride,
+    size_t M,
+    size_t N
+    )
 /*++
 
 Routine Description:
 
-    This routine is invoked from a worker thread to execute a segment of a transpose
+    This routine transposes a block of the input matrix (M rows by N columns)
+    to the output matrix (N rows by M columns). The rows of either matrix may
+    be strided, which allows the routine to operate on a tile of a larger
+    tensor.
+
+    The generic routine handles element types without an in-register block
+    transpose.
 
 Arguments:
 
-    Context - Supplies the pointer to the context for the threaded operation.
+    Input - Supplies the input buffer.
+
+    InputStride - Supplies the number of elements between input rows.
+
+    Output - Supplies the output buffer.
 
-    ThreadId - Supplies the current index of the threaded operation.
+    OutputStride - Supplies the number of elements between output rows.
+
+    M - Supplies the number of rows for the input matrix and the number of
+        columns for the output matrix.
+
+    N - Supplies the number of columns for the input matrix and the number of
+        rows for the output matrix.
 
 Return Value:
 
     None.
 
 --*/
-
-template<>
-void
-MlasTransposeThreaded<uint32_t>(
-    void* Context,
-    ptrdiff_t ThreadId
-    )
 {
-    const auto* WorkBlock = (MLAS_TRANPOSE_WORK_BLOCK<uint32_t>*)Context;
+    size_t n = N;
 
-    //
-    // Partition the operation along the M dimension.
-    //
+    while (n >= 4) {
 
-    size_t IndexM;
-    size_t CountM;
-    MlasPartitionWork(ThreadId, WorkBlock->ThreadCountM, WorkBlock->M, &IndexM, &CountM);
+        const ElementType* s = Input;
+        ElementType* d = Output;
+        size_t m = M;
 
-    //
-    // Set transpose parameters.
-    //
+        while (m > 0) {
 
-    const size_t M = WorkBlock->M;
-    const size_t N = WorkBlock->N;
+            MlasTranspose4xNVector(s, 1, d, OutputStride);
 
-    const uint32_t* Input = WorkBlock->Input + IndexM * N;
-    uint32_t* Output = WorkBlock->Output + IndexM;
+            s += InputStride;
+            d += 1;
+            m -= 1;
+        }
+
+        Input += 4;
+        Output += OutputStride * 4;
+        n -= 4;
+    }
 
+    while (n > 0) {
+
+        const ElementType* s = Input;
+        ElementType* d = Output;
+        size_t m = M;
+
+        while (m > 0) {
+
+            d[0] = s[0];
+
+            s += InputStride;
+            d += 1;
+            m -= 1;
+        }
+
+        Input += 1;
+        Output += OutputStride;
+        n -= 1;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasTransposeKernel<uint32_t>(
+    const uint32_t* Input,
+    size_t InputStride,
+    uint32_t* Output,
+    size_t OutputStride,
+    size_t M,
+    size_t N
+    )
+{
     //
     // Transpose elements from the input matrix to the output matrix 4 columns
     // at a time.
@@ -791,16 +872,16 @@ MlasTransposeThreaded<uint32_t>(
 
         const uint32_t* s = Input;
         uint32_t* d = Output;
-        size_t m = CountM;
+        size_t m = M;
 
 #if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS) || defined(MLAS_TARGET_POWER) || \
     defined(MLAS_TARGET_S390X) || defined(MLAS_LSX_INTRINSICS)
 
         while (m >= 4) {
 
-            MlasTranspose4x4Block(s, N, d, M);
+            MlasTranspose4x4Block(s, InputStride, d, OutputStride);
 
-            s += N * 4;
+            s += InputStride * 4;
             d += 4;
             m -= 4;
         }
@@ -809,15 +890,15 @@ MlasTransposeThreaded<uint32_t>(
 
         while (m > 0) {
 
-            MlasTranspose4xNVector(s, 1, d, M);
+            MlasTranspose4xNVector(s, 1, d, OutputStride);
 
-            s += N;
+            s += InputStride;
             d += 1;
             m -= 1;
         }
 
         Input += 4;
-        Output += M * 4;
+        Output += OutputStride * 4;
         n -= 4;
     }
 
@@ -830,13 +911,13 @@ MlasTransposeThreaded<uint32_t>(
 
         const uint32_t* s = Input;
         uint32_t* d = Output;
-        size_t m = CountM;
+        size_t m = M;
 
         while (m >= 4) {
 
-            MlasTranspose4xNVector(s, N, d, 1);
+            MlasTranspose4xNVector(s, InputStride, d, 1);
 
-            s += N * 4;
+            s += InputStride * 4;
             d += 4;
             m -= 4;
         }
@@ -845,64 +926,87 @@ MlasTransposeThreaded<uint32_t>(
 
             d[0] = s[0];
 
-            s += N;
+            s += InputStride;
             d += 1;
             m -= 1;
         }
 
         Input += 1;
-        Output += M;
+        Output += OutputStride;
         n -= 1;
     }
 }
 
 template<>
+MLAS_FORCEINLINE
 void
-MlasTransposeThreaded<uint16_t>(
-    void* Context,
-    ptrdiff_t ThreadId
+MlasTransposeKernel<uint16_t>(
+    const uint16_t* Input,
+    size_t InputStride,
+    uint16_t* Output,
+    size_t OutputStride,
+    size_t M,
+    size_t N
     )
 {
-    const auto* WorkBlock = (MLAS_TRANPOSE_WORK_BLOCK<uint16_t>*)Context;
+    size_t n = N;
+
+#if defined(MLAS_SSE2_INTRINSICS)
 
     //
-    // Partition the operation along the M dimension.
+    // Transpose elements from the input matrix to the output matrix 8 columns
+    // at a time.
     //
 
-    size_t IndexM;
-    size_t CountM;
-    MlasPartitionWork(ThreadId, WorkBlock->ThreadCountM, WorkBlock->M, &IndexM, &CountM);
+    while (n >= 8) {
 
-    //
-    // Set transpose parameters.
-    //
+        const uint16_t* s = Input;
+        uint16_t* d = Output;
+        size_t m = M;
 
-    const size_t M = WorkBlock->M;
-    const size_t N = WorkBlock->N;
+        while (m >= 8) {
+
+            MlasTranspose8x8Block(s, InputStride, d, OutputStride);
 
-    const uint16_t* Input = WorkBlock->Input + IndexM * N;
-    uint16_t* Output = WorkBlock->Output + IndexM;
+            s += InputStride * 8;
+            d += 8;
+            m -= 8;
+        }
+
+        while (m > 0) {
+
+            MlasTranspose8xNVector(s, 1, d, OutputStride);
+
+            s += InputStride;
+            d += 1;
+            m -= 1;
+        }
+
+        Input += 8;
+        Output += OutputStride * 8;
+        n -= 8;
+    }
+
+#endif
 
     //
     // Transpose elements from the input matrix to the output matrix 4 columns
     // at a time.
     //
 
-    size_t n = N;
-
     while (n >= 4) {
 
         const uint16_t* s = Input;
         uint16_t* d = Output;
-        size_t m = CountM;
+        size_t m = M;
 
 #if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS)  || defined(MLAS_LSX_INTRINSICS)
 
         while (m >= 4) {
 
-            MlasTranspose4x4Block(s, N, d, M);
+            MlasTranspose4x4Block(s, InputStride, d, OutputStride);
 
-            s += N * 4;
+            s += InputStride * 4;
             d += 4;
             m -= 4;
         }
@@ -911,15 +1015,15 @@ MlasTransposeThreaded<uint16_t>(
 
         while (m > 0) {
 
-            MlasTranspose4xNVector(s, 1, d, M);
+            MlasTranspose4xNVector(s, 1, d, OutputStride);
 
-            s += N;
+            s += InputStride;
             d += 1;
             m -= 1;
         }
 
         Input += 4;
-        Output += M * 4;
+        Output += OutputStride * 4;
         n -= 4;
     }
 
@@ -932,13 +1036,13 @@ MlasTransposeThreaded<uint16_t>(
 
         const uint16_t* s = Input;
         uint16_t* d = Output;
-        size_t m = CountM;
+        size_t m = M;
 
         while (m >= 4) {
 
-            MlasTranspose4xNVector(s, N, d, 1);
+            MlasTranspose4xNVector(s, InputStride, d, 1);
 
-            s += N * 4;
+            s += InputStride * 4;
             d += 4;
             m -= 4;
         }
@@ -947,44 +1051,29 @@ MlasTransposeThreaded<uint16_t>(
 
             d[0] = s[0];
 
-            s += N;
+            s += InputStride;
             d += 1;
             m -= 1;
         }
 
         Input += 1;
-        Output += M;
+        Output += OutputStride;
         n -= 1;
     }
 }
 
 template<>
+MLAS_FORCEINLINE
 void
-MlasTransposeThreaded<uint8_t>(
-    void* Context,
-    ptrdiff_t ThreadId
+MlasTransposeKernel<uint8_t>(
+    const uint8_t* Input,
+    size_t InputStride,
+    uint8_t* Output,
+    size_t OutputStride,
+    size_t M,
+    size_t N
     )
 {
-    const auto* WorkBlock = (MLAS_TRANPOSE_WORK_BLOCK<uint8_t>*)Context;
-
-    //
-    // Partition the operation along the M dimension.
-    //
-
-    size_t IndexM;
-    size_t CountM;
-    MlasPartitionWork(ThreadId, WorkBlock->ThreadCountM, WorkBlock->M, &IndexM, &CountM);
-
-    //
-    // Set transpose parameters.
-    //
-
-    const size_t M = WorkBlock->M;
-    const size_t N = WorkBlock->N;
-
-    const uint8_t* Input = WorkBlock->Input + IndexM * N;
-    uint8_t* Output = WorkBlock->Output + IndexM;
-
     //
     // Transpose elements from the input matrix to the output matrix 8 columns
     // at a time.
@@ -997,27 +1086,27 @@ MlasTransposeThreaded<uint8_t>(
 
         const uint8_t* s = Input;
         uint8_t* d = Output;
-        size_t m = CountM;
+        size_t m = M;
         while (m >= 16) {
 
-            MlasTranspose16x16Block(s, N, d, M);
+            MlasTranspose16x16Block(s, InputStride, d, OutputStride);
 
-            s += N * 16;
+            s += InputStride * 16;
             d += 16;
             m -= 16;
         }
 
         while (m > 0) {
 
-            MlasTranspose16xNVector(s, 1, d, M);
+            MlasTranspose16xNVector(s, 1, d, OutputStride);
 
-            s += N;
+            s += InputStride;
             d += 1;
             m -= 1;
         }
 
         Input += 16;
-        Output += M * 16;
+        Output += OutputStride * 16;
         n -= 16;
     }
 #endif
@@ -1025,15 +1114,15 @@ MlasTransposeThreaded<uint8_t>(
 
         const uint8_t* s = Input;
         uint8_t* d = Output;
-        size_t m = CountM;
+        size_t m = M;
 
 #if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS)  || defined(MLAS_LSX_INTRINSICS)
 
         while (m >= 8) {
 
-            MlasTranspose8x8Block(s, N, d, M);
+            MlasTranspose8x8Block(s, InputStride, d, OutputStride);
 
-            s += N * 8;
+            s += InputStride * 8;
             d += 8;
             m -= 8;
         }
@@ -1042,15 +1131,15 @@ MlasTransposeThreaded<uint8_t>(
 
         while (m > 0) {
 
-            MlasTranspose8xNVector(s, 1, d, M);
+            MlasTranspose8xNVector(s, 1, d, OutputStride);
 
-            s += N;
+            s += InputStride;
             d += 1;
             m -= 1;
         }
 
         Input += 8;
-        Output += M * 8;
+        Output += OutputStride * 8;
         n -= 8;
     }
 
@@ -1063,13 +1152,13 @@ MlasTransposeThreaded<uint8_t>(
 
         const uint8_t* s = Input;
         uint8_t* d = Output;
-        size_t m = CountM;
+        size_t m = M;
 
         while (m >= 8) {
 
-            MlasTranspose8xNVector(s, N, d, 1);
+            MlasTranspose8xNVector(s, InputStride, d, 1);
 
-            s += N * 8;
+            s += InputStride * 8;
             d += 8;
             m -= 8;
         }
@@ -1078,17 +1167,339 @@ MlasTransposeThreaded<uint8_t>(
 
             d[0] = s[0];
 
-            s += N;
+            s += InputStride;
             d += 1;
             m -= 1;
         }
 
         Input += 1;
-        Output += M;
+        Output += OutputStride;
         n -= 1;
     }
 }
 
+//
+// Define the minimum number of bytes to transpose per thread and the edge
+// length of the tiles that are transposed in cache.
+//
+
+constexpr size_t MLAS_TRANSPOSE_MINIMUM_BYTES_PER_THREAD = 64 * 1024;
+
+constexpr size_t MLAS_TRANSPOSE_TILE_ROWS = 256;
+
+template<typename DataType>
+constexpr size_t MlasTransposeTileColumns = 64 / sizeof(DataType);
+
+//
+// Define the shape of a transpose after unit axes have been removed and axes
+// that stay adjacent in the output have been merged. The axes are stored in
+// output order.
+//
+
+struct MLAS_TRANSPOSE_SHAPE {
+    size_t Rank;
+    size_t Shape[MLAS_TRANSPOSE_MAXIMUM_RANK];
+    size_t InputStrides[MLAS_TRANSPOSE_MAXIMUM_RANK];
+    size_t OutputStrides[MLAS_TRANSPOSE_MAXIMUM_RANK];
+};
+
+void
+MlasTransposeCanonicalizeShape(
+    const size_t* InputShape,
+    const size_t* Permutation,
+    size_t Rank,
+    MLAS_TRANSPOSE_SHAPE* TransposeShape
+    )
+/*++
+
+Routine Description:
+
+    This routine removes the unit axes of a transpose and merges the output
+    axes that are also contiguous in the input.
+
+Arguments:
+
+    InputShape - Supplies the shape of the input tensor.
+
+    Permutation - Supplies the input axis of each output axis.
+
+    Rank - Supplies the number of axes.
+
+    TransposeShape - Receives the canonical shape of the transpose.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t InputStrides[MLAS_TRANSPOSE_MAXIMUM_RANK];
+    size_t Stride = 1;
+
+    for (size_t i = Rank; i > 0; i--) {
+        InputStrides[i - 1] = Stride;
+        Stride *= InputShape[i - 1];
+    }
+
+    size_t MergedRank = 0;
+
+    for (size_t i = 0; i < Rank; i++) {
+
+        const size_t Axis = Permutation[i];
+        const size_t Dimension = InputShape[Axis];
+
+        if (Dimension == 1) {
+            continue;
+        }
+
+        if (MergedRank > 0 &&
+            TransposeShape->InputStrides[MergedRank - 1] == InputStrides[Axis] * Dimension) {
+            TransposeShape->Shape[MergedRank - 1] *= Dimension;
+            TransposeShape->InputStrides[MergedRank - 1] = InputStrides[Axis];
+        } else {
+            TransposeShape->Shape[MergedRank] = Dimension;
+            TransposeShape->InputStrides[MergedRank] = InputStrides[Axis];
+            MergedRank++;
+        }
+    }
+
+    Stride = 1;
+
+    for (size_t i = MergedRank; i > 0; i--) {
+        TransposeShape->OutputStrides[i - 1] = Stride;
+        Stride *= TransposeShape->Shape[i - 1];
+    }
+
+    TransposeShape->Rank = MergedRank;
+}
+
+template<typename Callback>
+void
+MlasTransposeForEachIndex(
+    const size_t* Shape,
+    const size_t* InputStrides,
+    const size_t* OutputStrides,
+    size_t Rank,
+    size_t Index,
+    size_t Count,
+    Callback Body
+    )
+/*++
+
+Routine Description:
+
+    This routine visits a range of the flattened index space of a shape and
+    passes the input and output offsets of each index to the callback.
+
+Arguments:
+
+    Shape - Supplies the shape to iterate over.
+
+    InputStrides - Supplies the input stride of each axis.
+
+    OutputStrides - Supplies the output stride of each axis.
+
+    Rank - Supplies the number of axes.
+
+    Index - Supplies the first flattened index to visit.
+
+    Count - Supplies the number of indices to visit.
+
+    Body - Supplies the callback invoked with the input and output offsets.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t AxisIndex[MLAS_TRANSPOSE_MAXIMUM_RANK];
+    size_t InputOffset = 0;
+    size_t OutputOffset = 0;
+
+    for (size_t i = Rank; i > 0; i--) {
+        AxisIndex[i - 1] = Index % Shape[i - 1];
+        Index /= Shape[i - 1];
+        InputOffset += AxisIndex[i - 1] * InputStrides[i - 1];
+        OutputOffset += AxisIndex[i - 1] * OutputStrides[i - 1];
+    }
+
+    while (Count > 0) {
+
+        Body(InputOffset, OutputOffset);
+
+        for (size_t i = Rank; i > 0; i--) {
+
+            InputOffset += InputStrides[i - 1];
+            OutputOffset += OutputStrides[i - 1];
+
+            if (++AxisIndex[i - 1] < Shape[i - 1]) {
+                break;
+            }
+
+            InputOffset -= InputStrides[i - 1] * Shape[i - 1];
+            OutputOffset -= OutputStrides[i - 1] * Shape[i - 1];
+            AxisIndex[i - 1] = 0;
+        }
+
+        Count--;
+    }
+}
+
+template<typename DataType>
+void
+MlasTransposeExecute(
+    const DataType* Input,
+    DataType* Output,
+    const MLAS_TRANSPOSE_SHAPE& TransposeShape,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a tensor with a canonical transpose shape.
+
+    If the innermost output axis is also the innermost input axis, the
+    transpose is a gather of contiguous rows. Otherwise, the innermost input
+    and output axes form a matrix that is transposed in cache sized tiles
+    with the in-register block kernels, once for every index of the remaining
+    batch axes. The rows or tiles are partitioned over the threads.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    TransposeShape - Supplies the canonical shape of the transpose.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t Rank = TransposeShape.Rank;
+
+    size_t ElementCount = 1;
+
+    for (size_t i = 0; i < Rank; i++) {
+        ElementCount *= TransposeShape.Shape[i];
+    }
+
+    if (ElementCount == 0) {
+        return;
+    }
+
+    if (Rank == 0 || TransposeShape.InputStrides[Rank - 1] == 1) {
+
+        const size_t RowSize = (Rank == 0) ? 1 : TransposeShape.Shape[Rank - 1];
+        const size_t RowCount = ElementCount / RowSize;
+
+        if (RowCount == 1) {
+            std::copy_n(Input, ElementCount, Output);
+            return;
+        }
+
+        ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+        ThreadCount = std::min(ThreadCount,
+            ptrdiff_t(ElementCount * sizeof(DataType) / MLAS_TRANSPOSE_MINIMUM_BYTES_PER_THREAD) + 1);
+        ThreadCount = std::min(ThreadCount, ptrdiff_t(RowCount));
+
+        MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t ThreadId) {
+
+            size_t RowIndex;
+            size_t RowsRemaining;
+            MlasPartitionWork(ThreadId, ThreadCount, RowCount, &RowIndex, &RowsRemaining);
+
+            MlasTransposeForEachIndex(TransposeShape.Shape, TransposeShape.InputStrides,
+                TransposeShape.OutputStrides, Rank - 1, RowIndex, RowsRemaining,
+                [&](size_t InputOffset, size_t OutputOffset) {
+                    std::copy_n(Input + InputOffset, RowSize, Output + OutputOffset);
+                });
+        });
+
+        return;
+    }
+
+    //
+    // Find the axis that is contiguous in the input. This axis supplies the
+    // columns of the transposed matrix and the innermost output axis supplies
+    // the rows. The other axes are batch axes.
+    //
+
+    size_t ColumnAxis = 0;
+
+    while (TransposeShape.InputStrides[ColumnAxis] != 1) {
+        ColumnAxis++;
+    }
+
+    const size_t M = TransposeShape.Shape[Rank - 1];
+    const size_t N = TransposeShape.Shape[ColumnAxis];
+    const size_t InputStride = TransposeShape.InputStrides[Rank - 1];
+    const size_t OutputStride = TransposeShape.OutputStrides[ColumnAxis];
+
+    size_t BatchShape[MLAS_TRANSPOSE_MAXIMUM_RANK];
+    size_t BatchInputStrides[MLAS_TRANSPOSE_MAXIMUM_RANK];
+    size_t BatchOutputStrides[MLAS_TRANSPOSE_MAXIMUM_RANK];
+    size_t BatchRank = 0;
+    size_t BatchCount = 1;
+
+    for (size_t i = 0; i < Rank - 1; i++) {
+        if (i != ColumnAxis) {
+            BatchShape[BatchRank] = TransposeShape.Shape[i];
+            BatchInputStrides[BatchRank] = TransposeShape.InputStrides[i];
+            BatchOutputStrides[BatchRank] = TransposeShape.OutputStrides[i];
+            BatchCount *= TransposeShape.Shape[i];
+            BatchRank++;
+        }
+    }
+
+    const size_t TileCountM = MlasDivRoundup(M, MLAS_TRANSPOSE_TILE_ROWS);
+    const size_t TileCountN = MlasDivRoundup(N, MlasTransposeTileColumns<DataType>);
+    const size_t TilesPerBatch = TileCountM * TileCountN;
+    const size_t TileCount = BatchCount * TilesPerBatch;
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+    ThreadCount = std::min(ThreadCount,
+        ptrdiff_t(ElementCount * sizeof(DataType) / MLAS_TRANSPOSE_MINIMUM_BYTES_PER_THREAD) + 1);
+    ThreadCount = std::min(ThreadCount, ptrdiff_t(TileCount));
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t ThreadId) {
+
+        size_t TileIndex;
+        size_t TilesRemaining;
+        MlasPartitionWork(ThreadId, ThreadCount, TileCount, &TileIndex, &TilesRemaining);
+
+        const size_t BatchIndex = TileIndex / TilesPerBatch;
+        size_t TileInBatch = TileIndex % TilesPerBatch;
+        const size_t BatchesSpanned = MlasDivRoundup(TileInBatch + TilesRemaining, TilesPerBatch);
+
+        MlasTransposeForEachIndex(BatchShape, BatchInputStrides, BatchOutputStrides, BatchRank,
+            BatchIndex, BatchesSpanned, [&](size_t InputOffset, size_t OutputOffset) {
+
+                const size_t TileEnd = std::min(TilesPerBatch, TileInBatch + TilesRemaining);
+
+                for (size_t t = TileInBatch; t < TileEnd; t++) {
+
+                    const size_t m = (t / TileCountN) * MLAS_TRANSPOSE_TILE_ROWS;
+                    const size_t n = (t % TileCountN) * MlasTransposeTileColumns<DataType>;
+
+                    MlasTransposeKernel<DataType>(Input + InputOffset + m * InputStride + n, InputStride,
+                        Output + OutputOffset + n * OutputStride + m, OutputStride,
+                        std::min(MLAS_TRANSPOSE_TILE_ROWS, M - m), std::min(MlasTransposeTileColumns<DataType>, N - n));
+                }
+
+                TilesRemaining -= TileEnd - TileInBatch;
+                TileInBatch = 0;
+            });
+    });
+}
+
 template<typename DataType>
 void
 MLASCALL
@@ -1127,35 +1538,72 @@ Return Value:
 
 --*/
 {
-    MLAS_TRANPOSE_WORK_BLOCK<DataType> WorkBlock;
+    const size_t InputShape[2] = {M, N};
+    const size_t Permutation[2] = {1, 0};
 
-    //
-    // Capture the transpose parameters to the work block.
-    //
+    MLAS_TRANSPOSE_SHAPE TransposeShape;
+    MlasTransposeCanonicalizeShape(InputShape, Permutation, 2, &TransposeShape);
 
-    WorkBlock.Input = Input;
-    WorkBlock.Output = Output;
-    WorkBlock.M = M;
-    WorkBlock.N = N;
+    MlasTransposeExecute(Input, Output, TransposeShape, ThreadPool);
+}
 
-    //
-    // Compute the number of target threads given the complexity of the transpose
-    // operation. Limit the number of threads to the number of rows and try to
-    // keep each thread processing a minimum number of elements before using
-    // another thread.
-    //
+template<typename DataType>
+void
+MLASCALL
+MlasTranspose(
+    const DataType* Input,
+    DataType* Output,
+    const size_t* InputShape,
+    const size_t* Permutation,
+    size_t Rank,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
 
-    ptrdiff_t ThreadCountM = MlasGetMaximumThreadCount(ThreadPool);
+Routine Description:
 
-    if (size_t(ThreadCountM) > M) {
-        ThreadCountM = ptrdiff_t(M);
-    }
+    This routine transposes the input tensor to the output tensor, where
+    output axis i is input axis Permutation[i].
+
+Arguments:
+
+    Input - Supplies the input buffer.
 
-    WorkBlock.ThreadCountM = ThreadCountM;
+    Output - Supplies the output buffer.
+
+    InputShape - Supplies the shape of the input tensor.
+
+    Permutation - Supplies the input axis of each output axis.
+
+    Rank - Supplies the number of axes, which must not exceed
+        MLAS_TRANSPOSE_MAXIMUM_RANK.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
 
-    MlasExecuteThreaded(MlasTransposeThreaded<DataType>, &WorkBlock, ThreadCountM, ThreadPool);
+--*/
+{
+    MLAS_TRANSPOSE_SHAPE TransposeShape;
+    MlasTransposeCanonicalizeShape(InputShape, Permutation, Rank, &TransposeShape);
+
+    MlasTransposeExecute(Input, Output, TransposeShape, ThreadPool);
 }
 
+template
+void
+MLASCALL
+MlasTranspose<uint64_t>(
+    const uint64_t* Input,
+    uint64_t* Output,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 template
 void
 MLASCALL
@@ -1226,3 +1674,51 @@ MlasTranspose<float>(
         N,
         ThreadPool);
 }
+
+template
+void
+MLASCALL
+MlasTranspose<uint64_t>(
+    const uint64_t* Input,
+    uint64_t* Output,
+    const size_t* InputShape,
+    const size_t* Permutation,
+    size_t Rank,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasTranspose<uint32_t>(
+    const uint32_t* Input,
+    uint32_t* Output,
+    const size_t* InputShape,
+    const size_t* Permutation,
+    size_t Rank,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasTranspose<uint16_t>(
+    const uint16_t* Input,
+    uint16_t* Output,
+    const size_t* InputShape,
+    const size_t* Permutation,
+    size_t Rank,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasTranspose<uint8_t>(
+    const uint8_t* Input,
+    uint8_t* Output,
+    const size_t* InputShape,
+    const size_t* Permutation,
+    size_t Rank,
+    MLAS_THREADPOOL* ThreadPool
+    );
@@ -478,6 +478,7 @@ bool LayerNormalizationGatherActor::PostProcess(Graph& /*graph*/, Node& current_
 
     auto& attributes = current_node.GetMutableAttributes();
     attributes["axis"] = ONNX_NAMESPACE::MakeAttribute("axis", static_cast<int64_t>(new_axis));
+    current_node.MarkAttributesChanged();
   }
 
   return true;
@@ -517,6 +518,7 @@ bool SoftmaxGatherActor::PostProcess(Graph& graph, Node& current_node, const Sli
 
     auto& attributes = current_node.GetMutableAttributes();
     attributes["axis"] = ONNX_NAMESPACE::MakeAttribute("axis", static_cast<int64_t>(new_axis));
+    current_node.MarkAttributesChanged();
   }
 
   return true;
@@ -296,6 +296,7 @@ bool LayerNormalizationReshapeActor::PostProcess(
     auto new_axis = axis - 1;
     auto& attributes = current_node.GetMutableAttributes();
     attributes["axis"] = ONNX_NAMESPACE::MakeAttribute("axis", static_cast<int64_t>(new_axis));
+    current_node.MarkAttributesChanged();
   }
   return true;
 }
@@ -52,6 +52,29 @@ static bool GetAxis(const Graph& graph, const Node& node, int64_t rank, int64_t&
   return false;
 }
 
+static bool HasShapeOfRank(const NodeArg& node_arg, int rank) {
+  const auto* shape = node_arg.Shape();
+  return shape != nullptr && shape->dim_size() == rank;
+}
+
+// Returns true if the ReduceSum/ReduceMean node reduces only axis 1 of its rank 3 input and drops it.
+static bool ReducesBagAxis(const Graph& graph, const Node& reduce_node) {
+  const auto& attrs = reduce_node.GetAttributes();
+  auto keepdims_attr = attrs.find("keepdims");
+  if (keepdims_attr == attrs.end() || !utils::HasInt(keepdims_attr->second) || keepdims_attr->second.i() != 0) {
+    return false;
+  }
+
+  InlinedVector<int64_t> axes;
+  auto axes_attr = attrs.find("axes");
+  if (axes_attr != attrs.end()) {
+    axes.assign(axes_attr->second.ints().begin(), axes_attr->second.ints().end());
+  } else if (reduce_node.InputDefs().size() < 2 || !reduce_node.InputDefs()[1]->Exists() ||
+             !optimizer_utils::AppendTensorFromInitializer(graph, *reduce_node.InputDefs()[1], axes, true)) {
+    return false;
+  }
+  return axes.size() == 1 && (axes[0] == 1 || axes[0] == -2);
+}
 }  // namespace
 
 bool GatherSliceToSplitFusion::IsSupportedGather(const Graph& graph, const Node& node, int64_t rank,
@@ -404,4 +427,109 @@ Status GatherToSliceFusion::ApplyImpl(Graph& graph, bool& modified, int graph_le
   return Status::OK();
 }
 
+/*
+Fuse the pooled lookup of an embedding table
+
+  data[V, D] -> Gather(axis=0, indices[B, L]) -> ReduceSum/ReduceMean(axes=[1], keepdims=0) -> [B, D]
+
+to
+
+  data[V, D] -> EmbeddingBag(indices[B, L], mode=sum/mean) -> [B, D]
+
+GatherBlockQuantized with uint8 data quantized along the last axis is fused the same way, carrying its scales,
+zero points, block_size and bits over to EmbeddingBag, so the rows are dequantized while they are accumulated.
+Weighted bags (a Mul between the Gather and the ReduceSum) are not matched.
+*/
+Status EmbeddingBagFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                     const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (p_node == nullptr) continue;  // we removed the node as part of an earlier fusion
+    Node& gather_node = *p_node;
+
+    ORT_RETURN_IF_ERROR(Recurse(gather_node, modified, graph_level, logger));
+
+    const bool is_gather = graph_utils::IsSupportedOptypeVersionAndDomain(gather_node, "Gather", {1, 11, 13});
+    const bool is_quantized_gather =
+        graph_utils::IsSupportedOptypeVersionAndDomain(gather_node, "GatherBlockQuantized", {1}, kMSDomain);
+    if ((!is_gather && !is_quantized_gather) ||
+        !graph_utils::IsSupportedProvider(gather_node, GetCompatibleExecutionProviders()) ||
+        !optimizer_utils::CheckOutputEdges(graph, gather_node, 1)) {
+      continue;
+    }
+
+    const auto& gather_inputs = gather_node.InputDefs();
+    if (!HasShapeOfRank(*gather_inputs[0], 2) || !HasShapeOfRank(*gather_inputs[1], 2)) continue;
+
+    const auto* output_type = gather_node.OutputDefs()[0]->TypeAsProto();
+    if (output_type == nullptr) continue;
+    const auto output_elem_type = output_type->tensor_type().elem_type();
+    if (output_elem_type != ONNX_NAMESPACE::TensorProto_DataType_FLOAT &&
+        output_elem_type != ONNX_NAMESPACE::TensorProto_DataType_FLOAT16) {
+      continue;
+    }
+
+    if (is_gather) {
+      if (GetGatherAxis(gather_node, 2) != 0) continue;
+    } else {
+      // EmbeddingBag reads the uint8 layout of GatherBlockQuantized only.
+      const auto* data_type = gather_inputs[0]->TypeAsProto();
+      if (data_type == nullptr ||
+          data_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_UINT8) {
+        continue;
+      }
+      const auto* gather_axis = graph_utils::GetNodeAttribute(gather_node, "gather_axis");
+      const auto* quantize_axis = graph_utils::GetNodeAttribute(gather_node, "quantize_axis");
+      if ((gather_axis != nullptr && gather_axis->i() != 0 && gather_axis->i() != -2) ||
+          (quantize_axis != nullptr && quantize_axis->i() != 1 && quantize_axis->i() != -1)) {
+        continue;
+      }
+    }
+
+    Node& reduce_node = *graph.GetNode(gather_node.OutputNodesBegin()->Index());
+    const bool is_sum = graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceSum", {1, 11, 13});
+    const bool is_mean = graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceMean", {1, 11, 13, 18});
+    if ((!is_sum && !is_mean) ||
+        reduce_node.GetExecutionProviderType() != gather_node.GetExecutionProviderType() ||
+        reduce_node.InputDefs()[0] != gather_node.OutputDefs()[0] ||
+        !ReducesBagAxis(graph, reduce_node)) {
+      continue;
+    }
+
+    NodeArg& empty_arg = graph.GetOrCreateNodeArg("", nullptr);
+    InlinedVector<NodeArg*> inputs{gather_node.MutableInputDefs()[0], gather_node.MutableInputDefs()[1],
+                                   &empty_arg, &empty_arg};
+    if (is_quantized_gather) {
+      const auto& quantized_inputs = gather_node.MutableInputDefs();
+      inputs.push_back(quantized_inputs[2]);
+      if (quantized_inputs.size() > 3 && quantized_inputs[3]->Exists()) {
+        inputs.push_back(quantized_inputs[3]);
+      }
+    }
+
+    Node& embedding_bag_node =
+        graph.AddNode(graph.GenerateNodeName(gather_node.Name() + "/EmbeddingBagFusion"), "EmbeddingBag",
+                      "fused Gather and " + reduce_node.OpType(), inputs, {}, nullptr, kMSDomain);
+    embedding_bag_node.AddAttribute("mode", std::string(is_sum ? "sum" : "mean"));
+    if (is_quantized_gather) {
+      // GatherBlockQuantized defaults to 4 bits and EmbeddingBag to 8, so always carry the value over.
+      const auto* bits = graph_utils::GetNodeAttribute(gather_node, "bits");
+      embedding_bag_node.AddAttribute("bits", bits != nullptr ? bits->i() : static_cast<int64_t>(4));
+      const auto* block_size = graph_utils::GetNodeAttribute(gather_node, "block_size");
+      if (block_size != nullptr) {
+        embedding_bag_node.AddAttribute("block_size", block_size->i());
+      }
+    }
+    embedding_bag_node.SetExecutionProviderType(gather_node.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, {gather_node, reduce_node}, embedding_bag_node);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
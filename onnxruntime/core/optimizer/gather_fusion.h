@@ -40,4 +40,19 @@ class GatherToSliceFusion : public GraphTransformer {
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
+/**
+@Class EmbeddingBagFusion
+
+Fuse Gather(axis=0) or GatherBlockQuantized(uint8) of a 2D table with 2D indices followed by ReduceSum/ReduceMean over
+the bag axis into one EmbeddingBag node, which pools the rows straight from the table instead of materializing the
+gathered [num_bags, bag_size, embedding_dim] tensor.
+*/
+class EmbeddingBagFusion : public GraphTransformer {
+ public:
+  EmbeddingBagFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("EmbeddingBagFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
 }  // namespace onnxruntime
@@ -4,6 +4,8 @@
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 
+#include <chrono>
+#include <limits>
 #include <memory>
 #include <utility>
 
@@ -30,17 +32,49 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
     return Status::OK();
   }
 
+  // Each transformer is a function of the graph, so one that made no modification would make none again until
+  // another transformer modifies the graph. Count the modifications and skip transformers that already ran without
+  // modifying the current version of the graph instead of re-running every transformer over the whole graph.
+  constexpr size_t kNotClean = std::numeric_limits<size_t>::max();
+  const size_t num_transformers = transformers->second.size();
+  size_t graph_version = 0;
+  InlinedVector<size_t> clean_at_version(num_transformers, kNotClean);
+
+  struct TransformerStats {
+    unsigned runs = 0;
+    unsigned modifying_runs = 0;
+    std::chrono::microseconds duration{0};
+  };
+  InlinedVector<TransformerStats> stats(num_transformers);
+
   for (unsigned step = 0; step < steps_; ++step) {
     if (IsLoadCancellationFlagSet()) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED, "Graph transformation canceled due to user request.");
     }
     bool graph_changed = false;
-    for (const auto& transformer : transformers->second) {
+    for (size_t i = 0; i < num_transformers; ++i) {
+      const auto& transformer = transformers->second[i];
       if (step > 0 && transformer->ShouldOnlyApplyOnce())
         continue;
 
+      if (clean_at_version[i] == graph_version)
+        continue;
+
       bool modified = false;
+      const auto start = std::chrono::steady_clock::now();
       ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
+      auto& transformer_stats = stats[i];
+      transformer_stats.duration += std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start);
+      ++transformer_stats.runs;
+
+      if (modified) {
+        ++transformer_stats.modifying_runs;
+        ++graph_version;
+      } else {
+        clean_at_version[i] = graph_version;
+      }
+
       graph_changed = graph_changed || modified;
       _is_graph_modified = _is_graph_modified || modified;
     }
@@ -49,6 +83,16 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
     }
   }
 
+  for (size_t i = 0; i < num_transformers; ++i) {
+    const auto& transformer_stats = stats[i];
+    if (transformer_stats.runs > 0) {
+      LOGS(logger, VERBOSE) << "GraphTransformer " << transformers->second[i]->Name()
+                            << " level " << static_cast<int>(level) << ": " << transformer_stats.runs
+                            << " run(s), " << transformer_stats.modifying_runs << " modified the graph, "
+                            << transformer_stats.duration.count() << " us";
+    }
+  }
+
   return Status::OK();
 }
 
@@ -483,12 +483,14 @@ Status GroupQueryAttentionFusion::ApplyImpl(
       }
 
       mat_mul_or_n_bits_new_node->GetMutableAttributes()["N"] = ONNX_NAMESPACE::MakeAttribute("N", static_cast<int64_t>(output_hidden_size));
+      mat_mul_or_n_bits_new_node->MarkAttributesChanged();
     }
 
     mat_mul_or_n_bits_new_node->SetExecutionProviderType(node.GetExecutionProviderType());
     FusePreGQANodes(graph, q_node, k_node, v_node, rotary_node_1, rotary_node_2, mat_mul_or_n_bits_new_node, matmul_or_nbits_output);
 
     node.GetMutableAttributes()["do_rotary"] = ONNX_NAMESPACE::MakeAttribute("do_rotary", static_cast<int64_t>(1));
+    node.MarkAttributesChanged();
 
     std::string empty_name;
     auto& empty_node_arg = graph.GetOrCreateNodeArg(empty_name, nullptr);
@@ -516,6 +516,7 @@ Status InsertCastTransformer::ApplyImpl(onnxruntime::Graph& graph, bool& modifie
         // Modify the dtype attribute (which defines the output type) to FLOAT if it is FLOAT16.
         if (dtype_attribute->second.i() == TensorProto_DataType_FLOAT16) {
           dtype_attribute->second.set_i(TensorProto_DataType_FLOAT);
+          node->MarkAttributesChanged();
         }
       }
 
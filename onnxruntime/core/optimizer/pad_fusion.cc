@@ -70,6 +70,7 @@ void UpdatePaddingAttribute(Node& child_node, const std::vector<int64_t>& pads_v
     uint32_t mirrored_pad_index = pads_index + (pads_size / 2);
     child_pads->Set(mirrored_child_index, child_pads->Get(mirrored_child_index) + pads_values[mirrored_pad_index]);
   }
+  child_node.MarkAttributesChanged();
 
   if (child_node.OpType() == "AveragePool") {
     child_node.AddAttribute("count_include_pad", static_cast<int64_t>(1));
@@ -276,9 +276,6 @@ common::Status If::SetupSubgraphExecutionInfo(const SessionState& session_state,
 }
 
 Status If::Compute(OpKernelContext* ctx) const {
-  ORT_ENFORCE(then_feeds_fetches_manager_ && else_feeds_fetches_manager_,
-              "CreateFeedsFetchesManager must be called prior to execution of graph.");
-
   auto ctx_internal = static_cast<OpKernelContextInternal*>(ctx);
 
   const auto& condition_tensor = *ctx->Input<Tensor>(0);
@@ -292,6 +289,11 @@ Status If::Compute(OpKernelContext* ctx) const {
   auto* session_state = ctx_internal->SubgraphSessionState(attribute);
   ORT_ENFORCE(session_state, "Subgraph SessionState was not found for '", attribute, "' attribute.");
 
+  // only the branch that is taken needs to be initialized if subgraph initialization is deferred
+  ORT_RETURN_IF_ERROR(ctx_internal->FinalizeSubgraphSessionState(attribute));
+  ORT_ENFORCE(condition ? then_feeds_fetches_manager_ : else_feeds_fetches_manager_,
+              "CreateFeedsFetchesManager must be called prior to execution of graph.");
+
   const auto& info = condition ? then_info_ : else_info_;
   IfImpl impl{*ctx_internal, *session_state, *info};
 
@@ -391,6 +391,7 @@ Status Loop::Compute(OpKernelContext* ctx) const {
   auto* ctx_internal = static_cast<OpKernelContextInternal*>(ctx);
   auto* session_state = ctx_internal->SubgraphSessionState("body");
   ORT_ENFORCE(session_state, "Subgraph SessionState was not found for 'body' attribute.");
+  ORT_RETURN_IF_ERROR(ctx_internal->FinalizeSubgraphSessionState("body"));
   ORT_ENFORCE(feeds_fetches_manager_, "CreateFeedsFetchesManager must be called prior to execution of graph.");
 
   LoopImpl loop_impl{*ctx_internal, *session_state, *info_, concat_output_func_};
@@ -171,13 +171,14 @@ Status Scan<8>::SetupSubgraphExecutionInfo(const SessionState& session_state,
 
 template <>
 Status Scan<8>::Compute(OpKernelContext* ctx) const {
-  ORT_ENFORCE(feeds_fetches_manager_ && info_,
-              "CreateFeedsFetchesManager must be called prior to execution of graph.");
-
   auto ctx_internal = static_cast<OpKernelContextInternal*>(ctx);
   auto* session_state = ctx_internal->SubgraphSessionState("body");
   ORT_ENFORCE(session_state, "Subgraph SessionState was not found for 'body' attribute.");
 
+  ORT_RETURN_IF_ERROR(ctx_internal->FinalizeSubgraphSessionState("body"));
+  ORT_ENFORCE(feeds_fetches_manager_ && info_,
+              "CreateFeedsFetchesManager must be called prior to execution of graph.");
+
   Scan8Impl scan_impl{*ctx_internal, *session_state, *info_, input_directions_, device_helpers_};
 
   auto status = scan_impl.Initialize();
@@ -1,13 +1,16 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <functional>
+#include <vector>
 
 #include "cumsum.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/platform/threadpool.h"
 
 using namespace onnxruntime;
 
@@ -36,6 +39,176 @@ Status GetAxis(const Tensor* axis_tensor, int64_t input_rank, int64_t& axis_out)
 
 }  // namespace cumsum_op
 
+namespace {
+
+// Long 1D scans are split into blocks of this many elements for the block scan. The block size does not depend on the
+// number of threads, so the rounding of floating point sums is the same for every thread pool size.
+constexpr int64_t kScanBlockSize = 16 * 1024;
+
+// Minimum number of columns scanned by one task when the columns of a slice are split between threads.
+constexpr int64_t kMinColumnsPerTask = 64;
+
+inline int64_t CeilDiv(int64_t a, int64_t b) { return (a + b - 1) / b; }
+
+// Scans the columns [first_col, last_col) of one [dim, lower_dim_size] slice.
+template <typename T>
+void ScanColumns(const T* input, T* output, int64_t dim, int64_t lower_dim_size, int64_t first_col,
+                 int64_t last_col, bool exclusive, bool reverse) {
+  const int64_t num_cols = last_col - first_col;
+  // offset of the first column of the i-th row in scan order
+  auto row = [&](int64_t i) { return (reverse ? dim - 1 - i : i) * lower_dim_size + first_col; };
+
+  T* out = output + row(0);
+  if (exclusive) {
+    std::fill_n(out, num_cols, T{0});
+  } else {
+    std::copy_n(input + row(0), num_cols, out);
+  }
+
+  for (int64_t i = 1; i < dim; ++i) {
+    const T* prev_out = out;
+    const T* in = input + row(exclusive ? i - 1 : i);
+    out = output + row(i);
+    for (int64_t j = 0; j < num_cols; ++j) {
+      out[j] = prev_out[j] + in[j];
+    }
+  }
+}
+
+// Scans n values that are `step` (1 or -1) apart, starting from `*offset` or from the first value if offset is null.
+template <typename T>
+void ScanStrided(const T* input, T* output, int64_t n, std::ptrdiff_t step, bool exclusive, const T* offset) {
+  T sum = offset != nullptr ? *offset : T{0};
+  int64_t i = 0;
+  if (offset == nullptr && !exclusive) {
+    sum = input[0];
+    output[0] = sum;
+    i = 1;
+  }
+
+  if (exclusive) {
+    for (; i < n; ++i) {
+      output[i * step] = sum;
+      sum += input[i * step];
+    }
+  } else {
+    for (; i < n; ++i) {
+      sum += input[i * step];
+      output[i * step] = sum;
+    }
+  }
+}
+
+// Block scan of slices whose axis is the innermost dimension (lower_dim_size == 1) and long enough to be split
+// between threads: the sum of every block is computed in parallel, the sums are scanned serially into the offset of
+// each block, and the blocks are then scanned in parallel starting from their offsets.
+template <typename T>
+void BlockScan(const T* input, T* output, int64_t upper_dim_count, int64_t dim, bool exclusive, bool reverse,
+               concurrency::ThreadPool* tp) {
+  const int64_t num_blocks = CeilDiv(dim, kScanBlockSize);
+  const std::ptrdiff_t step = reverse ? -1 : 1;
+
+  // first element (in scan order) and length of a block
+  auto block = [&](std::ptrdiff_t task, std::ptrdiff_t& first, int64_t& length) {
+    const int64_t slice = task / num_blocks;
+    const int64_t begin = (task % num_blocks) * kScanBlockSize;
+    length = std::min(kScanBlockSize, dim - begin);
+    first = slice * dim + (reverse ? dim - 1 - begin : begin);
+  };
+
+  const double block_bytes = static_cast<double>(kScanBlockSize * sizeof(T));
+  std::vector<T> block_offsets(onnxruntime::narrow<size_t>(upper_dim_count * num_blocks));
+  concurrency::ThreadPool::TryParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(upper_dim_count * num_blocks),
+      TensorOpCost{block_bytes, 0.0, static_cast<double>(kScanBlockSize)},
+      [&](std::ptrdiff_t first_task, std::ptrdiff_t last_task) {
+        for (std::ptrdiff_t task = first_task; task < last_task; ++task) {
+          std::ptrdiff_t first;
+          int64_t length;
+          block(task, first, length);
+          T sum{0};
+          for (int64_t i = 0; i < length; ++i) {
+            sum += input[first + i * step];
+          }
+          block_offsets[task] = sum;
+        }
+      });
+
+  for (int64_t slice = 0; slice < upper_dim_count; ++slice) {
+    T* offsets = block_offsets.data() + slice * num_blocks;
+    T sum{0};
+    for (int64_t b = 0; b < num_blocks; ++b) {
+      const T block_sum = offsets[b];
+      offsets[b] = sum;
+      sum += block_sum;
+    }
+  }
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(upper_dim_count * num_blocks),
+      TensorOpCost{block_bytes, block_bytes, static_cast<double>(kScanBlockSize)},
+      [&](std::ptrdiff_t first_task, std::ptrdiff_t last_task) {
+        for (std::ptrdiff_t task = first_task; task < last_task; ++task) {
+          std::ptrdiff_t first;
+          int64_t length;
+          block(task, first, length);
+          // the first block of a slice starts from its first value like the serial scan
+          const T* offset = task % num_blocks == 0 ? nullptr : &block_offsets[task];
+          ScanStrided(input + first, output + first, length, step, exclusive, offset);
+        }
+      });
+}
+
+}  // namespace
+
+namespace cumsum_op {
+
+template <typename T>
+void ComputeCumSum(const T* input, T* output, int64_t upper_dim_count, int64_t dim, int64_t lower_dim_size,
+                   bool exclusive, bool reverse, concurrency::ThreadPool* tp) {
+  const int64_t num_threads = concurrency::ThreadPool::DegreeOfParallelism(tp);
+
+  // the block scan does not depend on the number of threads so the sums are rounded the same for every thread pool
+  if (lower_dim_size == 1 && dim >= 2 * kScanBlockSize) {
+    BlockScan(input, output, upper_dim_count, dim, exclusive, reverse, tp);
+    return;
+  }
+
+  // split the columns of the slices when there are fewer slices than threads
+  int64_t column_blocks = 1;
+  if (upper_dim_count < num_threads) {
+    column_blocks = std::min(CeilDiv(num_threads, upper_dim_count), CeilDiv(lower_dim_size, kMinColumnsPerTask));
+  }
+  const int64_t columns_per_block = CeilDiv(lower_dim_size, column_blocks);
+  column_blocks = CeilDiv(lower_dim_size, columns_per_block);
+
+  const double task_size = static_cast<double>(dim * columns_per_block);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(upper_dim_count * column_blocks),
+      TensorOpCost{task_size * sizeof(T), task_size * sizeof(T), task_size},
+      [&](std::ptrdiff_t first_task, std::ptrdiff_t last_task) {
+        for (std::ptrdiff_t task = first_task; task < last_task; ++task) {
+          const int64_t slice = task / column_blocks;
+          const int64_t first_col = (task % column_blocks) * columns_per_block;
+          const int64_t last_col = std::min(first_col + columns_per_block, lower_dim_size);
+          const int64_t slice_offset = slice * dim * lower_dim_size;
+          ScanColumns(input + slice_offset, output + slice_offset, dim, lower_dim_size, first_col, last_col,
+                      exclusive, reverse);
+        }
+      });
+}
+
+template void ComputeCumSum<float>(const float*, float*, int64_t, int64_t, int64_t, bool, bool,
+                                   concurrency::ThreadPool*);
+template void ComputeCumSum<double>(const double*, double*, int64_t, int64_t, int64_t, bool, bool,
+                                    concurrency::ThreadPool*);
+template void ComputeCumSum<int32_t>(const int32_t*, int32_t*, int64_t, int64_t, int64_t, bool, bool,
+                                     concurrency::ThreadPool*);
+template void ComputeCumSum<int64_t>(const int64_t*, int64_t*, int64_t, int64_t, int64_t, bool, bool,
+                                     concurrency::ThreadPool*);
+
+}  // namespace cumsum_op
+
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     CumSum,
     11,
@@ -166,8 +339,8 @@ Status CumSum<T>::Compute(OpKernelContext* ctx) const {
   // 1) out[upper_dims...][0][lower_dims...] = 0
   // 2) out[upper_dims...][i][lower_dims...] =
   //      in[upper_dims...][i-1][lower_dims...] + out[upper_dims...][i-1][lower_dims...]
-  // we loop through the [upper_dims...] and start applying the identity in each slice
-  // since the [lower_dims...] are adjecent in memory, so we can add them like vectors
+  // the slices of [upper_dims...] are independent and so are the [lower_dims...] columns of a slice. since the
+  // [lower_dims...] are adjacent in memory, each step of the identity adds them like vectors.
 
   const auto input_shape = input->Shape().GetDims();
   const size_t axis = onnxruntime::narrow<size_t>(axis_input);
@@ -177,70 +350,8 @@ Status CumSum<T>::Compute(OpKernelContext* ctx) const {
   const int64_t lower_dim_size =  // sizes of the slices we can treat as 1D arrays
       std::accumulate(input_shape.begin() + axis + 1, input_shape.end(), static_cast<int64_t>(1), std::multiplies<int64_t>());
 
-  if (!reverse_) {
-    const auto* input_iter = input->Data<T>();
-    auto* output_iter = output_tensor.MutableData<T>();
-    const auto* prev_output_iter = output_iter;
-
-    if (exclusive_) {
-      for (int64_t outer = 0; outer < upper_dim_count; outer++) {
-        prev_output_iter = output_iter;
-        for (int64_t inner = 0; inner < lower_dim_size; inner++) {
-          *(output_iter++) = 0;
-        }
-        for (int64_t cum_axis = 1; cum_axis < dim; cum_axis++) {
-          for (int64_t inner = 0; inner < lower_dim_size; inner++) {
-            *(output_iter++) = *(prev_output_iter++) + *(input_iter++);
-          }
-        }
-        input_iter += lower_dim_size;
-      }
-    } else {
-      for (int64_t outer = 0; outer < upper_dim_count; outer++) {
-        prev_output_iter = output_iter;
-        for (int64_t inner = 0; inner < lower_dim_size; inner++) {
-          *(output_iter++) = *(input_iter++);
-        }
-        for (int64_t cum_axis = 1; cum_axis < dim; cum_axis++) {
-          for (int64_t inner = 0; inner < lower_dim_size; inner++) {
-            *(output_iter++) = *(prev_output_iter++) + *(input_iter++);
-          }
-        }
-      }
-    }
-  } else {
-    // in this case the logic is mostly the same, but we start from the end
-    const auto* input_iter = input->Data<T>() + input->Shape().Size();
-    auto* output_iter = output_tensor.MutableData<T>() + output_shape.Size();
-    const auto* prev_output_iter = output_iter;
-
-    if (exclusive_) {
-      for (int64_t outer = upper_dim_count - 1; outer >= 0; outer--) {
-        prev_output_iter = output_iter;
-        for (int64_t inner = lower_dim_size - 1; inner >= 0; inner--) {
-          *(--output_iter) = 0;
-        }
-        for (int64_t cum_axis = dim - 1; cum_axis > 0; cum_axis--) {
-          for (int64_t inner = lower_dim_size - 1; inner >= 0; inner--) {
-            *(--output_iter) = *(--prev_output_iter) + *(--input_iter);
-          }
-        }
-        input_iter -= lower_dim_size;
-      }
-    } else {
-      for (int64_t outer = upper_dim_count - 1; outer >= 0; outer--) {
-        prev_output_iter = output_iter;
-        for (int64_t inner = lower_dim_size - 1; inner >= 0; inner--) {
-          *(--output_iter) = *(--input_iter);
-        }
-        for (int64_t cum_axis = dim - 1; cum_axis > 0; cum_axis--) {
-          for (int64_t inner = lower_dim_size - 1; inner >= 0; inner--) {
-            *(--output_iter) = *(--prev_output_iter) + *(--input_iter);
-          }
-        }
-      }
-    }
-  }
+  cumsum_op::ComputeCumSum(input->Data<T>(), output_tensor.MutableData<T>(), upper_dim_count, dim, lower_dim_size,
+                           exclusive_ != 0, reverse_ != 0, ctx->GetOperatorThreadPool());
 
   return Status::OK();
 }
@@ -22,5 +22,14 @@ namespace cumsum_op {
 
 Status GetAxis(const Tensor* axis_tensor, int64_t input_rank, int64_t& axis_out);
 
+#ifndef SHARED_PROVIDER
+// Computes the cumulative sum of `upper_dim_count` slices of shape [dim, lower_dim_size] along their first axis.
+// The slices and the columns of large slices are split between the threads of `tp`, and long innermost axes are
+// computed with a block scan.
+template <typename T>
+void ComputeCumSum(const T* input, T* output, int64_t upper_dim_count, int64_t dim, int64_t lower_dim_size,
+                   bool exclusive, bool reverse, concurrency::ThreadPool* tp);
+#endif
+
 }  // namespace cumsum_op
 }  // namespace onnxruntime
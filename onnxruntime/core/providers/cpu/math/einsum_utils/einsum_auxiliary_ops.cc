@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "einsum_auxiliary_ops.h"
+#include "core/mlas/inc/mlas.h"
 
 using namespace onnxruntime::common;
 
@@ -47,6 +48,33 @@ Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
   return Status::OK();
 }
 
+// Issue all the batches as a single MLAS call so that they are partitioned across the thread pool together
+// instead of each (potentially small) batch being threaded on its own
+template <>
+Status MatMul<float>(const float* input_1_data, const float* input_2_data, float* output_data,
+                     size_t left_stride, size_t right_stride, size_t output_stride,
+                     size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+                     void* /*einsum_cuda_assets*/) {
+  if (num_batches == 0) {
+    return Status::OK();
+  }
+
+  std::vector<MLAS_SGEMM_DATA_PARAMS> data(num_batches);
+  for (size_t i = 0; i < num_batches; ++i) {
+    data[i].A = input_1_data + i * left_stride;
+    data[i].lda = K;
+    data[i].B = input_2_data + i * right_stride;
+    data[i].ldb = N;
+    data[i].C = output_data + i * output_stride;
+    data[i].ldc = N;
+    data[i].alpha = 1.0f;
+    data[i].beta = 0.0f;
+  }
+  MlasGemmBatch(CblasNoTrans, CblasNoTrans, M, N, K, data.data(), num_batches, tp);
+
+  return Status::OK();
+}
+
 // CPU specific ReduceSum helper
 template <typename T>
 std::unique_ptr<Tensor> ReduceSum(const Tensor& input, gsl::span<const int64_t> reduce_axes,
@@ -356,12 +384,6 @@ std::unique_ptr<Tensor> ReduceSum(const Tensor& input, const TensorShape& input_
 // Explicit template instantiations of functions
 
 // float
-template Status DeviceHelpers::CpuDeviceHelpers::MatMul<float>(
-    const float* input_1_data, const float* input_2_data, float* output_data,
-    size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
-    void* einsum_cuda_assets);
-
 template std::unique_ptr<Tensor> MatMul<float>(
     const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
     const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
@@ -72,6 +72,13 @@ Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
               size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
               void* einsum_cuda_assets);
 
+// float batches are issued as a single MlasGemmBatch call
+template <>
+Status MatMul<float>(const float* input_1_data, const float* input_2_data, float* output_data,
+                     size_t left_stride, size_t right_stride, size_t output_stride,
+                     size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+                     void* einsum_cuda_assets);
+
 template <typename T>
 std::unique_ptr<Tensor> ReduceSum(const Tensor& input, gsl::span<const int64_t> reduce_axes,
                                   bool keep_dims, AllocatorPtr allocator,
@@ -0,0 +1,290 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "einsum_contraction_planner.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+#include "core/common/common.h"
+#include "core/common/narrow.h"
+
+namespace onnxruntime {
+
+namespace EinsumOp {
+
+namespace {
+
+// Above this many operands the exhaustive search (3^n subset splits) is replaced by a greedy search
+constexpr size_t kMaxOperandsForOptimalSearch = 8;
+
+using OperandDims = std::vector<int64_t>;
+
+// Cost of a contraction path: the total FLOP estimate first and the total size of the intermediates second
+struct PathCost {
+  double flops = 0.0;
+  double intermediate_size = 0.0;
+
+  bool operator<(const PathCost& other) const {
+    if (flops != other.flops) {
+      return flops < other.flops;
+    }
+    return intermediate_size < other.intermediate_size;
+  }
+};
+
+double NumElements(const OperandDims& dims) {
+  double size = 1.0;
+  for (int64_t dim : dims) {
+    size *= static_cast<double>(dim);
+  }
+  return size;
+}
+
+// Every element of the "broadcasted" shape of the two operands costs a multiply-add
+double ContractionFlops(const OperandDims& left, const OperandDims& right) {
+  double flops = 1.0;
+  for (size_t i = 0; i < left.size(); ++i) {
+    flops *= static_cast<double>(std::max(left[i], right[i]));
+  }
+  return flops;
+}
+
+// The result keeps the subscript labels that are still required (i.e.) those in the output or
+// those that some operand not taking part in this contraction has; everything else is reduced.
+OperandDims ContractedDims(const OperandDims& left, const OperandDims& right, const std::vector<bool>& keep) {
+  OperandDims dims(left.size(), 1);
+  for (size_t i = 0; i < left.size(); ++i) {
+    if (keep[i]) {
+      dims[i] = std::max(left[i], right[i]);
+    }
+  }
+  return dims;
+}
+
+// Labels to keep after contracting `left` and `right` given the rest of the live operands
+std::vector<bool> KeptLabels(const std::vector<OperandDims>& operands, const std::vector<bool>& live,
+                             size_t left, size_t right, const std::vector<bool>& in_output) {
+  std::vector<bool> keep(in_output);
+  for (size_t o = 0; o < operands.size(); ++o) {
+    if (!live[o] || o == left || o == right) {
+      continue;
+    }
+    for (size_t i = 0; i < keep.size(); ++i) {
+      keep[i] = keep[i] || operands[o][i] > 1;
+    }
+  }
+  return keep;
+}
+
+// Simulates the given path (in SSA form) and accumulates its cost
+PathCost EvaluatePath(std::vector<OperandDims> operands, const ContractionPath& path,
+                      const std::vector<bool>& in_output) {
+  PathCost cost;
+  std::vector<bool> live(operands.size(), true);
+  for (const auto& step : path) {
+    auto keep = KeptLabels(operands, live, step.first, step.second, in_output);
+    auto dims = ContractedDims(operands[step.first], operands[step.second], keep);
+    cost.flops += ContractionFlops(operands[step.first], operands[step.second]);
+    cost.intermediate_size += NumElements(dims);
+    live[step.first] = false;
+    live[step.second] = false;
+    operands.push_back(std::move(dims));
+    live.push_back(true);
+  }
+  return cost;
+}
+
+ContractionPath LeftToRightPath(size_t num_inputs) {
+  ContractionPath path;
+  path.emplace_back(0, 1);
+  for (size_t input = 2; input < num_inputs; ++input) {
+    path.emplace_back(num_inputs + input - 2, input);
+  }
+  return path;
+}
+
+// Exhaustive search over all contraction trees via dynamic programming on operand subsets
+ContractionPath OptimalPath(const std::vector<OperandDims>& inputs, const std::vector<bool>& in_output) {
+  const size_t num_inputs = inputs.size();
+  const size_t num_labels = in_output.size();
+  const size_t num_subsets = size_t{1} << num_inputs;
+  const size_t all = num_subsets - 1;
+
+  // Dims of the intermediate that results from contracting all operands of a subset
+  std::vector<OperandDims> subset_dims(num_subsets, OperandDims(num_labels, 1));
+  for (size_t subset = 1; subset < num_subsets; ++subset) {
+    for (size_t i = 0; i < num_labels; ++i) {
+      bool keep = in_output[i];
+      int64_t dim = 1;
+      for (size_t o = 0; o < num_inputs; ++o) {
+        if (subset & (size_t{1} << o)) {
+          dim = std::max(dim, inputs[o][i]);
+        } else {
+          keep = keep || inputs[o][i] > 1;
+        }
+      }
+      subset_dims[subset][i] = keep ? dim : 1;
+    }
+  }
+
+  std::vector<PathCost> best_cost(num_subsets);
+  std::vector<size_t> best_split(num_subsets, 0);
+  for (size_t subset = 1; subset < num_subsets; ++subset) {
+    if ((subset & (subset - 1)) == 0) {
+      continue;  // single operand
+    }
+
+    const size_t lowest = subset & (~subset + 1);
+    bool found = false;
+    // Enumerate the splits (left, subset ^ left) with `left` holding the lowest operand so each split is seen once
+    for (size_t left = (subset - 1) & subset; left != 0; left = (left - 1) & subset) {
+      if ((left & lowest) == 0) {
+        continue;
+      }
+      const size_t right = subset ^ left;
+      PathCost cost;
+      cost.flops = best_cost[left].flops + best_cost[right].flops +
+                   ContractionFlops(subset_dims[left], subset_dims[right]);
+      cost.intermediate_size = best_cost[left].intermediate_size + best_cost[right].intermediate_size +
+                               NumElements(subset_dims[subset]);
+      if (!found || cost < best_cost[subset]) {
+        best_cost[subset] = cost;
+        best_split[subset] = left;
+        found = true;
+      }
+    }
+  }
+
+  ContractionPath path;
+  std::function<size_t(size_t)> emit = [&](size_t subset) -> size_t {
+    if ((subset & (subset - 1)) == 0) {
+      size_t index = 0;
+      while ((subset >> index) != 1) {
+        ++index;
+      }
+      return index;
+    }
+    const size_t left = emit(best_split[subset]);
+    const size_t right = emit(subset ^ best_split[subset]);
+    path.emplace_back(left, right);
+    return num_inputs + path.size() - 1;
+  };
+  emit(all);
+
+  return path;
+}
+
+// Greedily contracts the pair whose result removes the most elements (ties broken by FLOPs)
+ContractionPath GreedyPath(std::vector<OperandDims> operands, const std::vector<bool>& in_output) {
+  const size_t num_inputs = operands.size();
+  std::vector<bool> live(num_inputs, true);
+  ContractionPath path;
+
+  for (size_t step = 0; step + 1 < num_inputs; ++step) {
+    size_t best_left = 0;
+    size_t best_right = 0;
+    double best_score = std::numeric_limits<double>::infinity();
+    double best_flops = std::numeric_limits<double>::infinity();
+    OperandDims best_dims;
+
+    for (size_t left = 0; left < operands.size(); ++left) {
+      if (!live[left]) {
+        continue;
+      }
+      for (size_t right = left + 1; right < operands.size(); ++right) {
+        if (!live[right]) {
+          continue;
+        }
+        auto keep = KeptLabels(operands, live, left, right, in_output);
+        auto dims = ContractedDims(operands[left], operands[right], keep);
+        const double score = NumElements(dims) - NumElements(operands[left]) - NumElements(operands[right]);
+        const double flops = ContractionFlops(operands[left], operands[right]);
+        if (score < best_score || (score == best_score && flops < best_flops)) {
+          best_left = left;
+          best_right = right;
+          best_score = score;
+          best_flops = flops;
+          best_dims = std::move(dims);
+        }
+      }
+    }
+
+    path.emplace_back(best_left, best_right);
+    live[best_left] = false;
+    live[best_right] = false;
+    operands.push_back(std::move(best_dims));
+    live.push_back(true);
+  }
+
+  return path;
+}
+
+}  // namespace
+
+ContractionPath PlanContractionPath(const std::vector<TensorShape>& homogenized_input_dims,
+                                    const std::vector<int64_t>& subscript_indices_to_output_indices) {
+  const size_t num_inputs = homogenized_input_dims.size();
+  if (num_inputs <= 2) {
+    return {};
+  }
+
+  std::vector<OperandDims> inputs;
+  inputs.reserve(num_inputs);
+  for (const auto& shape : homogenized_input_dims) {
+    // Empty inputs produce an empty (or all zero) output cheaply in any order
+    if (shape.Size() == 0) {
+      return {};
+    }
+    auto dims = shape.GetDims();
+    inputs.emplace_back(dims.begin(), dims.end());
+  }
+
+  std::vector<bool> in_output(subscript_indices_to_output_indices.size());
+  for (size_t i = 0; i < in_output.size(); ++i) {
+    in_output[i] = subscript_indices_to_output_indices[i] != -1;
+  }
+
+  ContractionPath path = num_inputs <= kMaxOperandsForOptimalSearch ? OptimalPath(inputs, in_output)
+                                                                    : GreedyPath(inputs, in_output);
+
+  // Only deviate from the default order if it actually pays off
+  if (!(EvaluatePath(inputs, path, in_output) < EvaluatePath(inputs, LeftToRightPath(num_inputs), in_output))) {
+    return {};
+  }
+
+  return path;
+}
+
+ContractionPath ContractionPathCache::GetOrPlan(const std::vector<TensorShape>& homogenized_input_dims,
+                                                const std::vector<int64_t>& subscript_indices_to_output_indices) {
+  std::vector<int64_t> key;
+  for (const auto& shape : homogenized_input_dims) {
+    auto dims = shape.GetDims();
+    key.push_back(narrow<int64_t>(dims.size()));
+    key.insert(key.end(), dims.begin(), dims.end());
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = paths_.find(key);
+    if (it != paths_.end()) {
+      return it->second;
+    }
+  }
+
+  ContractionPath path = PlanContractionPath(homogenized_input_dims, subscript_indices_to_output_indices);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (paths_.size() >= kMaxCachedPaths) {
+    paths_.clear();
+  }
+  paths_.emplace(std::move(key), path);
+
+  return path;
+}
+
+}  // namespace EinsumOp
+
+}  // namespace onnxruntime
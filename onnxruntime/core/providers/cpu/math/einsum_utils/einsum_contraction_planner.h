@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// This module hosts the contraction order planner of the Einsum operator.
+
+// Einsum with more than 2 inputs is evaluated as a sequence of pair-wise contractions. The order in which the
+// operands are paired does not change the result (up to floating point rounding) but can change the cost by
+// orders of magnitude (e.g.) 'ij,jk,kl->il' with a tiny 'l' is far cheaper when 'jk' and 'kl' are contracted first.
+// Similar to numpy.einsum_path / opt_einsum, the planner estimates the FLOP count and the size of every
+// intermediate from the homogenized input dims and searches for the cheapest order:
+// an exhaustive (dynamic programming) search for a few operands and a greedy search otherwise.
+
+#pragma once
+
+#ifndef SHARED_PROVIDER
+#include "core/framework/tensor_shape.h"
+#endif
+
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace onnxruntime {
+
+namespace EinsumOp {
+
+// A contraction path is a list of operand pairs to contract.
+// Operands are identified by their "SSA" id: inputs take the ids [0, num_inputs) and the result of
+// the i-th contraction takes the id num_inputs + i.
+// An empty path means the default left-to-right order ((0, 1), (num_inputs, 2), ...).
+using ContractionPath = std::vector<std::pair<size_t, size_t>>;
+
+// Plans the contraction order for the given homogenized input dims
+// (each of rank num_subscript_indices, with dim value 1 for the subscript labels an input doesn't have).
+// `subscript_indices_to_output_indices` holds -1 for subscript labels that do not appear in the output.
+// Returns an empty path if the left-to-right order is already the cheapest.
+ContractionPath PlanContractionPath(const std::vector<TensorShape>& homogenized_input_dims,
+                                    const std::vector<int64_t>& subscript_indices_to_output_indices);
+
+// Caches contraction paths per input shape signature so that planning is done once per shape.
+// The equation is fixed per kernel, so the cache is owned by the kernel instance.
+class ContractionPathCache {
+ public:
+  ContractionPath GetOrPlan(const std::vector<TensorShape>& homogenized_input_dims,
+                            const std::vector<int64_t>& subscript_indices_to_output_indices);
+
+ private:
+  // Bound the number of distinct shapes that are remembered for models with dynamic shapes
+  static constexpr size_t kMaxCachedPaths = 32;
+
+  std::mutex mutex_;
+  std::map<std::vector<int64_t>, ContractionPath> paths_;
+};
+
+}  // namespace EinsumOp
+
+}  // namespace onnxruntime
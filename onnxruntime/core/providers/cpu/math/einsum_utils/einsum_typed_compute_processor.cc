@@ -343,6 +343,74 @@ void EinsumTypedComputeProcessor<T>::SetDeviceHelpers(const EinsumOp::DeviceHelp
   device_data_copy_func_ = device_data_copy_func;
 }
 
+template <typename T>
+void EinsumTypedComputeProcessor<T>::ProcessContractionPath(const EinsumOp::ContractionPath& path) {
+  const auto& subscript_indices_to_output_indices = einsum_compute_preprocessor_.GetMappedSubscriptIndicesToOutputindices();
+  auto& preprocessed_inputs = einsum_compute_preprocessor_.GetPreprocessedInputTensors();
+  const auto& raw_inputs = einsum_compute_preprocessor_.GetRawInputTensors();
+  const auto& homogenized_input_dims = einsum_compute_preprocessor_.GetHomogenizedInputDims();
+  const size_t num_subscript_labels = onnxruntime::narrow<size_t>(einsum_compute_preprocessor_.GetNumSubscriptIndices());
+  const size_t num_inputs = raw_inputs.size();
+
+  // Operands are indexed by their id in the path: inputs first, followed by the result of each contraction
+  std::vector<const Tensor*> operands;
+  std::vector<TensorShape> operand_dims;
+  std::vector<std::unique_ptr<Tensor>> intermediates(path.size());
+  std::vector<bool> live(num_inputs + path.size(), false);
+  operands.reserve(num_inputs + path.size());
+  operand_dims.reserve(num_inputs + path.size());
+  for (size_t input = 0; input < num_inputs; ++input) {
+    operands.push_back(preprocessed_inputs[input] ? preprocessed_inputs[input].get() : raw_inputs[input]);
+    operand_dims.push_back(homogenized_input_dims[input]);
+    live[input] = true;
+  }
+
+  for (size_t step = 0; step < path.size(); ++step) {
+    const size_t left = path[step].first;
+    const size_t right = path[step].second;
+    ORT_ENFORCE(left < operands.size() && right < operands.size() && live[left] && live[right] && left != right,
+                "Einsum op: Invalid contraction path");
+
+    // Reduce the dims that are not in the output and that no other live operand has
+    TensorShapeVector reduced_dims;
+    reduced_dims.reserve(num_subscript_labels);
+    for (size_t dim = 0; dim < num_subscript_labels; ++dim) {
+      if (subscript_indices_to_output_indices[dim] != -1) {
+        continue;
+      }
+      bool seen_elsewhere = false;
+      for (size_t o = 0; o < operands.size() && !seen_elsewhere; ++o) {
+        seen_elsewhere = live[o] && o != left && o != right && operand_dims[o][dim] > 1;
+      }
+      if (!seen_elsewhere) {
+        reduced_dims.push_back(static_cast<int64_t>(dim));
+      }
+    }
+
+    const bool is_final_pair = step == path.size() - 1;
+    auto result = PairwiseOperandProcess(*operands[left], operand_dims[left],
+                                         *operands[right], operand_dims[right],
+                                         reduced_dims, is_final_pair);
+
+    // Release the contracted intermediates as early as possible
+    live[left] = false;
+    live[right] = false;
+    if (left >= num_inputs) {
+      intermediates[left - num_inputs].reset();
+    }
+    if (right >= num_inputs) {
+      intermediates[right - num_inputs].reset();
+    }
+
+    if (!is_final_pair) {
+      operand_dims.push_back(result->Shape());
+      operands.push_back(result.get());
+      live[operands.size() - 1] = true;
+      intermediates[step] = std::move(result);
+    }
+  }
+}
+
 template <typename T>
 Status EinsumTypedComputeProcessor<T>::Run() {
   const auto& mapped_indices_to_last_input_index = einsum_compute_preprocessor_.GetMappedSubscriptIndicesToLastInputIndex();
@@ -357,6 +425,20 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
   auto num_inputs = context_->InputCount();
 
+  // With more than 2 inputs, contract the operands in a cost-based order if it beats the default left-to-right order
+  if (num_inputs > 2) {
+    const auto& subscript_indices_to_output_indices =
+        einsum_compute_preprocessor_.GetMappedSubscriptIndicesToOutputindices();
+    EinsumOp::ContractionPath path =
+        contraction_path_cache_
+            ? contraction_path_cache_->GetOrPlan(homogenized_input_dims, subscript_indices_to_output_indices)
+            : EinsumOp::PlanContractionPath(homogenized_input_dims, subscript_indices_to_output_indices);
+    if (!path.empty()) {
+      ProcessContractionPath(path);
+      return Status::OK();
+    }
+  }
+
   // Pre-process the first input so as to reduce any dims that only it has
   std::unique_ptr<const Tensor> result;
 
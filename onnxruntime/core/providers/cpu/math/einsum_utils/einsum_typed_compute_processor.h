@@ -9,6 +9,7 @@
 
 #include "einsum_auxiliary_ops.h"
 #include "einsum_compute_preprocessor.h"
+#include "einsum_contraction_planner.h"
 
 namespace onnxruntime {
 
@@ -33,6 +34,11 @@ class EinsumTypedComputeProcessor {
                         const EinsumOp::DeviceHelpers::ReduceSum<T>& device_reduce_sum_func,
                         const EinsumOp::DeviceHelpers::DataCopy& device_data_copy_func);
 
+  // Pass-in the kernel's cache of contraction paths (optional - the path is planned on every run without it)
+  void SetContractionPathCache(EinsumOp::ContractionPathCache* contraction_path_cache) {
+    contraction_path_cache_ = contraction_path_cache;
+  }
+
   Status Run();
 
  private:
@@ -48,6 +54,9 @@ class EinsumTypedComputeProcessor {
                                                  const gsl::span<const int64_t>& reduce_dims,
                                                  bool is_final_pair);
 
+  // Contracts the operands pair-wise in the order given by `path` (see EinsumOp::ContractionPath)
+  void ProcessContractionPath(const EinsumOp::ContractionPath& path);
+
   // Here we take a "candidate output"(candidate output is a tensor that is a permutation and / or a reshape away from the final output),
   // and after a few operations to get it to the required output structure, copy it to the op's output
   // The candidate output might contain dims that may not be part of the op's output (i.e.) the dims will have to be unsqueezed
@@ -65,6 +74,8 @@ class EinsumTypedComputeProcessor {
   EinsumOp::DeviceHelpers::ReduceSum<T> device_reduce_sum_func_;
   EinsumOp::DeviceHelpers::DataCopy device_data_copy_func_;
 
+  EinsumOp::ContractionPathCache* contraction_path_cache_ = nullptr;
+
   // Holds EP-specific assets required for (auxiliary) ops that need to be executed on non-CPU EPs
   void* einsum_ep_assets_;
 };
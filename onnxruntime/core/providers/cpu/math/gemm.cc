@@ -140,6 +140,28 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
   return true;
 }
 
+#if defined(MLAS_SBGEMM_SUPPORTED)
+// Adds beta * C to the output, broadcasting C as needed.
+static void GemmAccumulateBias(ptrdiff_t M, ptrdiff_t N, float beta,
+                               const float* c_data, const TensorShape* c_shape,
+                               float* y_data) {
+  auto output_mat = EigenMatrixMapRowMajor<float>(y_data, M, N);
+  if (c_shape->Size() == 1) {
+    // C is (), (1,) or (1, 1)
+    output_mat.array() += beta * *c_data;
+  } else if (c_shape->NumDimensions() == 1 || (*c_shape)[0] == 1) {
+    // C is (N,) or (1, N)
+    output_mat.rowwise() += beta * ConstEigenVectorMap<float>(c_data, N).transpose();
+  } else if ((*c_shape)[1] == 1) {
+    // C is (M, 1)
+    output_mat.colwise() += beta * ConstEigenVectorMap<float>(c_data, M);
+  } else {
+    // C is (M, N), no broadcast needed.
+    output_mat += beta * ConstEigenMatrixMapRowMajor<float>(c_data, M, N);
+  }
+}
+#endif
+
 template <typename T>
 void Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           ptrdiff_t M, ptrdiff_t N, ptrdiff_t K,
@@ -276,7 +298,17 @@ Status Gemm<float>::PrePack(const Tensor& tensor, int input_idx,
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-    is_packed = GemmPackBFp32(alloc, tensor, trans_A_ != CblasNoTrans, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
+#if defined(MLAS_SBGEMM_SUPPORTED)
+    // The bfloat16 kernels do not support transposing A or scaling by alpha.
+    if (use_fastmath_mode_ && trans_A_ == CblasNoTrans && alpha_ == 1.0f &&
+        static_cast<size_t>(tensor.Shape().Size()) >= kFastMathModeKernelsizeThreshold) {
+      is_packed = GemmPackBBfloat16(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
+      packed_b_is_bfloat16_ = is_packed;
+    } else
+#endif
+    {
+      is_packed = GemmPackBFp32(alloc, tensor, trans_A_ != CblasNoTrans, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
+    }
     bool share_prepacked_weights = (prepacked_weights != nullptr);
     if (is_packed && share_prepacked_weights) {
       prepacked_weights->buffers_.push_back(std::move(packed_b_));
@@ -434,6 +466,29 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   if (B) {
     ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, A->Data<float>(), B->Data<float>(), beta_,
                 c_data, c_shape, y_data, thread_pool);
+#if defined(MLAS_SBGEMM_SUPPORTED)
+  } else if (packed_b_is_bfloat16_ && K > 0) {
+    // A row vector C scaled by one is applied as the bias of the bfloat16 kernel,
+    // otherwise it is accumulated after the multiplication.
+    const bool c_is_bias = c_data != nullptr && beta_ == 1.0f && c_shape->Size() == N &&
+                           (c_shape->NumDimensions() == 1 || (*c_shape)[0] == 1);
+
+    MLAS_SBGEMM_DATA_PARAMS data;
+    data.A = A->Data<float>();
+    data.lda = static_cast<size_t>(K);
+    data.B = packed_b_.get();
+    data.ldb = 0;
+    data.C = y_data;
+    data.ldc = static_cast<size_t>(N);
+    data.Bias = c_is_bias ? c_data : nullptr;
+    data.AIsfp32 = true;
+    data.BIsfp32 = false;
+    MlasSBGemmBatch(static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K), 1, &data, thread_pool);
+
+    if (!c_is_bias && beta_ != 0 && c_data != nullptr) {
+      GemmAccumulateBias(M, N, beta_, c_data, c_shape, y_data);
+    }
+#endif
   } else {
     GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
     if (K > 0) {
@@ -9,6 +9,7 @@
 #include "core/common/common.h"
 #include "core/util/math.h"
 #include "core/providers/cpu/activation/activations.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 
 namespace onnxruntime {
 
@@ -25,6 +26,11 @@ template <typename T>
 class Gemm : protected GemmBase, public OpKernel {
  public:
   Gemm(const OpKernelInfo& info) : GemmBase(info), OpKernel(info) {
+#if defined(MLAS_SBGEMM_SUPPORTED)
+    if constexpr (std::is_same<T, float>::value) {
+      use_fastmath_mode_ = IsGemmFastMathModeEnabled(info);
+    }
+#endif
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -53,6 +59,15 @@ class Gemm : protected GemmBase, public OpKernel {
   // For fused gemm + activation
   std::unique_ptr<functors::ElementWiseRangedTransform<T>> activation_;
 
+#if defined(MLAS_SBGEMM_SUPPORTED)
+  // fastmath mode state, only used by Gemm<float>
+  bool use_fastmath_mode_{false};
+  // whether packed_b_ holds bfloat16 data for the fastmath kernels
+  bool packed_b_is_bfloat16_{false};
+  // same threshold as MatMul to outweigh the additional prepacking overhead
+  const size_t kFastMathModeKernelsizeThreshold = 32;
+#endif
+
   void ComputeActivation(_Inout_updates_(y_size) T* y_data, ptrdiff_t y_size, _Inout_opt_ concurrency::ThreadPool* thread_pool) const;
 };
 
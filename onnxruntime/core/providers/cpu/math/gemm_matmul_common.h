@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -14,4 +15,17 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
                    IAllocatorUniquePtr<void>& packed_b,
                    size_t& packed_b_size,
                    TensorShape& b_shape);
+
+#if defined(MLAS_SBGEMM_SUPPORTED)
+// Returns true if the session enables the bfloat16 fastmath mode for fp32 GEMM
+// and the processor has bfloat16 acceleration.
+bool IsGemmFastMathModeEnabled(const OpKernelInfo& info);
+
+bool GemmPackBBfloat16(AllocatorPtr& alloc,
+                       const Tensor& tensor_b,
+                       bool trans_b,
+                       IAllocatorUniquePtr<void>& packed_b,
+                       size_t& packed_b_size,
+                       TensorShape& b_shape);
+#endif
 };  // namespace onnxruntime
@@ -133,7 +133,15 @@ Status MatMul<T>::Compute(OpKernelContext* ctx) const {
 
   return Status::OK();
 }
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
+bool IsGemmFastMathModeEnabled(const OpKernelInfo& info) {
+  const auto& config_options = info.GetConfigOptions();
+  const bool enabled =
+      config_options.GetConfigOrDefault(kOrtSessionOptionsMlasGemmFastMathBfloat16, "0") == "1" ||
+      config_options.GetConfigOrDefault(kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16, "0") == "1";
+  return enabled && MlasBf16AccelerationSupported();
+}
+
 bool GemmPackBBfloat16(AllocatorPtr& alloc,
                        const Tensor& tensor_b,
                        bool trans_b,
@@ -163,10 +171,21 @@ bool GemmPackBBfloat16(AllocatorPtr& alloc,
   // buffer memory and we don not want it uninitialized and generate different hashes
   // if and when we try to cache this pre-packed buffer for sharing between sessions.
   memset(packed_b_data, 0, packed_b_size);
+
+  // The bfloat16 packing routine consumes a K x N matrix, so transpose B first
+  // if needed. This is a one time cost at session initialization.
+  const float* b_data = tensor_b.Data<float>();
+  std::vector<float> transposed_b;
+  if (trans_b) {
+    transposed_b.resize(K * N);
+    MlasTranspose(b_data, transposed_b.data(), N, K, nullptr);
+    b_data = transposed_b.data();
+  }
+
   MlasSBGemmConvertPackB(N,
                          K,
-                         tensor_b.Data<float>(),
-                         trans_b ? K : N,
+                         b_data,
+                         N,
                          packed_b_data);
   return true;
 }
@@ -180,7 +199,7 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
     size_t dim1 = 0;
     size_t dim2 = 0;
     TensorShape b_shape = tensor.Shape();
@@ -190,7 +209,9 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
       dim2 = static_cast<size_t>(b_shape[1]);
     }
 
-    if (use_fastmath_mode_ && (trans_b_attr_ == 0) && ((dim1 * dim2) >= kFastMathModeKernelsizeThreshold)) {
+    // The bfloat16 kernels do not support transposing A or scaling by alpha.
+    if (use_fastmath_mode_ && (trans_a_attr_ == 0) && (trans_b_attr_ == 0) && (alpha_attr_ == 1.0f) &&
+        ((dim1 * dim2) >= kFastMathModeKernelsizeThreshold)) {
       is_packed = GemmPackBBfloat16(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
     } else
 #endif
@@ -258,8 +279,9 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const size_t K = static_cast<size_t>(helper.K());
   const size_t lda = helper.Lda(trans_a);
   const size_t ldb = helper.Ldb(trans_b);
-#if defined(__aarch64__) && defined(__linux__)
-  if (use_fastmath_mode_ && !trans_b && ((N * K) >= kFastMathModeKernelsizeThreshold)) {
+#if defined(MLAS_SBGEMM_SUPPORTED)
+  if (use_fastmath_mode_ && (trans_a_attr_ == 0) && !trans_b && (alpha_attr_ == 1.0f) &&
+      ((N * K) >= kFastMathModeKernelsizeThreshold)) {
     std::vector<MLAS_SBGEMM_DATA_PARAMS> data(max_len);
     for (size_t i = 0; i < max_len; i++) {
       data[i].BIsfp32 = !(bool(packed_b_));
@@ -25,6 +25,8 @@
 #include <queue>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <type_traits>
 #include <core/common/safeint.h>
 
 namespace onnxruntime {
@@ -32,6 +34,8 @@ namespace onnxruntime {
 template <typename T>
 struct GreaterValueCmp {
   using DataType = T;
+  static constexpr bool kSelectsLargest = true;
+
   GreaterValueCmp(const T* data = nullptr) : data_(data) {
   }
 
@@ -53,6 +57,7 @@ struct GreaterValueCmp {
 template <typename T>
 struct LesserValueCmp {
   using DataType = T;
+  static constexpr bool kSelectsLargest = false;
 
   LesserValueCmp(const T* data = nullptr) : data_(data) {
   }
@@ -140,6 +145,149 @@ static void SelectTopK(const Comparator& comparer,
   // the data_holder now contains the indices of the top k elements in the first k elements
 }
 
+// Maps a float to an unsigned key with the same order. -0.0 and 0.0 compare equal so they get the same key.
+static inline uint32_t FloatToRadixKey(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  if (bits == 0x80000000u) {
+    bits = 0;
+  }
+  return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+// Selects the top k of the n contiguous values of a row without building and permuting an array of indices as
+// SelectTopK does. The key of the k-th best value is found one digit (11, 11 and 10 bits) at a time from a histogram
+// of the keys sharing the digits found so far. A last pass then collects the values that are better than it and
+// as many of the values equal to it as needed, lowest index first, which is the order of the comparators.
+// `indices` receives the k selected indices (offset by `first_index`) in increasing order.
+// Returns false without selecting anything if the row contains NaN, which has no place in that order.
+template <bool largest>
+static bool RadixSelectTopK(const float* data, int64_t n, unsigned k, int64_t first_index, int64_t* indices) {
+  constexpr int kDigitBits[] = {11, 11, 10};
+  std::vector<uint32_t> histogram(size_t{1} << 11);
+
+  auto key = [](float value) {
+    const uint32_t radix_key = FloatToRadixKey(value);
+    return largest ? radix_key : ~radix_key;
+  };
+
+  uint32_t prefix = 0;       // digits of the k-th best key found so far
+  uint32_t prefix_mask = 0;  // bits of those digits
+  uint32_t remaining = k;    // number of values to select among the ones matching the prefix
+  int shift = 32;
+
+  for (int digit_bits : kDigitBits) {
+    shift -= digit_bits;
+    const uint32_t digit_mask = (1u << digit_bits) - 1;
+    std::fill_n(histogram.begin(), size_t{1} << digit_bits, 0u);
+
+    if (prefix_mask == 0) {
+      for (int64_t i = 0; i < n; ++i) {
+        if (std::isnan(data[i])) {
+          return false;
+        }
+        ++histogram[key(data[i]) >> shift];
+      }
+    } else {
+      for (int64_t i = 0; i < n; ++i) {
+        const uint32_t value_key = key(data[i]);
+        if ((value_key & prefix_mask) == prefix) {
+          ++histogram[(value_key >> shift) & digit_mask];
+        }
+      }
+    }
+
+    // walk down from the best digit until the k-th best value is in the bucket
+    uint32_t digit = digit_mask;
+    while (histogram[digit] < remaining) {
+      remaining -= histogram[digit];
+      --digit;
+    }
+
+    prefix |= digit << shift;
+    prefix_mask |= digit_mask << shift;
+  }
+
+  unsigned selected = 0;
+  for (int64_t i = 0; i < n && selected < k; ++i) {
+    const uint32_t value_key = key(data[i]);
+    if (value_key > prefix) {
+      indices[selected++] = first_index + i;
+    } else if (value_key == prefix && remaining > 0) {
+      indices[selected++] = first_index + i;
+      --remaining;
+    }
+  }
+
+  return true;
+}
+
+// Long rows along the innermost axis (block_slice == 1) that are too few to keep the threads busy when split by row,
+// e.g. ranking millions of candidates for a handful of batch rows, are split into chunks instead. The top k of each
+// chunk are selected in parallel with a heap, and the top k of each row are then selected from the candidates of its
+// chunks. The comparators order by (value, index), so the result is the same as selecting from the whole row.
+template <class Comparator>
+static void FindTopKInLongRows(const typename Comparator::DataType* input_data, int64_t rows, int64_t cols,
+                               int64_t chunks_per_row, const unsigned k, bool sorted,
+                               typename Comparator::DataType* values_data, int64_t* indices_data,
+                               concurrency::ThreadPool* threadpool) {
+  using T = typename Comparator::DataType;
+  const Comparator comparer(input_data);
+  const int64_t num_chunks = rows * chunks_per_row;
+  std::vector<int64_t> candidates(onnxruntime::narrow<size_t>(num_chunks * k));
+
+  const double chunk_size = static_cast<double>(cols) / chunks_per_row;
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, onnxruntime::narrow<std::ptrdiff_t>(num_chunks),
+      TensorOpCost{chunk_size * sizeof(T), static_cast<double>(k * sizeof(int64_t)), chunk_size * 2},
+      [&](std::ptrdiff_t first_chunk, std::ptrdiff_t last_chunk) {
+        for (std::ptrdiff_t chunk = first_chunk; chunk < last_chunk; ++chunk) {
+          const int64_t row = chunk / chunks_per_row;
+          const int64_t chunk_in_row = chunk % chunks_per_row;
+          // chunks differ in size by 1 at most, so each of them holds at least k values
+          const int64_t begin = row * cols + cols * chunk_in_row / chunks_per_row;
+          const int64_t end = row * cols + cols * (chunk_in_row + 1) / chunks_per_row;
+          int64_t* heap = candidates.data() + chunk * k;
+
+          // add first k items starting from the bottom up
+          for (unsigned l = 0; l < k; ++l) {
+            heap[k - l - 1] = begin + l;
+            HeapifyIthPosition(heap, k - l - 1, k, comparer);
+          }
+
+          auto top = input_data[heap[0]];
+          for (int64_t idx = begin + k; idx < end; ++idx) {
+            if (comparer.CompareValueOnly(input_data[idx], top)) {
+              heap[0] = idx;
+              HeapifyIthPosition(heap, 0, k, comparer);
+              top = input_data[heap[0]];
+            }
+          }
+        }
+      });
+
+  const double num_candidates = static_cast<double>(chunks_per_row * k);
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, onnxruntime::narrow<std::ptrdiff_t>(rows),
+      TensorOpCost{num_candidates * sizeof(int64_t), static_cast<double>(k * (sizeof(T) + sizeof(int64_t))),
+                   num_candidates * 4},
+      [&](std::ptrdiff_t first_row, std::ptrdiff_t last_row) {
+        for (std::ptrdiff_t row = first_row; row < last_row; ++row) {
+          auto row_candidates = candidates.begin() + row * chunks_per_row * k;
+          std::nth_element(row_candidates, row_candidates + (k - 1), row_candidates + chunks_per_row * k, comparer);
+          if (sorted) {
+            std::sort(row_candidates, row_candidates + k, comparer);
+          }
+
+          for (unsigned l = 0; l < k; ++l) {
+            const int64_t idx = row_candidates[l];
+            values_data[row * k + l] = input_data[idx];
+            indices_data[row * k + l] = idx - row * cols;
+          }
+        }
+      });
+}
+
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
 // along with the metadata output 'indices'
@@ -173,6 +321,18 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
   int64_t threads_needed = static_cast<int64_t>(std::floor(input_shape.Size() * k / (128 * 1024)));
   num_threads = std::max(std::min(threads_needed, num_threads), static_cast<int64_t>(1));
 
+  if (block_slice == 1 && rows < tp_threads) {
+    // chunks of less than kMinChunkSize values or 8 * k values are not worth their candidates
+    constexpr int64_t kMinChunkSize = 16 * 1024;
+    const int64_t max_chunks = num_blocks / std::max(kMinChunkSize, static_cast<int64_t>(k) * 8);
+    const int64_t chunks_per_row = std::min((tp_threads + rows - 1) / rows, max_chunks);
+    if (chunks_per_row > 1) {
+      FindTopKInLongRows<Comparator>(input_data, rows, cols, chunks_per_row, k, sorted, values_data, indices_data,
+                                     threadpool);
+      return;
+    }
+  }
+
   // from testing various batch sizes relative to k, the following appears to work well as a selector.
   // tested with following combinations
   //   batch_size = [ 8, 16, 32, 64, 128, 256, 512, 1024, 2048 ]
@@ -285,6 +445,8 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
           }
         };
   } else {
+    // below this size nth_element on the indices is as fast as the radix select
+    constexpr int64_t kMinRadixSelectSize = 1024;
     find_top_k =
         [num_threads, rows, block_slice, num_blocks, k, sorted,
          input_data, cols,
@@ -299,7 +461,22 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
           for (auto i = work.start; i < work.end; ++i) {
             auto row_offset = i * cols;
             for (int64_t j = 0; j < block_slice; ++j) {
-              SelectTopK<Comparator>(comparer, row_offset, num_blocks, block_slice, j, k, sorted, data_holder);
+              bool selected = false;
+              if constexpr (std::is_same_v<typename Comparator::DataType, float>) {
+                // long contiguous rows are selected without sorting an array of indices when there is no NaN
+                if (block_slice == 1 && num_blocks >= kMinRadixSelectSize &&
+                    RadixSelectTopK<Comparator::kSelectsLargest>(input_data + row_offset, num_blocks, k,
+                                                                 row_offset, data_holder.data())) {
+                  if (sorted) {
+                    std::sort(data_holder.begin(), data_holder.begin() + k, comparer);
+                  }
+                  selected = true;
+                }
+              }
+
+              if (!selected) {
+                SelectTopK<Comparator>(comparer, row_offset, num_blocks, block_slice, j, k, sorted, data_holder);
+              }
 
               // Insert the top 'k' (largest or smallest) elements into the final output buffers
               for (int64_t l = 0; l < k; ++l) {
@@ -8,6 +8,8 @@
 #include "core/providers/cpu/ml/ml_common.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/common/safeint.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/text/string_dictionary.h"
 
 namespace onnxruntime {
 namespace ml {
@@ -24,13 +26,13 @@ class LabelEncoder final : public OpKernel {
 
     auto num_entries = string_classes.size();
 
-    string_to_int_map_.reserve(num_entries);
+    string_to_int_map_.Reserve(num_entries);
     int_to_string_map_.reserve(num_entries);
 
     for (size_t i = 0; i < num_entries; ++i) {
       const std::string& str = string_classes[i];
 
-      string_to_int_map_[str] = i;
+      string_to_int_map_.InsertOrAssign(str, static_cast<int64_t>(i));
       int_to_string_map_[i] = str;
     }
   }
@@ -38,13 +40,54 @@ class LabelEncoder final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  std::unordered_map<std::string, int64_t> string_to_int_map_;
+  StringDictionary<int64_t> string_to_int_map_;
   std::unordered_map<int64_t, std::string> int_to_string_map_;
 
   std::string default_string_;
   int64_t default_int_;
 };
 
+// String keys are looked up in a StringDictionary, other key types in the given hash map type.
+template <typename TKey, typename TValue, typename TMap>
+using LabelMap = std::conditional_t<std::is_same_v<TKey, std::string>, StringDictionary<TValue>, TMap>;
+
+template <typename TMap, typename TKey, typename TValue>
+void InsertLabel(TMap& map, const TKey& key, const TValue& value) {
+  map.emplace(key, value);
+}
+
+template <typename TValue>
+void InsertLabel(StringDictionary<TValue>& map, const std::string& key, const TValue& value) {
+  map.Emplace(key, value);
+}
+
+template <typename TMap, typename TKey, typename TValue>
+const TValue& LookupLabel(const TMap& map, const TKey& key, const TValue& default_value) {
+  const auto found = map.find(key);
+  return found == map.end() ? default_value : found->second;
+}
+
+template <typename TValue>
+const TValue& LookupLabel(const StringDictionary<TValue>& map, const std::string& key, const TValue& default_value) {
+  const TValue* found = map.Find(key);
+  return found == nullptr ? default_value : *found;
+}
+
+// Maps every input element through `map`, in parallel over the elements
+template <typename TMap, typename TKey, typename TValue>
+void EncodeLabels(const TMap& map, gsl::span<const TKey> input, gsl::span<TValue> output,
+                  const TValue& default_value, concurrency::ThreadPool* tp) {
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(input.size()),
+      TensorOpCost{static_cast<double>(sizeof(TKey)), static_cast<double>(sizeof(TValue)), 32.0},
+      [&map, input_data = input.data(), output_data = output.data(), &default_value](std::ptrdiff_t first,
+                                                                                     std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          output_data[i] = LookupLabel(map, input_data[i], default_value);
+        }
+      });
+}
+
 template <typename TKey, typename TValue>
 class LabelEncoder_2 final : public OpKernel {
  public:
@@ -63,8 +106,12 @@ class LabelEncoder_2 final : public OpKernel {
     ORT_ENFORCE(num_keys == num_values, "The ", key_field_name_, " and ", value_field_name_,
                 " attributes in LabelEncoder ", "(name: ", info.node().Name(), ") must have the same length. ",
                 "However, the number of key is ", num_keys, " and the number of ", "values is ", num_values, ".");
-    map_.reserve(num_keys);
-    for (size_t i = 0; i < num_keys; ++i) map_.emplace(keys[i], values[i]);
+    if constexpr (std::is_same_v<TKey, std::string>) {
+      map_.Reserve(num_keys);
+    } else {
+      map_.reserve(num_keys);
+    }
+    for (size_t i = 0; i < num_keys; ++i) InsertLabel(map_, keys[i], values[i]);
   }
 
   Status Compute(OpKernelContext* context) const override {
@@ -72,16 +119,8 @@ class LabelEncoder_2 final : public OpKernel {
     const TensorShape& shape = X->Shape();
     auto* Y = context->Output(0, shape);
 
-    auto input = X->template DataAsSpan<TKey>();
-    auto output = Y->template MutableDataAsSpan<TValue>();
-    auto input_iter = input.begin();
-    auto output_iter = output.begin();
-    while (input_iter != input.end()) {
-      const auto found = map_.find(*input_iter);
-      *output_iter = found == map_.end() ? default_value_ : found->second;
-      ++output_iter;
-      ++input_iter;
-    }
+    EncodeLabels(map_, X->template DataAsSpan<TKey>(), Y->template MutableDataAsSpan<TValue>(),
+                 default_value_, context->GetOperatorThreadPool());
     return Status::OK();
   }
 
@@ -94,7 +133,7 @@ class LabelEncoder_2 final : public OpKernel {
   // A collection of key-value pairs. Each (a_key, a_value) pair
   // means that the "a_key" in the input would be mapped to "a_value".
   // If map_ doesn't contain "a_key", we use default_value_ as its output.
-  InlinedHashMap<TKey, TValue> map_;
+  LabelMap<TKey, TValue, InlinedHashMap<TKey, TValue>> map_;
   TValue default_value_;
   // ONNX attribute name to load keys.
   std::string key_field_name_;
@@ -203,7 +242,7 @@ class LabelEncoder_4 final : public OpKernel {
     auto values = GetAttribute<TValue>(kernel_info, value_field_name_, "values_tensor");
     ORT_ENFORCE(keys.size() == values.size(), "Keys and values must have the same length.");
     for (size_t i = 0; i < keys.size(); ++i) {
-      map_.emplace(keys[i], values[i]);
+      InsertLabel(map_, keys[i], values[i]);
     }
   }
   Status Compute(OpKernelContext* context) const override {
@@ -211,22 +250,14 @@ class LabelEncoder_4 final : public OpKernel {
     const TensorShape& shape = X->Shape();
     auto* Y = context->Output(0, shape);
 
-    auto input = X->template DataAsSpan<TKey>();
-    auto output = Y->template MutableDataAsSpan<TValue>();
-    auto input_iter = input.begin();
-    auto output_iter = output.begin();
-    while (input_iter != input.end()) {
-      const auto found = map_.find(*input_iter);
-      *output_iter = found == map_.end() ? default_value_ : found->second;
-      ++output_iter;
-      ++input_iter;
-    }
+    EncodeLabels(map_, X->template DataAsSpan<TKey>(), Y->template MutableDataAsSpan<TValue>(),
+                 default_value_, context->GetOperatorThreadPool());
     return Status::OK();
   }
 
  private:
   void InitializeAttrFields(const OpKernelInfo& kernel_info);
-  HashMap<TKey, TValue, NaNHash<TKey>, NaNEqual<TKey>> map_;
+  LabelMap<TKey, TValue, HashMap<TKey, TValue, NaNHash<TKey>, NaNEqual<TKey>>> map_;
   TValue default_value_;
   std::string key_field_name_;
   std::string value_field_name_;
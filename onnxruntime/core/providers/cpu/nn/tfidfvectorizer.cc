@@ -7,9 +7,11 @@
 #include <core/common/safeint.h>
 #include "core/framework/tensor.h"
 #include "core/platform/threadpool.h"
+#include "core/providers/cpu/text/string_dictionary.h"
 
-#include <functional>
 #include <string_view>
+#include <type_traits>
+#include <vector>
 
 namespace onnxruntime {
 
@@ -23,83 +25,6 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>()),
     TfIdfVectorizer);
 
-namespace ngram_details {
-
-// NgrampPart implements a Trie like structure
-// for a unigram (1) it would insert into a root map with a valid id.
-// for (1,2,3) node 2 would be a child of 1 but have id == 0
-// because (1,2) does not exists. Node 3 would have a valid id.
-template <class T>
-struct NgramPart;
-
-template <>
-struct NgramPart<int64_t>;
-
-template <>
-struct NgramPart<std::string>;
-
-using NgramPartInt = NgramPart<int64_t>;
-using NgramPartString = NgramPart<std::string>;
-
-// Avoid recursive class definitions using unique_ptr + forward declaration
-using IntMap = InlinedHashMap<int64_t, std::unique_ptr<NgramPartInt>>;
-
-#ifndef DISABLE_ABSEIL
-using StrMap = absl::flat_hash_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                   std::hash<std::string>, std::equal_to<std::string>>;
-#else
-using StrMap = std::unordered_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                  std::hash<std::string>, std::equal_to<std::string>>;
-#endif
-
-template <>
-struct NgramPart<int64_t> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  IntMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
-};
-
-template <>
-struct NgramPart<std::string> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  StrMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
-};
-
-// Returns next ngram_id
-template <class K, class ForwardIter, class Map>
-inline size_t PopulateGrams(ForwardIter first, size_t ngrams, size_t ngram_size, size_t ngram_id,
-                            Map& c) {
-  for (; ngrams > 0; --ngrams) {
-    size_t n = 1;
-    Map* m = &c;
-    while (true) {
-      auto p = m->emplace(*first, std::make_unique<NgramPart<K>>(0));
-      ++first;
-      if (n == ngram_size) {
-        ORT_ENFORCE(p.first->second->id_ == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
-        p.first->second->id_ = ngram_id;
-        ++ngram_id;
-        break;
-      }
-      ++n;
-      m = &p.first->second->leafs_;
-    }
-  }
-  return ngram_id;
-}
-
-}  // namespace ngram_details
-}  // namespace onnxruntime
-
-using namespace onnxruntime::ngram_details;
-
-namespace onnxruntime {
-
-inline const void* AdvanceElementPtr(const void* p, size_t elements, size_t element_size) {
-  return reinterpret_cast<const uint8_t*>(p) + elements * element_size;
-}
-
 // The weighting criteria.
 // "TF"(term frequency),
 //    the counts are propagated to output
@@ -134,11 +59,18 @@ struct TfIdfVectorizer::Impl {
   gsl::span<const int64_t> ngram_indexes_;
   gsl::span<const float> weights_;
 
-  // This map contains references to pool_string_ entries
-  // of pool_strings attribute
-  StrMap str_map_;
-  // This map contains pool_int64s entries
-  IntMap int64_map_;
+  // The n-grams are compiled into a flat trie at construction.
+  // Every distinct pool item is interned to a dense token id (starting with 1, 0 - means not in the pool),
+  // so an input row is hashed once per item and the trie walks only compare integers.
+  // Node 0 is the root. Children of the root are indexed by token id directly,
+  // deeper edges live in a single hash map keyed by (parent node, token id).
+  bool pool_is_string_ = false;
+  StringDictionary<uint32_t> str_token_ids_;
+  InlinedHashMap<int64_t, uint32_t> int64_token_ids_;
+  std::vector<uint32_t> root_children_{0};
+  InlinedHashMap<uint64_t, uint32_t> edges_;
+  // n-gram id per node, 0 - means no n-gram ends at this node, search for a bigger N
+  std::vector<size_t> node_ngram_ids_{0};
 
   size_t output_size_ = 0;
 
@@ -153,6 +85,116 @@ struct TfIdfVectorizer::Impl {
     assert(ngram_id < ngram_indexes_.size());
     return SafeInt<size_t>(ngram_indexes_[ngram_id]);
   }
+
+  bool Empty() const { return node_ngram_ids_.size() == 1; }
+
+  static uint64_t EdgeKey(uint32_t node, uint32_t token_id) {
+    return (static_cast<uint64_t>(node) << 32) | token_id;
+  }
+
+  uint32_t InternToken(int64_t token) {
+    auto p = int64_token_ids_.emplace(token, static_cast<uint32_t>(int64_token_ids_.size() + 1));
+    return p.first->second;
+  }
+
+  uint32_t InternToken(const std::string& token) {
+    const uint32_t next_id = static_cast<uint32_t>(str_token_ids_.Size() + 1);
+    str_token_ids_.Emplace(token, next_id);
+    return *str_token_ids_.Find(token);
+  }
+
+  // Returns the child node of `node` for the token or 0 if there is none
+  uint32_t Child(uint32_t node, uint32_t token_id) const {
+    if (node == 0) {
+      return root_children_[token_id];
+    }
+    auto hit = edges_.find(EdgeKey(node, token_id));
+    return hit == edges_.end() ? 0 : hit->second;
+  }
+
+  uint32_t AddChild(uint32_t node, uint32_t token_id) {
+    if (node == 0 && root_children_.size() <= token_id) {
+      root_children_.resize(token_id + 1, 0);
+    }
+    uint32_t child = Child(node, token_id);
+    if (child == 0) {
+      ORT_ENFORCE(node_ngram_ids_.size() < UINT32_MAX, "Too many n-gram items in the pool");
+      child = static_cast<uint32_t>(node_ngram_ids_.size());
+      node_ngram_ids_.push_back(0);
+      if (node == 0) {
+        root_children_[token_id] = child;
+      } else {
+        edges_.emplace(EdgeKey(node, token_id), child);
+      }
+    }
+    return child;
+  }
+
+  // Returns next ngram_id
+  template <class ForwardIter>
+  size_t PopulateGrams(ForwardIter first, size_t ngrams, size_t ngram_size, size_t ngram_id) {
+    for (; ngrams > 0; --ngrams) {
+      uint32_t node = 0;
+      for (size_t n = 0; n < ngram_size; ++n, ++first) {
+        node = AddChild(node, InternToken(*first));
+      }
+      ORT_ENFORCE(node_ngram_ids_[node] == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
+      node_ngram_ids_[node] = ngram_id;
+      ++ngram_id;
+    }
+    return ngram_id;
+  }
+
+  // Maps a row of input items to token ids, 0 for the items that are not in the pool
+  template <class T>
+  void MapTokens(const T* row, size_t row_size, uint32_t* token_ids) const {
+    for (size_t i = 0; i < row_size; ++i) {
+      if constexpr (std::is_same_v<T, std::string>) {
+        const uint32_t* id = str_token_ids_.Find(row[i]);
+        token_ids[i] = id == nullptr ? 0 : *id;
+      } else {
+        auto hit = int64_token_ids_.find(static_cast<int64_t>(row[i]));
+        token_ids[i] = hit == int64_token_ids_.end() ? 0 : hit->second;
+      }
+    }
+  }
+
+  // Walks the trie from every start position of the row for every skip distance
+  // and calls fn_weight(output index) for every n-gram found.
+  template <class FnWeight>
+  void CountNgrams(gsl::span<const uint32_t> token_ids, FnWeight&& fn_weight) const {
+    const size_t row_size = token_ids.size();
+    const size_t max_gram_length = narrow<size_t>(max_gram_length_);
+    const size_t max_skip_distance = narrow<size_t>(max_skip_count_) + 1;  // Convert to distance
+    size_t start_ngram_size = narrow<size_t>(min_gram_length_);
+
+    for (size_t skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
+      for (size_t ngram_start = 0; ngram_start < row_size; ++ngram_start) {
+        // We went far enough so no n-grams of any size can be gathered
+        if (ngram_start + SafeInt<size_t>(skip_distance) * (start_ngram_size - 1) >= row_size) {
+          break;
+        }
+
+        uint32_t node = 0;
+        for (size_t ngram_size = 1, item = ngram_start;
+             ngram_size <= max_gram_length && item < row_size;
+             ++ngram_size, item += skip_distance) {
+          node = Child(node, token_ids[item]);
+          if (node == 0) {
+            break;
+          }
+          if (ngram_size >= start_ngram_size && node_ngram_ids_[node] != 0) {
+            fn_weight(OutputIdToIncrement(node_ngram_ids_[node]));
+          }
+        }
+      }
+      // We count UniGrams only once since they are not affected
+      // by skip distance
+      if (start_ngram_size == 1 && ++start_ngram_size > max_gram_length) {
+        break;
+      }
+    }
+  }
 };
 
 TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), impl_(std::make_unique<Impl>()) {
@@ -241,9 +283,9 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
       // Skip loading into hash_set ngrams that are not in the range of [min_gram_length-max_gram_length]
       if (ngram_size >= min_gram_length && ngram_size <= max_gram_length) {
         if (pool_strings.empty()) {
-          ngram_id = PopulateGrams<int64_t>(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_map_);
+          ngram_id = impl_->PopulateGrams(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id);
         } else {
-          ngram_id = PopulateGrams<std::string>(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_map_);
+          ngram_id = impl_->PopulateGrams(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id);
         }
       } else {
         ngram_id += ngrams;
@@ -251,82 +293,15 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
     }
     ++ngram_size;
   }
+
+  impl_->pool_is_string_ = !pool_strings.empty();
+  // Every token id must be a valid index of the root children
+  const size_t num_tokens = impl_->pool_is_string_ ? impl_->str_token_ids_.Size() : impl_->int64_token_ids_.size();
+  impl_->root_children_.resize(num_tokens + 1, 0);
 }
 
 TfIdfVectorizer::~TfIdfVectorizer() = default;
 
-void TfIdfVectorizer::ComputeImpl(const void* x_data_raw, size_t elem_size, ptrdiff_t row_num, size_t row_size,
-                                  bool is_input_string, gsl::span<float> output_data,
-                                  std::function<void(size_t, gsl::span<float>&)>& fn_weight) const {
-  const void* const row_begin = AdvanceElementPtr(x_data_raw, row_num * row_size, elem_size);
-  const void* const row_end = AdvanceElementPtr(row_begin, row_size, elem_size);
-
-  const auto& impl = *impl_;
-  const auto max_gram_length = impl.max_gram_length_;
-  const auto max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
-  auto start_ngram_size = impl.min_gram_length_;
-  size_t output_idx;
-
-  for (auto skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
-    auto ngram_start = row_begin;
-    auto const ngram_row_end = row_end;
-
-    while (ngram_start < ngram_row_end) {
-      // We went far enough so no n-grams of any size can be gathered
-      auto at_least_this = AdvanceElementPtr(ngram_start, SafeInt<size_t>(skip_distance) * (start_ngram_size - 1), elem_size);
-      if (at_least_this >= ngram_row_end) {
-        break;
-      }
-
-      auto ngram_item = ngram_start;
-      if (is_input_string) {
-        const std::string* str_item = reinterpret_cast<const std::string*>(ngram_item);
-        const StrMap* str_map = &impl.str_map_;
-        for (auto ngram_size = 1;
-             !str_map->empty() &&
-             ngram_size <= max_gram_length &&
-             str_item < ngram_row_end;
-             ++ngram_size, str_item += skip_distance) {
-          auto hit = str_map->find(*str_item);
-          if (hit == str_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            output_idx = impl.OutputIdToIncrement(hit->second->id_);
-            fn_weight(output_idx, output_data);
-          }
-          str_map = &hit->second->leafs_;
-        }
-      } else {
-        const IntMap* int_map = &impl.int64_map_;
-        for (auto ngram_size = 1;
-             !int_map->empty() &&
-             ngram_size <= max_gram_length &&
-             ngram_item < ngram_row_end;
-             ++ngram_size, ngram_item = AdvanceElementPtr(ngram_item, skip_distance, elem_size)) {
-          int64_t val = (elem_size == 4) ? int64_t{*reinterpret_cast<const int32_t*>(ngram_item)} : *reinterpret_cast<const int64_t*>(ngram_item);
-          auto hit = int_map->find(val);
-          if (hit == int_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            output_idx = impl.OutputIdToIncrement(hit->second->id_);
-            fn_weight(output_idx, output_data);
-          }
-          int_map = &hit->second->leafs_;
-        }
-      }
-      // Sliding window shift
-      ngram_start = AdvanceElementPtr(ngram_start, 1, elem_size);
-    }
-    // We count UniGrams only once since they are not affected
-    // by skip distance
-    if (start_ngram_size == 1 && ++start_ngram_size > max_gram_length) {
-      break;
-    }
-  }
-}
-
 Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   auto X = ctx->Input<Tensor>(0);
   auto& input_shape = X->Shape();
@@ -372,9 +347,7 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   auto output_data = Y->MutableData<float>();
   const bool is_input_string = X->IsDataTypeString();
 
-  if (total_items == 0 ||
-      (is_input_string && impl_->str_map_.empty()) ||
-      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_map_.empty())) {
+  if (total_items == 0 || impl.Empty() || is_input_string != impl.pool_is_string_) {
     // TfidfVectorizer may receive an empty input when it follows a Tokenizer
     // (for example for a string containing only stopwords).
     // TfidfVectorizer returns a zero tensor of shape
@@ -384,48 +357,66 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
-  auto x_data_raw = ctx->Input<Tensor>(0)->DataRaw();
-  const auto elem_size = X->DataType()->Size();
-  int32_t num_batches = std::min<int32_t>(concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()) * 2, num_rows);
-
-  const auto& w = impl.weights_;
-  std::function<void(size_t, gsl::span<float>&)> fn_weight;
-
-  switch (impl.weighting_criteria_) {
-    case kTF:
-      fn_weight = [](size_t i, gsl::span<float>& out) { out[i] += 1.0f; };
-      break;
-    case kIDF:
-      if (!w.empty()) {
-        fn_weight = [&w](size_t i, gsl::span<float>& out) { out[i] = w[i]; };
-      } else {
-        fn_weight = [](size_t i, gsl::span<float>& out) { out[i] = 1.0f; };
-      }
-      break;
-    case kTFIDF:
-      if (!w.empty()) {
-        fn_weight = [&w](size_t i, gsl::span<float>& out) { out[i] += w[i]; };
+  const void* x_data_raw = X->DataRaw();
+  const bool is_input_int32 = X->IsDataType<int32_t>();
+  const size_t output_size = impl.output_size_;
+
+  // Rows are independent: each one is mapped to token ids once and then matched against the trie
+  // for every start position and skip distance, writing only its own output row.
+  auto compute_rows = [&impl, C, output_size, output_data, x_data_raw, is_input_string,
+                       is_input_int32](std::ptrdiff_t first, std::ptrdiff_t last, auto fn_weight) {
+    std::vector<uint32_t> token_ids(C);
+    for (std::ptrdiff_t row_num = first; row_num < last; ++row_num) {
+      const size_t row_offset = static_cast<size_t>(row_num) * C;
+      if (is_input_string) {
+        impl.MapTokens(static_cast<const std::string*>(x_data_raw) + row_offset, C, token_ids.data());
+      } else if (is_input_int32) {
+        impl.MapTokens(static_cast<const int32_t*>(x_data_raw) + row_offset, C, token_ids.data());
       } else {
-        fn_weight = [](size_t i, gsl::span<float>& out) { out[i] += 1.0f; };
+        impl.MapTokens(static_cast<const int64_t*>(x_data_raw) + row_offset, C, token_ids.data());
       }
-      break;
-    case kNone:  // fall-through
-    default:
-      assert(false);
-  }
 
-  std::function<void(ptrdiff_t)> fn = [this, C, output_data, x_data_raw, elem_size,
-                                       is_input_string, num_batches, num_rows, &fn_weight](ptrdiff_t batch_num) {
-    // Frequency holder allocate [B..output_size_] and init all to zero.
-    auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_batches, static_cast<size_t>(num_rows));
-    for (auto row_num = work.start; row_num < work.end; ++row_num) {
-      auto out = gsl::span<float>(output_data + row_num * this->impl_->output_size_, this->impl_->output_size_);
-      std::fill(out.begin(), out.end(), 0.0f);
-      ComputeImpl(x_data_raw, elem_size, row_num, C, is_input_string, out, fn_weight);
+      // Frequency holder [output_size_] init all to zero.
+      float* out = output_data + static_cast<size_t>(row_num) * output_size;
+      std::fill_n(out, output_size, 0.0f);
+      impl.CountNgrams(token_ids, [out, &fn_weight](size_t i) { fn_weight(out, i); });
+    }
+  };
+
+  const auto& w = impl.weights_;
+  auto fn = [&impl, &w, &compute_rows](std::ptrdiff_t first, std::ptrdiff_t last) {
+    switch (impl.weighting_criteria_) {
+      case kTF:
+        compute_rows(first, last, [](float* out, size_t i) { out[i] += 1.0f; });
+        break;
+      case kIDF:
+        if (!w.empty()) {
+          compute_rows(first, last, [&w](float* out, size_t i) { out[i] = w[i]; });
+        } else {
+          compute_rows(first, last, [](float* out, size_t i) { out[i] = 1.0f; });
+        }
+        break;
+      case kTFIDF:
+        if (!w.empty()) {
+          compute_rows(first, last, [&w](float* out, size_t i) { out[i] += w[i]; });
+        } else {
+          compute_rows(first, last, [](float* out, size_t i) { out[i] += 1.0f; });
+        }
+        break;
+      case kNone:  // fall-through
+      default:
+        assert(false);
     }
   };
 
-  concurrency::ThreadPool::TrySimpleParallelFor(ctx->GetOperatorThreadPool(), num_batches, std::move(fn));
+  // Every item of a row is hashed once and then starts up to (max_skip_count + 1) trie walks
+  // of at most max_gram_length steps.
+  const double walks_per_row = static_cast<double>(C) * static_cast<double>(impl.max_skip_count_ + 1) *
+                               static_cast<double>(impl.max_gram_length_);
+  const TensorOpCost cost{static_cast<double>(C * X->DataType()->Size()),
+                          static_cast<double>(output_size * sizeof(float)),
+                          static_cast<double>(C) * 8.0 + walks_per_row * 4.0};
+  concurrency::ThreadPool::TryParallelFor(ctx->GetOperatorThreadPool(), num_rows, cost, fn);
   return Status::OK();
 }
 
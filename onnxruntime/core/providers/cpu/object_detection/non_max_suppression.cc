@@ -13,10 +13,13 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 
-#include <queue>
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <utility>
 
 #include "core/common/narrow.h"
+#include "core/mlas/inc/mlas.h"
 #include "non_max_suppression_helper.h"
 
 // TODO:fix the warnings
@@ -118,6 +121,186 @@ Status NonMaxSuppressionBase::GetThresholdsFromInputs(const PrepareContext& pc,
   return Status::OK();
 }
 
+namespace {
+
+struct BoxInfoPtr {
+  float score_{};
+  int64_t index_{};
+
+  BoxInfoPtr() = default;
+  explicit BoxInfoPtr(float score, int64_t idx) : score_(score), index_(idx) {}
+
+  // Orders by descending score, then ascending index.
+  inline bool operator<(const BoxInfoPtr& rhs) const {
+    return score_ > rhs.score_ || (score_ == rhs.score_ && index_ < rhs.index_);
+  }
+};
+
+// Number of fields of a box in the layout used by MlasIouExceedsThreshold:
+// {xmin, ymin, xmax, ymax, area}.
+constexpr size_t kBoxFields = 5;
+
+// Converts the boxes to the {xmin, ymin, xmax, ymax, area} layout once so that the
+// per-pair IoU test does no format handling.
+void ComputeBoxCorners(const float* boxes, size_t num_boxes, int64_t center_point_box, float* corners) {
+  for (size_t i = 0; i < num_boxes; ++i, boxes += 4, corners += kBoxFields) {
+    float x_min{};
+    float y_min{};
+    float x_max{};
+    float y_max{};
+    // center_point_box_ only support 0 or 1
+    if (0 == center_point_box) {
+      // boxes data format [y1, x1, y2, x2],
+      MaxMin(boxes[1], boxes[3], x_min, x_max);
+      MaxMin(boxes[0], boxes[2], y_min, y_max);
+    } else {
+      // 1 == center_point_box_ => boxes data format [x_center, y_center, width, height]
+      const float width_half = boxes[2] / 2;
+      const float height_half = boxes[3] / 2;
+      x_min = boxes[0] - width_half;
+      x_max = boxes[0] + width_half;
+      y_min = boxes[1] - height_half;
+      y_max = boxes[1] + height_half;
+    }
+    corners[0] = x_min;
+    corners[1] = y_min;
+    corners[2] = x_max;
+    corners[3] = y_max;
+    corners[4] = (x_max - x_min) * (y_max - y_min);
+  }
+}
+
+// Estimates a score such that about `count` of the scores are not lower than it, from a strided
+// sample of the scores. Returns false if there are too few scores for a cutoff to pay off.
+bool EstimateScoreCutoff(const float* scores, size_t num_scores, size_t count, float& cutoff) {
+  constexpr size_t kSampleSize = 1024;
+  if (num_scores < 8 * count || num_scores < 2 * kSampleSize) {
+    return false;
+  }
+
+  std::array<float, kSampleSize> sample;
+  const size_t stride = num_scores / kSampleSize;
+  for (size_t i = 0; i < kSampleSize; ++i) {
+    sample[i] = scores[i * stride];
+    if (std::isnan(sample[i])) {
+      return false;
+    }
+  }
+
+  const size_t rank = count * kSampleSize / num_scores;
+  std::nth_element(sample.begin(), sample.begin() + rank, sample.end(), std::greater<float>());
+  cutoff = sample[rank];
+  return true;
+}
+
+}  // namespace
+
+void NonMaxSuppression::ComputeSelectedIndices(const PrepareContext& pc, int64_t center_point_box,
+                                               int64_t max_output_boxes_per_class, float iou_threshold,
+                                               float score_threshold, concurrency::ThreadPool* tp,
+                                               std::vector<SelectedIndex>& selected_indices) {
+  const auto num_boxes = static_cast<size_t>(pc.num_boxes_);
+  const auto num_pairs = narrow<size_t>(pc.num_batches_ * pc.num_classes_);
+
+  std::vector<float> corners(narrow<size_t>(pc.num_batches_) * num_boxes * kBoxFields);
+  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
+    ComputeBoxCorners(pc.boxes_data_ + batch_index * num_boxes * 4, num_boxes, center_point_box,
+                      corners.data() + batch_index * num_boxes * kBoxFields);
+  }
+
+  const size_t max_selected = std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), num_boxes);
+  const size_t min_chunk_size = std::max<size_t>(2 * max_selected, 64);
+
+  // Each (batch, class) pair is independent; the results are concatenated in order afterwards.
+  std::vector<std::vector<SelectedIndex>> pair_selected_indices(num_pairs);
+
+  const double cost = static_cast<double>(num_boxes) * 16.0;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_pairs), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<BoxInfoPtr> candidate_boxes;
+        candidate_boxes.reserve(num_boxes);
+        // Selected boxes are stored as kBoxFields planes of max_selected elements.
+        std::vector<float> selected_boxes(kBoxFields * max_selected);
+
+        for (std::ptrdiff_t pair_index = first; pair_index < last; ++pair_index) {
+          const int64_t batch_index = pair_index / pc.num_classes_;
+          const int64_t class_index = pair_index % pc.num_classes_;
+          const float* batch_corners = corners.data() + batch_index * num_boxes * kBoxFields;
+          auto& selected = pair_selected_indices[pair_index];
+
+          const auto* class_scores = pc.scores_data_ + pair_index * num_boxes;
+          size_t num_selected = 0;
+
+          // With many boxes, a cutoff estimated from a sample of the scores limits the candidates to
+          // the likely top boxes. Every box below the cutoff scores lower than every box above it, so
+          // if the top boxes do not yield enough selections the remaining boxes are simply visited next.
+          float cutoff = 0.0f;
+          const bool has_cutoff = EstimateScoreCutoff(class_scores, num_boxes, 2 * min_chunk_size, cutoff);
+
+          // Filter by score_threshold_, keeping the boxes on the requested side of the cutoff.
+          auto collect_candidates = [&](bool above_cutoff) {
+            candidate_boxes.clear();
+            for (size_t box_index = 0; box_index < num_boxes; ++box_index) {
+              const float score = class_scores[box_index];
+              if ((pc.score_threshold_ == nullptr || score > score_threshold) &&
+                  (!has_cutoff || (score >= cutoff) == above_cutoff)) {
+                candidate_boxes.emplace_back(score, box_index);
+              }
+            }
+          };
+
+          // Only the top of the candidate list is usually visited, so candidates are ordered a chunk at
+          // a time: the chunk is selected with nth_element and then sorted. The chunk grows
+          // geometrically in case many boxes get suppressed.
+          auto select_candidates = [&]() {
+            size_t chunk_begin = 0;
+            size_t chunk_size = min_chunk_size;
+            while (chunk_begin < candidate_boxes.size() && num_selected < max_selected) {
+              const size_t chunk_end = std::min(chunk_begin + chunk_size, candidate_boxes.size());
+              if (chunk_end < candidate_boxes.size()) {
+                std::nth_element(candidate_boxes.begin() + chunk_begin, candidate_boxes.begin() + chunk_end,
+                                 candidate_boxes.end());
+              }
+              std::sort(candidate_boxes.begin() + chunk_begin, candidate_boxes.begin() + chunk_end);
+
+              for (size_t i = chunk_begin; i < chunk_end && num_selected < max_selected; ++i) {
+                const float* box = batch_corners + candidate_boxes[i].index_ * kBoxFields;
+
+                // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
+                if (!MlasIouExceedsThreshold(box, selected_boxes.data(), num_selected, max_selected, iou_threshold)) {
+                  for (size_t f = 0; f < kBoxFields; ++f) {
+                    selected_boxes[f * max_selected + num_selected] = box[f];
+                  }
+                  ++num_selected;
+                  selected.emplace_back(batch_index, class_index, candidate_boxes[i].index_);
+                }
+              }
+
+              chunk_begin = chunk_end;
+              chunk_size *= 2;
+            }
+          };
+
+          collect_candidates(true);
+          select_candidates();
+          if (has_cutoff && num_selected < max_selected) {
+            collect_candidates(false);
+            select_candidates();
+          }
+        }
+      });
+
+  size_t total_selected = 0;
+  for (const auto& selected : pair_selected_indices) {
+    total_selected += selected.size();
+  }
+  selected_indices.reserve(total_selected);
+  for (const auto& selected : pair_selected_indices) {
+    selected_indices.insert(selected_indices.end(), selected.begin(), selected.end());
+  }
+}
+
 Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   PrepareContext pc;
   ORT_RETURN_IF_ERROR(PrepareCompute(ctx, pc));
@@ -133,70 +316,9 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
-  const auto* const boxes_data = pc.boxes_data_;
-  const auto* const scores_data = pc.scores_data_;
-
-  struct BoxInfoPtr {
-    float score_{};
-    int64_t index_{};
-
-    BoxInfoPtr() = default;
-    explicit BoxInfoPtr(float score, int64_t idx) : score_(score), index_(idx) {}
-    inline bool operator<(const BoxInfoPtr& rhs) const {
-      return score_ < rhs.score_ || (score_ == rhs.score_ && index_ > rhs.index_);
-    }
-  };
-
-  const auto center_point_box = GetCenterPointBox();
-
   std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
-
-  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index);
-          }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index);
-        }
-      }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
-          }
-        }
-
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
-        }
-        sorted_boxes.pop();
-      }  // while
-    }  // for class_index
-  }  // for batch_index
+  ComputeSelectedIndices(pc, GetCenterPointBox(), max_output_boxes_per_class, iou_threshold, score_threshold,
+                         ctx->GetOperatorThreadPool(), selected_indices);
 
   constexpr auto last_dim = 3;
   const auto num_selected = selected_indices.size();
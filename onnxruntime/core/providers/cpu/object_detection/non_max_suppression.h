@@ -5,10 +5,12 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
 struct PrepareContext;
+struct SelectedIndex;
 
 class NonMaxSuppressionBase {
  protected:
@@ -38,5 +40,12 @@ class NonMaxSuppression final : public OpKernel, public NonMaxSuppressionBase {
   }
 
   Status Compute(OpKernelContext* context) const override;
+
+  // Runs the suppression for every (batch, class) pair of `pc` and returns the selected boxes
+  // ordered by batch, then class, then descending score.
+  static void ComputeSelectedIndices(const PrepareContext& pc, int64_t center_point_box,
+                                     int64_t max_output_boxes_per_class, float iou_threshold,
+                                     float score_threshold, concurrency::ThreadPool* tp,
+                                     std::vector<SelectedIndex>& selected_indices);
 };
 }  // namespace onnxruntime
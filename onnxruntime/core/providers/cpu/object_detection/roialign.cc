@@ -18,11 +18,13 @@
 #include "roialign.h"
 
 #include <cmath>
+#include <limits>
 #include <core/common/safeint.h>
 #include "core/util/math_cpuonly.h"
 #include "core/common/common.h"
 #include "core/framework/tensor.h"
 #include "core/platform/threadpool.h"
+#include "core/mlas/inc/mlas.h"
 
 using namespace onnxruntime::concurrency;
 
@@ -154,6 +156,22 @@ static void PreCalcForBilinearInterpolate(const int64_t height, const int64_t wi
   }
 }
 
+// Computes output[i] = sum_k weights[k * count + i] * input[offsets[k * count + i]].
+template <typename T>
+static void GatherInterpolate(const T* input, const int32_t* offsets, const T* weights, size_t taps,
+                              T* output, size_t count) {
+  if constexpr (std::is_same_v<T, float>) {
+    MlasGatherInterpolate(input, offsets, weights, taps, output, count);
+  } else {
+    std::fill_n(output, count, T{});
+    for (size_t k = 0; k < taps; k++) {
+      for (size_t i = 0; i < count; i++) {
+        output[i] += weights[k * count + i] * input[offsets[k * count + i]];
+      }
+    }
+  }
+}
+
 template <typename T>
 void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, float spatial_scale, int64_t height,
                      int64_t width, int64_t sampling_ratio, const T* bottom_rois, int64_t num_roi_cols, T* top_data,
@@ -163,11 +181,20 @@ void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, floa
   int64_t pooled_height = output_shape[2];
   int64_t pooled_width = output_shape[3];
 
-  // 100 is a random chosed value, need be tuned
-  double cost = static_cast<double>(channels * pooled_width * pooled_height * 100);
+  // When there are fewer ROIs than threads, the channels of each ROI are also split.
+  const int64_t channel_blocks =
+      std::clamp<int64_t>((ThreadPool::DegreeOfParallelism(ttp) + n_rois - 1) / std::max<int64_t>(n_rois, 1),
+                          1, std::max<int64_t>(channels, 1));
 
-  ThreadPool::TryParallelFor(ttp, static_cast<ptrdiff_t>(n_rois), cost, [&](ptrdiff_t n, ptrdiff_t end) {
-    for (; n != end; ++n) {
+  // 100 is a random chosed value, need be tuned
+  double cost = static_cast<double>(channels / channel_blocks * pooled_width * pooled_height * 100);
+
+  ThreadPool::TryParallelFor(ttp, static_cast<ptrdiff_t>(n_rois * channel_blocks), cost, [&](ptrdiff_t work, ptrdiff_t end) {
+    for (; work != end; ++work) {
+      const int64_t n = work / channel_blocks;
+      const int64_t channel_block = work % channel_blocks;
+      const int64_t c_start = channels * channel_block / channel_blocks;
+      const int64_t c_end = channels * (channel_block + 1) / channel_blocks;
       int64_t index_n = n * channels * pooled_width * pooled_height;
 
       const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
@@ -206,7 +233,40 @@ void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, floa
                                     roi_start_h, roi_start_w, bin_size_h, bin_size_w, roi_bin_grid_h,
                                     roi_bin_grid_w, pre_calc);
 
-      for (int64_t c = 0; c < channels; c++) {
+      if (mode == RoiAlignMode::avg) {
+        // Average pooling is a weighted sum of 4 taps per sample for each bin, so the
+        // precalculated samples are laid out as tap-major tables shared by all channels.
+        const size_t bins = narrow<size_t>(pooled_height * pooled_width);
+        const size_t taps = narrow<size_t>(4 * roi_bin_grid_h * roi_bin_grid_w);
+        std::vector<int32_t> offsets(taps * bins);
+        std::vector<T> weights(taps * bins);
+        for (size_t bin = 0; bin < bins; bin++) {
+          for (size_t sample = 0; sample < taps / 4; sample++) {
+            const auto& pc = pre_calc[bin * (taps / 4) + sample];
+            const size_t k = sample * 4;
+            offsets[(k + 0) * bins + bin] = static_cast<int32_t>(pc.pos1);
+            offsets[(k + 1) * bins + bin] = static_cast<int32_t>(pc.pos2);
+            offsets[(k + 2) * bins + bin] = static_cast<int32_t>(pc.pos3);
+            offsets[(k + 3) * bins + bin] = static_cast<int32_t>(pc.pos4);
+            weights[(k + 0) * bins + bin] = pc.w1;
+            weights[(k + 1) * bins + bin] = pc.w2;
+            weights[(k + 2) * bins + bin] = pc.w3;
+            weights[(k + 3) * bins + bin] = pc.w4;
+          }
+        }
+
+        for (int64_t c = c_start; c < c_end; c++) {
+          T* output = top_data + index_n + c * pooled_width * pooled_height;
+          GatherInterpolate(bottom_data + (roi_batch_ind * channels + c) * height * width,
+                            offsets.data(), weights.data(), taps, output, bins);
+          for (size_t bin = 0; bin < bins; bin++) {
+            output[bin] /= count;
+          }
+        }
+        continue;
+      }
+
+      for (int64_t c = c_start; c < c_end; c++) {
         int64_t index_n_c = index_n + c * pooled_width * pooled_height;
         const T* offset_bottom_data =
             bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
@@ -216,36 +276,24 @@ void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, floa
           for (int64_t pw = 0; pw < pooled_width; pw++) {
             int64_t index = index_n_c + ph * pooled_width + pw;
 
+            // max pooling
             T output_val = 0.;
-            if (mode == RoiAlignMode::avg) {  // avg pooling
-              for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
-                for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-                  const auto& pc = pre_calc[onnxruntime::narrow<size_t>(pre_calc_index)];
-                  output_val += pc.w1 * offset_bottom_data[pc.pos1] + pc.w2 * offset_bottom_data[pc.pos2] +
-                                pc.w3 * offset_bottom_data[pc.pos3] + pc.w4 * offset_bottom_data[pc.pos4];
-
-                  pre_calc_index += 1;
-                }
-              }
-              output_val /= count;
-            } else {  // max pooling
-              bool max_flag = false;
-              for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
-                for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-                  const auto& pc = pre_calc[onnxruntime::narrow<size_t>(pre_calc_index)];
-                  T val = std::max(
-                      std::max(std::max(pc.w1 * offset_bottom_data[pc.pos1], pc.w2 * offset_bottom_data[pc.pos2]),
-                               pc.w3 * offset_bottom_data[pc.pos3]),
-                      pc.w4 * offset_bottom_data[pc.pos4]);
-                  if (!max_flag) {
-                    output_val = val;
-                    max_flag = true;
-                  } else {
-                    output_val = std::max(output_val, val);
-                  }
-
-                  pre_calc_index += 1;
+            bool max_flag = false;
+            for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
+              for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
+                const auto& pc = pre_calc[onnxruntime::narrow<size_t>(pre_calc_index)];
+                T val = std::max(
+                    std::max(std::max(pc.w1 * offset_bottom_data[pc.pos1], pc.w2 * offset_bottom_data[pc.pos2]),
+                             pc.w3 * offset_bottom_data[pc.pos3]),
+                    pc.w4 * offset_bottom_data[pc.pos4]);
+                if (!max_flag) {
+                  output_val = val;
+                  max_flag = true;
+                } else {
+                  output_val = std::max(output_val, val);
                 }
+
+                pre_calc_index += 1;
               }
             }
 
@@ -316,6 +364,9 @@ Status RoiAlign<T>::Compute(OpKernelContext* context) const {
     return status;
   }
 
+  ORT_RETURN_IF_NOT(x_dims[2] * x_dims[3] <= std::numeric_limits<int32_t>::max(),
+                    "RoiAlign input spatial size ", x_dims[2] * x_dims[3], " exceeds the supported maximum.");
+
   auto& Y = *context->Output(0, {num_rois, num_channels, this->output_height_, this->output_width_});
 
   RoiAlignForward<T>(Y.Shape(), X_ptr->Data<T>(), this->spatial_scale_,
@@ -370,6 +370,79 @@ static void ValidateFastReduceRKR(const gsl::span<const int64_t>& fast_shape, co
   ORT_ENFORCE(fast_shape[1] == output.Shape().Size(), "Output size mismatch.");
 }
 
+static FastReduceKind MlasFastReduceKinds() {
+  return FastReduceKind::kR | FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR;
+}
+
+// MLAS vectorizes every contiguous layout returned by OptimizeShapeForFastReduce and
+// partitions the work itself, so the thread-count heuristics tuned for the Eigen
+// implementations do not apply here.
+static void MlasFastReduce(MLAS_REDUCE_KIND kind, FastReduceKind fast_kind, const Tensor& input,
+                           const gsl::span<const int64_t>& fast_shape, Tensor& output,
+                           concurrency::ThreadPool* tp) {
+  const float* data = input.Data<float>();
+  float* out = output.MutableData<float>();
+  switch (fast_kind) {
+    case FastReduceKind::kR:
+      ORT_ENFORCE(output.Shape().Size() == 1, "Output size mismatch.");
+      MlasReduce(kind, data, out, 1, narrow<size_t>(fast_shape[0]), 1, tp);
+      break;
+    case FastReduceKind::kKR:
+      ValidateFastReduceKR(fast_shape, output);
+      MlasReduce(kind, data, out, narrow<size_t>(fast_shape[0]), narrow<size_t>(fast_shape[1]), 1, tp);
+      break;
+    case FastReduceKind::kRK:
+      ValidateFastReduceRK(fast_shape, output);
+      MlasReduce(kind, data, out, 1, narrow<size_t>(fast_shape[0]), narrow<size_t>(fast_shape[1]), tp);
+      break;
+    case FastReduceKind::kKRK:
+      ValidateFastReduceKRK(fast_shape, output);
+      MlasReduce(kind, data, out, narrow<size_t>(fast_shape[0]), narrow<size_t>(fast_shape[1]),
+                 narrow<size_t>(fast_shape[2]), tp);
+      break;
+    case FastReduceKind::kRKR: {
+      ValidateFastReduceRKR(fast_shape, output);
+      // Every supported reduction is associative over equally sized groups: reduce the
+      // trailing axis first, then the leading one.
+      std::vector<float> partial(SafeInt<size_t>(fast_shape[0]) * fast_shape[1]);
+      MlasReduce(kind, data, partial.data(), partial.size(), narrow<size_t>(fast_shape[2]), 1, tp);
+      MlasReduce(kind, partial.data(), out, 1, narrow<size_t>(fast_shape[0]), narrow<size_t>(fast_shape[1]), tp);
+      break;
+    }
+    default:
+      ORT_THROW("Unsupported fast reduction kind for MLAS.");
+  }
+}
+
+// ArgMax and ArgMin reduce a single axis, which maps directly onto the
+// [outer, reduce, inner] layout of the MLAS kernels.
+static bool CommonMlasArgReduce(OpKernelContext* ctx, int64_t axis, bool keepdims,
+                                bool is_maximum, bool select_last_index) {
+  const Tensor* input = ctx->Input<Tensor>(0);
+  const TensorShape& input_shape = input->Shape();
+  if (input_shape.NumDimensions() == 0 || input_shape.Size() == 0) {
+    return false;
+  }
+
+  const size_t axis_index = narrow<size_t>(HandleNegativeAxis(axis, narrow<int64_t>(input_shape.NumDimensions())));
+  TensorShapeVector output_shape;
+  for (size_t i = 0; i < input_shape.NumDimensions(); ++i) {
+    if (i != axis_index) {
+      output_shape.push_back(input_shape[i]);
+    } else if (keepdims) {
+      output_shape.push_back(1);
+    }
+  }
+
+  Tensor* output = ctx->Output(0, output_shape);
+  MlasArgReduce(is_maximum, select_last_index, input->Data<float>(), output->MutableData<int64_t>(),
+                narrow<size_t>(input_shape.SizeToDimension(axis_index)),
+                narrow<size_t>(input_shape[axis_index]),
+                narrow<size_t>(input_shape.SizeFromDimension(axis_index + 1)),
+                ctx->GetOperatorThreadPool());
+  return true;
+}
+
 void ReduceAggregatorBase::FastReduceKR(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*) {
   ValidateMustBeOverloaded();
 }
@@ -785,6 +858,7 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
                             TensorShapeVector& output_shape,
                             TensorShapeVector& fast_axes,
                             FastReduceKind which_fast_reduce,
+                            MLAS_REDUCE_KIND which_mlas_reduce,
                             fast_reduce_fct* case_kr,
                             fast_reduce_fct* case_rk,
                             fast_reduce_fct* case_krk,
@@ -801,6 +875,12 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
       reduced_dims, input_axes.empty() ? axes_ : input_axes,
       fast_shape, output_shape, fast_axes, keepdims_ != 0, noop_with_empty_axes);
 
+  if (which_mlas_reduce != MlasReduceKindCount && IsFastReduceKindAvailable(fast_kind, MlasFastReduceKinds())) {
+    Tensor* output = ctx->Output(0, output_shape);
+    MlasFastReduce(which_mlas_reduce, fast_kind, *input, fast_shape, *output, ctx->GetOperatorThreadPool());
+    return true;
+  }
+
   if (which_fast_reduce != FastReduceKind::kNone) {
     if (IsFastReduceKindAvailable(fast_kind, which_fast_reduce)) {
       Tensor* output = ctx->Output(0, output_shape);
@@ -862,7 +942,7 @@ bool CommonFastReduce(OpKernelContext* ctx,
                       TensorShapeVector& fast_axes) {
   return CommonFastReduceSwitch(ctx, axes_, keepdims_, noop_with_empty_axes,
                                 fast_kind, fast_shape, output_shape, fast_axes,
-                                AGG::WhichFastReduce(), &AGG::FastReduceKR, &AGG::FastReduceRK,
+                                AGG::WhichFastReduce(), AGG::WhichMlasReduce(), &AGG::FastReduceKR, &AGG::FastReduceRK,
                                 &AGG::FastReduceKRK, &AGG::FastReduceRKR);
 }
 
@@ -1074,6 +1154,12 @@ std::unique_ptr<Tensor> ReduceSum<T>::Impl(const Tensor& input, gsl::span<const
     return output;
   }
 
+  if (ReduceAggregatorSum<T>::WhichMlasReduce() != MlasReduceKindCount &&
+      IsFastReduceKindAvailable(fast_kind, MlasFastReduceKinds())) {
+    MlasFastReduce(MlasReduceSum, fast_kind, input, fast_shape, *output, tp);
+    return output;
+  }
+
   if (IsFastReduceKindAvailable(fast_kind, ReduceAggregatorSum<T>::WhichFastReduce())) {
     switch (fast_kind) {
       case FastReduceKind::kKR: {
@@ -1130,6 +1216,11 @@ Status ReduceSumSquare<T>::Compute(OpKernelContext* ctx) const {
 
 template <typename T>
 Status ArgMax<T>::Compute(OpKernelContext* ctx) const {
+  if constexpr (std::is_same_v<T, float>) {
+    if (CommonMlasArgReduce(ctx, axes_[0], keepdims_, true, select_last_index_)) {
+      return Status::OK();
+    }
+  }
   if (select_last_index_) {
     CommonReduce1Loop<ReduceAggregatorArgMaxLastIndex<T>>(ctx, axes_, keepdims_);
   } else {
@@ -1140,6 +1231,11 @@ Status ArgMax<T>::Compute(OpKernelContext* ctx) const {
 
 template <typename T>
 Status ArgMin<T>::Compute(OpKernelContext* ctx) const {
+  if constexpr (std::is_same_v<T, float>) {
+    if (CommonMlasArgReduce(ctx, axes_[0], keepdims_, false, select_last_index_)) {
+      return Status::OK();
+    }
+  }
   if (select_last_index_) {
     CommonReduce1Loop<ReduceAggregatorArgMinLastIndex<T>>(ctx, axes_, keepdims_);
   } else {
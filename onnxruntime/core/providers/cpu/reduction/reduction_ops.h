@@ -16,6 +16,7 @@
 #include "core/platform/threadpool.h"
 #include "core/providers/cpu/reduction/reduction_kernel_base.h"
 #include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
 #include <cmath>
 
 namespace onnxruntime {
@@ -155,6 +156,8 @@ class ReduceAggregatorBase {
  public:
   // Fast reduction: see OptimizeShapeForFastReduce's comment.
   static inline FastReduceKind WhichFastReduce() { return FastReduceKind::kNone; }
+  // MLAS reduction computing the aggregator on every fast layout, MlasReduceKindCount if none.
+  static inline MLAS_REDUCE_KIND WhichMlasReduce() { return MlasReduceKindCount; }
   static void FastReduceKR(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*);
   static void FastReduceRK(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*);
   static void FastReduceKRK(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*);
@@ -229,6 +232,10 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
     return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR;
   }
 
+  static inline MLAS_REDUCE_KIND WhichMlasReduce() {
+    return std::is_same_v<T, float> ? MlasReduceSum : MlasReduceKindCount;
+  }
+
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
     const T* data = input.Data<T>();
@@ -317,6 +324,10 @@ class ReduceAggregatorMean : public ReduceAggregatorSum<T> {
   // Fast reduction
   // WhichFastReduce() already defined in ReduceAggregatorSum
 
+  static inline MLAS_REDUCE_KIND WhichMlasReduce() {
+    return std::is_same_v<T, float> ? MlasReduceMean : MlasReduceKindCount;
+  }
+
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
     ReduceAggregatorSum<T>::FastReduceKR(input, fast_shape, output, tp);
@@ -397,6 +408,10 @@ class ReduceAggregatorMax : public ReduceAggregator<T> {
     return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR;
   }
 
+  static inline MLAS_REDUCE_KIND WhichMlasReduce() {
+    return std::is_same_v<T, float> ? MlasReduceMaximum : MlasReduceKindCount;
+  }
+
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
     const T* data = input.Data<T>();
@@ -607,6 +622,10 @@ class ReduceAggregatorMin : public ReduceAggregator<T, T> {
     return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR;
   }
 
+  static inline MLAS_REDUCE_KIND WhichMlasReduce() {
+    return std::is_same_v<T, float> ? MlasReduceMinimum : MlasReduceKindCount;
+  }
+
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
     const T* data = input.Data<T>();
@@ -782,6 +801,10 @@ class ReduceAggregatorLogSumExp : public ReduceAggregator<T, T> {
   static void fill_for_empty_set(Tensor& output) {
     EigenMap<T>(output).array() = -std::numeric_limits<T>::infinity();
   }
+
+  static inline MLAS_REDUCE_KIND WhichMlasReduce() {
+    return std::is_same_v<T, float> ? MlasReduceLogSumExp : MlasReduceKindCount;
+  }
 };
 
 void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
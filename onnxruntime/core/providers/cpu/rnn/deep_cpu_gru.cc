@@ -492,21 +492,38 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
     gsl::span<T> hidden_output_2 = hidden_output.subspan(hidden_output_size_per_direction,
                                                          hidden_output_size_per_direction);
 
+    // The directions write to disjoint parts of the outputs so they can run at the same time
+    const bool concurrent_directions = RunDirectionsConcurrently(thread_pool, batch_size, hidden_size_, 3);
+    concurrency::ThreadPool* direction_thread_pool = concurrent_directions ? nullptr : thread_pool;
+
     detail::UniDirectionalGru<T> fw(alloc, seq_length, batch_size, input_size, hidden_size_,
                                     linear_before_reset_ != 0, Direction::kForward, bias_1, initial_hidden_1,
                                     activation_funcs_.Entries()[0],
                                     activation_funcs_.Entries()[1],
-                                    clip_, thread_pool);
-    fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_ZR_1, recurrent_weights_H_1,
-               output_1, hidden_output_1);
+                                    clip_, direction_thread_pool);
 
     detail::UniDirectionalGru<T> bw(alloc, seq_length, batch_size, input_size, hidden_size_,
                                     linear_before_reset_ != 0, Direction::kReverse, bias_2, initial_hidden_2,
                                     activation_funcs_.Entries()[2],
                                     activation_funcs_.Entries()[3],
-                                    clip_, thread_pool);
-    bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_ZR_2, recurrent_weights_H_2,
-               output_2, hidden_output_2);
+                                    clip_, direction_thread_pool);
+
+    auto compute_direction = [&](std::ptrdiff_t direction) {
+      if (direction == 0) {
+        fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_ZR_1, recurrent_weights_H_1,
+                   output_1, hidden_output_1);
+      } else {
+        bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_ZR_2, recurrent_weights_H_2,
+                   output_2, hidden_output_2);
+      }
+    };
+
+    if (concurrent_directions) {
+      concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, 2, compute_direction);
+    } else {
+      compute_direction(0);
+      compute_direction(1);
+    }
   } else {
     detail::UniDirectionalGru<T> gru_p(alloc, seq_length, batch_size, input_size, hidden_size_,
                                        linear_before_reset_ != 0, direction_, bias_1, initial_hidden_1,
@@ -788,10 +805,13 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
 
       out_added_offset = (step * batch_size_) * hidden_size_x3;
 
+      // Trailing rows whose sequences have ended are skipped by the GEMMs and the 1st set of activations
+      const int num_rows = NumRowsToCompute(sequence_lengths, 0, batch_size_, step, min_sequence_length);
+
       // calculate Ht-1*R[zr], and add to the weighted inputs that are in zrh
       // Ht-1 * R[zr] + Xt*(W[zr]^T)
       if (!recurrent_weightsZR_s.is_prepacked_) {
-        ComputeGemm(batch_size_, hidden_size_x2, hidden_size_, alpha,
+        ComputeGemm(num_rows, hidden_size_x2, hidden_size_, alpha,
                     prev_Ht, prev_Ht_end,
                     hidden_size_,
                     recurrent_weightsZR.begin(), recurrent_weightsZR.end(),
@@ -801,7 +821,7 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
       } else {
         MlasGemm(
             CblasNoTrans,
-            static_cast<size_t>(batch_size_), static_cast<size_t>(hidden_size_x2), static_cast<size_t>(hidden_size_), alpha,
+            static_cast<size_t>(num_rows), static_cast<size_t>(hidden_size_x2), static_cast<size_t>(hidden_size_), alpha,
             &*prev_Ht,
             static_cast<size_t>(hidden_size_),
             recurrent_weightsZR_s.buffer_,
@@ -823,7 +843,7 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
 
         // compute Ht-1 * (Rh^T) + Rbh
         if (!recurrent_weightsH_s.is_prepacked_) {
-          ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
+          ComputeGemm(num_rows, hidden_size_, hidden_size_, alpha,
                       prev_Ht, prev_Ht_end,  // Ht-1
                       hidden_size_,
                       recurrent_weightsH.begin(), recurrent_weightsH.end(),  // Rh^T
@@ -835,7 +855,7 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
         } else {
           MlasGemm(
               CblasNoTrans,
-              static_cast<size_t>(batch_size_), static_cast<size_t>(hidden_size_), static_cast<size_t>(hidden_size_), alpha,
+              static_cast<size_t>(num_rows), static_cast<size_t>(hidden_size_), static_cast<size_t>(hidden_size_), alpha,
               &*prev_Ht,
               static_cast<size_t>(hidden_size_),
               recurrent_weightsH_s.buffer_,
@@ -848,7 +868,7 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
       }
 
       // 1st Set Of Activations
-      for (int r = 0; r < batch_size_; r++) {
+      for (int r = 0; r < num_rows; r++) {
         const T* p_bias_r = use_bias_ ? SafeRawConstPointer<T>(batched_bias_WRr_local + r * hidden_size_,
                                                                batched_bias_WRr_local_end, hidden_size_)
                                       : nullptr;
@@ -889,7 +909,7 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
         // out_H currently contains Xt*(W[zrh]^T).
         auto out_H = zrh.begin() + out_added_offset;
 
-        for (int r = 0; r < batch_size_; r++) {
+        for (int r = 0; r < num_rows; r++) {
           // skip over the inputs with Z and R weights
           out_H += hidden_size_x2;
           for (int h = 0; h < hidden_size_; ++h) {
@@ -908,7 +928,7 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
 
         // Calculate Xt*(Wh^T) + rt (.) Ht-1 * Rh
         if (!recurrent_weightsH_s.is_prepacked_) {
-          ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
+          ComputeGemm(num_rows, hidden_size_, hidden_size_, alpha,
                       cur_h_local, cur_h_local_end,  // rt (.) Ht-1
                       hidden_size_,
                       recurrent_weightsH.begin(), recurrent_weightsH.end(),  // Rh^T
@@ -918,7 +938,7 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
         } else {
           MlasGemm(
               CblasNoTrans,
-              static_cast<size_t>(batch_size_), static_cast<size_t>(hidden_size_), static_cast<size_t>(hidden_size_), alpha,
+              static_cast<size_t>(num_rows), static_cast<size_t>(hidden_size_), static_cast<size_t>(hidden_size_), alpha,
               &*cur_h_local,
               static_cast<size_t>(hidden_size_),
               recurrent_weightsH_s.buffer_,
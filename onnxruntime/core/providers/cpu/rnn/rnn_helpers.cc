@@ -554,6 +554,33 @@ void merge_lstm_gates_to_memory(const float* pprev, const float* restrict pi, co
   }
 }
 
+// Fused LSTM cell for the default activations (f = Sigmoid, g = Tanh, h = Tanh) without peepholes.
+// piofc holds the i, o, f and c gate inputs back to back (4 * c values) and pb the matching fused bias or nullptr.
+// The sigmoid gates are contiguous so each activation is a single MLAS call over the whole row.
+// Updates the cell state in pcurr in-place and writes the hidden state to ph.
+void lstm_cell_sigmoid_tanh(const float* pb, float clip, float* piofc, float* pcurr, float* ph, int c) {
+  float* pi = piofc;
+  float* po = pi + c;
+  float* pf = po + c;
+  float* pg = pf + c;
+
+  if (pb != nullptr) {
+    clip_add_bias(clip, pb, piofc, 4 * c);
+  } else {
+    clip_ignore_bias(clip, nullptr, piofc, 4 * c);
+  }
+
+  MlasComputeLogistic(piofc, piofc, 3 * static_cast<size_t>(c));
+  MlasComputeTanh(pg, pg, c);
+
+  merge_lstm_gates_to_memory_in_place(pi, pf, pg, pcurr, c);
+
+  MlasComputeTanh(pcurr, ph, c);
+  for (int i = 0; i < c; i++) {
+    ph[i] *= po[i];
+  }
+}
+
 void gru_reset_gate_tanh(const float* ps1, float* ps2, float* pd, int c, float alpha, float beta) {
   ORT_UNUSED_PARAMETER(alpha);
   ORT_UNUSED_PARAMETER(beta);
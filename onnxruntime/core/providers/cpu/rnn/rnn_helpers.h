@@ -325,6 +325,31 @@ T* SafeRawPointer(typename gsl::span<T> span, size_t offset, size_t size) {
 void DumpMatrixImpl(const std::string& name, const float* src, int row, int col,
                     int offset = 0, int col_width = -1);
 
+// Returns how many rows of [first_row, first_row + num_rows) the recurrent GEMM needs to cover at `step`:
+// up to and including the last row whose sequence is still running. The rows past their sequence length
+// are masked out anyway, so when the batch is sorted by decreasing sequence length (as packed sequences are)
+// the GEMM shrinks to the live rows as the shorter sequences end.
+inline int NumRowsToCompute(gsl::span<const int> sequence_lengths, int first_row, int num_rows, int step,
+                            int min_sequence_length) {
+  if (step < min_sequence_length) {
+    return num_rows;
+  }
+  while (num_rows > 0 && sequence_lengths[first_row + num_rows - 1] <= step) {
+    --num_rows;
+  }
+  return num_rows;
+}
+
+// Returns true if the two directions of a bidirectional layer should run concurrently, each on a single thread.
+// This only pays off if a step's recurrent GEMM of one direction (batch_size x (num_gates * hidden_size) x
+// hidden_size) is too small for MLAS to split it across the threads anyway.
+inline bool RunDirectionsConcurrently(concurrency::ThreadPool* thread_pool, int batch_size, int hidden_size,
+                                      int num_gates) {
+  constexpr int64_t kMaxStepComplexity = 64 * 1024;
+  return concurrency::ThreadPool::DegreeOfParallelism(thread_pool) > 1 &&
+         int64_t{batch_size} * num_gates * hidden_size * hidden_size <= kMaxStepComplexity;
+}
+
 // Helper class to wrap the processing of the activation funcs and any alpha/beta values.
 // The alpha/beta values are consumed in the order of the activation funcs. once they run out
 // defaults will be used as needed.
@@ -383,6 +408,7 @@ void sigmoid_exact(float* pd, int c, float alpha, float beta);
 void tanh_exact(float* pd, int c, float alpha, float beta);
 void merge_lstm_gates_to_memory(const float* pprev, const float* pi, const float* pf, const float* pg, float* pcurr,
                                 int c);
+void lstm_cell_sigmoid_tanh(const float* pb, float clip, float* piofc, float* pcurr, float* ph, int c);
 void gru_reset_gate_tanh(const float* ps1, float* ps2, float* pd, int c, float alpha, float beta);
 void gru_reset_gate_sigmoid(const float* ps1, float* ps2, float* pd, int c, float alpha, float beta);
 void gru_reset_gate_relu(const float* ps1, const float* ps2, float* pd, int c, float alpha, float beta);
@@ -75,6 +75,11 @@ UniDirectionalLstm<T>::UniDirectionalLstm(
 
   clip_with_bias_ptr_ = use_bias_ ? deepcpu::clip_add_bias : deepcpu::clip_ignore_bias;
 
+  use_fused_gates_ = !use_peepholes_ && !input_forget_ &&
+                     activation_f_.func == deepcpu::sigmoid &&
+                     activation_g_.func == deepcpu::tanh &&
+                     activation_h_.func == deepcpu::tanh_m;
+
   SetNumThreads();
   AllocateBuffers();
   InitializeBuffers(initial_hidden_state, initial_cell_state);
@@ -103,10 +108,11 @@ void UniDirectionalLstm<T>::AllocateBuffers() {
   }
 
   if (use_bias_) {
-    bias_WRi_ = Allocate(allocator_, hidden_size_, bias_WRi_ptr_);
-    bias_WRf_ = Allocate(allocator_, hidden_size_, bias_WRf_ptr_);
-    bias_WRo_ = Allocate(allocator_, hidden_size_, bias_WRo_ptr_);
-    bias_WRc_ = Allocate(allocator_, hidden_size_, bias_WRc_ptr_);
+    bias_WR_ = Allocate(allocator_, 4 * hidden_size_, bias_WR_ptr_);
+    bias_WRi_ = bias_WR_.subspan(0 * hidden_size_, hidden_size_);
+    bias_WRo_ = bias_WR_.subspan(1 * hidden_size_, hidden_size_);
+    bias_WRf_ = bias_WR_.subspan(2 * hidden_size_, hidden_size_);
+    bias_WRc_ = bias_WR_.subspan(3 * hidden_size_, hidden_size_);
   }
 
   if (direction_ == kReverse) {
@@ -335,14 +341,19 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
 
       // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
       // Do it sequentially to avoid nested parallelism
-      ComputeGemm(num_seq_to_compute_adjusted, hidden_size_x4, hidden_size_, alpha,
-                  gsl::span<const T>(&*previous_state, previous_state_end - previous_state),  // Ht-1
-                  recurrent_weights,                                                          // R[iofc]
-                  beta, gsl::span<T>(&*step_out_IOFC, output_iofc.end() - step_out_IOFC),     // input contains Xt*(W[iofc]^T)
-                  hidden_size_x4,
-                  quantized_input_or_a_.data() + (seq_start * hidden_size_),
-                  quantized_C_buffer_.data() + (seq_start * hidden_size_x4),
-                  ttp);
+      // Trailing rows whose sequences have ended are skipped
+      const int num_rows_to_compute = NumRowsToCompute(sequence_lengths, seq_start, num_seq_to_compute_adjusted,
+                                                       step, min_sequence_length);
+      if (num_rows_to_compute > 0) {
+        ComputeGemm(num_rows_to_compute, hidden_size_x4, hidden_size_, alpha,
+                    gsl::span<const T>(&*previous_state, previous_state_end - previous_state),  // Ht-1
+                    recurrent_weights,                                                          // R[iofc]
+                    beta, gsl::span<T>(&*step_out_IOFC, output_iofc.end() - step_out_IOFC),     // input contains Xt*(W[iofc]^T)
+                    hidden_size_x4,
+                    quantized_input_or_a_.data() + (seq_start * hidden_size_),
+                    quantized_C_buffer_.data() + (seq_start * hidden_size_x4),
+                    ttp);
+      }
 
       DumpMatrix("Xt*(W[iofc]^T) + Ht-t*R[iofc]" + row_str, &*step_out_IOFC, num_seq_to_compute_adjusted, hidden_size_x4);
 
@@ -483,6 +494,22 @@ void UniDirectionalLstm<T>::GateComputations(
 
     // std::string row_str = " row[" + std::to_string(row + b) + "]";
 
+    if (use_fused_gates_) {
+      float* piofc = SafeRawPointer<T>(out + b * hidden_size_x4, out_end, hidden_size_x4);
+      float* pC_cur = SafeRawPointer<T>(C_prev + b * hidden_size_, C_prev_end, hidden_size_);
+      float* pH = SafeRawPointer<T>(batched_output + row * hidden_size_ + b * hidden_size_, batched_output_end,
+                                    hidden_size_);
+      deepcpu::lstm_cell_sigmoid_tanh(use_bias_ ? bias_WR_.data() : nullptr, clip_, piofc, pC_cur, pH, hidden_size_);
+
+      if (training_mode_) {
+        float* pC = SafeRawPointer<T>(batched_cell_states + row * hidden_size_ + b * hidden_size_,
+                                      batched_cell_states_end, hidden_size_);
+        std::copy_n(pC_cur, hidden_size_, pC);
+      }
+
+      continue;
+    }
+
     // check that we have hidden_size_x4 left starting at cur_out + b * hidden_size_x4, and get a raw pointer to that
     float* pi = SafeRawPointer<T>(out + b * hidden_size_x4, out_end, hidden_size_x4);
     float* po = pi + hidden_size_;
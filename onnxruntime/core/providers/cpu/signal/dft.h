@@ -1,8 +1,17 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "core/common/common.h"
+#include "core/common/inlined_containers.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/signal/fft_plan.h"
 
 namespace onnxruntime {
 
@@ -11,6 +20,9 @@ class DFT final : public OpKernel {
   bool is_onesided_ = true;
   int64_t axis_ = 0;
   bool is_inverse_ = false;
+  // FFT plans by transform length, built on first use and reused across Runs
+  mutable signal::FFTPlanCache<float> float_plans_;
+  mutable signal::FFTPlanCache<double> double_plans_;
 
  public:
   explicit DFT(const OpKernelInfo& info) : OpKernel(info) {
@@ -25,8 +37,35 @@ class DFT final : public OpKernel {
   Status Compute(OpKernelContext* ctx) const override;
 };
 
+namespace signal {
+
+// The samples of a streamed STFT signal (see kOrtRunOptionsConfigStftStreamId) that the previous Runs did not consume
+struct StftStreamState {
+  std::mutex mutex;
+  int64_t batch_size = 0;
+  int64_t frame_step = 0;
+  size_t element_size = 0;
+  // Samples of each batch row from the beginning of the next frame, [batch_size, tail_length]
+  int64_t tail_length = 0;
+  std::vector<uint8_t> tail;
+  // Samples at the beginning of the next Run that fall before the next frame (when frame_step > frame_length)
+  int64_t samples_to_skip = 0;
+};
+
+}  // namespace signal
+
 class STFT final : public OpKernel {
   bool is_onesided_ = true;
+  mutable signal::FFTPlanCache<float> float_plans_;
+  mutable signal::FFTPlanCache<double> double_plans_;
+
+  // Bound the state kept for streams that are never ended
+  static constexpr size_t kMaxStreams = 1024;
+  mutable std::mutex streams_mutex_;
+  mutable InlinedHashMap<std::string, std::shared_ptr<signal::StftStreamState>> streams_;
+
+  Status GetStreamState(OpKernelContext* ctx, std::string& stream_id, bool& is_end_of_stream,
+                        std::shared_ptr<signal::StftStreamState>& state) const;
 
  public:
   explicit STFT(const OpKernelInfo& info) : OpKernel(info) {
@@ -0,0 +1,338 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/signal/fft_plan.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace signal {
+
+namespace {
+
+// Prime factors up to this radix are handled by the generic butterfly. Lengths with a larger prime factor go through
+// Bluestein's algorithm, whose cost does not depend on the factorization.
+constexpr size_t kMaxGenericRadix = 31;
+
+constexpr double kPi = 3.14159265358979323846;
+
+// exp(sign * 2 * pi * i * numerator / denominator), computed in double precision
+template <typename T>
+std::complex<T> UnitRoot(uint64_t numerator, uint64_t denominator, bool inverse) {
+  const double angle = (inverse ? 2.0 : -2.0) * kPi * static_cast<double>(numerator) / static_cast<double>(denominator);
+  return std::complex<T>(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
+}
+
+size_t NextPowerOf2(size_t n) {
+  size_t result = 1;
+  while (result < n) {
+    result <<= 1;
+  }
+  return result;
+}
+
+}  // namespace
+
+template <typename T>
+FFTPlan<T>::FFTPlan(size_t n, bool inverse, bool real_input) : n_(n), inverse_(inverse), real_input_(real_input) {
+  ORT_ENFORCE(n > 0, "The DFT length must be greater than zero.");
+
+  if (real_input && n % 2 == 0) {
+    const size_t half = n / 2;
+    half_plan_ = std::make_unique<FFTPlan<T>>(half, inverse, false);
+    real_twiddles_.resize(half + 1);
+    for (size_t k = 0; k <= half; ++k) {
+      real_twiddles_[k] = UnitRoot<T>(k, n, inverse);
+    }
+    return;
+  }
+
+  // Factor powers of 4 first, then 2, then the odd primes in increasing order
+  size_t remaining = n;
+  size_t p = 4;
+  bool has_large_factor = false;
+  while (remaining > 1) {
+    while (remaining % p != 0) {
+      p = p == 4 ? 2 : (p == 2 ? 3 : p + 2);
+      if (p * p > remaining) {
+        p = remaining;
+      }
+    }
+    remaining /= p;
+    stages_.push_back(Stage{p, remaining});
+    has_large_factor = has_large_factor || p > kMaxGenericRadix;
+  }
+
+  if (!has_large_factor) {
+    twiddles_.resize(n);
+    for (size_t k = 0; k < n; ++k) {
+      twiddles_[k] = UnitRoot<T>(k, n, inverse);
+    }
+    return;
+  }
+
+  // Bluestein: with jk = (j^2 + k^2 - (k - j)^2) / 2, the DFT is the chirp weighted linear convolution of the chirp
+  // weighted input with the conjugate chirp, which is computed as a circular convolution of a power of 2 length.
+  stages_.clear();
+  const size_t m = NextPowerOf2(2 * n - 1);
+  convolution_plan_ = std::make_unique<FFTPlan<T>>(m, false, false);
+  chirp_.resize(n);
+  for (size_t j = 0; j < n; ++j) {
+    // j^2 mod 2n keeps the angle small so large lengths do not lose precision
+    const uint64_t j_squared = (static_cast<uint64_t>(j) * j) % (2 * static_cast<uint64_t>(n));
+    chirp_[j] = UnitRoot<T>(j_squared, 2 * n, inverse);
+  }
+
+  std::vector<std::complex<T>> conjugate_chirp(m, std::complex<T>(0, 0));
+  conjugate_chirp[0] = std::conj(chirp_[0]);
+  for (size_t j = 1; j < n; ++j) {
+    conjugate_chirp[j] = std::conj(chirp_[j]);
+    conjugate_chirp[m - j] = conjugate_chirp[j];
+  }
+  chirp_fft_.resize(m);
+  convolution_plan_->Execute(conjugate_chirp.data(), chirp_fft_.data(), nullptr);
+  // Fold the 1/m of the inverse convolution transform into the kernel
+  const T scale = static_cast<T>(1) / static_cast<T>(m);
+  for (auto& value : chirp_fft_) {
+    value *= scale;
+  }
+}
+
+template <typename T>
+size_t FFTPlan<T>::ScratchSize() const {
+  if (half_plan_) {
+    return half_plan_->ScratchSize();
+  }
+  const size_t complex_scratch = convolution_plan_ ? 2 * convolution_plan_->Size() : 0;
+  // Real input of odd length is widened to complex first
+  return real_input_ ? n_ + complex_scratch : complex_scratch;
+}
+
+template <typename T>
+void FFTPlan<T>::Execute(const std::complex<T>* in, std::complex<T>* out, std::complex<T>* scratch) const {
+  if (convolution_plan_) {
+    ExecuteBluestein(in, out, scratch);
+  } else if (stages_.empty()) {
+    out[0] = in[0];
+  } else {
+    Work(out, in, 1, stages_.data());
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::ExecuteReal(const T* in, std::complex<T>* out, std::complex<T>* scratch) const {
+  if (!half_plan_) {
+    std::complex<T>* widened = scratch;
+    for (size_t j = 0; j < n_; ++j) {
+      widened[j] = std::complex<T>(in[j], 0);
+    }
+    Execute(widened, out, scratch + n_);
+    return;
+  }
+
+  // z[j] = x[2j] + i x[2j + 1]. Its transform is Z = E + i O, where E and O are the (hermitian) transforms of the
+  // even and odd samples, so E[k] = (Z[k] + conj(Z[h - k])) / 2, O[k] = -i (Z[k] - conj(Z[h - k])) / 2 and
+  // X[k] = E[k] + w^k O[k].
+  const size_t half = n_ / 2;
+  half_plan_->Execute(reinterpret_cast<const std::complex<T>*>(in), out, scratch);
+
+  const std::complex<T> minus_half_i(0, static_cast<T>(-0.5));
+  const T z0_real = out[0].real();
+  const T z0_imag = out[0].imag();
+  out[0] = std::complex<T>(z0_real + z0_imag, 0);
+  out[half] = std::complex<T>(z0_real - z0_imag, 0);
+  for (size_t k = 1; k <= half / 2; ++k) {
+    const size_t k_mirror = half - k;
+    const std::complex<T> z = out[k];
+    const std::complex<T> z_mirror = out[k_mirror];
+    const std::complex<T> even = (z + std::conj(z_mirror)) * static_cast<T>(0.5);
+    const std::complex<T> odd = (z - std::conj(z_mirror)) * minus_half_i;
+    const std::complex<T> even_mirror = (z_mirror + std::conj(z)) * static_cast<T>(0.5);
+    const std::complex<T> odd_mirror = (z_mirror - std::conj(z)) * minus_half_i;
+    out[k] = even + real_twiddles_[k] * odd;
+    out[k_mirror] = even_mirror + real_twiddles_[k_mirror] * odd_mirror;
+  }
+
+  // The spectrum of a real signal is hermitian
+  for (size_t k = half + 1; k < n_; ++k) {
+    out[k] = std::conj(out[n_ - k]);
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::ExecuteBluestein(const std::complex<T>* in, std::complex<T>* out, std::complex<T>* scratch) const {
+  const size_t m = convolution_plan_->Size();
+  std::complex<T>* a = scratch;
+  std::complex<T>* a_fft = scratch + m;
+
+  for (size_t j = 0; j < n_; ++j) {
+    a[j] = in[j] * chirp_[j];
+  }
+  std::fill(a + n_, a + m, std::complex<T>(0, 0));
+  convolution_plan_->Execute(a, a_fft, nullptr);
+
+  // The inverse transform of the product is computed as conj(FFT(conj(.))) to reuse the forward plan
+  for (size_t i = 0; i < m; ++i) {
+    a_fft[i] = std::conj(a_fft[i] * chirp_fft_[i]);
+  }
+  convolution_plan_->Execute(a_fft, a, nullptr);
+
+  for (size_t k = 0; k < n_; ++k) {
+    out[k] = std::conj(a[k]) * chirp_[k];
+  }
+}
+
+// Decimation in time: transforms the `radix` interleaved sub-sequences of `in` (recursively) into consecutive blocks
+// of `out`, then combines them with the butterflies of the stage.
+template <typename T>
+void FFTPlan<T>::Work(std::complex<T>* out, const std::complex<T>* in, size_t fstride, const Stage* stage) const {
+  const size_t p = stage->radix;
+  const size_t m = stage->sub_length;
+
+  if (m == 1) {
+    for (size_t q = 0; q < p; ++q) {
+      out[q] = in[q * fstride];
+    }
+  } else {
+    for (size_t q = 0; q < p; ++q) {
+      Work(out + q * m, in + q * fstride, fstride * p, stage + 1);
+    }
+  }
+
+  switch (p) {
+    case 2:
+      Butterfly2(out, fstride, m);
+      break;
+    case 3:
+      Butterfly3(out, fstride, m);
+      break;
+    case 4:
+      Butterfly4(out, fstride, m);
+      break;
+    case 5:
+      Butterfly5(out, fstride, m);
+      break;
+    default:
+      ButterflyGeneric(out, fstride, m, p);
+      break;
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::Butterfly2(std::complex<T>* out, size_t fstride, size_t m) const {
+  const std::complex<T>* tw = twiddles_.data();
+  for (size_t k = 0; k < m; ++k) {
+    const std::complex<T> t = out[m + k] * tw[k * fstride];
+    out[m + k] = out[k] - t;
+    out[k] += t;
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::Butterfly3(std::complex<T>* out, size_t fstride, size_t m) const {
+  const std::complex<T>* tw = twiddles_.data();
+  // Imaginary part of the primitive 3rd root of unity in the direction of the plan
+  const T epi3 = tw[fstride * m].imag();
+  for (size_t k = 0; k < m; ++k) {
+    const std::complex<T> s1 = out[m + k] * tw[k * fstride];
+    const std::complex<T> s2 = out[2 * m + k] * tw[2 * k * fstride];
+    const std::complex<T> sum = s1 + s2;
+    const std::complex<T> diff = (s1 - s2) * epi3;
+    const std::complex<T> mid = out[k] - sum * static_cast<T>(0.5);
+    out[k] += sum;
+    out[m + k] = std::complex<T>(mid.real() - diff.imag(), mid.imag() + diff.real());
+    out[2 * m + k] = std::complex<T>(mid.real() + diff.imag(), mid.imag() - diff.real());
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::Butterfly4(std::complex<T>* out, size_t fstride, size_t m) const {
+  const std::complex<T>* tw = twiddles_.data();
+  for (size_t k = 0; k < m; ++k) {
+    const std::complex<T> s0 = out[m + k] * tw[k * fstride];
+    const std::complex<T> s1 = out[2 * m + k] * tw[2 * k * fstride];
+    const std::complex<T> s2 = out[3 * m + k] * tw[3 * k * fstride];
+    const std::complex<T> s5 = out[k] - s1;
+    const std::complex<T> s6 = out[k] + s1;
+    const std::complex<T> s3 = s0 + s2;
+    const std::complex<T> s4 = s0 - s2;
+    out[k] = s6 + s3;
+    out[2 * m + k] = s6 - s3;
+    // s5 -/+ i * s4 depending on the direction
+    if (inverse_) {
+      out[m + k] = std::complex<T>(s5.real() - s4.imag(), s5.imag() + s4.real());
+      out[3 * m + k] = std::complex<T>(s5.real() + s4.imag(), s5.imag() - s4.real());
+    } else {
+      out[m + k] = std::complex<T>(s5.real() + s4.imag(), s5.imag() - s4.real());
+      out[3 * m + k] = std::complex<T>(s5.real() - s4.imag(), s5.imag() + s4.real());
+    }
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::Butterfly5(std::complex<T>* out, size_t fstride, size_t m) const {
+  const std::complex<T>* tw = twiddles_.data();
+  const std::complex<T> ya = tw[fstride * m];
+  const std::complex<T> yb = tw[2 * fstride * m];
+  for (size_t k = 0; k < m; ++k) {
+    const std::complex<T> s0 = out[k];
+    const std::complex<T> s1 = out[m + k] * tw[k * fstride];
+    const std::complex<T> s2 = out[2 * m + k] * tw[2 * k * fstride];
+    const std::complex<T> s3 = out[3 * m + k] * tw[3 * k * fstride];
+    const std::complex<T> s4 = out[4 * m + k] * tw[4 * k * fstride];
+
+    const std::complex<T> s7 = s1 + s4;
+    const std::complex<T> s10 = s1 - s4;
+    const std::complex<T> s8 = s2 + s3;
+    const std::complex<T> s9 = s2 - s3;
+
+    out[k] = s0 + s7 + s8;
+
+    const std::complex<T> s5 = s0 + s7 * ya.real() + s8 * yb.real();
+    const std::complex<T> s6(s10.imag() * ya.imag() + s9.imag() * yb.imag(),
+                             -(s10.real() * ya.imag() + s9.real() * yb.imag()));
+    out[m + k] = s5 - s6;
+    out[4 * m + k] = s5 + s6;
+
+    const std::complex<T> s11 = s0 + s7 * yb.real() + s8 * ya.real();
+    const std::complex<T> s12(s9.imag() * ya.imag() - s10.imag() * yb.imag(),
+                              s10.real() * yb.imag() - s9.real() * ya.imag());
+    out[2 * m + k] = s11 + s12;
+    out[3 * m + k] = s11 - s12;
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::ButterflyGeneric(std::complex<T>* out, size_t fstride, size_t m, size_t p) const {
+  const std::complex<T>* tw = twiddles_.data();
+  std::array<std::complex<T>, kMaxGenericRadix> values;
+  for (size_t u = 0; u < m; ++u) {
+    for (size_t q = 0; q < p; ++q) {
+      values[q] = out[q * m + u];
+    }
+    for (size_t q = 0; q < p; ++q) {
+      const size_t k = q * m + u;
+      const size_t step = fstride * k;
+      size_t tw_index = 0;
+      std::complex<T> sum = values[0];
+      for (size_t r = 1; r < p; ++r) {
+        tw_index += step;
+        if (tw_index >= n_) {
+          tw_index -= n_;
+        }
+        sum += values[r] * tw[tw_index];
+      }
+      out[k] = sum;
+    }
+  }
+}
+
+template class FFTPlan<float>;
+template class FFTPlan<double>;
+
+}  // namespace signal
+}  // namespace onnxruntime
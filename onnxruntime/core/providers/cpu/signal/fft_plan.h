@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <complex>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace onnxruntime {
+namespace signal {
+
+// A precomputed plan for the n point DFT
+//   out[k] = sum_j in[j] * exp(s * 2 * pi * i * j * k / n)
+// with s = -1 for the forward and s = +1 for the (unscaled) inverse transform.
+//
+// Lengths whose prime factors are all small run a mixed-radix decimation in time FFT with radix 4, 2, 3 and 5
+// butterflies (and a generic butterfly for the other small primes). Any other length runs Bluestein's algorithm on top
+// of a power of 2 plan. A plan created for real input packs the even length signal into a complex signal of half the
+// length and untangles the spectrum afterwards.
+// Factors, twiddles and chirps are computed once at construction. A plan is immutable afterwards, so it is shared
+// between the threads running the transforms.
+template <typename T>
+class FFTPlan {
+ public:
+  FFTPlan(size_t n, bool inverse, bool real_input);
+
+  size_t Size() const { return n_; }
+
+  // Number of complex values of scratch space needed by Execute/ExecuteReal.
+  size_t ScratchSize() const;
+
+  // Transforms the n complex values of `in` into the n values of `out`. The buffers must not overlap.
+  // The plan must have been created for complex input.
+  void Execute(const std::complex<T>* in, std::complex<T>* out, std::complex<T>* scratch) const;
+
+  // Transforms the n real values of `in` into the n values of `out`. The plan must have been created for real input.
+  void ExecuteReal(const T* in, std::complex<T>* out, std::complex<T>* scratch) const;
+
+ private:
+  struct Stage {
+    size_t radix;
+    // Length of each of the `radix` sub-transforms combined by the stage
+    size_t sub_length;
+  };
+
+  void Work(std::complex<T>* out, const std::complex<T>* in, size_t fstride, const Stage* stage) const;
+  void Butterfly2(std::complex<T>* out, size_t fstride, size_t m) const;
+  void Butterfly3(std::complex<T>* out, size_t fstride, size_t m) const;
+  void Butterfly4(std::complex<T>* out, size_t fstride, size_t m) const;
+  void Butterfly5(std::complex<T>* out, size_t fstride, size_t m) const;
+  void ButterflyGeneric(std::complex<T>* out, size_t fstride, size_t m, size_t p) const;
+  void ExecuteBluestein(const std::complex<T>* in, std::complex<T>* out, std::complex<T>* scratch) const;
+
+  size_t n_;
+  bool inverse_;
+  bool real_input_;
+
+  // Mixed-radix transform
+  std::vector<Stage> stages_;
+  std::vector<std::complex<T>> twiddles_;
+
+  // Bluestein transform: the power of 2 convolution plan, the chirp and the transformed (and scaled) conjugate chirp
+  std::unique_ptr<FFTPlan<T>> convolution_plan_;
+  std::vector<std::complex<T>> chirp_;
+  std::vector<std::complex<T>> chirp_fft_;
+
+  // Real input of even length: the complex plan of half the length and the twiddles untangling its output
+  std::unique_ptr<FFTPlan<T>> half_plan_;
+  std::vector<std::complex<T>> real_twiddles_;
+};
+
+// Caches the plans of a kernel by (length, direction, real input) so they are built once instead of on every Run.
+template <typename T>
+class FFTPlanCache {
+ public:
+  std::shared_ptr<const FFTPlan<T>> Get(size_t n, bool inverse, bool real_input) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto key = std::make_tuple(n, inverse, real_input);
+    auto it = plans_.find(key);
+    if (it != plans_.end()) {
+      return it->second;
+    }
+    // Bound the number of distinct lengths that are remembered for models with dynamic shapes
+    if (plans_.size() >= kMaxCachedPlans) {
+      plans_.clear();
+    }
+    auto plan = std::make_shared<const FFTPlan<T>>(n, inverse, real_input);
+    plans_.emplace(key, plan);
+    return plan;
+  }
+
+ private:
+  static constexpr size_t kMaxCachedPlans = 16;
+
+  std::mutex mutex_;
+  std::map<std::tuple<size_t, bool, bool>, std::shared_ptr<const FFTPlan<T>>> plans_;
+};
+
+}  // namespace signal
+}  // namespace onnxruntime
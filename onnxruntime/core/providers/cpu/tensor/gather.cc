@@ -3,6 +3,10 @@
 
 // https://github.com/onnx/onnx/blob/main/docs/Operators.md#Gather
 #include "core/providers/cpu/tensor/gather.h"
+
+#include <algorithm>
+#include <cstring>
+
 #include "core/common/common.h"
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
@@ -83,6 +87,15 @@ Status GatherBase::PrepareForCompute(OpKernelContext* context, Prepare& p) const
   return Status::OK();
 }
 
+// Gathers the blocks [first, last) of a batch when a block is a single value of kBlockBytes bytes
+template <size_t kBlockBytes, typename Tin, typename TNormalize>
+static void GatherSmallBlocks(const uint8_t* src, uint8_t* dst, const Tin* indices_data, int64_t first, int64_t last,
+                              const TNormalize& normalize) {
+  for (int64_t i = first; i < last; ++i) {
+    memcpy(dst + i * kBlockBytes, src + normalize(indices_data[i]) * kBlockBytes, kBlockBytes);
+  }
+}
+
 template <typename Tin>
 Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uint8_t* dst_base, bool is_string_type,
                       const size_t element_bytes, const int64_t block_size, const int64_t M,
@@ -102,29 +115,66 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
     }
   }
 
-  auto lambda = [&](int64_t index) {
-    int64_t batch = index / N;
-    int64_t i = index % N;
+  const auto normalize = [axis_dim_limit](Tin idx) -> int64_t {
+    return idx < 0 ? idx + axis_dim_limit : idx;
+  };
 
-    const int64_t src_offset_batch = batch * data_batch_bytes;
-    const int64_t dst_offset_batch = batch * gathered_batch_bytes;
-    Tin idx = indices_data[i];
-    idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
-    const int64_t src_offset = src_offset_batch + idx * block_size;
-    const int64_t dst_offset = dst_offset_batch + i * block_size;
-
-    if (is_string_type) {
-      reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
-          reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
-    } else {
-      memcpy(dst_base + dst_offset, src_base + src_offset, narrow<size_t>(block_size));
+  // blocks of up to 8 bytes are copied with a fixed size memcpy, which compiles to a single load and store, instead of
+  // a call to memcpy per element
+  const bool copy_small_blocks = !is_string_type && block_size > 0 && block_size <= 8 &&
+                                 (block_size & (block_size - 1)) == 0;
+
+  // copies the blocks [first, last) of the output. index = batch * N + i.
+  auto copy_range = [&](int64_t first, int64_t last) {
+    int64_t batch = first / N;
+    int64_t i = first % N;
+    for (int64_t index = first; index < last; ++batch, i = 0) {
+      const int64_t end_i = std::min(N, i + (last - index));
+      index += end_i - i;
+      const uint8_t* src_batch = src_base + batch * data_batch_bytes;
+      uint8_t* dst_batch = dst_base + batch * gathered_batch_bytes;
+
+      if (is_string_type) {
+        const auto* src_strings = reinterpret_cast<const std::string*>(src_batch);
+        auto* dst_strings = reinterpret_cast<std::string*>(dst_batch);
+        const int64_t block = block_size / narrow<int64_t>(element_bytes);
+        for (; i < end_i; ++i) {
+          std::copy_n(src_strings + normalize(indices_data[i]) * block, block, dst_strings + i * block);
+        }
+      } else if (copy_small_blocks) {
+        switch (block_size) {
+          case 1:
+            GatherSmallBlocks<1>(src_batch, dst_batch, indices_data, i, end_i, normalize);
+            break;
+          case 2:
+            GatherSmallBlocks<2>(src_batch, dst_batch, indices_data, i, end_i, normalize);
+            break;
+          case 4:
+            GatherSmallBlocks<4>(src_batch, dst_batch, indices_data, i, end_i, normalize);
+            break;
+          default:
+            GatherSmallBlocks<8>(src_batch, dst_batch, indices_data, i, end_i, normalize);
+            break;
+        }
+      } else {
+        // runs of consecutive indices, e.g. from a Range or from sorted ids, are copied with a single memcpy
+        while (i < end_i) {
+          const int64_t idx = normalize(indices_data[i]);
+          int64_t run = 1;
+          while (i + run < end_i && normalize(indices_data[i + run]) == idx + run) {
+            ++run;
+          }
+          memcpy(dst_batch + i * block_size, src_batch + idx * block_size, narrow<size_t>(run * block_size));
+          i += run;
+        }
+      }
     }
   };
-  concurrency::ThreadPool::TryParallelFor(tp, SafeInt<ptrdiff_t>(M) * N, static_cast<double>(block_size),
-                                          [&lambda](ptrdiff_t first, ptrdiff_t last) {
-                                            for (int index = static_cast<int>(first), end = static_cast<int>(last); index < end; ++index) {
-                                              lambda(index);
-                                            }
+
+  const auto block_bytes = static_cast<double>(block_size);
+  concurrency::ThreadPool::TryParallelFor(tp, SafeInt<ptrdiff_t>(M) * N, TensorOpCost{block_bytes, block_bytes, 1.0},
+                                          [&copy_range](ptrdiff_t first, ptrdiff_t last) {
+                                            copy_range(first, last);
                                           });
 
   return Status::OK();
@@ -106,7 +106,7 @@ Status GatherNDBase::PrepareForCompute(const TensorShape& input_shape, const Ten
   concurrency::ThreadPool::TryParallelFor(
       tp, onnxruntime::narrow<size_t>(num_slices), static_cast<double>(num_slice_dims),
       [&lambda](ptrdiff_t first, ptrdiff_t last) {
-        for (int slice_idx = static_cast<int>(first), end = static_cast<int>(last); slice_idx < end; ++slice_idx) {
+        for (ptrdiff_t slice_idx = first; slice_idx < last; ++slice_idx) {
           lambda(slice_idx);
         }
       });
@@ -176,17 +176,54 @@ Status GatherND::Compute(OpKernelContext* context) const {
   return nullptr == p.input_str_base ? GatherNumber(p, tp) : GatherString(p, tp);
 }
 
+// Gathers the slices [first, last) when a slice is a single value of kSliceBytes bytes. The fixed size memcpy compiles
+// to a single load and store.
+template <size_t kSliceBytes>
+static void GatherSmallSlices(const GatherNDBase::Prepare& p, size_t first, size_t last) {
+  for (size_t slice_idx = first; slice_idx < last; ++slice_idx) {
+    memcpy(p.output_base + slice_idx * kSliceBytes, p.input_base + p.slice_offsets[slice_idx] * p.element_bytes,
+           kSliceBytes);
+  }
+}
+
 Status GatherND::GatherNumber(const Prepare& p, concurrency::ThreadPool* tp) const {
-  auto lambda = [&](int64_t slice_idx) {
-    memcpy(p.output_base + slice_idx * p.bytes_per_slice, p.input_base + p.slice_offsets[onnxruntime::narrow<size_t>(slice_idx)] * p.element_bytes,
-           onnxruntime::narrow<size_t>(p.bytes_per_slice));
+  const size_t bytes_per_slice = onnxruntime::narrow<size_t>(p.bytes_per_slice);
+  auto copy_range = [&p, bytes_per_slice](size_t first, size_t last) {
+    switch (bytes_per_slice) {
+      case 1:
+        GatherSmallSlices<1>(p, first, last);
+        break;
+      case 2:
+        GatherSmallSlices<2>(p, first, last);
+        break;
+      case 4:
+        GatherSmallSlices<4>(p, first, last);
+        break;
+      case 8:
+        GatherSmallSlices<8>(p, first, last);
+        break;
+      default:
+        // runs of slices that are adjacent in the input are copied with a single memcpy
+        for (size_t slice_idx = first; slice_idx < last;) {
+          const uint64_t offset = p.slice_offsets[slice_idx];
+          size_t run = 1;
+          while (slice_idx + run < last &&
+                 p.slice_offsets[slice_idx + run] == offset + run * p.element_count_per_slice) {
+            ++run;
+          }
+          memcpy(p.output_base + slice_idx * bytes_per_slice, p.input_base + offset * p.element_bytes,
+                 run * bytes_per_slice);
+          slice_idx += run;
+        }
+        break;
+    }
   };
+
+  const auto slice_bytes = static_cast<double>(p.bytes_per_slice);
   concurrency::ThreadPool::TryParallelFor(
-      tp, p.slice_offsets.size(), static_cast<double>(p.bytes_per_slice),
-      [&lambda](ptrdiff_t first, ptrdiff_t last) {
-        for (int slice_idx = static_cast<int>(first), end = static_cast<int>(last); slice_idx < end; ++slice_idx) {
-          lambda(slice_idx);
-        }
+      tp, p.slice_offsets.size(), TensorOpCost{slice_bytes, slice_bytes, 1.0},
+      [&copy_range](ptrdiff_t first, ptrdiff_t last) {
+        copy_range(static_cast<size_t>(first), static_cast<size_t>(last));
       });
   return Status::OK();
 }
@@ -201,7 +238,7 @@ Status GatherND::GatherString(const Prepare& p, concurrency::ThreadPool* tp) con
   concurrency::ThreadPool::TryParallelFor(
       tp, p.slice_offsets.size(), static_cast<double>(p.element_count_per_slice),
       [&lambda](ptrdiff_t first, ptrdiff_t last) {
-        for (int slice_idx = static_cast<int>(first), end = static_cast<int>(last); slice_idx < end; ++slice_idx) {
+        for (ptrdiff_t slice_idx = first; slice_idx < last; ++slice_idx) {
           lambda(slice_idx);
         }
       });
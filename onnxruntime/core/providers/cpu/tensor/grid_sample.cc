@@ -8,6 +8,7 @@
 #include "core/providers/common.h"
 #include "core/framework/copy.h"
 #include "core/providers/op_kernel_type_control.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -97,55 +98,94 @@ void GsGetCubicCoeffs(T x, T coeffs[4]) {
 }
 
 template <typename T>
-T GsBicubicInterpolate(T p[4][4], T x, T y) {
-  T v[4] = {};
-  T coeffs[4] = {};
-  GsGetCubicCoeffs(x, coeffs);
-  for (int64_t i = 0; i < 4; i++) {
-    v[i] = coeffs[0] * p[i][0] + coeffs[1] * p[i][1] + coeffs[2] * p[i][2] + coeffs[3] * p[i][3];
+int64_t GridSample<T>::IndexAtAxis(int64_t i, int64_t length, T border_min, T border_max) const {
+  if (padding_mode_ == Zeros) {
+    return (i >= 0 && i < length) ? i : -1;
+  } else if (padding_mode_ == Border) {
+    return std::clamp<int64_t>(i, 0, length - 1);
+  } else {  // (padding_mode_ == Reflection)
+    return static_cast<int64_t>(GsReflect(static_cast<T>(i), border_min, border_max));
   }
-  GsGetCubicCoeffs(y, coeffs);
-  return static_cast<T>(coeffs[0] * v[0] + coeffs[1] * v[1] + coeffs[2] * v[2] + coeffs[3] * v[3]);
 }
 
+// Every output point is a weighted sum of input taps: 1 for nearest, 2 per axis for
+// linear and 4 per axis for cubic. The taps only depend on the grid, so they are computed
+// once per block of output points into tap-major tables ([tap * count + point]) that are
+// then shared by every channel. A tap offset of -1 is a zero padded location.
 template <typename T>
-T GridSample<T>::PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, T border[/* 4 */]) const {
-  T pixel = {};  // default 0
-  if (padding_mode_ == Zeros) {
-    if (c >= 0 && c < W && r >= 0 && r < H) {
-      pixel = image[r * W + c];
+void GridSample<T>::ComputeTaps(const T* grid, int64_t count, const int64_t* input_dims, const T* border,
+                                size_t data_dims, int32_t* offsets, T* weights) const {
+  const size_t axis_taps = mode_ == Nearest ? 1 : (mode_ == Linear ? 2 : 4);
+  size_t taps = 1;
+  for (size_t d = 0; d < data_dims; d++) {
+    taps *= axis_taps;
+  }
+
+  for (int64_t p = 0; p < count; p++) {
+    // Per axis indices and weights, ordered from the outermost (depth/height) axis.
+    int64_t axis_index[3][4];
+    T axis_weight[3][4];
+
+    for (size_t d = 0; d < data_dims; d++) {
+      // The grid stores (x, y[, z]), i.e. the innermost axis first.
+      const size_t grid_axis = data_dims - 1 - d;
+      const int64_t length = input_dims[d];
+      const T border_min = border[grid_axis];
+      const T border_max = border[grid_axis + data_dims];
+      const T x = GsDenormalize<T>(grid[p * data_dims + grid_axis], length, align_corners_);
+
+      if (mode_ == Nearest) {
+        axis_index[d][0] = IndexAtAxis(static_cast<int64_t>(std::nearbyint(x)), length, border_min, border_max);
+        axis_weight[d][0] = T{1};
+      } else if (mode_ == Linear) {
+        const int64_t x1 = static_cast<int64_t>(std::floor(x));
+        axis_index[d][0] = IndexAtAxis(x1, length, border_min, border_max);
+        axis_index[d][1] = IndexAtAxis(x1 + 1, length, border_min, border_max);
+        axis_weight[d][0] = static_cast<T>(x1 + 1) - x;
+        axis_weight[d][1] = x - static_cast<T>(x1);
+      } else {  // (mode_ == Cubic)
+        const int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;
+        for (int64_t i = 0; i < 4; i++) {
+          axis_index[d][i] = IndexAtAxis(x0 + i, length, border_min, border_max);
+        }
+        GsGetCubicCoeffs(static_cast<T>(x - x0 - 1), axis_weight[d]);
+      }
+    }
+
+    for (size_t k = 0; k < taps; k++) {
+      int64_t offset = 0;
+      T weight = T{1};
+      size_t remainder = k;
+      size_t divisor = taps;
+      for (size_t d = 0; d < data_dims; d++) {
+        divisor /= axis_taps;
+        const size_t i = remainder / divisor;
+        remainder %= divisor;
+        offset = (offset < 0 || axis_index[d][i] < 0) ? -1 : offset * input_dims[d] + axis_index[d][i];
+        weight *= axis_weight[d][i];
+      }
+      offsets[k * count + p] = static_cast<int32_t>(offset);
+      weights[k * count + p] = weight;
     }
-  } else if (padding_mode_ == Border) {
-    c = std::clamp<int64_t>(c, 0, W - 1);
-    r = std::clamp<int64_t>(r, 0, H - 1);
-    pixel = image[r * W + c];
-  } else {  // (padding_mode_ == Reflection)
-    c = static_cast<int64_t>(GsReflect(static_cast<T>(c), border[0], border[2]));
-    r = static_cast<int64_t>(GsReflect(static_cast<T>(r), border[1], border[3]));
-    pixel = image[r * W + c];
   }
-  return pixel;
 }
 
 template <typename T>
-T GridSample<T>::PixelAtGrid3D(const T* image, int64_t d, int64_t h, int64_t w, int64_t D, int64_t H, int64_t W, T border[/* 6 */]) const {
-  T pixel = {};  // default 0
-  if (padding_mode_ == Zeros) {
-    if (w >= 0 && w < W && h >= 0 && h < H && d >= 0 && d < D) {
-      pixel = image[d * H * W + h * W + w];
+static void GsGatherInterpolate(const T* input, const int32_t* offsets, const T* weights, size_t taps,
+                                T* output, size_t count) {
+  if constexpr (std::is_same_v<T, float>) {
+    MlasGatherInterpolate(input, offsets, weights, taps, output, count);
+  } else {
+    std::fill_n(output, count, T{});
+    for (size_t k = 0; k < taps; k++) {
+      for (size_t p = 0; p < count; p++) {
+        const int32_t offset = offsets[k * count + p];
+        if (offset >= 0) {
+          output[p] += weights[k * count + p] * input[offset];
+        }
+      }
     }
-  } else if (padding_mode_ == Border) {
-    w = std::clamp<int64_t>(w, 0, W - 1);
-    h = std::clamp<int64_t>(h, 0, H - 1);
-    d = std::clamp<int64_t>(d, 0, D - 1);
-    pixel = image[d * H * W + h * W + w];
-  } else {  // (padding_mode_ == Reflection)
-    w = static_cast<int64_t>(GsReflect(static_cast<T>(w), border[0], border[3]));
-    h = static_cast<int64_t>(GsReflect(static_cast<T>(h), border[1], border[4]));
-    d = static_cast<int64_t>(GsReflect(static_cast<T>(d), border[2], border[5]));
-    pixel = image[d * H * W + h * W + w];
   }
-  return pixel;
 }
 
 // When grid sampling, padding is applied before interpolation.
@@ -183,187 +223,74 @@ Status GridSample<T>::Compute(OpKernelContext* context) const {
     ORT_ENFORCE(mode_ != Cubic, "Only support GridSample Cubic mode in 4-D cases.");
   }
 
-  if (data_dims == 2) {
-    // sample 2d;
-    auto H_in = input_dims[2];
-    auto W_in = input_dims[3];
-    auto H_out = grid_dims[1];
-    auto W_out = grid_dims[2];
-    TensorShape Y_shape = {N, C, H_out, W_out};
-    auto& Y = *context->Output(0, Y_shape);
-    // Return early if the output tensor is going to be of size 0
-    if (Y.Shape().Size() == 0) {
-      return Status::OK();
-    }
-
-    T x_min = -0.5f;
-    T x_max = W_in - 0.5f;
-    T y_min = -0.5f;
-    T y_max = H_in - 0.5f;
+  ORT_RETURN_IF_NOT(data_dims == 2 || data_dims == 3, "Only support GirdSample in 4-D or 5-D cases.");
 
-    if (align_corners_) {
-      x_min = 0.f;
-      x_max = W_in - 1.f;
-      y_min = 0.f;
-      y_max = H_in - 1.f;
-    }
-    T border[] = {x_min, y_min, x_max, y_max};  // l-t-r-b
-
-    concurrency::ThreadPool* tp = H_out * W_out > 64 ? context->GetOperatorThreadPool() : nullptr;
-    for (int64_t n = 0; n < N; n++) {
-      const T* grid_data = grid->Data<T>() + n * (H_out * W_out) * 2;
-      concurrency::ThreadPool::TrySimpleParallelFor(
-          tp, onnxruntime::narrow<std::ptrdiff_t>(C),
-          [&](std::ptrdiff_t c) {
-            const T* X_data = input->Data<T>() + (n * C + c) * (H_in * W_in);
-            T* Y_data = Y.MutableData<T>() + (n * C + c) * (H_out * W_out);
-
-            for (int64_t oy = 0; oy < H_out; oy++) {
-              for (int64_t ox = 0; ox < W_out; ox++) {
-                const T* gridpoint = grid_data + (oy * W_out + ox) * 2;
-                T* Y_gridpoint = Y_data + oy * W_out + ox;
-                auto nx = gridpoint[0];  // normalized location
-                auto ny = gridpoint[1];
-                auto x = GsDenormalize<T>(nx, W_in, align_corners_);  // actual location
-                auto y = GsDenormalize<T>(ny, H_in, align_corners_);
-
-                if (mode_ == Nearest) {
-                  x = static_cast<T>(std::nearbyint(static_cast<T>(x)));
-                  y = static_cast<T>(std::nearbyint(static_cast<T>(y)));
-                  // x, y are integers in all padding modes
-                  *Y_gridpoint = PixelAtGrid(X_data, static_cast<int64_t>(y), static_cast<int64_t>(x), H_in, W_in, border);
-                } else if (mode_ == Linear) {
-                  int64_t x1 = static_cast<int64_t>(std::floor(x));
-                  int64_t y1 = static_cast<int64_t>(std::floor(y));
-                  int64_t x2 = x1 + 1;
-                  int64_t y2 = y1 + 1;
-
-                  T p11 = PixelAtGrid(X_data, y1, x1, H_in, W_in, border);
-                  T p12 = PixelAtGrid(X_data, y1, x2, H_in, W_in, border);
-                  T p21 = PixelAtGrid(X_data, y2, x1, H_in, W_in, border);
-                  T p22 = PixelAtGrid(X_data, y2, x2, H_in, W_in, border);
-
-                  T dx2 = static_cast<T>(x2) - x;
-                  T dx1 = x - static_cast<T>(x1);
-                  T dy2 = static_cast<T>(y2) - y;
-                  T dy1 = y - static_cast<T>(y1);
-                  *Y_gridpoint = dy2 * (dx2 * p11 + dx1 * p12) + dy1 * (dx2 * p21 + dx1 * p22);
-                } else if (mode_ == Cubic) {
-                  int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;  // top-left corner of the bbox
-                  int64_t y0 = static_cast<int64_t>(std::floor(y)) - 1;
-
-                  T p[4][4] = {};  // [H][W]
-                  for (int64_t h = 0; h < 4; h++) {
-                    for (int64_t w = 0; w < 4; w++) {
-                      p[h][w] = PixelAtGrid(X_data, h + y0, w + x0, H_in, W_in, border);
-                    }
-                  }
-                  T dx = static_cast<T>(x - x0 - 1);
-                  T dy = static_cast<T>(y - y0 - 1);
-                  *Y_gridpoint = GsBicubicInterpolate(p, dx, dy);
-                }
-              }
-            }
-          });
-    }
-  } else if (data_dims == 3) {
-    // sample 3d;
-    auto D_in = input_dims[2];
-    auto H_in = input_dims[3];
-    auto W_in = input_dims[4];
-    auto D_out = grid_dims[1];
-    auto H_out = grid_dims[2];
-    auto W_out = grid_dims[3];
-    TensorShape Y_shape = {N, C, D_out, H_out, W_out};
-    auto& Y = *context->Output(0, Y_shape);
-    // Return early if the output tensor is going to be of size 0
-    if (Y.Shape().Size() == 0) {
-      return Status::OK();
-    }
+  const size_t spatial_dims = static_cast<size_t>(data_dims);
+  int64_t in_dims[3] = {};
+  TensorShapeVector Y_dims{N, C};
+  for (size_t d = 0; d < spatial_dims; d++) {
+    in_dims[d] = input_dims[2 + d];
+    Y_dims.push_back(grid_dims[1 + d]);
+  }
+  auto& Y = *context->Output(0, TensorShape(Y_dims));
+  // Return early if the output tensor is going to be of size 0
+  if (Y.Shape().Size() == 0) {
+    return Status::OK();
+  }
 
-    T x_min = -0.5f;
-    T x_max = W_in - 0.5f;
-    T y_min = -0.5f;
-    T y_max = H_in - 0.5f;
-    T z_min = -0.5f;
-    T z_max = D_in - 0.5f;
-
-    if (align_corners_) {
-      x_min = 0.f;
-      x_max = W_in - 1.f;
-      y_min = 0.f;
-      y_max = H_in - 1.f;
-      z_min = 0.f;
-      z_max = D_in - 1.f;
-    }
-    T border[] = {x_min, y_min, z_min, x_max, y_max, z_max};
-
-    concurrency::ThreadPool* tp = D_out * H_out * W_out > 64 ? context->GetOperatorThreadPool() : nullptr;
-    for (int64_t n = 0; n < N; n++) {
-      const T* grid_data = grid->Data<T>() + n * (D_out * H_out * W_out) * 3;
-      concurrency::ThreadPool::TrySimpleParallelFor(
-          tp, onnxruntime::narrow<std::ptrdiff_t>(C),
-          [&](std::ptrdiff_t c) {
-            const T* X_data = input->Data<T>() + (n * C + c) * (D_in * H_in * W_in);
-            T* Y_data = Y.MutableData<T>() + (n * C + c) * (D_out * H_out * W_out);
-
-            for (int64_t oz = 0; oz < D_out; oz++) {
-              for (int64_t oy = 0; oy < H_out; oy++) {
-                for (int64_t ox = 0; ox < W_out; ox++) {
-                  const T* gridpoint = grid_data + (oz * H_out * W_out + oy * W_out + ox) * 3;
-                  T* Y_gridpoint = Y_data + oz * H_out * W_out + oy * W_out + ox;
-                  auto nx = gridpoint[0];  // normalized location
-                  auto ny = gridpoint[1];
-                  auto nz = gridpoint[2];
-                  auto x = GsDenormalize<T>(nx, W_in, align_corners_);  // actual location
-                  auto y = GsDenormalize<T>(ny, H_in, align_corners_);
-                  auto z = GsDenormalize<T>(nz, D_in, align_corners_);
-
-                  if (mode_ == Nearest) {
-                    x = static_cast<T>(std::nearbyint(static_cast<T>(x)));
-                    y = static_cast<T>(std::nearbyint(static_cast<T>(y)));
-                    z = static_cast<T>(std::nearbyint(static_cast<T>(z)));
-
-                    // x, y are integers in all padding modes
-                    *Y_gridpoint = PixelAtGrid3D(X_data, static_cast<int64_t>(z), static_cast<int64_t>(y), static_cast<int64_t>(x),
-                                                 D_in, H_in, W_in, border);
-                  } else if (mode_ == Linear) {
-                    int64_t x1 = static_cast<int64_t>(std::floor(x));
-                    int64_t y1 = static_cast<int64_t>(std::floor(y));
-                    int64_t z1 = static_cast<int64_t>(std::floor(z));
-                    int64_t x2 = x1 + 1;
-                    int64_t y2 = y1 + 1;
-                    int64_t z2 = z1 + 1;
-
-                    T dx2 = static_cast<T>(x2) - x;
-                    T dx1 = x - static_cast<T>(x1);
-                    T dy2 = static_cast<T>(y2) - y;
-                    T dy1 = y - static_cast<T>(y1);
-                    T dz2 = static_cast<T>(z2) - z;
-                    T dz1 = z - static_cast<T>(z1);
-
-                    T p111 = PixelAtGrid3D(X_data, z1, y1, x1, D_in, H_in, W_in, border);
-                    T p112 = PixelAtGrid3D(X_data, z1, y1, x2, D_in, H_in, W_in, border);
-                    T p121 = PixelAtGrid3D(X_data, z1, y2, x1, D_in, H_in, W_in, border);
-                    T p122 = PixelAtGrid3D(X_data, z1, y2, x2, D_in, H_in, W_in, border);
-                    T Y_gridpoint_z1 = dy2 * (dx2 * p111 + dx1 * p112) + dy1 * (dx2 * p121 + dx1 * p122);
-
-                    T p211 = PixelAtGrid3D(X_data, z2, y1, x1, D_in, H_in, W_in, border);
-                    T p212 = PixelAtGrid3D(X_data, z2, y1, x2, D_in, H_in, W_in, border);
-                    T p221 = PixelAtGrid3D(X_data, z2, y2, x1, D_in, H_in, W_in, border);
-                    T p222 = PixelAtGrid3D(X_data, z2, y2, x2, D_in, H_in, W_in, border);
-                    T Y_gridpoint_z2 = dy2 * (dx2 * p211 + dx1 * p212) + dy1 * (dx2 * p221 + dx1 * p222);
-                    *Y_gridpoint = dz2 * Y_gridpoint_z1 + dz1 * Y_gridpoint_z2;
-                  }
-                }
-              }
-            }
-          });
-    }
-  } else {
-    // shall not reach here due to above checks
-    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Only support GirdSample in 4-D or 5-D cases.");
+  const int64_t in_size = input_dims.SizeFromDimension(2);
+  const int64_t out_size = Y.Shape().SizeFromDimension(2);
+  ORT_RETURN_IF_NOT(in_size <= std::numeric_limits<int32_t>::max(),
+                    "GridSample input spatial size ", in_size, " exceeds the supported maximum.");
+
+  // Border is {x_min, y_min[, z_min], x_max, y_max[, z_max]}, i.e. l-t-r-b in 2-D.
+  T border[6] = {};
+  for (size_t d = 0; d < spatial_dims; d++) {
+    const int64_t length = in_dims[spatial_dims - 1 - d];
+    border[d] = align_corners_ ? T{0} : static_cast<T>(-0.5f);
+    border[d + spatial_dims] = align_corners_ ? static_cast<T>(length - 1) : static_cast<T>(length - 0.5f);
   }
+
+  const size_t axis_taps = mode_ == Nearest ? 1 : (mode_ == Linear ? 2 : 4);
+  const size_t taps = spatial_dims == 2 ? axis_taps * axis_taps : axis_taps * axis_taps * axis_taps;
+
+  // Work is split into blocks of output points and, when there are too few blocks to occupy
+  // the thread pool, additionally into ranges of channels.
+  constexpr int64_t block_size = 256;
+  const int64_t num_blocks = (out_size + block_size - 1) / block_size;
+
+  concurrency::ThreadPool* tp = out_size > 64 ? context->GetOperatorThreadPool() : nullptr;
+  const int64_t degree_of_parallelism = concurrency::ThreadPool::DegreeOfParallelism(tp);
+  const int64_t channel_blocks =
+      std::clamp<int64_t>((degree_of_parallelism + N * num_blocks - 1) / (N * num_blocks), 1, C);
+
+  const T* X_data = input->Data<T>();
+  const T* grid_data = grid->Data<T>();
+  T* Y_data = Y.MutableData<T>();
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(N * num_blocks * channel_blocks),
+      [&](std::ptrdiff_t work) {
+        const int64_t cb = work % channel_blocks;
+        const int64_t block = (work / channel_blocks) % num_blocks;
+        const int64_t n = work / channel_blocks / num_blocks;
+
+        const int64_t point_start = block * block_size;
+        const int64_t count = std::min(block_size, out_size - point_start);
+        const int64_t c_start = C * cb / channel_blocks;
+        const int64_t c_end = C * (cb + 1) / channel_blocks;
+
+        std::vector<int32_t> offsets(taps * narrow<size_t>(count));
+        std::vector<T> weights(taps * narrow<size_t>(count));
+        ComputeTaps(grid_data + (n * out_size + point_start) * data_dims, count, in_dims, border,
+                    spatial_dims, offsets.data(), weights.data());
+
+        for (int64_t c = c_start; c < c_end; c++) {
+          GsGatherInterpolate(X_data + (n * C + c) * in_size, offsets.data(), weights.data(), taps,
+                              Y_data + (n * C + c) * out_size + point_start, narrow<size_t>(count));
+        }
+      });
+
   return Status::OK();
 }
 
@@ -68,8 +68,12 @@ class GridSample final : public OpKernel {
     Reflection
   };
 
-  T PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, T border[/* 4 */]) const;
-  T PixelAtGrid3D(const T* image, int64_t d, int64_t h, int64_t w, int64_t D, int64_t H, int64_t W, T border[/* 6 */]) const;
+  // Maps an integer location along one axis to an input index, or -1 for a zero padded location.
+  int64_t IndexAtAxis(int64_t i, int64_t length, T border_min, T border_max) const;
+
+  // Builds the tap-major offset and weight tables for `count` grid points.
+  void ComputeTaps(const T* grid, int64_t count, const int64_t* input_dims, const T* border,
+                   size_t data_dims, int32_t* offsets, T* weights) const;
 
   GridSampleInterpolationMode mode_{Linear};
   GridSamplePaddingMode padding_mode_{Zeros};
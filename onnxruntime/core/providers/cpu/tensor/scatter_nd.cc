@@ -3,6 +3,9 @@
 
 #include "core/providers/cpu/tensor/scatter_nd.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/platform/threadpool.h"
@@ -113,11 +116,13 @@ struct Prepare {
   const TData* input_base;
   TData* output_base;
   uint64_t element_to_copy;
+  uint64_t output_element_count;
   std::vector<uint64_t> element_offsets;
 
   Prepare() : input_base(nullptr),
               output_base(nullptr),
               element_to_copy(0),
+              output_element_count(0),
               element_offsets(0) {}
 };  // struct Prepare
 
@@ -161,6 +166,7 @@ Status PrepareForCompute(OpKernelContext* context, Prepare<TData>& p) {
   }
 
   p.element_to_copy = input_shape.SizeFromDimension(onnxruntime::narrow<size_t>(last_indice_dimension));
+  p.output_element_count = input_shape.Size();
   const int64_t* indice_offset = indice_tensor->Data<int64_t>();
   auto offset_count = indice_shape.Size() / last_indice_dimension;  // Times to copy
   p.element_offsets.assign(onnxruntime::narrow<size_t>(offset_count), 0LL);
@@ -350,59 +356,93 @@ struct Func_Max_ND<BFloat16> {
   }
 };
 
+// Copies the updates. Updates with duplicate indices are not defined by the spec so they run in parallel.
+template <typename TData>
+void ScatterNDCopy(const Prepare<TData>& p, concurrency::ThreadPool* tp) {
+  const Func_Copy_ND<TData> func;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, p.element_offsets.size(), static_cast<double>(p.element_to_copy),
+      [&p, &func](ptrdiff_t first, ptrdiff_t last) {
+        for (size_t i = static_cast<size_t>(first), end = static_cast<size_t>(last); i < end; ++i) {
+          func(p.output_base + p.element_offsets[i], p.input_base + i * p.element_to_copy, p.element_to_copy);
+        }
+      });
+}
+
+// Applies the updates with a reduction. Updates with duplicate indices reduce into the same slice of the output, so
+// they must not run concurrently. The updates are partitioned by the position of their slice in the output instead:
+// each partition owns a contiguous range of slices and applies its updates in their original order, which gives the
+// same result as applying all of them serially.
+template <typename TData, typename TFunc>
+void ScatterNDReduce(const Prepare<TData>& p, concurrency::ThreadPool* tp, const TFunc& func) {
+  const size_t num_updates = p.element_offsets.size();
+  const auto num_threads = concurrency::ThreadPool::DegreeOfParallelism(tp);
+  if (num_threads <= 1 || num_updates < 2 || p.element_to_copy == 0) {
+    for (size_t i = 0; i < num_updates; ++i) {
+      func(p.output_base + p.element_offsets[i], p.input_base + i * p.element_to_copy, p.element_to_copy);
+    }
+    return;
+  }
+
+  // a few partitions per thread to even out the number of updates per partition
+  const uint64_t num_partitions = std::min<uint64_t>(static_cast<uint64_t>(num_threads) * 4, num_updates);
+  const uint64_t num_slices = p.output_element_count / p.element_to_copy;
+  auto partition_of = [&](size_t i) {
+    return onnxruntime::narrow<size_t>(p.element_offsets[i] / p.element_to_copy * num_partitions / num_slices);
+  };
+
+  // counting sort of the updates by partition, keeping their order within a partition
+  std::vector<size_t> partition_starts(onnxruntime::narrow<size_t>(num_partitions) + 1, 0);
+  for (size_t i = 0; i < num_updates; ++i) {
+    ++partition_starts[partition_of(i) + 1];
+  }
+  for (size_t partition = 0; partition < num_partitions; ++partition) {
+    partition_starts[partition + 1] += partition_starts[partition];
+  }
+  std::vector<size_t> updates(num_updates);
+  std::vector<size_t> next_update(partition_starts.begin(), partition_starts.end() - 1);
+  for (size_t i = 0; i < num_updates; ++i) {
+    updates[next_update[partition_of(i)]++] = i;
+  }
+
+  const double bytes_per_partition = static_cast<double>(num_updates / num_partitions * p.element_to_copy *
+                                                         sizeof(TData));
+  concurrency::ThreadPool::TryParallelFor(
+      tp, onnxruntime::narrow<ptrdiff_t>(num_partitions),
+      TensorOpCost{bytes_per_partition * 2, bytes_per_partition, bytes_per_partition / sizeof(TData)},
+      [&](ptrdiff_t first, ptrdiff_t last) {
+        for (size_t j = partition_starts[static_cast<size_t>(first)], end = partition_starts[static_cast<size_t>(last)];
+             j < end; ++j) {
+          const size_t i = updates[j];
+          func(p.output_base + p.element_offsets[i], p.input_base + i * p.element_to_copy, p.element_to_copy);
+        }
+      });
+}
+
 template <typename TData>
 struct ScatterNDDispatchTarget {
   Status operator()(OpKernelContext* context, concurrency::ThreadPool* tp, ScatterND::Reduction reduction) const {
     Prepare<TData> prepare;
     ORT_RETURN_IF_ERROR(PrepareForCompute(context, prepare));
 
-    auto lambda = [&](int64_t i) {
-      switch (reduction) {
-        case ScatterND::Reduction::Add: {
-          auto func = Func_Add_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-        case ScatterND::Reduction::Mul: {
-          auto func = Func_Mul_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-        case ScatterND::Reduction::Min: {
-          auto func = Func_Min_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-        case ScatterND::Reduction::Max: {
-          auto func = Func_Max_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-        default:
-        case ScatterND::Reduction::None: {
-          auto func = Func_Copy_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-      }
-    };
-    concurrency::ThreadPool::TryParallelFor(
-        tp, prepare.element_offsets.size(), static_cast<double>(prepare.element_to_copy),
-        [&lambda](ptrdiff_t first, ptrdiff_t last) {
-          for (int i = static_cast<int>(first), end = static_cast<int>(last); i < end; ++i) {
-            lambda(i);
-          }
-        });
+    switch (reduction) {
+      case ScatterND::Reduction::Add:
+        ScatterNDReduce(prepare, tp, Func_Add_ND<TData>());
+        break;
+      case ScatterND::Reduction::Mul:
+        ScatterNDReduce(prepare, tp, Func_Mul_ND<TData>());
+        break;
+      case ScatterND::Reduction::Min:
+        ScatterNDReduce(prepare, tp, Func_Min_ND<TData>());
+        break;
+      case ScatterND::Reduction::Max:
+        ScatterNDReduce(prepare, tp, Func_Max_ND<TData>());
+        break;
+      default:
+      case ScatterND::Reduction::None:
+        ScatterNDCopy(prepare, tp);
+        break;
+    }
     return Status::OK();
   }
 };
@@ -348,6 +348,45 @@ bool IsTransposeReshape(const gsl::span<const size_t>& perm, gsl::span<const int
   return true;
 }
 
+// Transposes tensors with 1, 2, 4 or 8 byte elements with the MLAS N-D transpose, which merges the axes that stay
+// adjacent, transposes the innermost input and output axes in cache sized tiles and parallelizes over the tiles.
+static bool TryMlasTranspose(const gsl::span<const size_t>& permutations, const Tensor& input, Tensor& output,
+                             const TensorShape& input_shape, concurrency::ThreadPool* tp) {
+  const size_t rank = input_shape.NumDimensions();
+  if (input.IsDataTypeString() || rank > MLAS_TRANSPOSE_MAXIMUM_RANK) {
+    return false;
+  }
+
+  InlinedVector<size_t, MLAS_TRANSPOSE_MAXIMUM_RANK> input_dims(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    input_dims[i] = onnxruntime::narrow<size_t>(input_shape[i]);
+  }
+
+  const void* input_data = input.DataRaw();
+  void* output_data = output.MutableDataRaw();
+
+  switch (input.DataType()->Size()) {
+    case sizeof(uint8_t):
+      MlasTranspose(static_cast<const uint8_t*>(input_data), static_cast<uint8_t*>(output_data),
+                    input_dims.data(), permutations.data(), rank, tp);
+      return true;
+    case sizeof(uint16_t):
+      MlasTranspose(static_cast<const uint16_t*>(input_data), static_cast<uint16_t*>(output_data),
+                    input_dims.data(), permutations.data(), rank, tp);
+      return true;
+    case sizeof(uint32_t):
+      MlasTranspose(static_cast<const uint32_t*>(input_data), static_cast<uint32_t*>(output_data),
+                    input_dims.data(), permutations.data(), rank, tp);
+      return true;
+    case sizeof(uint64_t):
+      MlasTranspose(static_cast<const uint64_t*>(input_data), static_cast<uint64_t*>(output_data),
+                    input_dims.data(), permutations.data(), rank, tp);
+      return true;
+    default:
+      return false;
+  }
+}
+
 static Status TransposeImpl(const gsl::span<const size_t>& permutations, const Tensor& input, Tensor& output,
                             const TensorShape* input_shape_override, concurrency::ThreadPool* tp) {
   TensorShape shape = input_shape_override ? *input_shape_override : input.Shape();
@@ -359,6 +398,10 @@ static Status TransposeImpl(const gsl::span<const size_t>& permutations, const T
     return Status::OK();
   }
 
+  if (TryMlasTranspose(permutations, input, output, shape, tp)) {
+    return Status::OK();
+  }
+
   size_t from = 0, to = 0;
   bool moving_single_axis = IsTransposeMovingSingleAxis(permutations, from, to);
 
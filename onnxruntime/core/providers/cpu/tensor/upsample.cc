@@ -918,197 +918,138 @@ std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff
   return coeffs;
 }
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
-}
+// For each output coordinate along one axis, the input indices of the 4 point cubic grid (clamped to the input)
+// and their weights. The weights already include the exclude_outside renormalization.
+struct CubicAxisParams {
+  std::vector<float> original;
+  std::vector<int64_t> index;
+  std::vector<float> weight;
+};
 
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
-  }
+static CubicAxisParams SetupCubicAxis(int64_t input_size,
+                                      int64_t output_size,
+                                      float scale,
+                                      float cubic_coeff_a,
+                                      bool exclude_outside,
+                                      float roi_start,
+                                      float roi_end,
+                                      const GetOriginalCoordinateFunc& get_original_coordinate) {
+  CubicAxisParams p;
+  p.original.reserve(narrow<size_t>(output_size));
+  p.index.resize(narrow<size_t>(output_size) * CubicModeGridLength);
+  p.weight.resize(narrow<size_t>(output_size) * CubicModeGridLength);
+
+  for (int64_t o = 0; o < output_size; ++o) {
+    float in = scale == 1 ? static_cast<float>(o)
+                          : get_original_coordinate(static_cast<float>(o), scale,
+                                                    static_cast<float>(output_size),
+                                                    static_cast<float>(input_size),
+                                                    roi_start, roi_end);
+    p.original.emplace_back(in);
+
+    const auto in_int = static_cast<int64_t>(std::floor(in));
+    auto coeffs = GetCubicCoeffs(in - in_int, cubic_coeff_a);
+    float coeff_sum = 1;
+
+    if (exclude_outside) {
+      // When true, the weight of sampling locations outside the grid will be set to 0
+      // and the weight will be renormalized so that their sum is 1.0
+      coeff_sum = 0;
+      for (size_t i = 0; i < CubicModeGridLength; ++i) {
+        const int64_t in_val = in_int - 1 + static_cast<int64_t>(i);
+        if (in_val < 0 || in_val >= input_size) {
+          coeffs[i] = 0.0f;
+        }
+        coeff_sum += coeffs[i];
+      }
+    }
 
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[narrow<size_t>(i)] / coeff_sum * orig_data;
+    for (size_t i = 0; i < CubicModeGridLength; ++i) {
+      const size_t offset = narrow<size_t>(o) * CubicModeGridLength + i;
+      p.index[offset] = std::clamp<int64_t>(in_int - 1 + static_cast<int64_t>(i), 0, input_size - 1);
+      p.weight[offset] = coeffs[i] / coeff_sum;
+    }
   }
-  cache[grid_start_pos] = result;
 
-  return result;
+  return p;
 }
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 6001)
-#endif
-template <typename T>
-void ResizeBiCubic(int64_t batch_size,
-                   int64_t num_channels,
-                   int64_t input_height,
-                   int64_t input_width,
-                   int64_t output_height,
-                   int64_t output_width,
-                   float height_scale,
-                   float width_scale,
-                   float cubic_coeff_a,
-                   bool use_extrapolation,
-                   float extrapolation_value,
-                   bool exclude_outside,
-                   gsl::span<const float> roi,
-                   const T* Xdata,
-                   T* Ydata,
-                   const GetOriginalCoordinateFunc& get_original_coordinate) {
-  std::vector<float> y_original;
-  y_original.reserve(narrow<size_t>(output_height));
-
-  std::vector<float> x_original;
-  x_original.reserve(narrow<size_t>(output_width));
 
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
+// Bicubic resize of NCHW data. The 4x4 grid is separable, so every input row is interpolated along the width once
+// and each output row is the weighted sum of 4 of those rows.
+static void ResizeBiCubic(int64_t batch_size,
+                          int64_t num_channels,
+                          int64_t input_height,
+                          int64_t input_width,
+                          int64_t output_height,
+                          int64_t output_width,
+                          float height_scale,
+                          float width_scale,
+                          float cubic_coeff_a,
+                          bool use_extrapolation,
+                          float extrapolation_value,
+                          bool exclude_outside,
+                          gsl::span<const float> roi,
+                          const float* Xdata,
+                          float* Ydata,
+                          const GetOriginalCoordinateFunc& get_original_coordinate,
+                          concurrency::ThreadPool* tp) {
   auto roi_y_start = roi.size() / 2 - 2;
   auto roi_y_end = roi.size() - 2;
   auto roi_x_start = roi.size() / 2 - 1;
   auto roi_x_end = roi.size() - 1;
 
-  // generate coefficients in y direction
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = height_scale == 1 ? static_cast<float>(y)
-                                   : get_original_coordinate(static_cast<float>(y), height_scale,
-                                                             static_cast<float>(output_height),
-                                                             static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[narrow<size_t>(y)] - std::floor(y_original[narrow<size_t>(y)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
+  const CubicAxisParams y_params = SetupCubicAxis(input_height, output_height, height_scale, cubic_coeff_a,
+                                                  exclude_outside, roi[roi_y_start], roi[roi_y_end],
+                                                  get_original_coordinate);
+  const CubicAxisParams x_params = SetupCubicAxis(input_width, output_width, width_scale, cubic_coeff_a,
+                                                  exclude_outside, roi[roi_x_start], roi[roi_x_end],
+                                                  get_original_coordinate);
+
+  // when use_extrapolation is set and original index is out of the dim range
+  // then use extrapolation_value as the output value.
+  std::vector<int64_t> extrapolated_x;
+  if (use_extrapolation) {
+    for (int64_t x = 0; x < output_width; ++x) {
+      const float in_x = x_params.original[narrow<size_t>(x)];
+      if (in_x < 0 || in_x > static_cast<float>(input_width - 1)) {
+        extrapolated_x.push_back(x);
+      }
     }
   }
 
-  // generate coefficients in x direction
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x),
-                                                            width_scale,
-                                                            static_cast<float>(output_width),
-                                                            static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[narrow<size_t>(x)] - std::floor(x_original[narrow<size_t>(x)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
+  auto interpolate_row = [&](const float* Xrow, float* row) {
+    const int64_t* index = x_params.index.data();
+    const float* weight = x_params.weight.data();
+    for (int64_t x = 0; x < output_width; ++x) {
+      float result = 0;
+      for (size_t i = 0; i < CubicModeGridLength; ++i) {
+        result += weight[i] * Xrow[index[i]];
+      }
+      row[x] = result;
+      index += CubicModeGridLength;
+      weight += CubicModeGridLength;
     }
-  }
-
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
-
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[narrow<size_t>(y)];
-
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
-          for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
-          }
-          continue;
-        }
-
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[narrow<size_t>(i)] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[narrow<size_t>(i)];
-            y_coeff_sum += y_coeff_holder[narrow<size_t>(i)];
-          }
-        }
-
-        for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[narrow<size_t>(x)];
-
-          // when use_extrapolation is set and original index is out of the dim range
-          // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
-            continue;
-          }
-
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[narrow<size_t>(i)] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[narrow<size_t>(i)];
-              x_coeff_sum += x_coeff_holder[narrow<size_t>(i)];
-            }
-          }
-
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[narrow<size_t>(i)] / y_coeff_sum;
-          }
+  };
 
-          Ydata[y * output_width + x] = static_cast<T>(result);
-        }
-      }
+  auto blend_rows = [&](const float* const* rows, int64_t y, float* Yrow) {
+    const float in_y = y_params.original[narrow<size_t>(y)];
+    if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
+      std::fill_n(Yrow, output_width, extrapolation_value);
+      return;
+    }
 
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
+    MlasInterpolateRows(rows, y_params.weight.data() + narrow<size_t>(y) * CubicModeGridLength,
+                        CubicModeGridLength, Yrow, narrow<size_t>(output_width));
 
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
+    for (int64_t x : extrapolated_x) {
+      Yrow[x] = extrapolation_value;
     }
-  }
+  };
+
+  SeparableResize<float, float>(batch_size * num_channels, input_height, input_width, output_height, output_width,
+                                CubicModeGridLength, y_params.index.data(), Xdata, Ydata,
+                                interpolate_row, blend_rows, tp);
 }
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
 
 template <typename T>
 Status Upsample<T>::BaseCompute(OpKernelContext* context,
@@ -1361,7 +1302,8 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
         ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
                       height_scale, width_scale, cubic_coeff_a_, use_extrapolation_,
                       extrapolation_value_, exclude_outside_, roi, X->Data<float>(),
-                      Y->MutableData<float>(), get_original_coordinate_);
+                      Y->MutableData<float>(), get_original_coordinate_,
+                      output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
       }
       return Status::OK();
     }
@@ -3,10 +3,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 #ifndef SHARED_PROVIDER
 #include "core/framework/op_kernel.h"
 #endif
+#include "core/common/inlined_containers.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/cpu/tensor/upsamplebase.h"
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(push)
@@ -81,6 +85,152 @@ BilinearParams SetupUpsampleBilinear(const int32_t input_height,
                                      const GetOriginalCoordinateFunc& get_original_coordinate,
                                      const bool is_nchw);
 
+// Separable resize of `num_images` images, where an image row holds `input_row_size` values in the input and
+// `output_row_size` values in the output.
+// Output row y of an image blends the `taps` input rows row_index[y * taps + k]. Each of those rows is first resized
+// horizontally by `interpolate_row(const T* input_row, AccumulateType* row)` into a per-thread cache, so that adjacent
+// output rows sharing an input row only interpolate it once, and `blend_rows(const AccumulateType* const* rows,
+// int64_t y, T* output_row)` then combines them. Both callbacks walk contiguous rows, which lets them vectorize.
+// The work is split across the images and output rows.
+template <typename T, typename AccumulateType, typename InterpolateRowFn, typename BlendRowsFn>
+void SeparableResize(int64_t num_images,
+                     int64_t input_height,
+                     int64_t input_row_size,
+                     int64_t output_height,
+                     int64_t output_row_size,
+                     size_t taps,
+                     const int64_t* row_index,
+                     const T* const XdataBase,
+                     T* const YdataBase,
+                     const InterpolateRowFn& interpolate_row,
+                     const BlendRowsFn& blend_rows,
+                     concurrency::ThreadPool* tp) {
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_images * output_height),
+      static_cast<double>(output_row_size * (taps + 2)),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<AccumulateType> cache(taps * static_cast<size_t>(output_row_size));
+        InlinedVector<int64_t, 4> cache_index(taps, -1);
+        InlinedVector<const AccumulateType*, 4> rows(taps);
+        int64_t cached_image = -1;
+
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const int64_t image = i / output_height;
+          const int64_t y = i % output_height;
+
+          if (image != cached_image) {
+            std::fill(cache_index.begin(), cache_index.end(), -1);
+            cached_image = image;
+          }
+
+          const T* Xdata = XdataBase + image * input_height * input_row_size;
+          const int64_t* y_index = row_index + static_cast<size_t>(y) * taps;
+
+          for (size_t k = 0; k < taps; ++k) {
+            auto slot = static_cast<size_t>(std::find(cache_index.begin(), cache_index.end(), y_index[k]) -
+                                            cache_index.begin());
+            if (slot == taps) {
+              // Replace a cached row that is not needed for this output row.
+              for (slot = 0; std::find(y_index, y_index + taps, cache_index[slot]) != y_index + taps; ++slot) {
+              }
+              interpolate_row(Xdata + y_index[k] * input_row_size, cache.data() + slot * output_row_size);
+              cache_index[slot] = y_index[k];
+            }
+            rows[k] = cache.data() + slot * output_row_size;
+          }
+
+          blend_rows(rows.data(), y, YdataBase + i * output_row_size);
+        }
+      });
+}
+
+// Separable form of the bilinear resize below for images of `pixel_size` values per pixel (1 for NCHW, the number
+// of channels for NHWC). With integer weights (d*_scale_10) the rows are kept as exact integer sums, so the result
+// is identical to the direct 4 point interpolation.
+template <typename T, typename AccumulateType, bool UseExtrapolation, typename Params>
+void SeparableUpsampleBilinear(const int32_t num_images,
+                               const int32_t pixel_size,
+                               const int32_t input_height,
+                               const int32_t input_width,
+                               const int32_t output_height,
+                               const int32_t output_width,
+                               const Params& p,
+                               const AccumulateType* dx1,
+                               const AccumulateType* dx2,
+                               const AccumulateType* dy1,
+                               const AccumulateType* dy2,
+                               const float extrapolation_value,
+                               const T* const XdataBase,
+                               T* const YdataBase,
+                               concurrency::ThreadPool* tp) {
+  std::vector<int64_t> row_index(static_cast<size_t>(output_height) * 2);
+  for (int32_t y = 0; y < output_height; ++y) {
+    row_index[2 * y] = p.input_width_mul_y1[y] / std::max(input_width, 1);
+    row_index[2 * y + 1] = p.input_width_mul_y2[y] / std::max(input_width, 1);
+  }
+
+  std::vector<int32_t> extrapolated_x;
+  if constexpr (UseExtrapolation) {
+    for (int32_t x = 0; x < output_width; ++x) {
+      if (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)) {
+        extrapolated_x.push_back(x);
+      }
+    }
+  }
+
+  const int64_t output_row_size = static_cast<int64_t>(output_width) * pixel_size;
+
+  auto interpolate_row = [&](const T* Xdata, AccumulateType* row) {
+    if (pixel_size == 1) {
+      for (int32_t x = 0; x < output_width; ++x) {
+        row[x] = dx2[x] * Xdata[p.in_x1[x]] + dx1[x] * Xdata[p.in_x2[x]];
+      }
+      return;
+    }
+
+    for (int32_t x = 0; x < output_width; ++x) {
+      const T* X1 = Xdata + static_cast<int64_t>(p.in_x1[x]) * pixel_size;
+      const T* X2 = Xdata + static_cast<int64_t>(p.in_x2[x]) * pixel_size;
+      const AccumulateType X1_coef = dx2[x];
+      const AccumulateType X2_coef = dx1[x];
+      for (int32_t c = 0; c < pixel_size; ++c) {
+        row[c] = X1_coef * X1[c] + X2_coef * X2[c];
+      }
+      row += pixel_size;
+    }
+  };
+
+  auto blend_rows = [&](const AccumulateType* const* rows, int64_t y, T* Ydata) {
+    if constexpr (UseExtrapolation) {
+      if (p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) {
+        std::fill_n(Ydata, output_row_size, static_cast<T>(extrapolation_value));
+        return;
+      }
+    }
+
+    if constexpr (std::is_same<AccumulateType, float>::value) {
+      const float weights[2] = {dy2[y], dy1[y]};
+      MlasInterpolateRows(rows, weights, 2, Ydata, static_cast<size_t>(output_row_size));
+    } else {
+      const AccumulateType Y1_coef = dy2[y];
+      const AccumulateType Y2_coef = dy1[y];
+      const AccumulateType* Y1 = rows[0];
+      const AccumulateType* Y2 = rows[1];
+      for (int64_t i = 0; i < output_row_size; ++i) {
+        Ydata[i] = static_cast<T>((Y1_coef * Y1[i] + Y2_coef * Y2[i]) / (1 << 20));
+      }
+    }
+
+    for (int32_t x : extrapolated_x) {
+      std::fill_n(Ydata + static_cast<int64_t>(x) * pixel_size, pixel_size, static_cast<T>(extrapolation_value));
+    }
+  };
+
+  SeparableResize<T, AccumulateType>(num_images, input_height, static_cast<int64_t>(input_width) * pixel_size,
+                                     output_height, output_row_size, 2, row_index.data(), XdataBase, YdataBase,
+                                     interpolate_row, blend_rows, tp);
+}
+
 template <typename T>
 void UpsampleBilinear(const int32_t batch_size,
                       const int32_t num_channels,
@@ -101,6 +251,19 @@ void UpsampleBilinear(const int32_t batch_size,
   BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
                                            height_scale, width_scale, roi,
                                            alloc, get_original_coordinate, true);
+  if constexpr (std::is_same<T, float>::value) {
+    if (use_extrapolation) {
+      SeparableUpsampleBilinear<T, float, true>(batch_size * num_channels, 1, input_height, input_width,
+                                                output_height, output_width, p, p.dx1, p.dx2, p.dy1, p.dy2,
+                                                extrapolation_value, XdataBase, YdataBase, tp);
+    } else {
+      SeparableUpsampleBilinear<T, float, false>(batch_size * num_channels, 1, input_height, input_width,
+                                                 output_height, output_width, p, p.dx1, p.dx2, p.dy1, p.dy2,
+                                                 extrapolation_value, XdataBase, YdataBase, tp);
+    }
+    return;
+  }
+
   for (int32_t n = 0; n < batch_size; ++n) {
     concurrency::ThreadPool::TrySimpleParallelFor(
         tp, num_channels,
@@ -154,6 +317,13 @@ void NhwcUpsampleBilinear(const int32_t batch_size,
   BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
                                            height_scale, width_scale, roi,
                                            alloc, get_original_coordinate, false);
+  if constexpr (std::is_same<T, float>::value) {
+    SeparableUpsampleBilinear<T, float, UseExtrapolation>(batch_size, num_channels, input_height, input_width,
+                                                          output_height, output_width, p, p.dx1, p.dx2, p.dy1, p.dy2,
+                                                          extrapolation_value, XdataBase, YdataBase, tp);
+    return;
+  }
+
   for (int32_t n = 0; n < batch_size; ++n) {
     const T* const Xdata = XdataBase + n * (input_height * input_width) * num_channels;
     T* const Ydata = YdataBase + n * (output_height * output_width) * num_channels;
@@ -251,73 +421,11 @@ void NhwcUpsampleBilinearInteger(const int32_t batch_size,
   BilinearParamsInteger p = SetupUpsampleBilinearInteger(input_height, input_width, output_height, output_width,
                                                          height_scale, width_scale, roi,
                                                          alloc, get_original_coordinate, false);
-  for (int32_t n = 0; n < batch_size; ++n) {
-    const T* const Xdata = XdataBase + n * (input_height * input_width) * num_channels;
-    T* const Ydata = YdataBase + n * (output_height * output_width) * num_channels;
-    concurrency::ThreadPool::TryParallelFor(
-        tp, static_cast<std::ptrdiff_t>(output_height) * output_width,
-        static_cast<double>(num_channels * 2),
-        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
-          for (std::ptrdiff_t i = first; i < last; ++i) {
-            const int32_t x = static_cast<int32_t>(i % output_width);
-            const int32_t y = static_cast<int32_t>(i / output_width);
-            const int32_t output_offset = (output_width * y + x) * num_channels;
-
-            // when use_extrapolation is set and original index of x or y is out of the dim range
-            // then use extrapolation_value as the output value.
-            if constexpr (UseExtrapolation) {
-              if ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
-                  (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1))) {
-                for (int32_t c = 0; c < num_channels; ++c) {
-                  Ydata[output_offset + c] = static_cast<T>(extrapolation_value);
-                }
-              } else {
-                const int32_t X11_offset = (p.input_width_mul_y1[y] + p.in_x1[x]) * num_channels;
-                const int32_t X21_offset = (p.input_width_mul_y1[y] + p.in_x2[x]) * num_channels;
-                const int32_t X12_offset = (p.input_width_mul_y2[y] + p.in_x1[x]) * num_channels;
-                const int32_t X22_offset = (p.input_width_mul_y2[y] + p.in_x2[x]) * num_channels;
-                const int32_t X11_coef_scale_20 = p.dx2_scale_10[x] * p.dy2_scale_10[y];
-                const int32_t X21_coef_scale_20 = p.dx1_scale_10[x] * p.dy2_scale_10[y];
-                const int32_t X12_coef_scale_20 = p.dx2_scale_10[x] * p.dy1_scale_10[y];
-                const int32_t X22_coef_scale_20 = p.dx1_scale_10[x] * p.dy1_scale_10[y];
-                for (int32_t c = 0; c < num_channels; ++c) {
-                  const T X11 = Xdata[X11_offset + c];
-                  const T X21 = Xdata[X21_offset + c];
-                  const T X12 = Xdata[X12_offset + c];
-                  const T X22 = Xdata[X22_offset + c];
-
-                  Ydata[output_offset + c] = static_cast<T>((X11_coef_scale_20 * X11 +
-                                                             X21_coef_scale_20 * X21 +
-                                                             X12_coef_scale_20 * X12 +
-                                                             X22_coef_scale_20 * X22) /
-                                                            (1 << 20));
-                }
-              }
-            } else {
-              const int32_t X11_offset = (p.input_width_mul_y1[y] + p.in_x1[x]) * num_channels;
-              const int32_t X21_offset = (p.input_width_mul_y1[y] + p.in_x2[x]) * num_channels;
-              const int32_t X12_offset = (p.input_width_mul_y2[y] + p.in_x1[x]) * num_channels;
-              const int32_t X22_offset = (p.input_width_mul_y2[y] + p.in_x2[x]) * num_channels;
-              const int32_t X11_coef_scale_20 = p.dx2_scale_10[x] * p.dy2_scale_10[y];
-              const int32_t X21_coef_scale_20 = p.dx1_scale_10[x] * p.dy2_scale_10[y];
-              const int32_t X12_coef_scale_20 = p.dx2_scale_10[x] * p.dy1_scale_10[y];
-              const int32_t X22_coef_scale_20 = p.dx1_scale_10[x] * p.dy1_scale_10[y];
-              for (int32_t c = 0; c < num_channels; ++c) {
-                const T X11 = Xdata[X11_offset + c];
-                const T X21 = Xdata[X21_offset + c];
-                const T X12 = Xdata[X12_offset + c];
-                const T X22 = Xdata[X22_offset + c];
-
-                Ydata[output_offset + c] = static_cast<T>((X11_coef_scale_20 * X11 +
-                                                           X21_coef_scale_20 * X21 +
-                                                           X12_coef_scale_20 * X12 +
-                                                           X22_coef_scale_20 * X22) /
-                                                          (1 << 20));
-              }
-            }
-          }
-        });
-  }
+  SeparableUpsampleBilinear<T, int32_t, UseExtrapolation>(batch_size, num_channels, input_height, input_width,
+                                                          output_height, output_width, p,
+                                                          p.dx1_scale_10, p.dx2_scale_10, p.dy1_scale_10,
+                                                          p.dy2_scale_10, extrapolation_value, XdataBase, YdataBase,
+                                                          tp);
 }
 
 }  // namespace onnxruntime
@@ -0,0 +1,161 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+// A string keyed dictionary for the string processing kernels (LabelEncoder, CategoryMapper, StringNormalizer, ...).
+// The dictionary is built once at kernel construction and then only looked up, typically for millions of rows.
+//
+// Keys are interned into a single arena and the table is open addressed (linear probing) over entries that keep the
+// full hash, so a lookup by std::string_view never allocates, rarely compares bytes of non-matching keys and touches
+// a couple of cache lines instead of walking the per-node allocations of std::unordered_map<std::string, T>.
+// Lookups are thread-safe as long as no insertion happens concurrently.
+template <typename TValue>
+class StringDictionary {
+ public:
+  StringDictionary() = default;
+
+  void Reserve(size_t num_keys) {
+    entries_.reserve(num_keys);
+    if (num_keys * 2 > slots_.size()) {
+      Rehash(num_keys * 2);
+    }
+  }
+
+  // Inserts the key if it is not present yet. Returns false (and keeps the existing value) otherwise.
+  bool Emplace(std::string_view key, const TValue& value) {
+    return Insert(key, value, false);
+  }
+
+  // Inserts the key or overwrites the value of the existing key.
+  void InsertOrAssign(std::string_view key, const TValue& value) {
+    Insert(key, value, true);
+  }
+
+  // Returns the value for the key or nullptr if the key is not present.
+  const TValue* Find(std::string_view key) const {
+    if (entries_.empty()) {
+      return nullptr;
+    }
+    const uint64_t hash = Hash(key);
+    const uint32_t entry = slots_[FindSlot(key, hash)];
+    return entry == 0 ? nullptr : &entries_[entry - 1].value;
+  }
+
+  bool Contains(std::string_view key) const {
+    return Find(key) != nullptr;
+  }
+
+  size_t Size() const { return entries_.size(); }
+
+  bool Empty() const { return entries_.empty(); }
+
+ private:
+  struct Entry {
+    uint64_t hash;
+    size_t offset;
+    size_t length;
+    TValue value;
+  };
+
+  // Hashes 8 bytes at a time
+  static uint64_t Hash(std::string_view key) {
+    constexpr uint64_t kMultiplier = 0x9E3779B97F4A7C15ull;
+    uint64_t hash = 0xCBF29CE484222325ull ^ (key.size() * kMultiplier);
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= key.size(); i += sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, key.data() + i, sizeof(word));
+      hash = (hash ^ word) * kMultiplier;
+      hash ^= hash >> 32;
+    }
+    if (i < key.size()) {
+      uint64_t word = 0;
+      memcpy(&word, key.data() + i, key.size() - i);
+      hash = (hash ^ word) * kMultiplier;
+    }
+    hash ^= hash >> 29;
+    hash *= 0xBF58476D1CE4E5B9ull;
+    hash ^= hash >> 32;
+    return hash;
+  }
+
+  std::string_view Key(const Entry& entry) const {
+    return std::string_view(arena_.data() + entry.offset, entry.length);
+  }
+
+  // Returns the slot holding the key or the empty slot where it would be inserted
+  size_t FindSlot(std::string_view key, uint64_t hash) const {
+    const size_t mask = slots_.size() - 1;
+    for (size_t slot = static_cast<size_t>(hash) & mask;; slot = (slot + 1) & mask) {
+      const uint32_t entry = slots_[slot];
+      if (entry == 0) {
+        return slot;
+      }
+      const Entry& candidate = entries_[entry - 1];
+      if (candidate.hash == hash && Key(candidate) == key) {
+        return slot;
+      }
+    }
+  }
+
+  bool Insert(std::string_view key, const TValue& value, bool overwrite) {
+    // Keep the load factor at or below 1/2
+    if ((entries_.size() + 1) * 2 > slots_.size()) {
+      Rehash((entries_.size() + 1) * 2);
+    }
+
+    const uint64_t hash = Hash(key);
+    const size_t slot = FindSlot(key, hash);
+    if (slots_[slot] != 0) {
+      if (overwrite) {
+        entries_[slots_[slot] - 1].value = value;
+      }
+      return false;
+    }
+
+    ORT_ENFORCE(entries_.size() < UINT32_MAX, "Too many keys in StringDictionary.");
+    entries_.push_back(Entry{hash, arena_.size(), key.size(), value});
+    arena_.append(key.data(), key.size());
+    slots_[slot] = static_cast<uint32_t>(entries_.size());
+    return true;
+  }
+
+  void Rehash(size_t min_slots) {
+    size_t num_slots = 16;
+    while (num_slots < min_slots) {
+      num_slots *= 2;
+    }
+    if (num_slots <= slots_.size()) {
+      return;
+    }
+
+    slots_.assign(num_slots, 0);
+    const size_t mask = num_slots - 1;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      size_t slot = static_cast<size_t>(entries_[i].hash) & mask;
+      while (slots_[slot] != 0) {
+        slot = (slot + 1) & mask;
+      }
+      slots_[slot] = static_cast<uint32_t>(i + 1);
+    }
+  }
+
+  // Holds the bytes of all the keys back to back
+  std::string arena_;
+  std::vector<Entry> entries_;
+  // Index + 1 of the entry in `entries_` or 0 for an empty slot. The size is always a power of 2.
+  std::vector<uint32_t> slots_;
+};
+
+}  // namespace onnxruntime
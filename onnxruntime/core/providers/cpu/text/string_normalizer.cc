@@ -3,7 +3,9 @@
 
 #include "string_normalizer.h"
 #include "core/common/common.h"
+#include "core/common/string_utils.h"
 #include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
 // Used below HAS_DEPRECATED_DECLARATIONS
 #include "onnxruntime_config.h"
 
@@ -12,6 +14,7 @@
 #include <locale.h>
 #endif  // _MSC_VER
 
+#include <algorithm>
 #include <codecvt>
 #include <locale>
 #include <functional>
@@ -440,6 +443,33 @@ const std::string default_locale("en_US.UTF-8");  // All non-MS and not Apple
 
 using namespace string_normalizer;
 
+namespace {
+
+// Returns true if the locale maps the case of every 7-bit ASCII character exactly like the plain ASCII mapping
+bool LocaleMatchesAsciiCase(const Locale& locale) {
+  std::wstring lower;
+  for (wchar_t ch = 1; ch < 0x80; ++ch) {
+    lower.push_back(ch);
+  }
+  std::wstring upper(lower);
+  locale.ChangeCase(StringNormalizer::LOWER, lower);
+  locale.ChangeCase(StringNormalizer::UPPER, upper);
+
+  for (wchar_t ch = 1; ch < 0x80; ++ch) {
+    const wchar_t expected_lower = (ch >= L'A' && ch <= L'Z') ? ch + (L'a' - L'A') : ch;
+    const wchar_t expected_upper = (ch >= L'a' && ch <= L'z') ? ch - (L'a' - L'A') : ch;
+    if (lower[ch - 1] != expected_lower || upper[ch - 1] != expected_upper) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Strings handled by a single task. The strings are short, so a task must hold quite a few to pay off.
+constexpr std::ptrdiff_t kStringsPerBatch = 256;
+
+}  // namespace
+
 StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info) {
   int64_t iscasesensitive = 0;
   Status status = info.GetAttr("is_case_sensitive", &iscasesensitive);
@@ -462,21 +492,29 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info) {
   locale_name_ = info.GetAttrOrDefault("locale", default_locale);
 
   std::vector<std::string> stop_words = info.GetAttrsOrDefault<std::string>("stopwords");
+  stopwords_.Reserve(stop_words.size());
   if (is_case_sensitive_) {
-    stopwords_.reserve(stop_words.size());
-    for (std::string& s : stop_words) {
-      stopwords_.insert(std::move(s));
+    for (const std::string& s : stop_words) {
+      stopwords_.Emplace(s, true);
     }
   } else {
     Locale locale(locale_name_);
     Utf8Converter converter;
-    wstopwords_.reserve(stop_words.size());
-    for (std::string& s : stop_words) {
+    for (const std::string& s : stop_words) {
       std::wstring wstr = converter.from_bytes(s);
       locale.ChangeCase(compare_caseaction_, wstr);
-      wstopwords_.insert(std::move(wstr));
+      std::string str;
+      str.resize(converter.ComputeRequiredSizeToUtf8(wstr));
+      ORT_THROW_IF_ERROR(converter.ConvertToUtf8(wstr, str));
+      stopwords_.Emplace(str, true);
     }
   }
+
+  // Only query the locale when Compute() needs it
+  if (case_change_action_ != NONE || (!is_case_sensitive_ && !stopwords_.Empty())) {
+    Locale locale(locale_name_);
+    ascii_case_matches_locale_ = LocaleMatchesAsciiCase(locale);
+  }
 }
 
 Status StringNormalizer::Compute(OpKernelContext* ctx) const {
@@ -507,9 +545,7 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   }
 
   // Special case, no filtering and no case change
-  if (case_change_action_ == NONE &&
-      ((is_case_sensitive_ && stopwords_.empty()) ||
-       (!is_case_sensitive_ && wstopwords_.empty()))) {
+  if (case_change_action_ == NONE && stopwords_.Empty()) {
     output_shape.push_back(C);
     auto output_tensor = ctx->Output(0, output_shape);
     auto const output_data = output_tensor->MutableData<std::string>();
@@ -520,118 +556,113 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   // We need to know the result dimension, and for that we need to filter
   // the words first. If comparison mode is case sensitive, we just go ahead
   // and compare with the original strings. Otherwise, we need to convert the string
-  // to widechar, lowercase it and then compare. Case-insensitive comparison is complicated
+  // to widechar, change its case and then compare. Case-insensitive comparison is complicated
   // for UTF-8 and requires additional dependency.
+  // ASCII strings take a shortcut when the locale agrees with the ASCII case mapping.
 
   Locale locale(locale_name_);
-  Utf8Converter converter;
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const std::ptrdiff_t num_strings = narrow<std::ptrdiff_t>(input_span.size());
+
+  // Changes the case of `s` into `dest`, using `wchar_buffer` as scratch space
+  auto change_case = [this, &locale](CaseAction case_action, const std::string& s, std::string& dest,
+                                     Utf8Converter& converter, std::wstring& wchar_buffer) -> Status {
+    if (ascii_case_matches_locale_ && utils::IsAsciiString(s)) {
+      dest.resize(s.size());
+      if (case_action == LOWER) {
+        utils::AsciiToLower(s, dest.data());
+      } else {
+        utils::AsciiToUpper(s, dest.data());
+      }
+      return Status::OK();
+    }
 
-  // Compute the largest widestring buffer needed.
-  size_t max_wide_buffer_len = 0;
-  for (const auto& s : input_span) {
-    size_t wchars = 0;
     // Checks for invalid UTF-8 characters on Windows
+    size_t wchars = 0;
     ORT_RETURN_IF_ERROR(converter.ComputeRequiredSizeToWideChar(s, wchars));
-    max_wide_buffer_len = std::max(max_wide_buffer_len, wchars);
-  }
-
-  // Reuse reserved space
-  std::wstring wchar_buffer;
-  wchar_buffer.reserve(max_wide_buffer_len);
-
-  // Output everything and change case as required
-  auto output_no_filtering = [&](const TensorShape& output_shape) {
-    auto output_tensor = ctx->Output(0, output_shape);
-    auto const output_data = output_tensor->MutableData<std::string>();
-    for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
-      const std::string& s = input_span[i];
-      wchar_buffer.resize(max_wide_buffer_len);
-      ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-      locale.ChangeCase(case_change_action_, wchar_buffer);
+    wchar_buffer.resize(wchars);
+    ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
+    locale.ChangeCase(case_action, wchar_buffer);
 
-      auto& dest = output_data[i];
-      size_t utf8_buffer_len = converter.ComputeRequiredSizeToUtf8(wchar_buffer);
-      dest.resize(utf8_buffer_len);
-      ORT_RETURN_IF_ERROR(converter.ConvertToUtf8(wchar_buffer, dest));
-    }
-    return Status::OK();
+    dest.resize(converter.ComputeRequiredSizeToUtf8(wchar_buffer));
+    return converter.ConvertToUtf8(wchar_buffer, dest);
   };
 
-  auto output_filtered = [&](const TensorShape& output_shape, gsl::span<const size_t> filtered_indices) {
-    auto output_tensor = ctx->Output(0, output_shape);
-    auto output_data = output_tensor->MutableData<std::string>();
-    for (size_t i : filtered_indices) {
-      const std::string& s = input_span[i];
-      if (case_change_action_ != NONE) {
-        wchar_buffer.resize(max_wide_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-        locale.ChangeCase(case_change_action_, wchar_buffer);
-
-        auto& dest = *output_data++;
-        size_t utf8_buffer_len = converter.ComputeRequiredSizeToUtf8(wchar_buffer);
-        dest.resize(utf8_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToUtf8(wchar_buffer, dest));
-      } else {
-        *output_data++ = s;
+  // Runs `fn(index, converter, wchar_buffer, scratch)` over the given number of strings in parallel batches.
+  // Each batch has its own converter and scratch buffers.
+  auto parallel_for_strings = [tp](std::ptrdiff_t count,
+                                   const std::function<Status(std::ptrdiff_t, Utf8Converter&, std::wstring&,
+                                                              std::string&)>& fn) -> Status {
+    const std::ptrdiff_t num_batches = std::clamp<std::ptrdiff_t>(
+        count / kStringsPerBatch, 1, concurrency::ThreadPool::DegreeOfParallelism(tp));
+    std::vector<Status> batch_status(onnxruntime::narrow<size_t>(num_batches));
+    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_batches, [&](std::ptrdiff_t batch) {
+      auto work = concurrency::ThreadPool::PartitionWork(batch, num_batches, count);
+      Utf8Converter converter;
+      std::wstring wchar_buffer;
+      std::string scratch;
+      for (std::ptrdiff_t i = work.start; i < work.end; ++i) {
+        auto status = fn(i, converter, wchar_buffer, scratch);
+        if (!status.IsOK()) {
+          batch_status[batch] = std::move(status);
+          return;
+        }
       }
+    });
+    for (auto& status : batch_status) {
+      ORT_RETURN_IF_ERROR(status);
     }
     return Status::OK();
   };
 
-  Status status;
-
-  if (is_case_sensitive_) {
-    if (stopwords_.empty()) {
-      assert(case_change_action_ != NONE);
-      output_shape.push_back(C);
-      status = output_no_filtering(output_shape);
-    } else {
-      // we need to filter
-      InlinedVector<size_t> filtered_strings_indices;
-      filtered_strings_indices.reserve(input_span.size());
-
-      for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
-        const std::string& s = input_span[i];
-        if (stopwords_.count(s) == 0) {
-          filtered_strings_indices.push_back(i);
-        }
+  // Filter the stopwords out
+  std::vector<std::ptrdiff_t> filtered_strings_indices;
+  if (!stopwords_.Empty()) {
+    std::vector<uint8_t> keep(input_span.size());
+    ORT_RETURN_IF_ERROR(parallel_for_strings(
+        num_strings, [&](std::ptrdiff_t i, Utf8Converter& converter, std::wstring& wchar_buffer, std::string& scratch) {
+          const std::string& s = input_span[i];
+          if (is_case_sensitive_) {
+            keep[i] = !stopwords_.Contains(s);
+          } else {
+            // Case insensitive filtering is performed by converting the input strings
+            // to compare_caseaction_.
+            ORT_RETURN_IF_ERROR(change_case(compare_caseaction_, s, scratch, converter, wchar_buffer));
+            keep[i] = !stopwords_.Contains(scratch);
+          }
+          return Status::OK();
+        }));
+
+    filtered_strings_indices.reserve(input_span.size());
+    for (std::ptrdiff_t i = 0; i < num_strings; ++i) {
+      if (keep[i]) {
+        filtered_strings_indices.push_back(i);
       }
-
-      // According to the spec, if all strings are filtered out
-      // the output must have a shape of {1} with a single empty string.
-      const int64_t filtered_count = std::max<int64_t>(1, narrow<int64_t>(filtered_strings_indices.size()));
-      output_shape.push_back(filtered_count);
-      status = output_filtered(output_shape, filtered_strings_indices);
     }
-  } else {
-    if (wstopwords_.empty()) {
-      assert(case_change_action_ != NONE);
-      output_shape.push_back(C);
-      status = output_no_filtering(output_shape);
-    } else {
-      // Case insensitive filtering is performed by converting the input strings
-      // to compare_caseaction_. For that we convert to wchar_t UNICODE.
-      // Otherwise, we need to pull ICU library on all platforms.
-      InlinedVector<size_t> filtered_strings_indices;
-      filtered_strings_indices.reserve(input_span.size());
-      for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
-        const std::string& s = input_span[i];
-        wchar_buffer.resize(max_wide_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-        locale.ChangeCase(compare_caseaction_, wchar_buffer);
-        if (wstopwords_.count(wchar_buffer) == 0) {
-          filtered_strings_indices.push_back(i);
-        }
-      }
 
-      // According to the spec, if all strings are filtered out
-      // the output must have a shape of {1} with a single empty string.
-      const int64_t filtered_count = std::max<int64_t>(1, narrow<int64_t>(filtered_strings_indices.size()));
-      output_shape.push_back(filtered_count);
-      status = output_filtered(output_shape, filtered_strings_indices);
-    }
+    // According to the spec, if all strings are filtered out
+    // the output must have a shape of {1} with a single empty string.
+    const int64_t filtered_count = std::max<int64_t>(1, narrow<int64_t>(filtered_strings_indices.size()));
+    output_shape.push_back(filtered_count);
+  } else {
+    assert(case_change_action_ != NONE);
+    output_shape.push_back(C);
   }
 
-  return status;
+  auto output_tensor = ctx->Output(0, output_shape);
+  auto output_data = output_tensor->MutableData<std::string>();
+  const bool filtered = !stopwords_.Empty();
+  const std::ptrdiff_t output_count = filtered ? narrow<std::ptrdiff_t>(filtered_strings_indices.size()) : num_strings;
+
+  // Output the remaining strings and change case as required
+  return parallel_for_strings(
+      output_count, [&](std::ptrdiff_t i, Utf8Converter& converter, std::wstring& wchar_buffer, std::string&) {
+        const std::string& s = input_span[filtered ? filtered_strings_indices[i] : i];
+        if (case_change_action_ == NONE) {
+          output_data[i] = s;
+          return Status::OK();
+        }
+        return change_case(case_change_action_, s, output_data[i], converter, wchar_buffer);
+      });
 }
 }  // namespace onnxruntime
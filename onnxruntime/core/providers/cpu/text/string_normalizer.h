@@ -3,8 +3,8 @@
 
 #pragma once
 
-#include "core/common/inlined_containers.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/text/string_dictionary.h"
 
 #include <locale>
 #include <string>
@@ -31,9 +31,11 @@ class StringNormalizer : public OpKernel {
   // used for case-insensitive compare
   CaseAction compare_caseaction_{LOWER};
   std::string locale_name_;
-  // Either if these are populated but not both
-  InlinedHashSet<std::string> stopwords_;
-  InlinedHashSet<std::wstring> wstopwords_;
+  // UTF-8 stopwords, already converted to compare_caseaction_ if the comparison is case-insensitive
+  StringDictionary<bool> stopwords_;
+  // Set if the locale changes the case of ASCII characters just like the plain ASCII mapping,
+  // which lets ASCII strings skip the UTF-8 -> wchar_t -> UTF-8 round trip
+  bool ascii_case_matches_locale_{false};
 };
 
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <atomic>
 #include <memory>
 #include <sstream>
 #include <list>
@@ -730,6 +731,12 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 InferenceSession::~InferenceSession() {
+  // The background initialization of deferred subgraphs uses the session state.
+  if (subgraph_initialization_done_) {
+    stop_subgraph_initialization_.store(true, std::memory_order_relaxed);
+    subgraph_initialization_done_->Wait();
+  }
+
   if (session_options_.enable_profiling) {
     ORT_TRY {
       EndProfiling();
@@ -962,6 +969,140 @@ common::Status InferenceSession::SaveToOrtFormat(const std::filesystem::path& fi
   return Status::OK();
 }
 
+common::Status InferenceSession::LoadFromSessionCache() {
+  const std::string cache_dir = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsSessionCacheDir,
+                                                                                    "");
+  if (cache_dir.empty()) {
+    return Status::OK();
+  }
+
+  std::error_code error;
+  if (!ort_format_model_bytes_.empty() || !session_options_.optimized_model_filepath.empty() ||
+      !session_options_.external_initializers.empty() ||
+      !session_options_.external_initializer_files_mmap.empty() ||
+      !session_options_.initializers_to_share_map.empty() ||
+      model_location_.empty() || !std::filesystem::is_regular_file(model_location_, error)) {
+    LOGS(*session_logger_, INFO) << "The session cache is only used for ONNX models loaded from a file, without an "
+                                    "optimized model path or initializers provided by the session options.";
+    return Status::OK();
+  }
+
+  size_t model_size = 0;
+  ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(model_location_.c_str(), model_size));
+  std::vector<char> model_bytes(model_size);
+  ORT_RETURN_IF_ERROR(Env::Default().ReadFileIntoBuffer(model_location_.c_str(), 0, model_size,
+                                                        gsl::make_span(model_bytes)));
+
+  const std::string key = inference_session_utils::ComputeSessionCacheKey(
+      model_bytes, *model_, custom_schema_registries_, session_options_, optimizers_to_disable_,
+      execution_providers_.GetIds());
+  std::filesystem::path cached_model_path = std::filesystem::path(ToPathString(cache_dir)) / (key + ".onnx");
+
+  if (!std::filesystem::exists(cached_model_path, error)) {
+    LOGS(*session_logger_, INFO) << "Session cache miss. The optimized model is saved to "
+                                 << ToUTF8String(cached_model_path.native());
+    session_cache_model_path_ = std::move(cached_model_path);
+    return Status::OK();
+  }
+
+  const bool strict_shape_type_inference = session_options_.config_options.GetConfigOrDefault(
+                                               kOrtSessionOptionsConfigStrictShapeTypeInference, "0") == "1";
+  std::shared_ptr<onnxruntime::Model> cached_model;
+  Status status = onnxruntime::Model::Load(cached_model_path.native(), cached_model,
+                                           HasLocalSchema() ? &custom_schema_registries_ : nullptr,
+                                           *session_logger_,
+                                           ModelOptions(true, strict_shape_type_inference,
+                                                        check_load_cancellation_fn_));
+  if (!status.IsOK()) {
+    // a stale or corrupted entry is removed so it is replaced instead of failing the session. Entries are only
+    // published if the path does not exist, see SaveToSessionCache.
+    LOGS(*session_logger_, WARNING) << "Failed to load the cached model " << ToUTF8String(cached_model_path.native())
+                                    << ". It is replaced. " << status.ErrorMessage();
+    std::filesystem::remove(cached_model_path, error);
+    session_cache_model_path_ = std::move(cached_model_path);
+    return Status::OK();
+  }
+
+  LOGS(*session_logger_, INFO) << "Session cache hit. Loaded the optimized model "
+                               << ToUTF8String(cached_model_path.native());
+  model_ = std::move(cached_model);
+  model_location_ = cached_model_path.native();
+  loaded_from_session_cache_ = true;
+  return SaveModelMetadata(*model_);
+}
+
+void InferenceSession::SaveToSessionCache() {
+  if (session_state_->GetFuncMgr().NumFuncs() > 0) {
+    LOGS(*session_logger_, INFO) << "The optimized model contains compiled nodes and is not saved to the session cache.";
+    return;
+  }
+
+  // Sessions of other processes may save the same entry concurrently. Each session writes the model under a
+  // temporary name and the external data to a file name unique to the session, which the model references. The
+  // complete model is then published under its final name only if no other session published it first, so a session
+  // never loads a partially written entry and a published external data file is never rewritten.
+  static std::atomic<size_t> session_cache_save_counter{0};
+  const PathString unique_suffix = ToPathString(std::to_string(Env::Default().GetSelfPid()) + "." +
+                                                std::to_string(session_cache_save_counter++));
+  const std::filesystem::path external_data_file_name =
+      session_cache_model_path_.stem().native() + ORT_TSTR(".") + unique_suffix + ORT_TSTR(".onnx.data");
+  const std::filesystem::path external_data_path =
+      session_cache_model_path_.parent_path() / external_data_file_name;
+  std::filesystem::path temp_model_path = session_cache_model_path_;
+  temp_model_path += ORT_TSTR(".") + unique_suffix + ORT_TSTR(".tmp");
+
+  std::error_code error;
+  std::filesystem::create_directories(session_cache_model_path_.parent_path(), error);
+
+  const size_t external_initializers_min_size_in_bytes =
+      ParseStringWithClassicLocale<size_t>(session_options_.config_options.GetConfigOrDefault(
+          kOrtSessionOptionsOptimizedModelExternalInitializersMinSizeInBytes, "1024"));
+  ModelSavingOptions model_saving_options{external_initializers_min_size_in_bytes};
+  model_saving_options.align_offset = true;
+
+  Status status;
+  ORT_TRY {
+    status = Model::SaveWithExternalInitializers(*model_, temp_model_path, external_data_file_name,
+                                                 model_saving_options);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+    });
+  }
+
+  bool published = false;
+  if (status.IsOK()) {
+    // creating a hard link fails if the entry exists, unlike a rename which replaces it
+    std::filesystem::create_hard_link(temp_model_path, session_cache_model_path_, error);
+    if (!error) {
+      published = true;
+    } else if (!std::filesystem::exists(session_cache_model_path_, error)) {
+      // the file system does not support hard links
+      std::filesystem::rename(temp_model_path, session_cache_model_path_, error);
+      if (error) {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, error.message());
+      } else {
+        published = true;
+      }
+    } else {
+      LOGS(*session_logger_, INFO) << "The optimized model was saved to the session cache by another session. "
+                                   << ToUTF8String(session_cache_model_path_.native());
+    }
+  }
+
+  std::filesystem::remove(temp_model_path, error);
+  if (!published) {
+    std::filesystem::remove(external_data_path, error);
+  }
+
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Failed to save the optimized model to the session cache "
+                                    << ToUTF8String(session_cache_model_path_.native()) << ". "
+                                    << status.ErrorMessage();
+  }
+}
+
 common::Status InferenceSession::LoadWithLoader(std::function<common::Status(std::shared_ptr<Model>&)> loader,
                                                 const std::string& event_name) {
   Status status = Status::OK();
@@ -1998,6 +2139,11 @@ static void ResolveMemoryPatternFlags(SessionState& session_state) {
 
   for (const auto& entry : session_state.GetSubgraphSessionStateMap()) {
     for (const auto& name_to_subgraph_session_state : entry.second) {
+      // resolved when the deferred finalization of the subgraph session state runs
+      if (name_to_subgraph_session_state.second->IsFinalizationDeferred()) {
+        continue;
+      }
+
       ResolveMemoryPatternFlags(*name_to_subgraph_session_state.second);
     }
   }
@@ -2059,6 +2205,11 @@ common::Status InferenceSession::Initialize() {
       }
 
       have_cpu_ep = execution_providers_.Get(onnxruntime::kCpuExecutionProvider) != nullptr;
+
+#if !defined(ORT_MINIMAL_BUILD)
+      // The execution providers are known now. A CPU EP that is implicitly added below doesn't change the cache key.
+      ORT_RETURN_IF_ERROR_SESSIONID_(LoadFromSessionCache());
+#endif
     }
 
     // Verify that there are no external initializers in the graph if external data is disabled.
@@ -2220,9 +2371,11 @@ common::Status InferenceSession::Initialize() {
         return Status::OK();
       };
 
-      // add predefined transformers
+      // add predefined transformers. a model from the session cache was optimized already.
       ORT_RETURN_IF_ERROR_SESSIONID_(AddPredefinedTransformers(graph_transformer_mgr_,
-                                                               session_options_.graph_optimization_level,
+                                                               loaded_from_session_cache_
+                                                                   ? TransformerLevel::Default
+                                                                   : session_options_.graph_optimization_level,
                                                                minimal_build_optimization_handling,
                                                                record_runtime_optimization_produced_op_schema,
                                                                *session_logger_));
@@ -2452,13 +2605,24 @@ common::Status InferenceSession::Initialize() {
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
     }
 
+#if !defined(ORT_MINIMAL_BUILD)
+    const bool saving_session_cache = !session_cache_model_path_.empty();
+#else
+    const bool saving_session_cache = false;
+#endif
+
     ORT_RETURN_IF_ERROR_SESSIONID_(
         session_state_->FinalizeSessionState(model_location_, kernel_registry_manager_,
                                              // need to keep the initializers if saving the optimized model
-                                             !saving_model,
-                                             saving_ort_format));
+                                             !saving_model && !saving_session_cache,
+                                             saving_ort_format,
+                                             saving_session_cache));
 
 #if !defined(ORT_MINIMAL_BUILD)
+    if (saving_session_cache) {
+      SaveToSessionCache();
+    }
+
     if (saving_model) {
       if (session_state_->GetFuncMgr().NumFuncs() > 0) {
         ORT_RETURN_IF_ERROR_SESSIONID_(
@@ -2507,6 +2671,12 @@ common::Status InferenceSession::Initialize() {
     }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+    if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigEnableCpuGraphCapture, "0") ==
+        "1") {
+      ORT_RETURN_IF_ERROR_SESSIONID_(CpuGraph::Create(*session_state_, cpu_graph_));
+      LOGS(*session_logger_, INFO) << "This session will use the CPU graph capture feature as requested by the user.";
+    }
+
     // Resolve memory pattern flags of the main graph and subgraph session states
     ResolveMemoryPatternFlags(*session_state_);
 
@@ -2520,6 +2690,33 @@ common::Status InferenceSession::Initialize() {
     // once the model is saved, we may remove unnecessary attributes for inference
     session_state_->PruneRemovableAttributes();
 
+    // Initialize the subgraphs that were deferred to their first execution in the background if requested.
+    // Run calls that need one of them before that happens initialize it themselves.
+    concurrency::ThreadPool* subgraph_initialization_thread_pool = GetIntraOpThreadPoolToUse();
+    if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigLazySubgraphInitialization,
+                                                           "0") == "2" &&
+        subgraph_initialization_thread_pool != nullptr) {
+      subgraph_initialization_done_ = std::make_unique<Notification>();
+      concurrency::ThreadPool::Schedule(subgraph_initialization_thread_pool, [this]() {
+        Status status;
+        ORT_TRY {
+          status = session_state_->FinalizeDeferredSubgraphSessionStates([this]() {
+            return stop_subgraph_initialization_.load(std::memory_order_relaxed);
+          });
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+          });
+        }
+        if (!status.IsOK()) {
+          LOGS(*session_logger_, WARNING) << "Background initialization of subgraphs failed: "
+                                          << status.ErrorMessage();
+        }
+        subgraph_initialization_done_->Notify();
+      });
+    }
+
     // and log telemetry
     std::filesystem::path model_path = graph.ModelPath();
     std::string model_file_name = model_path.filename().string();
@@ -3053,7 +3250,15 @@ Status InferenceSession::Run(const RunOptions& run_options,
       DeviceStreamCollectionHolder device_stream_collection_holder(session_state_.get());
 #endif
 
-      if (retval.IsOK()) {
+      // Replay the graph captured on CPU, or capture it, if it applies to this Run.
+      bool executed_cpu_graph = false;
+      if (retval.IsOK() && cpu_graph_ &&
+          graph_annotation_id != CachedExecutionProviderForGraphReplay::kGraphAnnotationSkip) {
+        retval = cpu_graph_->Run(graph_annotation_id, feeds_fetches_manager.GetFeedsFetchesInfo(), feeds, *p_fetches,
+                                 run_options.config_options, run_options.terminate, executed_cpu_graph);
+      }
+
+      if (retval.IsOK() && !executed_cpu_graph) {
         retval = utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds, *p_fetches,
                                      session_options_.execution_mode,
                                      run_options,
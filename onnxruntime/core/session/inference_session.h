@@ -15,6 +15,7 @@
 #include "core/common/path_string.h"
 #include "core/common/profiler.h"
 #include "core/common/status.h"
+#include "core/framework/cpu_graph.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/iexecutor.h"
@@ -754,6 +755,14 @@ class InferenceSession {
   }
 
   common::Status SaveToOrtFormat(const std::filesystem::path& filepath) const;
+
+  // Replaces the loaded model with its optimized version from the session cache directory if there is one.
+  // Otherwise remembers where the optimized model is saved once the session state is finalized.
+  [[nodiscard]] common::Status LoadFromSessionCache();
+
+  // Saves the optimized model and its pre-packed weights to the session cache directory.
+  // Failures are logged and don't fail the session initialization.
+  void SaveToSessionCache();
 #endif
 
   /**
@@ -932,6 +941,19 @@ class InferenceSession {
   bool is_inited_ = false;                   // GUARDED_BY(session_mutex_)
   bool is_concurrent_run_supported_ = true;  // Graph execution in Run is GUARDED_BY(session_mutex_) if false
 
+  // Background initialization of the subgraphs deferred by kOrtSessionOptionsConfigLazySubgraphInitialization.
+  // Set when it was scheduled, and notified once it completes.
+  std::unique_ptr<Notification> subgraph_initialization_done_;
+  std::atomic<bool> stop_subgraph_initialization_{false};
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Session cache (kOrtSessionOptionsSessionCacheDir) state set by LoadFromSessionCache.
+  // The model was loaded from the cache so the graph optimizations are skipped.
+  bool loaded_from_session_cache_ = false;  // GUARDED_BY(session_mutex_)
+  // Path to save the optimized model to on a cache miss. Empty if the cache is not used or was hit.
+  std::filesystem::path session_cache_model_path_;  // GUARDED_BY(session_mutex_)
+#endif
+
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
   InterOpDomains interop_domains_;
 #endif
@@ -1041,6 +1063,9 @@ class InferenceSession {
 
   CachedExecutionProviderForGraphReplay cached_execution_provider_for_graph_replay_;
 
+  // Captured graphs of the CPU graph capture (kOrtSessionOptionsConfigEnableCpuGraphCapture) if it is enabled.
+  std::unique_ptr<CpuGraph> cpu_graph_;
+
 #if !defined(ORT_MINIMAL_BUILD)
   // Enable nodestats collection
   std::optional<NodeStatsRecorder> node_stats_recorder_;
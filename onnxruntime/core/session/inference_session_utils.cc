@@ -5,6 +5,21 @@
 
 #include "core/session/inference_session_utils.h"
 
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <set>
+#include <sstream>
+
+#include "core/common/cpuid_info.h"
+#include "core/common/path_string.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/model.h"
+#include "core/graph/schema_registry.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "onnxruntime_config.h"  // for ORT_VERSION
+
 namespace onnxruntime {
 
 //---------------------
@@ -270,6 +285,169 @@ Status ParseTuningResultsFromModelMetadata(const onnxruntime::ModelMetadata& met
   return Status::OK();
 }
 
+// Adds the paths of the external data files of the initializers of graph and its subgraphs to external_data_files,
+// and the custom op schemas of its nodes to custom_schemas.
+static void CollectSessionCacheDependencies(
+    const Graph& graph,
+    const std::list<std::shared_ptr<IOnnxRuntimeOpSchemaCollection>>& custom_schema_registries,
+    std::set<std::filesystem::path>& external_data_files,
+    std::set<const ONNX_NAMESPACE::OpSchema*>& custom_schemas) {
+  const std::filesystem::path model_dir = graph.ModelPath().parent_path();
+
+  for (const auto& [name, tensor_proto] : graph.GetAllInitializedTensors()) {
+    if (!utils::HasExternalData(*tensor_proto) || utils::HasExternalDataInMemory(*tensor_proto)) {
+      continue;
+    }
+
+    std::basic_string<ORTCHAR_T> file_path;
+    FileOffsetType offset = 0;
+    SafeInt<size_t> length = 0;
+    if (utils::GetExternalDataInfo(*tensor_proto, model_dir, file_path, offset, length).IsOK()) {
+      external_data_files.insert(file_path);
+    }
+  }
+
+  for (const auto& node : graph.Nodes()) {
+    const ONNX_NAMESPACE::OpSchema* schema = node.Op();
+    if (schema != nullptr) {
+      for (const auto& registry : custom_schema_registries) {
+        if (registry->GetSchema(node.OpType(), schema->SinceVersion(), node.Domain()) == schema) {
+          custom_schemas.insert(schema);
+          break;
+        }
+      }
+    }
+
+    for (const auto& [attribute_name, subgraph] : node.GetAttributeNameToSubgraphMap()) {
+      CollectSessionCacheDependencies(*subgraph, custom_schema_registries, external_data_files, custom_schemas);
+    }
+  }
+}
+
+std::string ComputeSessionCacheKey(gsl::span<const char> model_bytes,
+                                   const Model& model,
+                                   const std::list<std::shared_ptr<IOnnxRuntimeOpSchemaCollection>>&
+                                       custom_schema_registries,
+                                   const SessionOptions& session_options,
+                                   const InlinedHashSet<std::string>& optimizers_to_disable,
+                                   gsl::span<const std::string> execution_provider_ids) {
+  uint32_t model_hash[4];
+  MurmurHash3::x86_128(model_bytes.data(), model_bytes.size(), 0, model_hash);
+
+  // Everything that can change the optimized graph or the pre-packed weights besides the model itself.
+  std::ostringstream description;
+  description << "model:" << model_hash[0] << "," << model_hash[1] << "," << model_hash[2] << "," << model_hash[3];
+
+  std::set<std::filesystem::path> external_data_files;
+  std::set<const ONNX_NAMESPACE::OpSchema*> custom_schemas;
+  CollectSessionCacheDependencies(model.MainGraph(), custom_schema_registries, external_data_files, custom_schemas);
+
+  // The content of the external data files is not hashed as they may be very large. A file that is replaced or
+  // modified has a different size or modification time.
+  description << ";external_data:";
+  for (const auto& file : external_data_files) {
+    std::error_code size_error;
+    std::error_code time_error;
+    const auto file_size = std::filesystem::file_size(file, size_error);
+    const auto write_time = std::filesystem::last_write_time(file, time_error);
+    description << PathToUTF8String(file.native()) << ":" << (size_error ? 0 : file_size) << ":"
+                << (time_error ? 0 : write_time.time_since_epoch().count()) << ",";
+  }
+
+  // The custom op registries of the session are used to load the cached model, so the registered domains and the
+  // schemas the model was optimized with must not change.
+  std::vector<std::string> schema_descriptions;
+  for (const auto* schema : custom_schemas) {
+    std::ostringstream schema_description;
+    schema_description << schema->domain() << ":" << schema->Name() << ":" << schema->SinceVersion() << "(";
+    for (const auto& input : schema->inputs()) {
+      schema_description << input.GetName() << ":" << input.GetTypeStr() << ":"
+                         << static_cast<int>(input.GetOption()) << ",";
+    }
+    schema_description << ")->(";
+    for (const auto& output : schema->outputs()) {
+      schema_description << output.GetName() << ":" << output.GetTypeStr() << ":"
+                         << static_cast<int>(output.GetOption()) << ",";
+    }
+    schema_description << ")";
+    for (const auto& constraint : schema->typeConstraintParams()) {
+      schema_description << constraint.type_param_str << "=";
+      for (const auto& type : constraint.allowed_type_strs) {
+        schema_description << type << "|";
+      }
+      schema_description << ",";
+    }
+    std::vector<std::string> attributes;
+    for (const auto& [attribute_name, attribute] : schema->attributes()) {
+      attributes.push_back(attribute_name + ":" + std::to_string(static_cast<int>(attribute.type)) + ":" +
+                           std::to_string(attribute.required));
+    }
+    std::sort(attributes.begin(), attributes.end());
+    for (const auto& attribute : attributes) {
+      schema_description << attribute << ",";
+    }
+    schema_descriptions.push_back(schema_description.str());
+  }
+  for (const auto& registry : custom_schema_registries) {
+    for (const auto& [domain, version] : registry->GetLatestOpsetVersions(false)) {
+      schema_descriptions.push_back(domain + ":" + std::to_string(version));
+    }
+  }
+  std::sort(schema_descriptions.begin(), schema_descriptions.end());
+  description << ";custom_schemas:";
+  for (const auto& schema_description : schema_descriptions) {
+    description << schema_description << ";";
+  }
+
+  description << ";version:" << ORT_VERSION << ";providers:";
+  for (const auto& id : execution_provider_ids) {
+    description << id << ",";
+  }
+
+  description << ";level:" << static_cast<int>(session_options.graph_optimization_level) << ";disabled:";
+  std::vector<std::string> disabled(optimizers_to_disable.begin(), optimizers_to_disable.end());
+  std::sort(disabled.begin(), disabled.end());
+  for (const auto& name : disabled) {
+    description << name << ",";
+  }
+
+  description << ";dims:";
+  for (const auto& dim : session_options.free_dimension_overrides) {
+    description << dim.dim_identifier << ":" << static_cast<int>(dim.dim_identifier_type) << "=" << dim.dim_value
+                << ",";
+  }
+
+  description << ";config:";
+  std::vector<std::pair<std::string, std::string>> configs;
+  for (const auto& entry : session_options.config_options.GetConfigOptionsMap()) {
+    if (entry.first != kOrtSessionOptionsSessionCacheDir) {
+      configs.emplace_back(entry.first, entry.second);
+    }
+  }
+  std::sort(configs.begin(), configs.end());
+  for (const auto& entry : configs) {
+    description << entry.first << "=" << entry.second << ",";
+  }
+
+  const auto& cpu_info = CPUIDInfo::GetCPUIDInfo();
+  description << ";cpu:" << cpu_info.GetCPUVendor() << ","
+              << cpu_info.HasAVX() << cpu_info.HasAVX2() << cpu_info.HasAVX512f() << cpu_info.HasAVX512Skylake()
+              << cpu_info.HasAVX512_BF16() << cpu_info.HasAMX_BF16() << cpu_info.HasF16C()
+              << cpu_info.HasArmNeonDot() << cpu_info.HasArmNeon_I8MM() << cpu_info.HasArmSve()
+              << cpu_info.HasArmNeon_BF16() << cpu_info.HasArm_SME();
+
+  const std::string key_source = description.str();
+  uint32_t key[4];
+  MurmurHash3::x86_128(key_source.data(), key_source.size(), 0, key);
+
+  std::ostringstream key_str;
+  key_str << std::hex << std::setfill('0');
+  for (uint32_t part : key) {
+    key_str << std::setw(8) << part;
+  }
+  return key_str.str();
+}
+
 }  // namespace inference_session_utils
 }  // namespace onnxruntime
 
@@ -65,6 +65,18 @@ Status ParseTuningResultsFromModelMetadata(const onnxruntime::ModelMetadata& met
                                            /*out*/ bool& key_found,
                                            const logging::Logger& logger);
 
+// Computes the key of the session cache entries (kOrtSessionOptionsSessionCacheDir) of a model.
+// The key is a hash of the model file content, the size and modification time of the external data files of
+// model, the custom op schemas the nodes of model use, the ORT version, the execution providers, the session options
+// that affect the optimized graph or the pre-packed weights, and the CPU features the pre-packed weights may depend on.
+std::string ComputeSessionCacheKey(gsl::span<const char> model_bytes,
+                                   const Model& model,
+                                   const std::list<std::shared_ptr<IOnnxRuntimeOpSchemaCollection>>&
+                                       custom_schema_registries,
+                                   const SessionOptions& session_options,
+                                   const InlinedHashSet<std::string>& optimizers_to_disable,
+                                   gsl::span<const std::string> execution_provider_ids);
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 }  // namespace inference_session_utils
@@ -0,0 +1,173 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Reference pooling of the rows of a dequantized [num_rows, dim] table.
+std::vector<float> PoolBags(const std::vector<float>& table, int64_t dim, const std::vector<int64_t>& indices,
+                            const std::vector<int64_t>& bag_starts, const std::vector<float>& weights, bool mean) {
+  const int64_t num_rows = static_cast<int64_t>(table.size()) / dim;
+  const size_t num_bags = bag_starts.size() - 1;
+  std::vector<float> output(num_bags * dim, 0.0f);
+  for (size_t b = 0; b < num_bags; ++b) {
+    for (int64_t i = bag_starts[b]; i < bag_starts[b + 1]; ++i) {
+      const int64_t row = indices[i] < 0 ? indices[i] + num_rows : indices[i];
+      const float weight = weights.empty() ? 1.0f : weights[i];
+      for (int64_t d = 0; d < dim; ++d) {
+        output[b * dim + d] += weight * table[row * dim + d];
+      }
+    }
+    const int64_t count = bag_starts[b + 1] - bag_starts[b];
+    if (mean && count > 0) {
+      for (int64_t d = 0; d < dim; ++d) {
+        output[b * dim + d] /= static_cast<float>(count);
+      }
+    }
+  }
+  return output;
+}
+
+}  // namespace
+
+TEST(EmbeddingBagOpTest, Sum2DIndices) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  const std::vector<float> table = ValueRange<float>(12, 1.0f);
+  const std::vector<int64_t> indices = {0, 2, 1, 1, 3, -1};
+  test.AddInput<float>("data", {4, 3}, table);
+  test.AddInput<int64_t>("indices", {3, 2}, indices);
+  test.AddOutput<float>("output", {3, 3}, PoolBags(table, 3, indices, {0, 2, 4, 6}, {}, false));
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, MeanOffsetsWithEmptyBag) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  const std::vector<float> table = ValueRange<float>(20, -4.0f, 0.5f);
+  const std::vector<int32_t> indices = {0, 1, 2, 3, 4, 0};
+  test.AddInput<float>("data", {5, 4}, table);
+  test.AddInput<int32_t>("indices", {6}, indices);
+  test.AddInput<int32_t>("offsets", {3}, {0, 2, 2});
+  test.AddOutput<float>("output", {3, 4},
+                        PoolBags(table, 4, {0, 1, 2, 3, 4, 0}, {0, 2, 2, 6}, {}, true));
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, PerSampleWeights) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  const std::vector<float> table = ValueRange<float>(12, 1.0f);
+  const std::vector<int64_t> indices = {3, 0, 1, 2};
+  const std::vector<float> weights = {0.5f, -1.0f, 2.0f, 0.25f};
+  test.AddInput<float>("data", {4, 3}, table);
+  test.AddInput<int64_t>("indices", {4}, indices);
+  test.AddInput<int64_t>("offsets", {2}, {0, 3});
+  test.AddInput<float>("per_sample_weights", {4}, weights);
+  test.AddOutput<float>("output", {2, 3}, PoolBags(table, 3, indices, {0, 3, 4}, weights, false));
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, Float16) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  const std::vector<float> table = ValueRange<float>(16, -2.0f, 0.25f);
+  const std::vector<int64_t> indices = {1, 3, 0, 2};
+  test.AddInput<MLFloat16>("data", {4, 4}, ToFloat16(table));
+  test.AddInput<int64_t>("indices", {2, 2}, indices);
+  test.AddOutput<MLFloat16>("output", {2, 4}, ToFloat16(PoolBags(table, 4, indices, {0, 2, 4}, {}, false)));
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, Quantized8Bits) {
+  constexpr int64_t num_rows = 3, dim = 32, block_size = 16, blocks_per_row = 2;
+  std::vector<uint8_t> data(num_rows * dim);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>((i * 37) % 256);
+  }
+  const std::vector<float> scales = {0.5f, 0.25f, 0.125f, 1.0f, 0.75f, 0.0625f};
+  const std::vector<uint8_t> zero_points = {128, 100, 0, 255, 64, 130};
+
+  std::vector<float> table(num_rows * dim);
+  for (int64_t r = 0; r < num_rows; ++r) {
+    for (int64_t d = 0; d < dim; ++d) {
+      const int64_t block = r * blocks_per_row + d / block_size;
+      table[r * dim + d] = (static_cast<float>(data[r * dim + d]) - zero_points[block]) * scales[block];
+    }
+  }
+
+  const std::vector<int64_t> indices = {2, 0, 1, 1, 0};
+  const std::vector<float> weights = {1.0f, 0.5f, 2.0f, -1.0f, 0.25f};
+
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("bits", 8);
+  test.AddAttribute<int64_t>("block_size", block_size);
+  test.AddInput<uint8_t>("data", {num_rows, dim}, data);
+  test.AddInput<int64_t>("indices", {5}, indices);
+  test.AddInput<int64_t>("offsets", {2}, {0, 2});
+  test.AddInput<float>("per_sample_weights", {5}, weights);
+  test.AddInput<float>("scales", {num_rows, blocks_per_row}, scales);
+  test.AddInput<uint8_t>("zero_points", {num_rows, blocks_per_row}, zero_points);
+  test.AddOutput<float>("output", {2, dim}, PoolBags(table, dim, indices, {0, 2, 5}, weights, false));
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, Quantized4BitsDefaultZeroPoint) {
+  constexpr int64_t num_rows = 3, packed_dim = 16, dim = 32, block_size = 16, blocks_per_row = 2;
+  std::vector<uint8_t> data(num_rows * packed_dim);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>((i * 53 + 11) % 256);
+  }
+  const std::vector<float> scales = {0.5f, 0.25f, 0.125f, 1.0f, 0.75f, 0.0625f};
+
+  // Two 4 bit values per byte, low nibble first. The default zero point is 8.
+  std::vector<float> table(num_rows * dim);
+  for (int64_t r = 0; r < num_rows; ++r) {
+    for (int64_t d = 0; d < dim; ++d) {
+      const uint8_t packed = data[r * packed_dim + d / 2];
+      const int value = (d & 1) ? (packed >> 4) : (packed & 0x0F);
+      table[r * dim + d] = static_cast<float>(value - 8) * scales[r * blocks_per_row + d / block_size];
+    }
+  }
+
+  const std::vector<int64_t> indices = {0, 2, 1, 2};
+
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddAttribute<int64_t>("bits", 4);
+  test.AddAttribute<int64_t>("block_size", block_size);
+  test.AddInput<uint8_t>("data", {num_rows, packed_dim}, data);
+  test.AddInput<int64_t>("indices", {2, 2}, indices);
+  test.AddOptionalInputEdge<int64_t>();
+  test.AddOptionalInputEdge<float>();
+  test.AddInput<float>("scales", {num_rows, blocks_per_row}, scales);
+  test.AddOutput<float>("output", {2, dim}, PoolBags(table, dim, indices, {0, 2, 4}, {}, true));
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, InvalidIndex) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {2, 2}, {1.0f, 2.0f, 3.0f, 4.0f});
+  test.AddInput<int64_t>("indices", {1, 2}, {0, 2});
+  test.AddOutput<float>("output", {1, 2}, {0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds");
+}
+
+TEST(EmbeddingBagOpTest, InvalidOffsets) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {2, 2}, {1.0f, 2.0f, 3.0f, 4.0f});
+  test.AddInput<int64_t>("indices", {3}, {0, 1, 0});
+  test.AddInput<int64_t>("offsets", {2}, {0, 4});
+  test.AddOutput<float>("output", {2, 2}, {0.0f, 0.0f, 0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "offsets must start at 0");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -6,6 +6,8 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <cstring>
+#include <filesystem>
 #include <functional>
 #include <future>
 #include <iterator>
@@ -21,6 +23,7 @@
 #include "core/framework/compute_capability.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/execution_provider.h"
+#include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
@@ -28,6 +31,7 @@
 #include "core/framework/bfc_arena.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
+#include "core/graph/model_saving_options.h"
 #include "core/graph/op.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/platform/env.h"
@@ -564,6 +568,530 @@ TEST(InferenceSessionTests, TestModelSerialization) {
   ASSERT_TRUE(session_object_emptyValidation.Initialize().IsOK());
 }
 
+TEST(InferenceSessionTests, TestSessionCache) {
+  const std::string test_model = "testdata/transform/abs-id-max.onnx";
+  const std::filesystem::path cache_dir = "InferenceSessionTests.TestSessionCache";
+  std::filesystem::remove_all(cache_dir);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestSessionCache";
+  so.graph_optimization_level = TransformerLevel::Level1;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsSessionCacheDir, cache_dir.string().c_str()));
+
+  auto count_cached_models = [&cache_dir]() {
+    size_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(cache_dir)) {
+      count += entry.path().extension() == ".onnx" ? 1 : 0;
+    }
+    return count;
+  };
+
+  // The first session optimizes the model and saves it to the cache.
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(test_model));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  ASSERT_EQ(CountOpsInGraph(session_object.GetGraph())["Identity"], 0);
+  ASSERT_EQ(count_cached_models(), 1u);
+
+  // The second session loads the optimized model from the cache.
+  InferenceSessionWrapper cached_session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(cached_session_object.Load(test_model));
+  ASSERT_STATUS_OK(cached_session_object.Initialize());
+  const auto& cached_graph = cached_session_object.GetGraph();
+  ASSERT_EQ(cached_graph.ModelPath().parent_path(), cache_dir);
+  ASSERT_EQ(CountOpsInGraph(cached_graph)["Identity"], 0);
+  ASSERT_EQ(count_cached_models(), 1u);
+
+  // Different session options use a different entry.
+  so.graph_optimization_level = TransformerLevel::Default;
+  InferenceSessionWrapper unoptimized_session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(unoptimized_session_object.Load(test_model));
+  ASSERT_STATUS_OK(unoptimized_session_object.Initialize());
+  ASSERT_GT(CountOpsInGraph(unoptimized_session_object.GetGraph())["Identity"], 0);
+  ASSERT_EQ(count_cached_models(), 2u);
+
+  std::filesystem::remove_all(cache_dir);
+}
+
+TEST(InferenceSessionTests, TestSessionCachePrePackedWeights) {
+  // Y = MatMul(X, B) with a constant B that the CPU MatMul kernel pre-packs. B is larger than the minimum size of
+  // external initializers, so it is saved to the external data file of the cache entry with its pre-packed weights.
+  constexpr int64_t kDim = 64;
+  onnxruntime::Model model("session_cache_prepack", false, ModelMetaData(), PathString(),
+                           IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(kDim);
+
+  std::vector<float> b_values(static_cast<size_t>(kDim * kDim));
+  for (size_t i = 0; i < b_values.size(); ++i) {
+    b_values[i] = static_cast<float>(i % 17) * 0.125f - 1.f;
+  }
+  ONNX_NAMESPACE::TensorProto b;
+  b.set_name("B");
+  b.add_dims(kDim);
+  b.add_dims(kDim);
+  b.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  b.set_raw_data(b_values.data(), b_values.size() * sizeof(float));
+  graph.AddInitializedTensor(b);
+
+  ONNX_NAMESPACE::TypeProto b_type;
+  b_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  auto& x_arg = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& b_arg = graph.GetOrCreateNodeArg("B", &b_type);
+  auto& y_arg = graph.GetOrCreateNodeArg("Y", nullptr);
+  graph.AddNode("matmul", "MatMul", "", {&x_arg, &b_arg}, {&y_arg});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  const std::filesystem::path cache_dir = "InferenceSessionTests.TestSessionCachePrePackedWeights";
+  std::filesystem::remove_all(cache_dir);
+  const PathString model_file_name = ORT_TSTR("session_cache_prepack_test.onnx");
+  ASSERT_STATUS_OK(onnxruntime::Model::Save(model, model_file_name));
+
+  std::vector<float> x_values(static_cast<size_t>(3 * kDim));
+  for (size_t i = 0; i < x_values.size(); ++i) {
+    x_values[i] = static_cast<float>(i % 5) - 2.f;
+  }
+
+  const std::vector<int64_t> x_dims{3, kDim};
+  auto run = [&x_dims, &x_values](InferenceSession& session) {
+    OrtValue x_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], x_dims, x_values, &x_value);
+    NameMLValMap feeds{{"X", x_value}};
+    const std::vector<std::string> output_names{"Y"};
+    std::vector<OrtValue> fetches;
+    EXPECT_STATUS_OK(session.Run(feeds, output_names, &fetches));
+    const auto y = fetches.at(0).Get<Tensor>().DataAsSpan<float>();
+    return std::vector<float>(y.begin(), y.end());
+  };
+
+  SessionOptions uncached_so;
+  uncached_so.session_logid = "InferenceSessionTests.TestSessionCachePrePackedWeights";
+  InferenceSessionWrapper uncached_session_object{uncached_so, GetEnvironment()};
+  ASSERT_STATUS_OK(uncached_session_object.Load(model_file_name));
+  ASSERT_STATUS_OK(uncached_session_object.Initialize());
+  const std::vector<float> expected_y = run(uncached_session_object);
+
+  SessionOptions so = uncached_so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsSessionCacheDir, cache_dir.string().c_str()));
+
+  // The first session saves the pre-packed weight of B to the cache entry.
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_file_name));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  const auto& prepacked = session_object.GetGraph().GetPrepacked();
+  ASSERT_EQ(prepacked.GetNumberOfWeightsForWriting(), 1u);
+  const auto* keys = prepacked.GetKeysForWeightForSaving("B");
+  ASSERT_NE(keys, nullptr);
+  ASSERT_EQ(keys->size(), 1u);
+  const std::string key = *keys->cbegin();
+  const auto* prepacked_weights = prepacked.GetPrepackedWeights(key);
+  ASSERT_NE(prepacked_weights, nullptr);
+  EXPECT_THAT(run(session_object), ::testing::Pointwise(::testing::FloatNear(1e-4f), expected_y));
+
+  // The second session loads the pre-packed weight from the external data file of the cache entry and the kernel
+  // uses it, so no other pre-packed weight is added to the graph.
+  InferenceSessionWrapper cached_session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(cached_session_object.Load(model_file_name));
+  ASSERT_STATUS_OK(cached_session_object.Initialize());
+  const auto& cached_graph = cached_session_object.GetGraph();
+  ASSERT_EQ(cached_graph.ModelPath().parent_path(), cache_dir);
+  const auto& cached_prepacked = cached_graph.GetPrepacked();
+  ASSERT_EQ(cached_prepacked.GetKeyToBlob().size(), 1u);
+  const auto* cached_prepacked_weights = cached_prepacked.GetPrepackedWeights(key);
+  ASSERT_NE(cached_prepacked_weights, nullptr);
+  ASSERT_EQ(cached_prepacked_weights->buffer_sizes_, prepacked_weights->buffer_sizes_);
+  for (size_t i = 0; i < prepacked_weights->buffers_.size(); ++i) {
+    ASSERT_EQ(std::memcmp(cached_prepacked_weights->buffers_[i].get(), prepacked_weights->buffers_[i].get(),
+                          prepacked_weights->buffer_sizes_[i]),
+              0);
+  }
+  EXPECT_THAT(run(cached_session_object), ::testing::Pointwise(::testing::FloatNear(1e-4f), expected_y));
+
+  // The published entry and its external data file are not replaced by later sessions.
+  size_t data_file_count = 0;
+  for (const auto& entry : std::filesystem::directory_iterator(cache_dir)) {
+    const auto file_name = entry.path().filename().string();
+    data_file_count += file_name.size() > 5 && file_name.compare(file_name.size() - 5, 5, ".data") == 0 ? 1 : 0;
+    ASSERT_NE(entry.path().extension(), ".tmp");
+  }
+  ASSERT_EQ(data_file_count, 1u);
+
+  std::filesystem::remove_all(cache_dir);
+  std::filesystem::remove(model_file_name);
+}
+
+TEST(InferenceSessionTests, TestPrefetchExternalInitializers) {
+  // Y = MatMul(X, B) + C with B and C in an external data file. B is larger than the size of the chunks that are
+  // prefetched concurrently, so its mapped data is read by several tasks.
+  constexpr int64_t kRows = 1024;
+  constexpr int64_t kCols = 1088;
+  onnxruntime::Model model("prefetch_external_initializers", false, ModelMetaData(), PathString(),
+                           IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  auto add_initializer = [&graph](const std::string& name, const std::vector<int64_t>& dims) {
+    ONNX_NAMESPACE::TensorProto tensor;
+    tensor.set_name(name);
+    size_t size = 1;
+    for (int64_t dim : dims) {
+      tensor.add_dims(dim);
+      size *= static_cast<size_t>(dim);
+    }
+    std::vector<float> values(size);
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = static_cast<float>(i % 13) * 0.0625f - 0.375f;
+    }
+    tensor.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    tensor.set_raw_data(values.data(), values.size() * sizeof(float));
+    graph.AddInitializedTensor(tensor);
+
+    ONNX_NAMESPACE::TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    return &graph.GetOrCreateNodeArg(name, &type);
+  };
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(kRows);
+
+  auto& x_arg = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto* b_arg = add_initializer("B", {kRows, kCols});
+  auto* c_arg = add_initializer("C", {kCols});
+  auto& matmul_arg = graph.GetOrCreateNodeArg("matmul_out", nullptr);
+  auto& y_arg = graph.GetOrCreateNodeArg("Y", nullptr);
+  graph.AddNode("matmul", "MatMul", "", {&x_arg, b_arg}, {&matmul_arg});
+  graph.AddNode("add", "Add", "", {&matmul_arg, c_arg}, {&y_arg});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  const PathString model_file_name = ORT_TSTR("prefetch_external_initializers_test.onnx");
+  const PathString external_file_name = ORT_TSTR("prefetch_external_initializers_test.onnx.data");
+  ModelSavingOptions model_saving_options{0};
+  model_saving_options.align_offset = true;
+  ASSERT_STATUS_OK(onnxruntime::Model::SaveWithExternalInitializers(model, model_file_name, external_file_name,
+                                                                    model_saving_options));
+
+  std::vector<float> x_values(static_cast<size_t>(2 * kRows));
+  for (size_t i = 0; i < x_values.size(); ++i) {
+    x_values[i] = static_cast<float>(i % 7) - 3.f;
+  }
+
+  const std::vector<int64_t> x_dims{2, kRows};
+  auto run = [&x_dims, &x_values](InferenceSession& session) {
+    OrtValue x_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], x_dims, x_values, &x_value);
+    NameMLValMap feeds{{"X", x_value}};
+    const std::vector<std::string> output_names{"Y"};
+    std::vector<OrtValue> fetches;
+    EXPECT_STATUS_OK(session.Run(feeds, output_names, &fetches));
+    const auto y = fetches.at(0).Get<Tensor>().DataAsSpan<float>();
+    return std::vector<float>(y.begin(), y.end());
+  };
+
+  SessionOptions default_so;
+  default_so.session_logid = "InferenceSessionTests.TestPrefetchExternalInitializers";
+  InferenceSessionWrapper default_session_object{default_so, GetEnvironment()};
+  ASSERT_STATUS_OK(default_session_object.Load(model_file_name));
+  ASSERT_STATUS_OK(default_session_object.Initialize());
+  const std::vector<float> expected_y = run(default_session_object);
+
+  SessionOptions so = default_so;
+  so.intra_op_param.thread_pool_size = 4;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigParallelInitialization, "1"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigPrefetchExternalInitializers, "1"));
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_file_name));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  EXPECT_THAT(run(session_object), ::testing::Pointwise(::testing::FloatNear(1e-4f), expected_y));
+
+  std::filesystem::remove(model_file_name);
+  std::filesystem::remove(external_file_name);
+}
+
+TEST(InferenceSessionTests, TestShapePlanCache) {
+  // Z = ConstantOfShape(T), T = Shape(X) * 2. Shape and Mul are shape computation nodes.
+  onnxruntime::Model model("shape_plan_cache", false, ModelMetaData(), PathString(),
+                           IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("M");
+  ONNX_NAMESPACE::TypeProto int64_tensor;
+  int64_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+
+  ONNX_NAMESPACE::TensorProto two;
+  two.set_name("two");
+  two.add_dims(1);
+  two.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+  two.add_int64_data(2);
+  graph.AddInitializedTensor(two);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& s = graph.GetOrCreateNodeArg("S", &int64_tensor);
+  auto& t = graph.GetOrCreateNodeArg("T", &int64_tensor);
+  auto& z = graph.GetOrCreateNodeArg("Z", nullptr);
+  auto& two_arg = graph.GetOrCreateNodeArg("two", &int64_tensor);
+  graph.AddNode("shape", "Shape", "", {&x}, {&s});
+  graph.AddNode("mul", "Mul", "", {&s, &two_arg}, {&t});
+  graph.AddNode("constant_of_shape", "ConstantOfShape", "", {&t}, {&z});
+  graph.SetOutputs({&t, &z});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  const PathString model_file_name = ORT_TSTR("shape_plan_cache_test.onnx");
+  ASSERT_STATUS_OK(onnxruntime::Model::Save(model, model_file_name));
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestShapePlanCache";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigShapePlanCacheSize, "1"));
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_file_name));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  const ShapePlanCache* shape_plan_cache = session_object.GetSessionState().GetShapePlanCache();
+  ASSERT_NE(shape_plan_cache, nullptr);
+
+  auto run = [&session_object](int64_t n, int64_t m) {
+    const std::vector<int64_t> dims{n, m};
+    OrtValue x_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims,
+                         std::vector<float>(static_cast<size_t>(n * m), 1.f), &x_value);
+    NameMLValMap feeds{{"X", x_value}};
+    const std::vector<std::string> output_names{"T", "Z"};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(feeds, output_names, &fetches));
+    ASSERT_EQ(fetches.size(), 2u);
+    VerifyOutputs<int64_t>(fetches[0].Get<Tensor>(), {2}, {2 * n, 2 * m});
+    VerifyOutputs<float>(fetches[1].Get<Tensor>(), {2 * n, 2 * m},
+                         std::vector<float>(static_cast<size_t>(4 * n * m), 0.f));
+  };
+
+  run(2, 3);
+  run(2, 3);
+  run(1, 5);
+  run(2, 3);
+
+  const auto stats = shape_plan_cache->GetStats();
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.misses, 3u);
+  EXPECT_EQ(stats.evictions, 2u);
+  EXPECT_EQ(stats.entries, 1u);
+
+  std::filesystem::remove(model_file_name);
+}
+
+TEST(InferenceSessionTests, TestCpuGraphCapture) {
+  // Y = (X + X) * X
+  onnxruntime::Model model("cpu_graph_capture", false, ModelMetaData(), PathString(),
+                           IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& sum = graph.GetOrCreateNodeArg("sum", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("add", "Add", "", {&x, &x}, {&sum});
+  graph.AddNode("mul", "Mul", "", {&sum, &x}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  const PathString model_file_name = ORT_TSTR("cpu_graph_capture_test.onnx");
+  ASSERT_STATUS_OK(onnxruntime::Model::Save(model, model_file_name));
+
+  auto make_feed = [](const std::vector<float>& values) {
+    const std::vector<int64_t> dims{static_cast<int64_t>(values.size() / 3), 3};
+    OrtValue x_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims, values, &x_value);
+    return x_value;
+  };
+
+  auto expected_output = [](const std::vector<float>& values) {
+    std::vector<float> expected;
+    for (float value : values) {
+      expected.push_back(2 * value * value);
+    }
+    return expected;
+  };
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestCpuGraphCapture";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigEnableCpuGraphCapture, "1"));
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_file_name));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // The first Run captures the graph, the Runs with the same feed shape replay it and the others use the regular
+  // execution.
+  const std::vector<std::vector<float>> inputs{{1.f, 2.f, 3.f, 4.f, 5.f, 6.f},
+                                               {6.f, 5.f, 4.f, 3.f, 2.f, 1.f},
+                                               {7.f, 8.f, 9.f},
+                                               {-1.f, 0.f, 1.f, 2.f, 3.f, 4.f}};
+  for (const auto& values : inputs) {
+    NameMLValMap feeds{{"X", make_feed(values)}};
+    const std::vector<std::string> output_names{"Y"};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(feeds, output_names, &fetches));
+    ASSERT_EQ(fetches.size(), 1u);
+    VerifyOutputs<float>(fetches[0].Get<Tensor>(), {static_cast<int64_t>(values.size() / 3), 3},
+                         expected_output(values));
+  }
+
+  // Use a CpuGraph of the session state directly to check which Runs are captured or replayed.
+  const SessionState& session_state = session_object.GetSessionState();
+  std::unique_ptr<CpuGraph> cpu_graph;
+  ASSERT_STATUS_OK(CpuGraph::Create(session_state, cpu_graph));
+
+  const std::vector<std::string> feed_names{"X"};
+  const std::vector<std::string> output_names{"Y"};
+  FeedsFetchesInfo feeds_fetches_info(feed_names, output_names, session_state.GetOrtValueNameIdxMap());
+  const ConfigOptions run_config_options;
+  const bool terminate_flag = false;
+
+  auto run = [&](int graph_annotation_id, const std::vector<float>& values) {
+    std::vector<OrtValue> feeds{make_feed(values)};
+    std::vector<OrtValue> fetches;
+    bool executed = false;
+    EXPECT_STATUS_OK(cpu_graph->Run(graph_annotation_id, feeds_fetches_info, feeds, fetches, run_config_options,
+                                    terminate_flag, executed));
+    if (executed) {
+      EXPECT_EQ(fetches.size(), 1u);
+      VerifyOutputs<float>(fetches[0].Get<Tensor>(), {static_cast<int64_t>(values.size() / 3), 3},
+                           expected_output(values));
+    }
+
+    return executed;
+  };
+
+  EXPECT_FALSE(cpu_graph->IsGraphCaptured(0));
+  EXPECT_TRUE(run(0, inputs[0]));
+  EXPECT_TRUE(cpu_graph->IsGraphCaptured(0));
+  EXPECT_TRUE(run(0, inputs[1]));
+  EXPECT_FALSE(run(0, inputs[2]));
+  EXPECT_TRUE(run(0, inputs[3]));
+
+  EXPECT_FALSE(cpu_graph->IsGraphCaptured(1));
+  EXPECT_TRUE(run(1, inputs[2]));
+  EXPECT_TRUE(cpu_graph->IsGraphCaptured(1));
+  EXPECT_TRUE(run(1, inputs[2]));
+}
+
+// The kernels of a replayed graph read the run config entries of the Run that replays it.
+TEST(InferenceSessionTests, TestCpuGraphCaptureRunConfigOptions) {
+  // Y = STFT(X, frame_step = 2, frame_length = 4) with the samples of X streamed over the Runs
+  onnxruntime::Model model("cpu_graph_capture_run_options", false, ModelMetaData(), PathString(),
+                           IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 17}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  ONNX_NAMESPACE::TypeProto int64_scalar;
+  int64_scalar.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+  int64_scalar.mutable_tensor_type()->mutable_shape();
+
+  for (const auto& [name, value] : {std::pair<std::string, int64_t>{"frame_step", 2},
+                                    std::pair<std::string, int64_t>{"frame_length", 4}}) {
+    ONNX_NAMESPACE::TensorProto initializer;
+    initializer.set_name(name);
+    initializer.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+    initializer.add_int64_data(value);
+    graph.AddInitializedTensor(initializer);
+  }
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& frame_step = graph.GetOrCreateNodeArg("frame_step", &int64_scalar);
+  auto& window = graph.GetOrCreateNodeArg("", nullptr);
+  auto& frame_length = graph.GetOrCreateNodeArg("frame_length", &int64_scalar);
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+  graph.AddNode("stft", "STFT", "", {&x, &frame_step, &window, &frame_length}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  const PathString model_file_name = ORT_TSTR("cpu_graph_capture_run_options_test.onnx");
+  ASSERT_STATUS_OK(onnxruntime::Model::Save(model, model_file_name));
+
+  auto make_feed = [](const std::vector<float>& values) {
+    OrtValue x_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0],
+                         {1, static_cast<int64_t>(values.size()), 1}, values, &x_value);
+    return x_value;
+  };
+
+  const std::vector<std::vector<float>> inputs{{1.f, 2.f, 3.f, 4.f},
+                                               {5.f, 6.f, 7.f, 8.f},
+                                               {9.f, 10.f, 11.f, 12.f}};
+
+  RunOptions run_options;
+  ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigStftStreamId, "stream"));
+  const std::vector<std::string> output_names{"Y"};
+
+  // The outputs of the Runs streaming the inputs with the regular execution
+  std::vector<std::vector<float>> expected_outputs;
+  {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.TestCpuGraphCaptureRunConfigOptions";
+    InferenceSession session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(model_file_name));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    for (const auto& values : inputs) {
+      NameMLValMap feeds{{"X", make_feed(values)}};
+      std::vector<OrtValue> fetches;
+      ASSERT_STATUS_OK(session_object.Run(run_options, feeds, output_names, &fetches));
+      const auto output = fetches[0].Get<Tensor>().DataAsSpan<float>();
+      expected_outputs.emplace_back(output.begin(), output.end());
+    }
+  }
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestCpuGraphCaptureRunConfigOptions";
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_file_name));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // The first Run starts the stream with the regular execution. Every later Run of the stream computes two frames,
+  // the second Run captures the graph and the third one replays it.
+  {
+    NameMLValMap feeds{{"X", make_feed(inputs[0])}};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(run_options, feeds, output_names, &fetches));
+  }
+
+  const SessionState& session_state = session_object.GetSessionState();
+  std::unique_ptr<CpuGraph> cpu_graph;
+  ASSERT_STATUS_OK(CpuGraph::Create(session_state, cpu_graph));
+
+  const std::vector<std::string> feed_names{"X"};
+  FeedsFetchesInfo feeds_fetches_info(feed_names, output_names, session_state.GetOrtValueNameIdxMap());
+  const bool terminate_flag = false;
+
+  for (size_t i = 1; i < inputs.size(); ++i) {
+    std::vector<OrtValue> feeds{make_feed(inputs[i])};
+    std::vector<OrtValue> fetches;
+    bool executed = false;
+    ASSERT_STATUS_OK(cpu_graph->Run(0, feeds_fetches_info, feeds, fetches, run_options.config_options,
+                                    terminate_flag, executed));
+    ASSERT_TRUE(executed);
+    // A replay without the stream computes a single frame, which disables the replay.
+    ASSERT_TRUE(cpu_graph->IsGraphCaptured(0));
+
+    const auto output = fetches[0].Get<Tensor>().DataAsSpan<float>();
+    EXPECT_EQ(fetches[0].Get<Tensor>().Shape(), TensorShape({1, 2, 3, 2}));
+    EXPECT_THAT(std::vector<float>(output.begin(), output.end()),
+                ::testing::Pointwise(::testing::FloatNear(1e-4f), expected_outputs[i]));
+  }
+}
+
 TEST(InferenceSessionTests, RequestLoadCancellation) {
   {
     // Explicit cancel during load, small model is fine
@@ -1,7 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <absl/base/config.h>
 
 #include "asserts.h"
@@ -21,11 +24,13 @@
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/util/thread_utils.h"
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "test/test_environment.h"
 #include "test/unittest_util/graph_transform_test_builder.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/file_util.h"
+#include "test/util/include/temp_dir.h"
 #include "core/optimizer/layout_transformation/layout_transformation.h"
 #include "core/optimizer/graph_optimizer_registry.h"
 
@@ -203,6 +208,14 @@ TEST_P(SessionStateAddGetKernelTest, AddGetKernelTest) {
   auto test_kernel = s.GetKernel(node.Index());
   std::cout << "orig: " << orig_num_outputs << " new: " << test_kernel->Node().OutputDefs().size() << std::endl;
   EXPECT_EQ(orig_num_outputs, test_kernel->Node().OutputDefs().size());
+
+  // the dispatch info of the kernel points at the arguments of the node in the NodeIndexInfo
+  const auto& dispatch_info = s.GetKernelDispatchInfo(node.Index());
+  EXPECT_EQ(dispatch_info.kernel, test_kernel);
+  EXPECT_EQ(dispatch_info.node_input_start_index, s.GetNodeIndexInfo().GetNodeOffset(node.Index()));
+  EXPECT_EQ(dispatch_info.node_implicit_input_start_index, dispatch_info.node_input_start_index);
+  EXPECT_EQ(dispatch_info.node_output_start_index, dispatch_info.node_input_start_index);
+  EXPECT_FALSE(dispatch_info.is_yield_op);
 }
 
 INSTANTIATE_TEST_SUITE_P(SessionStateTests, SessionStateAddGetKernelTest, testing::Values(0, 1));
@@ -759,6 +772,7 @@ static void PlaceAllNodesToCPUEP(Graph& graph) {
 struct PrepackingTestParam {
   bool test_subgraph;
   bool test_prepacking;
+  bool test_parallel_initialization = false;
 };
 
 class SessionStatePrepackingTest : public testing::TestWithParam<PrepackingTestParam> {};
@@ -801,6 +815,8 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
   sess_options.enable_mem_reuse = true;
   sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] =
       test_param.test_prepacking ? "0" : "1";
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigParallelInitialization] =
+      test_param.test_parallel_initialization ? "1" : "0";
 
   SessionState session_state(model.MainGraph(),
                              execution_providers,
@@ -1418,6 +1434,62 @@ TEST_F(SessionStateTestSharedInitalizersWithPrePacking, TestPrepackedSerializati
     ASSERT_EQ(1U, prepacked_for_main_graph.GetKeyToBlob().size());
   }
 }
+
+// Pre-packed weights are memory mapped from the files of the shared pre-packed weights directory
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, TestSharedPrePackedWeightsDir) {
+  TemporaryDirectory shared_dir(ORT_TSTR("shared_prepacked_weights_dir"));
+
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+  // Enable pre-packing
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+  sess_options.config_options.configurations[kOrtSessionOptionsSharedPrePackedWeightsDir] =
+      PathToUTF8String(shared_dir.Path());
+
+  auto count_files = [&shared_dir]() {
+    size_t num_files = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(shared_dir.Path())) {
+      EXPECT_EQ(entry.path().extension(), ORT_TSTR(".bin"));
+      ++num_files;
+    }
+    return num_files;
+  };
+
+  // The first session writes the file of the pre-packed weight and the second one maps the same file
+  for (size_t i = 0; i < 2; ++i) {
+    Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                DefaultLoggingManager().DefaultLogger());
+    CreateSimpleGraph(model.MainGraph());
+    PlaceAllNodesToCPUEP(model.MainGraph());
+    SessionState session_state(model.MainGraph(),
+                               execution_providers,
+                               tp.get(),
+                               nullptr, /*inter_op_thread_pool*/
+                               dtm,
+                               edlm,
+                               DefaultLoggingManager().DefaultLogger(),
+                               profiler,
+                               sess_options);
+
+    ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                        kernel_registry_manager));
+    ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(1));
+    ASSERT_EQ(count_files(), static_cast<size_t>(1));
+
+    const auto& key_to_blob = model.MainGraph().GetPrepacked().GetKeyToBlob();
+    ASSERT_EQ(key_to_blob.size(), static_cast<size_t>(1));
+    const PrePackedWeights& weights = key_to_blob.begin()->second;
+    ASSERT_EQ(weights.buffers_.size(), static_cast<size_t>(1));
+    ASSERT_EQ(weights.buffer_sizes_[0], sizeof(float) * 2);
+    const float* data = static_cast<const float*>(weights.buffers_[0].get());
+    ASSERT_EQ(data[0], 1.2345f);
+    ASSERT_EQ(data[1], 1.2345f * 2.f);
+  }
+}
 #endif  // __wasm__
 
 INSTANTIATE_TEST_SUITE_P(SessionStateTests,
@@ -1425,7 +1497,189 @@ INSTANTIATE_TEST_SUITE_P(SessionStateTests,
                          testing::Values(PrepackingTestParam{false, false},
                                          PrepackingTestParam{false, true},
                                          PrepackingTestParam{true, false},
-                                         PrepackingTestParam{true, true}));
+                                         PrepackingTestParam{true, true},
+                                         PrepackingTestParam{false, true, true},
+                                         PrepackingTestParam{true, true, true}));
+
+// Finalizes the session state of a graph placed on the CPU EP with sequential or parallel initialization.
+class SessionStateParallelInitializationTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    OrtThreadPoolParams to;
+    to.thread_pool_size = 4;
+    tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
+
+    auto cpu_execution_provider = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false));
+    ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider, std::move(cpu_execution_provider)));
+    ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+  }
+
+  std::unique_ptr<Model> CreateModel() {
+    return std::make_unique<Model>("graph_main", false, ModelMetaData(), PathString(),
+                                   IOnnxRuntimeOpSchemaRegistryList(),
+                                   std::unordered_map<std::string, int>{{kOnnxDomain, 13}},
+                                   std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                                   DefaultLoggingManager().DefaultLogger());
+  }
+
+  Status Finalize(Graph& graph, bool parallel, std::unique_ptr<SessionState>& session_state) {
+    sess_options.config_options.configurations[kOrtSessionOptionsConfigParallelInitialization] = parallel ? "1" : "0";
+    session_state = std::make_unique<SessionState>(graph, execution_providers, tp.get(), nullptr, dtm, edlm,
+                                                   DefaultLoggingManager().DefaultLogger(), profiler, sess_options);
+    PlaceAllNodesToCPUEP(graph);
+
+    // kernel constructors report errors with exceptions, which the session turns into a status
+    Status status;
+    ORT_TRY {
+      status = session_state->FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(), kernel_registry_manager);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+    return status;
+  }
+
+  std::unique_ptr<concurrency::ThreadPool> tp;
+  ExecutionProviders execution_providers;
+  DataTransferManager dtm;
+  ExternalDataLoaderManager edlm;
+  profiling::Profiler profiler;
+  SessionOptions sess_options;
+  KernelRegistryManager kernel_registry_manager;
+};
+
+// Y = X + C0 + C1 + ... with in-memory initializers that are decoded concurrently.
+static void CreateAddChainGraph(Graph& graph, size_t num_initializers) {
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  NodeArg* input = &graph.GetOrCreateNodeArg("X", &float_tensor);
+  for (size_t i = 0; i < num_initializers; ++i) {
+    const std::string initializer_name = "C" + std::to_string(i);
+    ONNX_NAMESPACE::TensorProto tensor_proto;
+    tensor_proto.set_name(initializer_name);
+    tensor_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    tensor_proto.add_dims(2);
+    tensor_proto.add_dims(4);
+    for (size_t j = 0; j < 8; ++j) {
+      tensor_proto.add_float_data(static_cast<float>(i * 8 + j) * 0.5f);
+    }
+    graph.AddInitializedTensor(tensor_proto);
+
+    NodeArg& initializer = graph.GetOrCreateNodeArg(initializer_name, &float_tensor);
+    NodeArg& output = graph.GetOrCreateNodeArg("T" + std::to_string(i), &float_tensor);
+    graph.AddNode("add" + std::to_string(i), "Add", "", {input, &initializer}, {&output});
+    input = &output;
+  }
+  ASSERT_STATUS_OK(graph.Resolve());
+}
+
+TEST_F(SessionStateParallelInitializationTest, InitializersMatchSequential) {
+  constexpr size_t kNumInitializers = 16;
+  auto sequential_model = CreateModel();
+  CreateAddChainGraph(sequential_model->MainGraph(), kNumInitializers);
+  std::unique_ptr<SessionState> sequential_session_state;
+  ASSERT_STATUS_OK(Finalize(sequential_model->MainGraph(), false, sequential_session_state));
+
+  auto parallel_model = CreateModel();
+  CreateAddChainGraph(parallel_model->MainGraph(), kNumInitializers);
+  std::unique_ptr<SessionState> parallel_session_state;
+  ASSERT_STATUS_OK(Finalize(parallel_model->MainGraph(), true, parallel_session_state));
+
+  ASSERT_EQ(parallel_session_state->GetInitializedTensors().size(),
+            sequential_session_state->GetInitializedTensors().size());
+  for (size_t i = 0; i < kNumInitializers; ++i) {
+    const std::string initializer_name = "C" + std::to_string(i);
+    int sequential_idx = -1;
+    int parallel_idx = -1;
+    ASSERT_STATUS_OK(sequential_session_state->GetOrtValueNameIdxMap().GetIdx(initializer_name, sequential_idx));
+    ASSERT_STATUS_OK(parallel_session_state->GetOrtValueNameIdxMap().GetIdx(initializer_name, parallel_idx));
+    const auto sequential_values =
+        sequential_session_state->GetInitializedTensors().at(sequential_idx).Get<Tensor>().DataAsSpan<float>();
+    const auto parallel_values =
+        parallel_session_state->GetInitializedTensors().at(parallel_idx).Get<Tensor>().DataAsSpan<float>();
+    ASSERT_EQ(std::vector<float>(parallel_values.begin(), parallel_values.end()),
+              std::vector<float>(sequential_values.begin(), sequential_values.end()))
+        << initializer_name;
+    ASSERT_EQ(parallel_values[0], static_cast<float>(i * 8) * 0.5f);
+  }
+}
+
+// Y0 = Resize(X, mode=bad_mode0), Y1 = Resize(X, mode=bad_mode1), ... The kernel constructors fail.
+static void CreateInvalidResizeGraph(Graph& graph) {
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  for (int i = 0; i < 4; ++i) {
+    float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(i < 2 ? 1 : 2);
+  }
+
+  ONNX_NAMESPACE::TensorProto scales;
+  scales.set_name("scales");
+  scales.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  scales.add_dims(4);
+  for (float scale : {1.f, 1.f, 2.f, 2.f}) {
+    scales.add_float_data(scale);
+  }
+  graph.AddInitializedTensor(scales);
+
+  ONNX_NAMESPACE::TypeProto scales_type;
+  scales_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  NodeArg& input = graph.GetOrCreateNodeArg("X", &float_tensor);
+  NodeArg& roi = graph.GetOrCreateNodeArg("", nullptr);
+  NodeArg& scales_arg = graph.GetOrCreateNodeArg("scales", &scales_type);
+  for (int i = 0; i < 8; ++i) {
+    NodeArg& output = graph.GetOrCreateNodeArg("Y" + std::to_string(i), nullptr);
+    Node& node = graph.AddNode("resize" + std::to_string(i), "Resize", "", {&input, &roi, &scales_arg}, {&output});
+    node.AddAttribute("mode", "bad_mode" + std::to_string(i));
+  }
+  ASSERT_STATUS_OK(graph.Resolve());
+}
+
+TEST_F(SessionStateParallelInitializationTest, KernelErrorMatchesSequential) {
+  auto sequential_model = CreateModel();
+  CreateInvalidResizeGraph(sequential_model->MainGraph());
+  std::unique_ptr<SessionState> sequential_session_state;
+  const Status sequential_status = Finalize(sequential_model->MainGraph(), false, sequential_session_state);
+  ASSERT_FALSE(sequential_status.IsOK());
+  ASSERT_THAT(sequential_status.ErrorMessage(), ::testing::HasSubstr("bad_mode0"));
+
+  // the kernels are created concurrently, but the error of the first node is reported
+  auto parallel_model = CreateModel();
+  CreateInvalidResizeGraph(parallel_model->MainGraph());
+  std::unique_ptr<SessionState> parallel_session_state;
+  const Status parallel_status = Finalize(parallel_model->MainGraph(), true, parallel_session_state);
+  ASSERT_FALSE(parallel_status.IsOK());
+  ASSERT_THAT(parallel_status.ErrorMessage(), ::testing::HasSubstr("bad_mode0"));
+  ASSERT_THAT(parallel_status.ErrorMessage(), ::testing::Not(::testing::HasSubstr("bad_mode1")));
+}
+
+#ifndef __wasm__
+TEST_F(SessionStateParallelInitializationTest, ProfilesInitializationPhases) {
+  const std::string profile_file_name = "session_state_parallel_initialization_profile.json";
+  profiler.Initialize(&DefaultLoggingManager().DefaultLogger());
+  profiler.StartProfiling(profile_file_name);
+
+  auto model = CreateModel();
+  CreateAddChainGraph(model->MainGraph(), 4);
+  std::unique_ptr<SessionState> session_state;
+  ASSERT_STATUS_OK(Finalize(model->MainGraph(), true, session_state));
+
+  const std::string profile_file = profiler.EndProfiling();
+  std::ifstream profile(profile_file);
+  const std::string profile_content((std::istreambuf_iterator<char>(profile)), std::istreambuf_iterator<char>());
+  profile.close();
+  std::filesystem::remove(profile_file);
+
+  for (const char* event_name :
+       {"session_state_save_initialized_tensors", "session_state_create_kernels", "session_state_prepack"}) {
+    EXPECT_THAT(profile_content, ::testing::HasSubstr(event_name));
+  }
+}
+#endif  // __wasm__
 #endif
 
 }  // namespace test
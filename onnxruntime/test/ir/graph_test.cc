@@ -31,6 +31,9 @@ using namespace ONNX_NAMESPACE;
 namespace onnxruntime {
 namespace test {
 
+// number of times the CountShapeInference_Fake type and shape inference function has run
+static int count_shape_inference_calls = 0;
+
 static bool RegisterCustomSchemas() {
   OPERATOR_SCHEMA(Variable_DFS)
       .SetDoc("Input variable.")
@@ -108,6 +111,19 @@ static bool RegisterCustomSchemas() {
         fail_shape_inference("try harder");
       });
 
+  OPERATOR_SCHEMA(CountShapeInference_Fake)
+      .SetDoc("Counts type and shape inference calls.")
+      .Attr("tag", "unused attribute", AttributeProto::INT, OPTIONAL_VALUE)
+      .Input(0, "input_1", "docstr for input_1.", "tensor(int32)")
+      .Output(0, "output_1", "docstr for output_1.", "tensor(int32)")
+      .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
+        ++count_shape_inference_calls;
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (hasInputShape(ctx, 0)) {
+          propagateShapeFromInputToOutput(ctx, 0, 0);
+        }
+      });
+
   OPERATOR_SCHEMA(Fake_Sub)
       .SinceVersion(1)
       .SetDomain(kMSNchwcDomain)
@@ -1511,6 +1527,64 @@ TEST_F(GraphTest, ShapeInferenceErrorHandling) {
                                       "Node (node_1) Op (ShapeInferenceThrowsOp) [ShapeInferenceError] try harder");
 }
 
+// Resolve after a change only runs type and shape inferencing for the changed nodes and their affected consumers.
+TEST_F(GraphTest, ResolveInfersOnlyAffectedNodes) {
+  Model model("graph_1", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_int32;
+  tensor_int32.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+
+  auto& a_in = graph.GetOrCreateNodeArg("a_in", &tensor_int32);
+  auto& a_out = graph.GetOrCreateNodeArg("a_out", nullptr);
+  auto& b_out = graph.GetOrCreateNodeArg("b_out", nullptr);
+  auto& c_in = graph.GetOrCreateNodeArg("c_in", &tensor_int32);
+  auto& c_out = graph.GetOrCreateNodeArg("c_out", nullptr);
+  graph.AddNode("a", "CountShapeInference_Fake", "a", {&a_in}, {&a_out});
+  graph.AddNode("b", "CountShapeInference_Fake", "b", {&a_out}, {&b_out});
+  auto& node_c = graph.AddNode("c", "CountShapeInference_Fake", "c", {&c_in}, {&c_out});
+
+  count_shape_inference_calls = 0;
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(count_shape_inference_calls, 3);
+  EXPECT_EQ(b_out.Shape(), nullptr);
+
+  // a new shape for a_in reaches b through a. c is not inferred again.
+  TypeProto tensor_int32_2x3 = tensor_int32;
+  tensor_int32_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  tensor_int32_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  graph.SetNodeArgType(a_in, tensor_int32_2x3);
+
+  count_shape_inference_calls = 0;
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(count_shape_inference_calls, 2);
+  ASSERT_NE(b_out.Shape(), nullptr);
+  EXPECT_EQ(utils::GetTensorShapeFromTensorShapeProto(*b_out.Shape()), TensorShape({2, 3}));
+
+  // an attribute change only affects the modified node as its output type and shape are unchanged.
+  node_c.AddAttribute("tag", int64_t{1});
+
+  count_shape_inference_calls = 0;
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(count_shape_inference_calls, 1);
+
+  // accessing the mutable attributes without modifying them does not change the node.
+  EXPECT_EQ(node_c.GetMutableAttributes().at("tag").i(), 1);
+  graph.SetGraphResolveNeeded();
+
+  count_shape_inference_calls = 0;
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(count_shape_inference_calls, 0);
+
+  // a modification through the mutable attributes is recorded by MarkAttributesChanged.
+  node_c.GetMutableAttributes().at("tag").set_i(2);
+  node_c.MarkAttributesChanged();
+
+  count_shape_inference_calls = 0;
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(count_shape_inference_calls, 1);
+}
+
 TEST_F(GraphTest, AddTensorAttribute) {
   OPERATOR_SCHEMA(__Constant)
       .SetDoc("Constant Op.")
@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "core/util/thread_utils.h"
+#include "test/mlas/bench/bench_util.h"
+
+using onnxruntime::narrow;
+
+static std::unique_ptr<onnxruntime::concurrency::ThreadPool> CreateReduceThreadPool(int threads) {
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = threads;
+  tpo.auto_set_affinity = true;
+
+  return std::unique_ptr<onnxruntime::concurrency::ThreadPool>(
+      onnxruntime::concurrency::CreateThreadPool(
+          &onnxruntime::Env::Default(), tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+}
+
+// Reduces a [Outer, Reduce, Inner] tensor along the middle axis.
+void REDUCE(benchmark::State& state) {
+  const auto kind = static_cast<MLAS_REDUCE_KIND>(state.range(0));
+  const auto outer = narrow<size_t>(state.range(1));
+  const auto reduce = narrow<size_t>(state.range(2));
+  const auto inner = narrow<size_t>(state.range(3));
+  const auto threads = narrow<int>(state.range(4));
+
+  if (outer == 0 || reduce == 0 || inner == 0 || threads <= 0) {
+    throw std::invalid_argument("Outer, Reduce, Inner, and Threads must be greater than 0!");
+  }
+
+  auto tp = CreateReduceThreadPool(threads);
+
+  auto input = RandomVectorUniform<float>(outer * reduce * inner, -1.0f, 1.0f);
+  std::vector<float> output(outer * inner);
+
+  // warming up run
+  MlasReduce(kind, input.data(), output.data(), outer, reduce, inner, tp.get());
+
+  for (auto _ : state) {
+    MlasReduce(kind, input.data(), output.data(), outer, reduce, inner, tp.get());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * outer * reduce * inner * sizeof(float)));
+}
+
+void ARGREDUCE(benchmark::State& state) {
+  const bool is_maximum = state.range(0) != 0;
+  const auto outer = narrow<size_t>(state.range(1));
+  const auto reduce = narrow<size_t>(state.range(2));
+  const auto inner = narrow<size_t>(state.range(3));
+  const auto threads = narrow<int>(state.range(4));
+
+  if (outer == 0 || reduce == 0 || inner == 0 || threads <= 0) {
+    throw std::invalid_argument("Outer, Reduce, Inner, and Threads must be greater than 0!");
+  }
+
+  auto tp = CreateReduceThreadPool(threads);
+
+  auto input = RandomVectorUniform<float>(outer * reduce * inner, -1.0f, 1.0f);
+  std::vector<int64_t> output(outer * inner);
+
+  // warming up run
+  MlasArgReduce(is_maximum, false, input.data(), output.data(), outer, reduce, inner, tp.get());
+
+  for (auto _ : state) {
+    MlasArgReduce(is_maximum, false, input.data(), output.data(), outer, reduce, inner, tp.get());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * outer * reduce * inner * sizeof(float)));
+}
+
+// Common axis layouts: last axis (softmax/layernorm style rows), leading axis,
+// spatial axes of NCHW (global pooling), channels of NHWC, and full reductions.
+static void ReduceLayouts(benchmark::internal::Benchmark* b) {
+  for (int threads : {1, 8}) {
+    b->Args({MlasReduceSum, 4096, 1024, 1, threads});
+    b->Args({MlasReduceSum, 1, 4096, 1024, threads});
+    b->Args({MlasReduceSum, 64 * 256, 56 * 56, 1, threads});
+    b->Args({MlasReduceSum, 64, 56 * 56, 256, threads});
+    b->Args({MlasReduceSum, 1, 1 << 22, 1, threads});
+    b->Args({MlasReduceMean, 4096, 1024, 1, threads});
+    b->Args({MlasReduceMean, 64, 56 * 56, 256, threads});
+    b->Args({MlasReduceMaximum, 4096, 1024, 1, threads});
+    b->Args({MlasReduceMaximum, 64, 56 * 56, 256, threads});
+    b->Args({MlasReduceMinimum, 1, 4096, 1024, threads});
+    b->Args({MlasReduceLogSumExp, 4096, 1024, 1, threads});
+    b->Args({MlasReduceLogSumExp, 1, 4096, 1024, threads});
+  }
+}
+
+static void ArgReduceLayouts(benchmark::internal::Benchmark* b) {
+  for (int threads : {1, 8}) {
+    for (int is_maximum : {0, 1}) {
+      b->Args({is_maximum, 4096, 1024, 1, threads});
+      b->Args({is_maximum, 1, 4096, 1024, threads});
+      b->Args({is_maximum, 64, 1000, 49, threads});
+    }
+  }
+}
+
+BENCHMARK(REDUCE)
+    ->ArgNames({"Kind", "Outer", "Reduce", "Inner", "Threads"})
+    ->Apply(ReduceLayouts)
+    ->UseRealTime();
+
+BENCHMARK(ARGREDUCE)
+    ->ArgNames({"IsMaximum", "Outer", "Reduce", "Inner", "Threads"})
+    ->Apply(ArgReduceLayouts)
+    ->UseRealTime();
@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "core/util/thread_utils.h"
+#include "test/mlas/bench/bench_util.h"
+
+using onnxruntime::narrow;
+
+static std::unique_ptr<onnxruntime::concurrency::ThreadPool> CreateTransposeThreadPool(int threads) {
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = threads;
+  tpo.auto_set_affinity = true;
+
+  return std::unique_ptr<onnxruntime::concurrency::ThreadPool>(
+      onnxruntime::concurrency::CreateThreadPool(
+          &onnxruntime::Env::Default(), tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+}
+
+// Transposes a 4D tensor of ElementType with the permutation packed into the
+// second argument as four decimal digits (e.g. 231 for {0, 2, 3, 1}).
+template <typename ElementType>
+void TRANSPOSE(benchmark::State& state) {
+  const auto threads = narrow<int>(state.range(0));
+  const auto packed_permutation = narrow<size_t>(state.range(1));
+  const size_t shape[4] = {narrow<size_t>(state.range(2)), narrow<size_t>(state.range(3)),
+                           narrow<size_t>(state.range(4)), narrow<size_t>(state.range(5))};
+  const size_t permutation[4] = {packed_permutation / 1000 % 10, packed_permutation / 100 % 10,
+                                 packed_permutation / 10 % 10, packed_permutation % 10};
+
+  if (threads <= 0) {
+    throw std::invalid_argument("Threads must be greater than 0!");
+  }
+
+  auto tp = CreateTransposeThreadPool(threads);
+
+  const size_t count = shape[0] * shape[1] * shape[2] * shape[3];
+  std::vector<ElementType> input(count);
+  std::vector<ElementType> output(count);
+  for (size_t i = 0; i < count; i++) {
+    input[i] = static_cast<ElementType>(i);
+  }
+
+  // warming up run
+  MlasTranspose(input.data(), output.data(), shape, permutation, 4, tp.get());
+
+  for (auto _ : state) {
+    MlasTranspose(input.data(), output.data(), shape, permutation, 4, tp.get());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * count * sizeof(ElementType)));
+}
+
+// NCHW <-> NHWC layout changes, the attention head split/merge, and a full
+// reversal of the axes.
+static void TransposeLayouts(benchmark::internal::Benchmark* b) {
+  for (int threads : {1, 8}) {
+    b->Args({threads, 231, 1, 64, 112, 112});
+    b->Args({threads, 312, 1, 112, 112, 64});
+    b->Args({threads, 231, 8, 256, 28, 28});
+    b->Args({threads, 213, 8, 128, 12, 64});
+    b->Args({threads, 3210, 16, 32, 48, 64});
+  }
+}
+
+BENCHMARK_TEMPLATE(TRANSPOSE, uint32_t)
+    ->ArgNames({"Threads", "Perm", "D0", "D1", "D2", "D3"})
+    ->Apply(TransposeLayouts)
+    ->UseRealTime();
+
+BENCHMARK_TEMPLATE(TRANSPOSE, uint16_t)
+    ->ArgNames({"Threads", "Perm", "D0", "D1", "D2", "D3"})
+    ->Apply(TransposeLayouts)
+    ->UseRealTime();
+
+BENCHMARK_TEMPLATE(TRANSPOSE, uint8_t)
+    ->ArgNames({"Threads", "Perm", "D0", "D1", "D2", "D3"})
+    ->Apply(TransposeLayouts)
+    ->UseRealTime();
@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasInterpolateRowsTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferOutput;
+
+  void Test(size_t RowCount, size_t N) {
+    float* Input = BufferInput.GetBuffer(RowCount * N);
+    float* Output = BufferOutput.GetBuffer(N);
+
+    std::default_random_engine generator(static_cast<unsigned>(RowCount * 131 + N));
+    std::uniform_real_distribution<float> distribution(-4.0f, 4.0f);
+
+    std::vector<const float*> Rows(RowCount);
+    std::vector<float> Weights(RowCount);
+    for (size_t k = 0; k < RowCount; k++) {
+      Rows[k] = Input + k * N;
+      Weights[k] = distribution(generator);
+    }
+    for (size_t i = 0; i < RowCount * N; i++) {
+      Input[i] = distribution(generator);
+    }
+
+    MlasInterpolateRows(Rows.data(), Weights.data(), RowCount, Output, N);
+
+    for (size_t n = 0; n < N; n++) {
+      double Expected = 0.0;
+      for (size_t k = 0; k < RowCount; k++) {
+        Expected += double(Weights[k]) * double(Rows[k][n]);
+      }
+      ASSERT_NEAR(Output[n], Expected, 1e-4 * std::max(1.0, std::fabs(Expected)))
+          << "RowCount=" << RowCount << " N=" << N << " @" << n;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("InterpolateRows");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t RowCount : {0, 1, 2, 3, 4, 7}) {
+      for (size_t N : {1, 3, 4, 15, 16, 17, 33, 100, 1027}) {
+        Test(RowCount, N);
+      }
+    }
+  }
+};
+
+class MlasGatherInterpolateTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferOutput;
+
+  void Test(size_t InputCount, size_t TapCount, size_t N) {
+    float* Input = BufferInput.GetBuffer(InputCount);
+    float* Output = BufferOutput.GetBuffer(N);
+
+    std::default_random_engine generator(static_cast<unsigned>(TapCount * 131 + N));
+    std::uniform_real_distribution<float> distribution(-4.0f, 4.0f);
+    std::uniform_int_distribution<int32_t> offset_distribution(-1, static_cast<int32_t>(InputCount) - 1);
+
+    std::vector<int32_t> Offsets(TapCount * N);
+    std::vector<float> Weights(TapCount * N);
+    for (size_t i = 0; i < TapCount * N; i++) {
+      // Roughly one in four taps lands outside of the input.
+      Offsets[i] = (i % 4 == 1) ? -1 : offset_distribution(generator);
+      Weights[i] = distribution(generator);
+    }
+    for (size_t i = 0; i < InputCount; i++) {
+      Input[i] = distribution(generator);
+    }
+
+    MlasGatherInterpolate(Input, Offsets.data(), Weights.data(), TapCount, Output, N);
+
+    for (size_t n = 0; n < N; n++) {
+      double Expected = 0.0;
+      for (size_t k = 0; k < TapCount; k++) {
+        const int32_t Offset = Offsets[k * N + n];
+        if (Offset >= 0) {
+          Expected += double(Weights[k * N + n]) * double(Input[Offset]);
+        }
+      }
+      ASSERT_NEAR(Output[n], Expected, 1e-4 * std::max(1.0, std::fabs(Expected)))
+          << "TapCount=" << TapCount << " N=" << N << " @" << n;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("GatherInterpolate");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t TapCount : {0, 1, 4, 8, 16}) {
+      for (size_t N : {1, 3, 7, 8, 9, 15, 16, 17, 33, 100, 1027}) {
+        Test(257, TapCount, N);
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasInterpolateRowsTest>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasGatherInterpolateTest>::RegisterShortExecute();
+  }
+  return count;
+});
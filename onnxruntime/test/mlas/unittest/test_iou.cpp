@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasIouTest : public MlasTestBase {
+ private:
+  static bool ReferenceIouExceedsThreshold(const float* Box, const float* Other, float IouThreshold) {
+    const float IntersectionXMin = std::max(Box[0], Other[0]);
+    const float IntersectionYMin = std::max(Box[1], Other[1]);
+    const float IntersectionXMax = std::min(Box[2], Other[2]);
+    const float IntersectionYMax = std::min(Box[3], Other[3]);
+    if (IntersectionXMax <= IntersectionXMin || IntersectionYMax <= IntersectionYMin) {
+      return false;
+    }
+    const float IntersectionArea = (IntersectionXMax - IntersectionXMin) * (IntersectionYMax - IntersectionYMin);
+    const float UnionArea = Box[4] + Other[4] - IntersectionArea;
+    if (IntersectionArea <= 0.0f || Box[4] <= 0.0f || Other[4] <= 0.0f || UnionArea <= 0.0f) {
+      return false;
+    }
+    return IntersectionArea / UnionArea > IouThreshold;
+  }
+
+  static void RandomBox(std::default_random_engine& generator, float* Box) {
+    std::uniform_real_distribution<float> position(0.0f, 10.0f);
+    std::uniform_real_distribution<float> extent(-0.5f, 4.0f);
+    Box[0] = position(generator);
+    Box[1] = position(generator);
+    Box[2] = Box[0] + std::max(extent(generator), 0.0f);
+    Box[3] = Box[1] + std::max(extent(generator), 0.0f);
+    Box[4] = (Box[2] - Box[0]) * (Box[3] - Box[1]);
+  }
+
+  void Test(size_t Count, float IouThreshold) {
+    const size_t Stride = Count + 3;
+    std::vector<float> Boxes(5 * Stride);
+    std::default_random_engine generator(static_cast<unsigned>(Count * 7 + 1));
+
+    for (size_t trial = 0; trial < 64; trial++) {
+      float Box[5];
+      RandomBox(generator, Box);
+
+      bool Expected = false;
+      for (size_t i = 0; i < Count; i++) {
+        float Other[5];
+        RandomBox(generator, Other);
+        for (size_t f = 0; f < 5; f++) {
+          Boxes[f * Stride + i] = Other[f];
+        }
+        Expected = Expected || ReferenceIouExceedsThreshold(Box, Other, IouThreshold);
+      }
+
+      ASSERT_EQ(MlasIouExceedsThreshold(Box, Boxes.data(), Count, Stride, IouThreshold), Expected)
+          << "Count=" << Count << " IouThreshold=" << IouThreshold << " trial=" << trial;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Iou");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t Count : {0, 1, 3, 4, 5, 8, 13, 64}) {
+      for (float IouThreshold : {0.0f, 0.3f, 0.7f, 1.0f}) {
+        Test(Count, IouThreshold);
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasIouTest>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,201 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasReduceTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<int64_t> BufferIndices;
+  MLAS_THREADPOOL* threadpool_;
+
+  static double Reference(MLAS_REDUCE_KIND Kind, const float* Input, size_t ReduceCount, size_t InnerCount) {
+    double Maximum = -std::numeric_limits<double>::infinity();
+    double Minimum = std::numeric_limits<double>::infinity();
+    double Sum = 0.0;
+
+    for (size_t r = 0; r < ReduceCount; r++) {
+      const double Value = Input[r * InnerCount];
+      Maximum = std::max(Maximum, Value);
+      Minimum = std::min(Minimum, Value);
+      Sum += Value;
+    }
+
+    switch (Kind) {
+      case MlasReduceSum:
+        return Sum;
+      case MlasReduceMean:
+        return Sum / double(ReduceCount);
+      case MlasReduceMaximum:
+        return Maximum;
+      case MlasReduceMinimum:
+        return Minimum;
+      default: {
+        double SumExp = 0.0;
+        for (size_t r = 0; r < ReduceCount; r++) {
+          SumExp += std::exp(double(Input[r * InnerCount]) - Maximum);
+        }
+        return std::log(SumExp) + Maximum;
+      }
+    }
+  }
+
+  static int64_t ReferenceArg(bool IsMaximum, bool SelectLastIndex, const float* Input, size_t ReduceCount, size_t InnerCount) {
+    float Value = Input[0];
+    int64_t Index = 0;
+
+    for (size_t r = 1; r < ReduceCount; r++) {
+      const float Candidate = Input[r * InnerCount];
+      const bool Select = IsMaximum ? (SelectLastIndex ? Candidate >= Value : Candidate > Value)
+                                    : (SelectLastIndex ? Candidate <= Value : Candidate < Value);
+      if (Select) {
+        Value = Candidate;
+        Index = int64_t(r);
+      }
+    }
+
+    return Index;
+  }
+
+  void FillInput(float* Input, size_t Count, unsigned Seed) {
+    std::default_random_engine generator(Seed);
+    std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+
+    for (size_t i = 0; i < Count; i++) {
+      Input[i] = distribution(generator);
+    }
+  }
+
+  void Test(MLAS_REDUCE_KIND Kind, size_t OuterCount, size_t ReduceCount, size_t InnerCount) {
+    const size_t InputCount = OuterCount * ReduceCount * InnerCount;
+    const size_t OutputCount = OuterCount * InnerCount;
+
+    float* Input = BufferInput.GetBuffer(InputCount);
+    float* Output = BufferOutput.GetBuffer(OutputCount);
+
+    FillInput(Input, InputCount, static_cast<unsigned>(InputCount + Kind));
+
+    MlasReduce(Kind, Input, Output, OuterCount, ReduceCount, InnerCount, threadpool_);
+
+    for (size_t o = 0; o < OuterCount; o++) {
+      for (size_t i = 0; i < InnerCount; i++) {
+        const double Expected = Reference(Kind, Input + o * ReduceCount * InnerCount + i, ReduceCount, InnerCount);
+        const float Actual = Output[o * InnerCount + i];
+        const double Tolerance = 1e-5 * std::max(1.0, std::fabs(Expected)) + 1e-6 * double(ReduceCount);
+        ASSERT_LE(std::fabs(Actual - Expected), Tolerance)
+            << "Kind=" << Kind << " Outer=" << OuterCount << " Reduce=" << ReduceCount << " Inner=" << InnerCount
+            << " @[" << o << "," << i << "], got: " << Actual << ", expecting: " << Expected;
+      }
+    }
+  }
+
+  void TestArg(bool IsMaximum, bool SelectLastIndex, size_t OuterCount, size_t ReduceCount, size_t InnerCount, bool WithTies) {
+    const size_t InputCount = OuterCount * ReduceCount * InnerCount;
+    const size_t OutputCount = OuterCount * InnerCount;
+
+    float* Input = BufferInput.GetBuffer(InputCount);
+    int64_t* Output = BufferIndices.GetBuffer(OutputCount);
+
+    FillInput(Input, InputCount, static_cast<unsigned>(InputCount));
+
+    if (WithTies) {
+      for (size_t i = 0; i < InputCount; i++) {
+        Input[i] = std::round(Input[i] / 4.0f);
+      }
+    }
+
+    MlasArgReduce(IsMaximum, SelectLastIndex, Input, Output, OuterCount, ReduceCount, InnerCount, threadpool_);
+
+    for (size_t o = 0; o < OuterCount; o++) {
+      for (size_t i = 0; i < InnerCount; i++) {
+        const int64_t Expected = ReferenceArg(IsMaximum, SelectLastIndex, Input + o * ReduceCount * InnerCount + i, ReduceCount, InnerCount);
+        ASSERT_EQ(Output[o * InnerCount + i], Expected)
+            << "IsMaximum=" << IsMaximum << " SelectLastIndex=" << SelectLastIndex << " Outer=" << OuterCount
+            << " Reduce=" << ReduceCount << " Inner=" << InnerCount << " @[" << o << "," << i << "]";
+      }
+    }
+  }
+
+  void TestSpecialValues() {
+    constexpr float Infinity = std::numeric_limits<float>::infinity();
+    constexpr float NaN = std::numeric_limits<float>::quiet_NaN();
+
+    float* Input = BufferInput.GetBuffer(64);
+    float* Output = BufferOutput.GetBuffer(1);
+    int64_t* Indices = BufferIndices.GetBuffer(1);
+
+    std::fill_n(Input, 64, -Infinity);
+    MlasReduce(MlasReduceLogSumExp, Input, Output, 1, 64, 1, threadpool_);
+    ASSERT_EQ(Output[0], -Infinity);
+
+    Input[17] = Infinity;
+    MlasReduce(MlasReduceLogSumExp, Input, Output, 1, 64, 1, threadpool_);
+    ASSERT_EQ(Output[0], Infinity);
+
+    for (size_t i = 0; i < 64; i++) {
+      Input[i] = float(i % 7);
+    }
+    Input[5] = NaN;
+    Input[40] = NaN;
+    MlasArgReduce(true, false, Input, Indices, 1, 64, 1, threadpool_);
+    ASSERT_EQ(Indices[0], ReferenceArg(true, false, Input, 64, 1));
+    MlasArgReduce(false, true, Input, Indices, 1, 64, 1, threadpool_);
+    ASSERT_EQ(Indices[0], ReferenceArg(false, true, Input, 64, 1));
+
+    Input[0] = NaN;
+    MlasArgReduce(true, true, Input, Indices, 1, 64, 1, threadpool_);
+    ASSERT_EQ(Indices[0], 0);
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "Reduce_Threaded" : "Reduce_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasReduceTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    static const size_t Shapes[][3] = {
+        {1, 1, 1},
+        {1, 7, 1},
+        {3, 64, 1},
+        {5, 131, 1},
+        {1, 100000, 1},
+        {1, 3, 5},
+        {2, 9, 16},
+        {4, 33, 71},
+        {1, 1000, 3},
+        {1, 4097, 40},
+        {3, 17, 2100},
+        {1, 64, 65536},
+    };
+
+    for (const auto& Shape : Shapes) {
+      for (int Kind = 0; Kind < MlasReduceKindCount; Kind++) {
+        Test(MLAS_REDUCE_KIND(Kind), Shape[0], Shape[1], Shape[2]);
+      }
+      for (bool IsMaximum : {false, true}) {
+        for (bool SelectLastIndex : {false, true}) {
+          TestArg(IsMaximum, SelectLastIndex, Shape[0], Shape[1], Shape[2], false);
+          TestArg(IsMaximum, SelectLastIndex, Shape[0], Shape[1], Shape[2], true);
+        }
+      }
+    }
+
+    TestSpecialValues();
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasReduceTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasReduceTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
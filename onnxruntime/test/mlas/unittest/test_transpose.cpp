@@ -23,6 +23,64 @@ class MlasTransposeTest : public MlasTestBase {
     ASSERT_EQ(memcmp(Output, OutputReference, M * N * sizeof(ElementType)), 0) << " [" << M << "," << N << "]";
   }
 
+  void
+  Test(const std::vector<size_t>& Shape, const std::vector<size_t>& Permutation) {
+    const size_t Rank = Shape.size();
+    size_t Count = 1;
+    for (size_t d : Shape) {
+      Count *= d;
+    }
+
+    ElementType* Input = BufferInput.GetBuffer(Count);
+    ElementType* Output = BufferOutput.GetBuffer(Count);
+    ElementType* OutputReference = BufferOutputReference.GetBuffer(Count);
+
+    for (size_t i = 0; i < Count; i++) {
+      Input[i] = static_cast<ElementType>(i * 2654435761u);
+    }
+
+    MlasTranspose(Input, Output, Shape.data(), Permutation.data(), Rank, threadpool_);
+    ReferenceTranspose(Input, OutputReference, Shape, Permutation);
+
+    std::ostringstream Description;
+    for (size_t i = 0; i < Rank; i++) {
+      Description << (i == 0 ? "[" : ",") << Shape[i] << ":" << Permutation[i];
+    }
+    Description << "]";
+
+    ASSERT_EQ(memcmp(Output, OutputReference, Count * sizeof(ElementType)), 0) << Description.str();
+  }
+
+  void ReferenceTranspose(const ElementType* Input, ElementType* Output,
+                          const std::vector<size_t>& Shape, const std::vector<size_t>& Permutation) {
+    const size_t Rank = Shape.size();
+    std::vector<size_t> InputStrides(Rank, 1);
+    for (size_t i = Rank - 1; i > 0; i--) {
+      InputStrides[i - 1] = InputStrides[i] * Shape[i];
+    }
+
+    std::vector<size_t> Index(Rank, 0);
+    size_t Count = 1;
+    for (size_t d : Shape) {
+      Count *= d;
+    }
+
+    for (size_t o = 0; o < Count; o++) {
+      size_t Offset = 0;
+      for (size_t i = 0; i < Rank; i++) {
+        Offset += Index[i] * InputStrides[Permutation[i]];
+      }
+      Output[o] = Input[Offset];
+
+      for (size_t i = Rank; i > 0; i--) {
+        if (++Index[i - 1] < Shape[Permutation[i - 1]]) {
+          break;
+        }
+        Index[i - 1] = 0;
+      }
+    }
+  }
+
   void ReferenceTranspose(const ElementType* Input, ElementType* Output, size_t M, size_t N) {
     for (size_t m = 0; m < M; m++) {
       for (size_t n = 0; n < N; n++) {
@@ -45,6 +103,7 @@ class MlasTransposeTest : public MlasTestBase {
     if (std::is_same<ElementType, float>::value) return std::string("FP32");
     if (std::is_same<ElementType, uint32_t>::value) return std::string("U32");
     if (std::is_same<ElementType, uint16_t>::value) return std::string("U16");
+    if (std::is_same<ElementType, uint64_t>::value) return std::string("U64");
     if (std::is_same<ElementType, uint8_t>::value) return std::string("U8");
     return std::string("unknown");
   }
@@ -55,6 +114,26 @@ class MlasTransposeTest : public MlasTestBase {
         Test(m, n);
       }
     }
+
+    Test(100, 130);
+    Test(257, 65);
+    Test(3, 4099);
+
+    if constexpr (std::is_unsigned_v<ElementType>) {
+      Test({2, 3, 4}, {0, 2, 1});
+      Test({2, 3, 4}, {2, 1, 0});
+      Test({2, 3, 4}, {1, 0, 2});
+      Test({1, 64, 56, 56}, {0, 2, 3, 1});
+      Test({1, 56, 56, 64}, {0, 3, 1, 2});
+      Test({2, 3, 65, 70}, {0, 3, 1, 2});
+      Test({4, 12, 33, 64}, {0, 2, 1, 3});
+      Test({2, 5, 7, 9, 11}, {4, 2, 0, 3, 1});
+      Test({2, 1, 7, 1, 11}, {3, 4, 1, 2, 0});
+      Test({3, 130, 1, 129}, {3, 2, 1, 0});
+      Test({2, 3, 4, 5, 6, 7, 2, 3}, {7, 5, 3, 1, 6, 4, 2, 0});
+      Test({1, 1, 1}, {2, 0, 1});
+      Test({5, 0, 3}, {2, 0, 1});
+    }
   }
 };
 
@@ -64,9 +143,11 @@ static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_exe
     count += MlasDirectShortExecuteTests<MlasTransposeTest<uint32_t, false>>::RegisterShortExecute();
     count += MlasDirectShortExecuteTests<MlasTransposeTest<uint16_t, false>>::RegisterShortExecute();
     count += MlasDirectShortExecuteTests<MlasTransposeTest<uint8_t, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasTransposeTest<uint64_t, false>>::RegisterShortExecute();
     count += MlasDirectShortExecuteTests<MlasTransposeTest<uint32_t, true>>::RegisterShortExecute();
     count += MlasDirectShortExecuteTests<MlasTransposeTest<uint16_t, true>>::RegisterShortExecute();
     count += MlasDirectShortExecuteTests<MlasTransposeTest<uint8_t, true>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasTransposeTest<uint64_t, true>>::RegisterShortExecute();
     count += MlasDirectShortExecuteTests<MlasTransposeTest<float, true>>::RegisterShortExecute();
     count += MlasDirectShortExecuteTests<MlasTransposeTest<int8_t, true>>::RegisterShortExecute();
   }
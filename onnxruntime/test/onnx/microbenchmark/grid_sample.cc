@@ -0,0 +1,207 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "common.h"
+
+#include <benchmark/benchmark.h>
+#include <core/graph/model.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <core/session/ort_env.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+#define ORT_BREAK_ON_ERROR(expr)                                \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+    }                                                           \
+  } while (0);
+
+namespace {
+
+constexpr int64_t kChannels = 32;
+constexpr int64_t kHeight = 64;
+constexpr int64_t kWidth = 64;
+
+const char* const kModes[] = {"nearest", "linear", "cubic"};
+
+struct BenchmarkInput {
+  std::string name;
+  std::vector<int64_t> shape;
+  ONNX_NAMESPACE::TensorProto_DataType type;
+};
+
+// Serializes a model with a single node of op_type that consumes the graph inputs and produces Y.
+std::string CreateSingleNodeModel(const std::string& op_type, const std::vector<BenchmarkInput>& inputs,
+                                  const std::string& mode) {
+  auto logger = env->GetLoggingManager()->CreateLogger("grid_sample");
+  onnxruntime::Model model(op_type, false, *logger);
+  auto& graph = model.MainGraph();
+
+  std::vector<onnxruntime::NodeArg*> input_args;
+  for (const auto& input : inputs) {
+    if (input.name.empty()) {
+      input_args.push_back(&graph.GetOrCreateNodeArg("", nullptr));
+      continue;
+    }
+    ONNX_NAMESPACE::TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(input.type);
+    for (int64_t dim : input.shape) {
+      type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+    input_args.push_back(&graph.GetOrCreateNodeArg(input.name, &type));
+  }
+
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+  auto& node = graph.AddNode(op_type, op_type, "", input_args, {&y});
+  node.AddAttribute("mode", mode);
+
+  ORT_THROW_IF_ERROR(graph.Resolve());
+
+  std::string model_bytes;
+  model.ToProto().SerializeToString(&model_bytes);
+  return model_bytes;
+}
+
+// Runs the model on the given inputs once per iteration with num_threads intra-op threads.
+void RunModel(benchmark::State& state, const std::string& model_bytes, int num_threads,
+              const std::vector<BenchmarkInput>& inputs, std::vector<std::vector<float>>& float_data,
+              std::vector<std::vector<int64_t>>& int64_data) {
+  OrtSessionOptions* session_options;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+  ORT_BREAK_ON_ERROR(g_ort->SetIntraOpNumThreads(session_options, num_threads));
+
+  OrtSession* session;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionFromArray(env, model_bytes.data(), model_bytes.size(), session_options,
+                                                   &session));
+
+  OrtMemoryInfo* memory_info;
+  ORT_BREAK_ON_ERROR(g_ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
+
+  std::vector<const char*> input_names;
+  std::vector<OrtValue*> input_values;
+  size_t float_index = 0;
+  size_t int64_index = 0;
+  for (const auto& input : inputs) {
+    if (input.name.empty()) {
+      continue;
+    }
+    OrtValue* value = nullptr;
+    if (input.type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+      auto& data = float_data[float_index++];
+      ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, data.data(), data.size() * sizeof(float),
+                                                               input.shape.data(), input.shape.size(),
+                                                               ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &value));
+    } else {
+      auto& data = int64_data[int64_index++];
+      ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, data.data(),
+                                                               data.size() * sizeof(int64_t), input.shape.data(),
+                                                               input.shape.size(),
+                                                               ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64, &value));
+    }
+    input_names.push_back(input.name.c_str());
+    input_values.push_back(value);
+  }
+
+  const char* output_names[] = {"Y"};
+  for (auto _ : state) {
+    OrtValue* output = nullptr;
+    ORT_BREAK_ON_ERROR(g_ort->Run(session, nullptr, input_names.data(), input_values.data(), input_values.size(),
+                                  output_names, 1, &output));
+    g_ort->ReleaseValue(output);
+  }
+
+  for (OrtValue* value : input_values) {
+    g_ort->ReleaseValue(value);
+  }
+  g_ort->ReleaseMemoryInfo(memory_info);
+  g_ort->ReleaseSession(session);
+  g_ort->ReleaseSessionOptions(session_options);
+}
+
+std::vector<float> RandomValues(size_t size, float low, float high) {
+  float* data = GenerateArrayWithRandomValue<float>(size, low, high);
+  std::vector<float> values(data, data + size);
+  aligned_free(data);
+  return values;
+}
+
+}  // namespace
+
+// GridSample of a [1, C, H, W] input at H x W grid points. range(0) indexes the mode: nearest, linear, cubic.
+static void BM_GridSample(benchmark::State& state) {
+  const std::string mode = kModes[state.range(0)];
+  const int num_threads = static_cast<int>(state.range(1));
+
+  const std::vector<BenchmarkInput> inputs{
+      {"X", {1, kChannels, kHeight, kWidth}, ONNX_NAMESPACE::TensorProto_DataType_FLOAT},
+      {"grid", {1, kHeight, kWidth, 2}, ONNX_NAMESPACE::TensorProto_DataType_FLOAT}};
+  std::vector<std::vector<float>> float_data{RandomValues(kChannels * kHeight * kWidth, -1.f, 1.f),
+                                             RandomValues(kHeight * kWidth * 2, -1.f, 1.f)};
+  std::vector<std::vector<int64_t>> int64_data;
+
+  RunModel(state, CreateSingleNodeModel("GridSample", inputs, mode), num_threads, inputs, float_data, int64_data);
+}
+
+BENCHMARK(BM_GridSample)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgsProduct({{0, 1, 2}, {1, 4}});
+
+// Resize of a [1, C, H, W] input by 2 along H and W. range(0) indexes the mode: nearest, linear, cubic.
+static void BM_Resize(benchmark::State& state) {
+  const std::string mode = kModes[state.range(0)];
+  const int num_threads = static_cast<int>(state.range(1));
+
+  const std::vector<BenchmarkInput> inputs{
+      {"X", {1, kChannels, kHeight, kWidth}, ONNX_NAMESPACE::TensorProto_DataType_FLOAT},
+      {"", {}, ONNX_NAMESPACE::TensorProto_DataType_FLOAT},
+      {"scales", {4}, ONNX_NAMESPACE::TensorProto_DataType_FLOAT}};
+  std::vector<std::vector<float>> float_data{RandomValues(kChannels * kHeight * kWidth, -1.f, 1.f),
+                                             {1.f, 1.f, 2.f, 2.f}};
+  std::vector<std::vector<int64_t>> int64_data;
+
+  RunModel(state, CreateSingleNodeModel("Resize", inputs, mode), num_threads, inputs, float_data, int64_data);
+}
+
+BENCHMARK(BM_Resize)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgsProduct({{0, 1, 2}, {1, 4}});
+
+// RoiAlign in avg mode of range(0) random ROIs of a [1, C, H, W] input.
+static void BM_RoiAlign(benchmark::State& state) {
+  const int64_t num_rois = state.range(0);
+  const int num_threads = static_cast<int>(state.range(1));
+
+  const std::vector<BenchmarkInput> inputs{
+      {"X", {1, kChannels, kHeight, kWidth}, ONNX_NAMESPACE::TensorProto_DataType_FLOAT},
+      {"rois", {num_rois, 4}, ONNX_NAMESPACE::TensorProto_DataType_FLOAT},
+      {"batch_indices", {num_rois}, ONNX_NAMESPACE::TensorProto_DataType_INT64}};
+  std::vector<float> rois(static_cast<size_t>(num_rois * 4));
+  const std::vector<float> corners = RandomValues(rois.size(), 0.f, static_cast<float>(kWidth - 1));
+  for (size_t i = 0; i < rois.size(); i += 4) {
+    rois[i] = std::min(corners[i], corners[i + 2]);
+    rois[i + 1] = std::min(corners[i + 1], corners[i + 3]);
+    rois[i + 2] = std::max(corners[i], corners[i + 2]);
+    rois[i + 3] = std::max(corners[i + 1], corners[i + 3]);
+  }
+  std::vector<std::vector<float>> float_data{RandomValues(kChannels * kHeight * kWidth, -1.f, 1.f),
+                                             std::move(rois)};
+  std::vector<std::vector<int64_t>> int64_data{std::vector<int64_t>(static_cast<size_t>(num_rois), 0)};
+
+  RunModel(state, CreateSingleNodeModel("RoiAlign", inputs, "avg"), num_threads, inputs, float_data, int64_data);
+}
+
+BENCHMARK(BM_RoiAlign)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgsProduct({{16, 256}, {1, 4}});
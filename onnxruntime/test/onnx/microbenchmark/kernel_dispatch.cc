@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/model.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <core/session/ort_env.h>
+
+#include <string>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+#define ORT_BREAK_ON_ERROR(expr)                                \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+    }                                                           \
+  } while (0);
+
+// Y = (((X + X) + X) + ...) + X with num_nodes Add nodes on single element tensors.
+static std::string CreateAddChainModel(int64_t num_nodes) {
+  auto logger = env->GetLoggingManager()->CreateLogger("kernel_dispatch");
+  onnxruntime::Model model("kernel_dispatch", false, *logger);
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto* previous = &x;
+  for (int64_t i = 0; i < num_nodes; ++i) {
+    const std::string output_name = i + 1 == num_nodes ? "Y" : "T" + std::to_string(i);
+    auto* output = &graph.GetOrCreateNodeArg(output_name, &float_tensor);
+    graph.AddNode("add_" + std::to_string(i), "Add", "", {previous, &x}, {output});
+    previous = output;
+  }
+
+  ORT_THROW_IF_ERROR(graph.Resolve());
+
+  std::string model_bytes;
+  model.ToProto().SerializeToString(&model_bytes);
+  return model_bytes;
+}
+
+// Measures the time it takes to dispatch a node. The kernels do next to no work, so the time per node is the
+// overhead of the executor: creating the kernel context, looking up the inputs and outputs and releasing them.
+static void BM_KernelDispatch(benchmark::State& state) {
+  const int64_t num_nodes = state.range(0);
+  const std::string model_bytes = CreateAddChainModel(num_nodes);
+
+  OrtSessionOptions* session_options;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+  ORT_BREAK_ON_ERROR(g_ort->SetIntraOpNumThreads(session_options, 1));
+  ORT_BREAK_ON_ERROR(g_ort->SetSessionGraphOptimizationLevel(session_options, ORT_DISABLE_ALL));
+
+  OrtSession* session;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionFromArray(env, model_bytes.data(), model_bytes.size(), session_options,
+                                                   &session));
+
+  OrtMemoryInfo* memory_info;
+  ORT_BREAK_ON_ERROR(g_ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
+
+  float x = 1.f;
+  const int64_t shape[] = {1};
+  OrtValue* input;
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, &x, sizeof(x), shape, 1,
+                                                           ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &input));
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  for (auto _ : state) {
+    OrtValue* output = nullptr;
+    ORT_BREAK_ON_ERROR(g_ort->Run(session, nullptr, input_names, &input, 1, output_names, 1, &output));
+    g_ort->ReleaseValue(output);
+  }
+
+  state.counters["time_per_node"] =
+      benchmark::Counter(static_cast<double>(num_nodes),
+                         benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+
+  g_ort->ReleaseValue(input);
+  g_ort->ReleaseMemoryInfo(memory_info);
+  g_ort->ReleaseSession(session);
+  g_ort->ReleaseSessionOptions(session_options);
+}
+
+BENCHMARK(BM_KernelDispatch)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond);
@@ -0,0 +1,66 @@
+#include "common.h"
+
+#include <benchmark/benchmark.h>
+#include "core/providers/cpu/object_detection/non_max_suppression.h"
+#include "core/providers/cpu/object_detection/non_max_suppression_helper.h"
+#include "core/util/thread_utils.h"
+
+using namespace onnxruntime;
+
+// Detector style NonMaxSuppression: one batch of `num_boxes` anchors scored for `num_classes` classes.
+static void BM_NonMaxSuppression(benchmark::State& state) {
+  const int64_t num_classes = state.range(0);
+  const int num_boxes = static_cast<int>(state.range(1));
+  const int64_t max_output_boxes_per_class = state.range(2);
+  const bool use_thread_pool = state.range(3) != 0;
+  constexpr float iou_threshold = 0.5f;
+  constexpr float score_threshold = 0.05f;
+
+  std::default_random_engine generator(1234);
+  std::uniform_real_distribution<float> position(0.0f, 600.0f);
+  std::uniform_real_distribution<float> extent(5.0f, 120.0f);
+  std::uniform_real_distribution<float> score(0.0f, 1.0f);
+
+  std::vector<float> boxes(static_cast<size_t>(num_boxes) * 4);
+  for (size_t i = 0; i < boxes.size(); i += 4) {
+    boxes[i + 0] = position(generator);
+    boxes[i + 1] = position(generator);
+    boxes[i + 2] = boxes[i + 0] + extent(generator);
+    boxes[i + 3] = boxes[i + 1] + extent(generator);
+  }
+  std::vector<float> scores(static_cast<size_t>(num_classes * num_boxes));
+  for (auto& s : scores) {
+    s = score(generator);
+  }
+
+  PrepareContext pc;
+  pc.boxes_data_ = boxes.data();
+  pc.scores_data_ = scores.data();
+  pc.score_threshold_ = &score_threshold;
+  pc.num_batches_ = 1;
+  pc.num_classes_ = num_classes;
+  pc.num_boxes_ = num_boxes;
+
+  OrtThreadPoolParams tpo;
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<concurrency::ThreadPool> tp(
+      concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tpo, concurrency::ThreadPoolType::INTRA_OP));
+
+  std::vector<SelectedIndex> selected_indices;
+  for (auto _ : state) {
+    selected_indices.clear();
+    NonMaxSuppression::ComputeSelectedIndices(pc, 0, max_output_boxes_per_class, iou_threshold, score_threshold,
+                                              use_thread_pool ? tp.get() : nullptr, selected_indices);
+    benchmark::DoNotOptimize(selected_indices.data());
+  }
+}
+
+BENCHMARK(BM_NonMaxSuppression)
+    ->ArgNames({"Classes", "Boxes", "MaxOutput", "Threaded"})
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Args({1, 1000, 100, 0})
+    ->Args({80, 1000, 100, 0})
+    ->Args({80, 20000, 200, 0})
+    ->Args({80, 20000, 200, 1})
+    ->Args({90, 100000, 100, 1});
@@ -0,0 +1,77 @@
+#include "common.h"
+
+#include <benchmark/benchmark.h>
+#include <core/framework/allocator.h>
+#include <core/framework/tensor.h>
+#include <core/providers/cpu/math/cumsum.h>
+#include <core/providers/cpu/math/top_k.h>
+#include <core/util/thread_utils.h>
+
+using namespace onnxruntime;
+
+static std::unique_ptr<concurrency::ThreadPool> CreateIntraOpThreadPool(int num_threads) {
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = num_threads;
+  return concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tpo, concurrency::ThreadPoolType::INTRA_OP);
+}
+
+// TopK over the last axis of a [rows, cols] input
+static void BM_TopKLastAxis(benchmark::State& state) {
+  const int64_t rows = state.range(0);
+  const int64_t cols = state.range(1);
+  const unsigned k = static_cast<unsigned>(state.range(2));
+  const int num_threads = static_cast<int>(state.range(3));
+
+  AllocatorPtr allocator = std::make_shared<CPUAllocator>();
+  Tensor input(DataTypeImpl::GetType<float>(), TensorShape({rows, cols}), allocator);
+  float* data = GenerateArrayWithRandomValue<float>(static_cast<size_t>(rows * cols), -1, 1);
+  std::copy_n(data, rows * cols, input.MutableData<float>());
+  aligned_free(data);
+
+  auto tp = CreateIntraOpThreadPool(num_threads);
+  for (auto _ : state) {
+    Tensor values;
+    Tensor indices;
+    auto status = GetTopK<float>(&input, -1, k, true, true, allocator, tp.get(), values, indices);
+    if (!status.IsOK()) {
+      state.SkipWithError(status.ErrorMessage().c_str());
+      break;
+    }
+  }
+}
+
+BENCHMARK(BM_TopKLastAxis)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Args({1, 1000000, 10, 1})
+    ->Args({1, 1000000, 10, 8})
+    ->Args({8, 1000000, 100, 8})
+    ->Args({1, 1000000, 100000, 1})
+    ->Args({64, 10000, 1000, 8});
+
+// CumSum over the last axis of a [rows, cols] input
+static void BM_CumSumLastAxis(benchmark::State& state) {
+  const int64_t rows = state.range(0);
+  const int64_t cols = state.range(1);
+  const int num_threads = static_cast<int>(state.range(2));
+
+  const size_t size = static_cast<size_t>(rows * cols);
+  float* input = GenerateArrayWithRandomValue<float>(size, -1, 1);
+  float* output = static_cast<float*>(aligned_alloc(size * sizeof(float), 64));
+
+  auto tp = CreateIntraOpThreadPool(num_threads);
+  for (auto _ : state) {
+    cumsum_op::ComputeCumSum(input, output, rows, cols, int64_t{1}, false, false, tp.get());
+    benchmark::ClobberMemory();
+  }
+
+  aligned_free(input);
+  aligned_free(output);
+}
+
+BENCHMARK(BM_CumSumLastAxis)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Args({1, 1000000, 1})
+    ->Args({1, 1000000, 8})
+    ->Args({64, 4096, 8});
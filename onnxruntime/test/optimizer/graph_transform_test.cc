@@ -5,6 +5,7 @@
 #pragma warning(disable : 4244)
 #endif
 
+#include <optional>
 #include <random>
 
 #include "gtest/gtest.h"
@@ -104,6 +105,52 @@ namespace onnxruntime {
 namespace test {
 
 #define MODEL_FOLDER ORT_TSTR("testdata/transform/")
+
+namespace {
+// Reports a modification from its first `num_modifications` calls and counts how often it is applied.
+class CountingTransformer : public GraphTransformer {
+ public:
+  CountingTransformer(const std::string& name, int num_modifications)
+      : GraphTransformer(name), num_modifications_(num_modifications) {}
+
+  int NumApplied() const { return num_applied_; }
+
+ private:
+  Status ApplyImpl(Graph& /*graph*/, bool& modified, int /*graph_level*/,
+                   const logging::Logger& /*logger*/) const override {
+    modified = num_applied_++ < num_modifications_;
+    return Status::OK();
+  }
+
+  const int num_modifications_;
+  mutable int num_applied_ = 0;
+};
+}  // namespace
+
+// A transformer that ran without modifying the graph is not applied again until the graph is modified.
+TEST_F(GraphTransformationTests, TransformerAtFixedPointIsSkipped) {
+  constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "abs-id-max.onnx";
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, *logger_));
+  Graph& graph = model->MainGraph();
+
+  auto modifies_twice = std::make_unique<CountingTransformer>("ModifiesTwice", 2);
+  auto never_modifies = std::make_unique<CountingTransformer>("NeverModifies", 0);
+  const auto* modifies_twice_ptr = modifies_twice.get();
+  const auto* never_modifies_ptr = never_modifies.get();
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(modifies_twice), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(never_modifies), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  // step 0 and 1: both run and ModifiesTwice modifies the graph.
+  // step 2: ModifiesTwice reaches its fixed point, after which NeverModifies has already seen the current graph.
+  EXPECT_EQ(modifies_twice_ptr->NumApplied(), 3);
+  EXPECT_EQ(never_modifies_ptr->NumApplied(), 2);
+  EXPECT_TRUE(graph_transformation_mgr.IsGraphModified());
+}
+
 TEST_F(GraphTransformationTests, IdentityElimination) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "abs-id-max.onnx";
   std::shared_ptr<Model> model;
@@ -8325,6 +8372,160 @@ TEST_F(GraphTransformationTests, MatMulNBitsBiasFusion) {
   }
 }
 
+TEST_F(GraphTransformationTests, EmbeddingBagFusion) {
+  struct TestOptions {
+    const char* reduce_op;
+    int opset;
+    bool keepdims;
+  };
+
+  auto run_test = [&logger = *logger_](const TestOptions& opts) {
+    SCOPED_TRACE(MakeString("reduce_op:", opts.reduce_op, ", opset:", opts.opset, ", keepdims:", opts.keepdims));
+    // ReduceSum takes axes as an input since opset 13 and ReduceMean since opset 18.
+    const bool axes_as_input = opts.opset >= (std::string(opts.reduce_op) == "ReduceSum" ? 13 : 18);
+
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* data_arg = builder.MakeInput<float>({{10, 4}});
+      auto* indices_arg = builder.MakeInput<int64_t>({{3, 5}});
+      auto* gather_out = builder.MakeIntermediate();
+      auto* reduce_out = builder.MakeOutput();
+
+      builder.AddNode("Gather", {data_arg, indices_arg}, {gather_out})
+          .AddAttribute("axis", static_cast<int64_t>(0));
+      if (axes_as_input) {
+        auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {1});
+        builder.AddNode(opts.reduce_op, {gather_out, axes_arg}, {reduce_out})
+            .AddAttribute("keepdims", static_cast<int64_t>(opts.keepdims));
+      } else {
+        Node& reduce_node = builder.AddNode(opts.reduce_op, {gather_out}, {reduce_out});
+        reduce_node.AddAttribute("axes", std::vector<int64_t>{1});
+        reduce_node.AddAttribute("keepdims", static_cast<int64_t>(opts.keepdims));
+      }
+    };
+
+    auto pre_graph_checker = [&](Graph& graph) {
+      auto op_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_count["Gather"] == 1);
+      TEST_RETURN_IF_NOT(op_count[opts.reduce_op] == 1);
+      return Status::OK();
+    };
+
+    auto post_graph_checker = [&](Graph& graph) {
+      auto op_count = CountOpsInGraph(graph);
+      const int fused = opts.keepdims ? 0 : 1;
+      TEST_RETURN_IF_NOT(op_count["Gather"] == 1 - fused);
+      TEST_RETURN_IF_NOT(op_count[opts.reduce_op] == 1 - fused);
+      TEST_RETURN_IF_NOT(op_count["com.microsoft.EmbeddingBag"] == fused);
+      for (auto& node : graph.Nodes()) {
+        if (node.OpType() == "EmbeddingBag") {
+          const auto* mode = graph_utils::GetNodeAttribute(node, "mode");
+          TEST_RETURN_IF_NOT(mode != nullptr);
+          TEST_RETURN_IF_NOT(mode->s() == (std::string(opts.reduce_op) == "ReduceSum" ? "sum" : "mean"));
+        }
+      }
+      return Status::OK();
+    };
+
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, opts.opset, logger, std::make_unique<EmbeddingBagFusion>(),
+                                          TransformerLevel::Level2, 1, pre_graph_checker, post_graph_checker));
+  };
+
+  run_test({"ReduceSum", 12, false});
+  run_test({"ReduceSum", 13, false});
+  run_test({"ReduceMean", 13, false});
+  run_test({"ReduceMean", 18, false});
+  // The bag axis must be dropped for the output to match EmbeddingBag.
+  run_test({"ReduceSum", 13, true});
+}
+
+TEST_F(GraphTransformationTests, EmbeddingBagFusionQuantized) {
+  struct TestOptions {
+    const char* reduce_op;
+    std::optional<int64_t> bits;
+    bool has_zero_points;
+  };
+
+  constexpr int64_t num_rows = 10;
+  constexpr int64_t embedding_dim = 32;
+  constexpr int64_t block_size = 16;
+
+  auto run_test = [&logger = *logger_](const TestOptions& opts) {
+    SCOPED_TRACE(MakeString("reduce_op:", opts.reduce_op, ", bits:", opts.bits.value_or(-1),
+                            ", has_zero_points:", opts.has_zero_points));
+    // GatherBlockQuantized defaults to 4 bits.
+    const int64_t bits = opts.bits.value_or(4);
+    const int64_t packed_dim = embedding_dim * bits / 8;
+    const int64_t num_blocks = embedding_dim / block_size;
+
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* data_arg = builder.MakeInitializer<uint8_t>({num_rows, packed_dim}, uint8_t(0), uint8_t(255));
+      auto* indices_arg = builder.MakeInput<int64_t>({{3, 5}});
+      auto* scales_arg = builder.MakeInitializer<float>({num_rows, num_blocks}, 0.5f, 1.5f);
+      std::vector<NodeArg*> gather_inputs{data_arg, indices_arg, scales_arg};
+      if (opts.has_zero_points) {
+        // 4 bit zero points are packed two per byte along the quantized axis.
+        const int64_t zero_points_dim = bits == 4 ? (num_blocks + 1) / 2 : num_blocks;
+        gather_inputs.push_back(builder.MakeInitializer<uint8_t>({num_rows, zero_points_dim}, uint8_t(0),
+                                                                 uint8_t(255)));
+      }
+      auto* gather_out = builder.MakeIntermediate();
+      auto* reduce_out = builder.MakeOutput();
+
+      Node& gather_node = builder.AddNode("GatherBlockQuantized", gather_inputs, {gather_out}, kMSDomain);
+      gather_node.AddAttribute("block_size", block_size);
+      if (opts.bits.has_value()) {
+        gather_node.AddAttribute("bits", *opts.bits);
+      }
+      auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {1});
+      builder.AddNode(opts.reduce_op, {gather_out, axes_arg}, {reduce_out})
+          .AddAttribute("keepdims", static_cast<int64_t>(0));
+    };
+
+    auto pre_graph_checker = [&](Graph& graph) {
+      auto op_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_count["com.microsoft.GatherBlockQuantized"] == 1);
+      TEST_RETURN_IF_NOT(op_count[opts.reduce_op] == 1);
+      return Status::OK();
+    };
+
+    auto post_graph_checker = [&](Graph& graph) {
+      auto op_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_count["com.microsoft.GatherBlockQuantized"] == 0);
+      TEST_RETURN_IF_NOT(op_count[opts.reduce_op] == 0);
+      TEST_RETURN_IF_NOT(op_count["com.microsoft.EmbeddingBag"] == 1);
+      for (auto& node : graph.Nodes()) {
+        if (node.OpType() == "EmbeddingBag") {
+          const auto* mode = graph_utils::GetNodeAttribute(node, "mode");
+          TEST_RETURN_IF_NOT(mode != nullptr);
+          TEST_RETURN_IF_NOT(mode->s() == (std::string(opts.reduce_op) == "ReduceSum" ? "sum" : "mean"));
+          const auto* bits_attr = graph_utils::GetNodeAttribute(node, "bits");
+          TEST_RETURN_IF_NOT(bits_attr != nullptr);
+          TEST_RETURN_IF_NOT(bits_attr->i() == bits);
+          const auto* block_size_attr = graph_utils::GetNodeAttribute(node, "block_size");
+          TEST_RETURN_IF_NOT(block_size_attr != nullptr);
+          TEST_RETURN_IF_NOT(block_size_attr->i() == block_size);
+
+          // data, indices, the empty offsets and per_sample_weights, scales and the optional zero points
+          const auto& inputs = node.InputDefs();
+          TEST_RETURN_IF_NOT(inputs.size() == (opts.has_zero_points ? 6u : 5u));
+          TEST_RETURN_IF_NOT(!inputs[2]->Exists() && !inputs[3]->Exists());
+          TEST_RETURN_IF_NOT(graph_utils::IsInitializer(graph, inputs[4]->Name(), false));
+        }
+      }
+      return Status::OK();
+    };
+
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 21, logger, std::make_unique<EmbeddingBagFusion>(),
+                                          TransformerLevel::Level2, 1, pre_graph_checker, post_graph_checker));
+  };
+
+  run_test({"ReduceSum", 4, true});
+  run_test({"ReduceMean", 8, true});
+  run_test({"ReduceSum", 8, false});
+  // bits is not set on the Gather, so the GatherBlockQuantized default of 4 must be set on EmbeddingBag.
+  run_test({"ReduceSum", std::nullopt, false});
+}
+
 #endif  // !defined(DISABLE_CONTRIB_OPS)
 
 }  // namespace test
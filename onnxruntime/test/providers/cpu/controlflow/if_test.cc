@@ -8,7 +8,9 @@
 #include "core/providers/cpu/controlflow/if.h"
 #include "test/providers/provider_test_utils.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
+#include "test/util/include/asserts.h"
 #include "test/util/include/default_providers.h"
 
 using namespace ONNX_NAMESPACE;
@@ -22,6 +24,8 @@ struct RunOptions {
   int symbolic_dim_value_in_main_graph = -1;
   bool include_dim_values_in_subgraph = true;
   bool mixed_execution_providers = false;
+  // value for kOrtSessionOptionsConfigLazySubgraphInitialization if set
+  std::string lazy_subgraph_initialization;
 };
 }  // namespace
 
@@ -258,6 +262,11 @@ void RunTest(bool condition_value,
     execution_providers.push_back(DefaultCpuExecutionProvider());
 
     test.Run(expect_result, failure_message, excluded_providers, nullptr, &execution_providers);
+  } else if (!options.lazy_subgraph_initialization.empty()) {
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigLazySubgraphInitialization,
+                                                      options.lazy_subgraph_initialization.c_str()));
+    test.Run(so, expect_result, failure_message, excluded_providers);
   } else {
     test.Run(expect_result, failure_message, excluded_providers);
   }
@@ -295,6 +304,27 @@ TEST(If, NoShapeInMainGraph_ShapeInSubgraph_False) {
   RunTest(false, options, false);
 }
 
+TEST(If, LazySubgraphInitialization_True) {
+  RunOptions options{};
+  options.lazy_subgraph_initialization = "1";
+
+  RunTest(true, options, false);
+}
+
+TEST(If, LazySubgraphInitialization_False) {
+  RunOptions options{};
+  options.lazy_subgraph_initialization = "1";
+
+  RunTest(false, options, false);
+}
+
+TEST(If, LazySubgraphInitializationInBackground) {
+  RunOptions options{};
+  options.lazy_subgraph_initialization = "2";
+
+  RunTest(false, options, false);
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM)
 TEST(If, MixedExecutionProviders) {
   RunOptions options{};
@@ -9,8 +9,10 @@
 #include "core/common/logging/logging.h"
 #include "core/framework/session_state.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/asserts.h"
 #include "test/util/include/default_providers.h"
 #include "test/unittest_util/framework_test_utils.h"
 
@@ -29,6 +31,8 @@ struct RunOptions {
   bool init_iter_num_1d_tensor = true;
   bool subgraph_cond_1d_tensor = true;
   bool subgraph_iter_num_1d_tensor = true;
+  // value for kOrtSessionOptionsConfigLazySubgraphInitialization if set
+  std::string lazy_subgraph_initialization;
 };
 }  // namespace
 
@@ -366,6 +370,11 @@ void RunTest(int64_t max_iterations,
     execution_providers.push_back(DefaultCpuExecutionProvider());
 
     test.Run(expect_result, failure_message, {kTensorrtExecutionProvider}, nullptr, &execution_providers);
+  } else if (!options.lazy_subgraph_initialization.empty()) {
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigLazySubgraphInitialization,
+                                                      options.lazy_subgraph_initialization.c_str()));
+    test.Run(so, expect_result, failure_message, {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
   } else {
     test.Run(expect_result, failure_message, {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});  // Disable TensorRT because of unsupported data type INT64
   }
@@ -440,6 +449,20 @@ TEST(Loop, LoopSubgraphRankMismatch) {
   ExitDueToCond(options);
 }
 
+TEST(Loop, LazySubgraphInitialization) {
+  RunOptions options{};
+  options.lazy_subgraph_initialization = "1";
+
+  ExitDueToCond(options);
+}
+
+TEST(Loop, LazySubgraphInitializationInBackground) {
+  RunOptions options{};
+  options.lazy_subgraph_initialization = "2";
+
+  ExitDueToCond(options);
+}
+
 TEST(Loop, ExitDueToMaxIterations) {
   int64_t max_iterations = 2;
   constexpr int64_t expected_num_iterations = 2;
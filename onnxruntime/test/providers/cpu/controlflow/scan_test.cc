@@ -7,7 +7,9 @@
 #include "core/session/inference_session.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/controlflow/scan_utils.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/asserts.h"
 #include "test/util/include/default_providers.h"
 
 using namespace ONNX_NAMESPACE;
@@ -24,6 +26,8 @@ struct RunOptions {
   bool scalar_loop_state_value = false;
   bool add_bad_shape = false;
   bool mixed_execution_providers = false;
+  // value for kOrtSessionOptionsConfigLazySubgraphInitialization if set
+  std::string lazy_subgraph_initialization;
   // Disable TensorRT because its parser fails, and it can't handle unknown dimensions
   std::unordered_set<std::string> excluded_provider_types{kTensorrtExecutionProvider, kOpenVINOExecutionProvider};
 };
@@ -315,7 +319,14 @@ static void RunTest_v8(const std::string test_name, int64_t batch_size, int64_t
   test.AddOutput<float>("scan_output_2", output_shape, output_2);
   test.AddOutput<float>("scan_output_3", output_shape, output_3);
 
-  test.Run(expect_result, failure_message, options.excluded_provider_types);
+  if (!options.lazy_subgraph_initialization.empty()) {
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigLazySubgraphInitialization,
+                                                      options.lazy_subgraph_initialization.c_str()));
+    test.Run(so, expect_result, failure_message, options.excluded_provider_types);
+  } else {
+    test.Run(expect_result, failure_message, options.excluded_provider_types);
+  }
 }
 
 static void RunTest_v9(const std::string test_name, int64_t sequence_len, int64_t input_size,
@@ -418,6 +429,11 @@ static void RunTest_v9(const std::string test_name, int64_t sequence_len, int64_
     execution_providers.push_back(DefaultCpuExecutionProvider());
 
     test.Run(expect_result, failure_message, options.excluded_provider_types, nullptr, &execution_providers);
+  } else if (!options.lazy_subgraph_initialization.empty()) {
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigLazySubgraphInitialization,
+                                                      options.lazy_subgraph_initialization.c_str()));
+    test.Run(so, expect_result, failure_message, options.excluded_provider_types);
   } else {
     test.Run(expect_result, failure_message, options.excluded_provider_types);
   }
@@ -567,6 +583,28 @@ static void OuterScopeAccess_NoShapeInMainGraph_NoTypeAndShapeInSubgraph(bool is
 
 TEST_8_AND_9(OuterScopeAccess_NoShapeInMainGraph_NoTypeAndShapeInSubgraph);
 
+static void LazySubgraphInitialization(bool is_v8) {
+  RunOptions options{};
+  options.is_v8 = is_v8;
+  options.include_outer_scope_add = true;
+  options.lazy_subgraph_initialization = "1";
+
+  ShortSequenceOneInBatchOneLoopStateVar(options);
+}
+
+TEST_8_AND_9(LazySubgraphInitialization);
+
+static void LazySubgraphInitializationInBackground(bool is_v8) {
+  RunOptions options{};
+  options.is_v8 = is_v8;
+  options.include_outer_scope_add = true;
+  options.lazy_subgraph_initialization = "2";
+
+  ShortSequenceOneInBatchOneLoopStateVar(options);
+}
+
+TEST_8_AND_9(LazySubgraphInitializationInBackground);
+
 // shape inferencing is only strict for the latest version so only test BadShape with that
 // Scan test uses Split operator in the subgraph. It was updated for opset13
 // Enable this test once Split for op13 is implemented.
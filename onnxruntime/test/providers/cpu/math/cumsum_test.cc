@@ -4,7 +4,10 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/util/include/default_providers.h"
+#include "core/platform/env.h"
+#include "core/providers/cpu/math/cumsum.h"
 #include "core/util/math.h"
+#include "core/util/thread_utils.h"
 
 namespace onnxruntime {
 namespace test {
@@ -257,5 +260,63 @@ TEST(CumSumTest, _1DTestLong) {
   test.AddOutput<int32_t>("y", {N}, output_value);
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
+TEST(CumSumTest, _2DTestLongReverseExclusive) {
+  // long innermost axes are split into blocks that are scanned from the sum of the preceding blocks
+  OpTester test("CumSum", 14, onnxruntime::kOnnxDomain);
+  test.AddAttribute<int64_t>("exclusive", 1);
+  test.AddAttribute<int64_t>("reverse", 1);
+  constexpr int N = 50000;
+  std::vector<float> output_value(2 * N);
+  for (int i = 0; i < N; ++i) {
+    output_value[i] = static_cast<float>(N - 1 - i);
+    output_value[N + i] = static_cast<float>(2 * (N - 1 - i));
+  }
+  std::vector<float> input_value(2 * N, 1.f);
+  std::fill(input_value.begin() + N, input_value.end(), 2.f);
+  test.AddInput<float>("x", {2, N}, input_value);
+  test.AddInput<int32_t>("axis", {}, {1});
+  test.AddOutput<float>("y", {2, N}, output_value);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+TEST(CumSumTest, _3DTestWideSlice) {
+  // the columns of a slice are split between threads when there are fewer slices than threads
+  OpTester test("CumSum", 14, onnxruntime::kOnnxDomain);
+  constexpr int D = 3;
+  constexpr int L = 1000;
+  std::vector<int64_t> input_value(D * L);
+  std::vector<int64_t> output_value(D * L);
+  for (int i = 0; i < D; ++i) {
+    for (int j = 0; j < L; ++j) {
+      input_value[i * L + j] = j + i;
+      output_value[i * L + j] = (i + 1) * j + i * (i + 1) / 2;
+    }
+  }
+  test.AddInput<int64_t>("x", {1, D, L}, input_value);
+  test.AddInput<int32_t>("axis", {}, {1});
+  test.AddOutput<int64_t>("y", {1, D, L}, output_value);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+TEST(CumSumTest, LongAxisSameResultForAnyThreadCount) {
+  // the float sums of a long innermost axis are rounded the same without a thread pool and with several threads
+  constexpr int64_t N = 100000;
+  std::vector<float> input(N);
+  for (int64_t i = 0; i < N; ++i) {
+    input[i] = static_cast<float>((i * 7919) % 1000) * 0.001f + (i % 3 == 0 ? 1000.f : 0.f);
+  }
+
+  OrtThreadPoolParams tp_params;
+  tp_params.thread_pool_size = 4;
+  auto tp = concurrency::CreateThreadPool(&Env::Default(), tp_params, concurrency::ThreadPoolType::INTRA_OP);
+
+  for (const bool exclusive : {false, true}) {
+    for (const bool reverse : {false, true}) {
+      std::vector<float> serial_output(N);
+      std::vector<float> parallel_output(N);
+      cumsum_op::ComputeCumSum(input.data(), serial_output.data(), 1, N, 1, exclusive, reverse, nullptr);
+      cumsum_op::ComputeCumSum(input.data(), parallel_output.data(), 1, N, 1, exclusive, reverse, tp.get());
+      ASSERT_EQ(serial_output, parallel_output) << "exclusive: " << exclusive << " reverse: " << reverse;
+    }
+  }
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -592,6 +592,30 @@ TEST(Einsum, ImplicitEinsumAsTensorContraction) {
   test.Run();
 }
 
+// Contraction order
+// The narrow trailing operand makes contracting the last two inputs first cheaper than the left-to-right order
+
+TEST(Einsum, ExplicitEinsumAsMatrixChainContractedRightToLeft) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,jk,kl->il");
+  test.AddInput<float>("x", {2, 3}, {-1.f, 1.f, -2.f, 0.f, 2.f, -1.f});
+  test.AddInput<float>("y", {3, 4}, {0.f, 2.f, -1.f, 1.f, -2.f, 0.f, 2.f, -1.f, 1.f, -2.f, 0.f, 2.f});
+  test.AddInput<float>("z", {4, 1}, {1.f, -2.f, 0.f, 2.f});
+  test.AddOutput<float>("o", {2, 1}, {-20.f, -17.f});
+  test.Run();
+}
+
+TEST(Einsum, ExplicitEinsumAsMatrixChainContractedRightToLeft_4_Inputs) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ab,bc,cd,de->ae");
+  test.AddInput<float>("w", {2, 3}, {-1.f, 1.f, -2.f, 0.f, 2.f, -1.f});
+  test.AddInput<float>("x", {3, 4}, {0.f, 2.f, -1.f, 1.f, -2.f, 0.f, 2.f, -1.f, 1.f, -2.f, 0.f, 2.f});
+  test.AddInput<float>("y", {4, 4}, {1.f, -2.f, 0.f, 2.f, -1.f, 1.f, -2.f, 0.f, 2.f, -1.f, 1.f, -2.f, 0.f, 2.f, -1.f, 1.f});
+  test.AddInput<float>("z", {4, 1}, {2.f, -1.f, 1.f, -2.f});
+  test.AddOutput<float>("o", {2, 1}, {50.f, 50.f});
+  test.Run();
+}
+
 // Theme: Half support
 
 TEST(Einsum, ExplicitEinsumAsIdentity_1D_input_Half) {
@@ -9,8 +9,9 @@
 #include "test/common/cuda_op_test_utils.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "default_providers.h"
+#include "core/mlas/inc/mlas.h"
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
 
 namespace onnxruntime {
 namespace test {
@@ -294,6 +295,61 @@ TEST(MathOpTest, MatMulSharedPrepackedWeights_FastMath) {
 
 #endif
 
+TEST(MathOpTest, GemmTransBInitializer_FastMath) {
+  // Y = A * B' + beta * C, with B pre-packed to bfloat16. A row vector C with beta 1 is
+  // applied as the kernel bias while other bias shapes are accumulated afterwards.
+  struct BiasCase {
+    float beta;
+    std::vector<int64_t> c_dims;
+    std::vector<float> c_vals;
+  };
+  const std::vector<BiasCase> bias_cases{
+      {1.0f, {8}, {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f}},
+      {0.5f, {4, 1}, {2.0f, 4.0f, 6.0f, 8.0f}},
+  };
+
+  for (const auto& bias_case : bias_cases) {
+    OpTester test("Gemm", 13);
+    test.AddAttribute("transA", static_cast<int64_t>(0));
+    test.AddAttribute("transB", static_cast<int64_t>(1));
+    test.AddAttribute("alpha", 1.0f);
+    test.AddAttribute("beta", bias_case.beta);
+
+    std::vector<float> a_vals;
+    for (int i = 0; i < 4; i++) {
+      a_vals.insert(a_vals.end(), 8, static_cast<float>(i + 1));
+    }
+    test.AddInput<float>("A", {4, 8}, a_vals);
+    // B is to be an initializer for triggering pre-packing
+    test.AddInput<float>("B", {8, 8}, std::vector<float>(64, 1.0f), true);
+    test.AddInput<float>("C", bias_case.c_dims, bias_case.c_vals, true);
+
+    std::vector<float> expected_vals;
+    for (int i = 0; i < 4; i++) {
+      for (int j = 0; j < 8; j++) {
+        const float c = bias_case.c_dims.size() == 1 ? bias_case.c_vals[j] : bias_case.c_vals[i];
+        expected_vals.push_back(8.0f * (i + 1) + bias_case.beta * c);
+      }
+    }
+    test.AddOutput<float>("Y", {4, 8}, expected_vals);
+
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(
+        kOrtSessionOptionsMlasGemmFastMathBfloat16, "1"));
+
+    auto cpu_ep = []() -> std::vector<std::unique_ptr<IExecutionProvider>> {
+      std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+      execution_providers.push_back(DefaultCpuExecutionProvider());
+      return execution_providers;
+    };
+
+    test.Config(so)
+        .Config(run_with_tunable_op)
+        .ConfigEps(cpu_ep())
+        .RunWithConfig();
+  }
+}
+
 // Dummy run to disable the FastMath mode for the current session
 TEST(MathOpTest, MatMulUint64Type_DisableFastMath) {
   RunMatMulTest<uint64_t>(9, false, false, true);
@@ -301,4 +357,4 @@ TEST(MathOpTest, MatMulUint64Type_DisableFastMath) {
 
 }  // namespace test
 }  // namespace onnxruntime
-#endif  // defined(__aarch64__) && defined(__linux__)
+#endif  // defined(MLAS_SBGEMM_SUPPORTED)
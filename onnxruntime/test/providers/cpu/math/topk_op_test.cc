@@ -861,5 +861,47 @@ TEST(TopKOperator, SelectTopKThreaded) {
   TestThreaded<double>(k, n, batch_size);
 }
 
+// rows of values with many duplicates. with float, rows of 1024+ values and a large k use the radix select, and long
+// rows with fewer rows than threads are split into chunks. both must pick the first instances of equal values.
+template <typename T>
+static void TestDuplicates(int64_t k, int64_t rows, int64_t cols, int64_t largest) {
+  std::vector<T> input_vals(rows * cols);
+  for (int64_t i = 0; i < rows * cols; ++i) {
+    input_vals[i] = static_cast<T>((i * 7919) % 10 - 5);
+  }
+  std::vector<int64_t> input_dimensions = {rows, cols};
+
+  std::vector<T> expected_vals;
+  std::vector<int64_t> expected_indices;
+  std::vector<int64_t> expected_dimensions = {rows, k};
+  for (int64_t r = 0; r < rows; ++r) {
+    const T* row = input_vals.data() + r * cols;
+    std::vector<int64_t> order(cols);
+    std::iota(order.begin(), order.end(), int64_t{0});
+    std::stable_sort(order.begin(), order.end(), [row, largest](int64_t lhs, int64_t rhs) {
+      return largest ? row[lhs] > row[rhs] : row[lhs] < row[rhs];
+    });
+    for (int64_t l = 0; l < k; ++l) {
+      expected_vals.push_back(row[order[l]]);
+      expected_indices.push_back(order[l]);
+    }
+  }
+
+  RunTest(11, k, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, false, -1,
+          largest);
+}
+
+TEST(TopKOperator, RadixSelectDuplicates) {
+  TestDuplicates<float>(1500, 2, 4000, 1);
+  TestDuplicates<float>(1500, 2, 4000, 0);
+  TestDuplicates<double>(1500, 2, 4000, 1);
+}
+
+TEST(TopKOperator, LongRowsDuplicates) {
+  TestDuplicates<float>(10, 1, 200000, 1);
+  TestDuplicates<float>(10, 1, 200000, 0);
+  TestDuplicates<int64_t>(100, 1, 200000, 1);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
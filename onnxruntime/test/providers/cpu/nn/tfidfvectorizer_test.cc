@@ -689,6 +689,39 @@ TEST(TfIdfVectorizerTest, String_TFIDFWeights_onlyBigrams_Skip5_2rows) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(TfIdfVectorizerTest, Int64_TF_UniBiTrigrams_Skip1_ManyRows) {
+  OpTester test("TfIdfVectorizer", opset_ver);
+  // s=1, Min=1, Max=3, weights empty, int64
+  // 5 only appears inside of n-grams and 9 is not in the pool at all
+  InitTestAttr(test, "TF", 1, 3, 1,
+               {0, 2, 6},
+               {0, 1, 2, 3, 4},  // 5 output indexes
+               {},
+               {2, 3,        // 1-grams
+                4, 5, 3, 2,  // bi-grams
+                2, 4, 5},    // tri-grams
+               {});
+
+  // Enough rows for them to be split across the threads
+  constexpr int64_t num_rows = 100;
+  std::vector<int64_t> input;
+  std::vector<float> output;
+  for (int64_t row = 0; row < num_rows; ++row) {
+    if (row % 2 == 0) {
+      input.insert(input.end(), {2, 4, 5, 9, 3, 2});
+      output.insert(output.end(), {2.f, 1.f, 1.f, 1.f, 1.f});
+    } else {
+      // (3, 2) and (4, 5) are only found with a skip of 1
+      input.insert(input.end(), {3, 9, 2, 4, 9, 5});
+      output.insert(output.end(), {1.f, 1.f, 1.f, 1.f, 0.f});
+    }
+  }
+  test.AddInput<int64_t>("T", {num_rows, 6}, input);
+  test.AddOutput<float>("Y", {num_rows, 5}, output);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 // This test runs the inference 100 times to test the improvement
 // It enables profiling while running inference multiple times.
 // So we can manually inspect the profiling output
@@ -404,5 +404,37 @@ TEST(NonMaxSuppressionOpTest, WithIOUThresholdOpset11) {
   test.Run();
 }
 
+TEST(NonMaxSuppressionOpTest, ManyBoxes) {
+  // Enough boxes for the candidates to be pre-filtered by score.
+  // Batch 0: boxes 2k and 2k + 1 are identical, so every other box gets suppressed.
+  // Batch 1: every box but box 0 is identical, so box 0 has the lowest score but still gets selected.
+  constexpr int64_t num_boxes = 4096;
+  std::vector<float> boxes;
+  std::vector<float> scores;
+  for (int64_t batch = 0; batch < 2; batch++) {
+    for (int64_t i = 0; i < num_boxes; i++) {
+      const float x = batch == 0 ? static_cast<float>(i / 2 * 2) : (i == 0 ? -10.0f : 0.0f);
+      boxes.insert(boxes.end(), {0.0f, x, 1.0f, x + 1.0f});
+      scores.push_back(static_cast<float>(i + 1) / num_boxes);
+    }
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {2, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {2, 1, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {5L});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices", {7, 3},
+                          {0L, 0L, 4095L,
+                           0L, 0L, 4093L,
+                           0L, 0L, 4091L,
+                           0L, 0L, 4089L,
+                           0L, 0L, 4087L,
+                           1L, 0L, 4095L,
+                           1L, 0L, 0L});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
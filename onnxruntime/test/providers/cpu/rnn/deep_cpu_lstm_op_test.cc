@@ -374,6 +374,46 @@ TEST(LSTMTest, MixedSequenceLengthsReverse) {
   SimpleWeightsNoBiasTwoRows("reverse", Y_data, Y_h_data, Y_c_data, &seq_lengths);
 }
 
+// the rows are sorted by decreasing sequence length and the small bidirectional layer runs its directions concurrently
+TEST(LSTMTest, MixedSequenceLengthsBidirectional) {
+  // TODO: Unskip when fixed #41968513
+  if (DefaultDmlExecutionProvider().get() != nullptr) {
+    GTEST_SKIP() << "Skipping because of the following error: MLOperatorAuthorImpl.cpp(1817): The parameter is incorrect.";
+  }
+
+  // combination of the MixedSequenceLengths and MixedSequenceLengthsReverse output for seq_lengths {2, 1}
+  std::vector<int> seq_lengths{2, 1};
+
+  std::vector<float> Y_data{
+      0.28828835f, 0.36581863f, 0.45679406f,
+      0.34526032f, 0.47220859f, 0.55850911f,
+
+      0.55391603f, 0.69201493f, 0.82696019f,
+      0.34526044f, 0.47220877f, 0.55850935f,
+
+      0.84196719f, 0.89402526f, 0.91073048f,
+      0.f, 0.f, 0.f,
+
+      0.61249432f, 0.70678632f, 0.74094619f,
+      0.f, 0.f, 0.f};
+
+  std::vector<float> Y_h_data{
+      0.84196719f, 0.89402526f, 0.91073048f,
+      0.34526032f, 0.47220859f, 0.55850911f,
+
+      0.55391603f, 0.69201493f, 0.82696019f,
+      0.34526044f, 0.47220877f, 0.55850935f};
+
+  std::vector<float> Y_c_data{
+      1.27731147f, 1.44181041f, 1.53179041f,
+      0.54983425f, 0.59868795f, 0.64565659f,
+
+      1.27850552f, 1.46799496f, 1.57641257f,
+      0.54983425f, 0.59868795f, 0.64565659f};
+
+  SimpleWeightsNoBiasTwoRows("bidirectional", Y_data, Y_h_data, Y_c_data, &seq_lengths);
+}
+
 // test path in LSTM model where batch_parallel_ is false and there are multiple steps (seq_length > 1)
 TEST(LSTMTest, BatchParallelFalseSeqLengthGreaterThanOne) {
   // TODO: Unskip when fixed #41968513
@@ -5,7 +5,9 @@
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "core/session/onnxruntime_run_options_config_keys.h"
 #include "test/common/tensor_op_test_utils.h"
+#include "test/util/include/asserts.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/util/include/test_random_seed.h"
 #include "test/util/include/default_providers.h"
@@ -66,6 +68,31 @@ static void TestRadix2DFTFloat(bool onesided, int since_version) {
   test.Run();
 }
 
+static void TestMixedRadixDFTFloat(bool onesided, int since_version) {
+  OpTester test("DFT", since_version);
+
+  vector<int64_t> shape = {1, 12, 1};
+  vector<int64_t> output_shape = {1, 12, 2};
+  output_shape[1] = onesided ? (1 + (shape[1] >> 1)) : shape[1];
+
+  vector<float> input = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  vector<float> expected_output = {78.0f, 0.0f, -6.0f, 22.39230f, -6.0f, 10.39230f, -6.0f, 6.0f,
+                                   -6.0f, 3.46410f, -6.0f, 1.60770f, -6.0f, 0.0f, -6.0f, -1.60770f,
+                                   -6.0f, -3.46410f, -6.0f, -6.0f, -6.0f, -10.39230f, -6.0f, -22.39230f};
+
+  if (onesided) {
+    expected_output.resize(14);
+  }
+  test.AddInput<float>("input", shape, input);
+  if (since_version == 20) {
+    test.AddInput<int64_t>("dft_length", {}, {12});
+    test.AddInput<int64_t>("axis", {}, {1});
+  }
+  test.AddAttribute<int64_t>("onesided", static_cast<int64_t>(onesided));
+  test.AddOutput<float>("output", output_shape, expected_output);
+  test.Run();
+}
+
 static void TestInverseFloat(int since_version) {
   OpTester test("DFT", since_version);
 
@@ -108,6 +135,31 @@ TEST(SignalOpsTest, DFT17_Float_radix2_onesided) { TestRadix2DFTFloat(true, kMin
 
 TEST(SignalOpsTest, DFT20_Float_radix2_onesided) { TestRadix2DFTFloat(true, kOpsetVersion20); }
 
+TEST(SignalOpsTest, DFT17_Float_mixed_radix) { TestMixedRadixDFTFloat(false, kMinOpsetVersion); }
+
+TEST(SignalOpsTest, DFT20_Float_mixed_radix) { TestMixedRadixDFTFloat(false, kOpsetVersion20); }
+
+TEST(SignalOpsTest, DFT17_Float_mixed_radix_onesided) { TestMixedRadixDFTFloat(true, kMinOpsetVersion); }
+
+TEST(SignalOpsTest, DFT20_Float_mixed_radix_onesided) { TestMixedRadixDFTFloat(true, kOpsetVersion20); }
+
+// A signal longer than dft_length is truncated before a length that is computed with Bluestein.
+TEST(SignalOpsTest, DFT20_Float_bluestein_truncated) {
+  OpTester test("DFT", kOpsetVersion20);
+
+  vector<float> input(40, 1.0f);
+  vector<float> expected_output(19 * 2, 0.0f);
+  expected_output[0] = 37.0f;
+
+  test.AddInput<float>("input", {1, 40, 1}, input);
+  test.AddInput<int64_t>("dft_length", {}, {37});
+  test.AddInput<int64_t>("axis", {}, {1});
+  test.AddAttribute<int64_t>("onesided", static_cast<int64_t>(true));
+  test.AddOutput<float>("output", {1, 19, 2}, expected_output);
+  test.SetOutputAbsErr("output", 0.0002f);
+  test.Run();
+}
+
 TEST(SignalOpsTest, DFT17_Float_inverse) {
   TestInverseFloat(kMinOpsetVersion);
 }
@@ -233,6 +285,101 @@ TEST(SignalOpsTest, STFTFloat) {
   test.Run();
 }
 
+// The window holds real values that scale both components of a complex signal.
+TEST(SignalOpsTest, STFTFloat_ComplexSignalWindow) {
+  OpTester test("STFT", kMinOpsetVersion);
+
+  test.AddInput<float>("signal", {1, 4, 2}, {1, 1, 2, 0, 3, -1, 4, 2});
+  test.AddInput<int64_t>("frame_step", {}, {4});
+  test.AddInput<float>("window", {4}, {1, 0, 1, 0});
+  test.AddInput<int64_t>("frame_length", {}, {4});
+  test.AddAttribute<int64_t>("onesided", static_cast<int64_t>(false));
+
+  // The windowed frame is {1+1j, 0, 3-1j, 0}.
+  vector<float> expected_output = {4.0f, 0.0f, -2.0f, 2.0f, 4.0f, 0.0f, -2.0f, 2.0f};
+  test.AddOutput<float>("output", {1, 1, 4, 2}, expected_output);
+  test.Run();
+}
+
+// The frames of a complex signal start every frame_step complex samples.
+TEST(SignalOpsTest, STFTFloat_ComplexSignalFrameOffset) {
+  OpTester test("STFT", kMinOpsetVersion);
+
+  test.AddInput<float>("signal", {1, 6, 2}, {1, 1, 2, 0, 3, 1, 4, 0, 5, 1, 6, 0});
+  test.AddInput<int64_t>("frame_step", {}, {2});
+  test.AddInput<float>("window", {2}, {1, 1});
+  test.AddInput<int64_t>("frame_length", {}, {2});
+  test.AddAttribute<int64_t>("onesided", static_cast<int64_t>(false));
+
+  // The frames are {1+1j, 2}, {3+1j, 4} and {5+1j, 6}.
+  vector<float> expected_output = {3.0f, 1.0f, -1.0f, 1.0f,
+                                   7.0f, 1.0f, -1.0f, 1.0f,
+                                   11.0f, 1.0f, -1.0f, 1.0f};
+  test.AddOutput<float>("output", {1, 3, 2, 2}, expected_output);
+  test.Run();
+}
+
+TEST(SignalOpsTest, STFTFloat_Streaming) {
+  OpTester test("STFT", kMinOpsetVersion);
+
+  test.AddInput<float>("signal", {1, 6, 1}, {1, 2, 3, 4, 5, 6});
+  test.AddInput<int64_t>("frame_step", {}, {2});
+  test.AddInput<float>("window", {4}, {1, 1, 1, 1});
+  test.AddInput<int64_t>("frame_length", {}, {4});
+
+  // The first Run computes the frames at 0 and 2 and keeps the samples {5, 6} of the frame at 4.
+  // The second Run continues with the same chunk, so its frames are {5, 6, 1, 2}, {1, 2, 3, 4} and {3, 4, 5, 6}.
+  vector<float> expected_output = {14.0f, 0.0f, 4.0f, -4.0f, -2.0f, 0.0f,
+                                   10.0f, 0.0f, -2.0f, 2.0f, -2.0f, 0.0f,
+                                   18.0f, 0.0f, -2.0f, 2.0f, -2.0f, 0.0f};
+  test.AddOutput<float>("output", {1, 3, 3, 2}, expected_output);
+
+  RunOptions run_options;
+  ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigStftStreamId, "stream_0"));
+  test.SetNumRunCalls(2);
+  test.Config(&run_options).RunWithConfig();
+}
+
+TEST(SignalOpsTest, STFTFloat_StreamingEndReleasesState) {
+  OpTester test("STFT", kMinOpsetVersion);
+
+  test.AddInput<float>("signal", {1, 6, 1}, {1, 2, 3, 4, 5, 6});
+  test.AddInput<int64_t>("frame_step", {}, {2});
+  test.AddInput<float>("window", {4}, {1, 1, 1, 1});
+  test.AddInput<int64_t>("frame_length", {}, {4});
+
+  // Each Run ends the stream, so the second Run starts a new stream without the samples {5, 6} kept by the first
+  // and only computes the frames {1, 2, 3, 4} and {3, 4, 5, 6}.
+  vector<float> expected_output = {10.0f, 0.0f, -2.0f, 2.0f, -2.0f, 0.0f,
+                                   18.0f, 0.0f, -2.0f, 2.0f, -2.0f, 0.0f};
+  test.AddOutput<float>("output", {1, 2, 3, 2}, expected_output);
+
+  RunOptions run_options;
+  ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigStftStreamId, "stream_0"));
+  ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigStftStreamEnd, "1"));
+  test.SetNumRunCalls(2);
+  test.Config(&run_options).RunWithConfig();
+}
+
+TEST(SignalOpsTest, STFTFloat_StreamingSkipsSamplesOfHop) {
+  OpTester test("STFT", kMinOpsetVersion);
+
+  test.AddInput<float>("signal", {1, 3, 1}, {1, 2, 3});
+  test.AddInput<int64_t>("frame_step", {}, {4});
+  test.AddInput<float>("window", {2}, {1, 1});
+  test.AddInput<int64_t>("frame_length", {}, {2});
+
+  // The first Run computes the frame at 0. The next frame starts at 4, one sample past the end of the first chunk,
+  // so the second Run skips the sample {1} of its chunk and computes the frame {2, 3}.
+  vector<float> expected_output = {5.0f, 0.0f, -1.0f, 0.0f};
+  test.AddOutput<float>("output", {1, 1, 2, 2}, expected_output);
+
+  RunOptions run_options;
+  ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigStftStreamId, "stream_0"));
+  test.SetNumRunCalls(2);
+  test.Config(&run_options).RunWithConfig();
+}
+
 TEST(SignalOpsTest, HannWindowFloat) {
   OpTester test("HannWindow", kMinOpsetVersion);
 
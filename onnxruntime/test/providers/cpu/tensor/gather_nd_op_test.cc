@@ -329,5 +329,14 @@ TEST(GatherNDOpTest, GatherND_slice_int64_t) {
   test.Run();
 }
 
+TEST(GatherNDOpTest, GatherND_adjacent_slices) {
+  // slices that are adjacent in the input are copied together
+  OpTester test("GatherND", 12, kOnnxDomain);
+  test.AddInput<int32_t>("data", {4, 3}, ValueRange<int32_t>(12));
+  test.AddInput<int64_t>("indices", {5, 1}, {1LL, 2LL, 3LL, 0LL, -4LL});
+  test.AddOutput<int32_t>("output", {5, 3}, {3, 4, 5, 6, 7, 8, 9, 10, 11, 0, 1, 2, 0, 1, 2});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/common/tensor_op_test_utils.h"
 #include "test/util/include/default_providers.h"
 
 namespace onnxruntime {
@@ -430,6 +431,33 @@ TEST(GatherOpTest, Gather_axis1_scalar_indices) {
   run_test(false);
   run_test(true);
 }
+TEST(GatherOpTest, Gather_axis0_string_rows) {
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<std::string>("data", {3, 2},
+                             {"00", "01",
+                              "10", "11",
+                              "20", "21"});
+  test.AddInput<int64_t>("indices", {3}, {2LL, 0LL, -2LL});
+  test.AddOutput<std::string>("output", {3, 2},
+                              {"20", "21",
+                               "00", "01",
+                               "10", "11"});
+  test.Run();
+}
+
+TEST(GatherOpTest, Gather_axis1_consecutive_indices) {
+  // runs of consecutive indices are copied together, including runs mixing negative and positive indices
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 1LL);
+  test.AddInput<float>("data", {2, 5, 2}, ValueRange<float>(20));
+  test.AddInput<int64_t>("indices", {6}, {1LL, 2LL, -2LL, 4LL, 0LL, 0LL});
+  test.AddOutput<float>("output", {2, 6, 2},
+                        {2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 0.f, 1.f, 0.f, 1.f,
+                         12.f, 13.f, 14.f, 15.f, 16.f, 17.f, 18.f, 19.f, 10.f, 11.f, 10.f, 11.f});
+  test.Run();
+}
+
 #ifdef ENABLE_TRAINING_OPS
 // Should remove the shrunken_gather include from ENABLE_TRAINING_OPS once 1). compute optimizer is enabled for inference or
 // 2). this is needed by inference for other purpose.
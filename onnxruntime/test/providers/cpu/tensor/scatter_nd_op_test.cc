@@ -246,5 +246,29 @@ TEST(ScatterNDOpTest, ScatterND_empty_indices) {
   test1.Run(OpTester::ExpectResult::kExpectSuccess, "", {kDmlExecutionProvider});
 }
 
+TEST(ScatterNDOpTest, ScatterND_18_add_duplicate_indices) {
+  // many updates of the same rows. the updates are partitioned by row so they never run concurrently on a row.
+  constexpr int64_t rows = 64;
+  constexpr int64_t num_updates = 1000;
+  std::vector<int64_t> indices(num_updates);
+  std::vector<int64_t> updates(num_updates * 2);
+  std::vector<int64_t> expected(rows * 2, 1);
+  for (int64_t i = 0; i < num_updates; ++i) {
+    indices[i] = (i * 7) % rows;
+    updates[i * 2] = i;
+    updates[i * 2 + 1] = -i;
+    expected[indices[i] * 2] += i;
+    expected[indices[i] * 2 + 1] -= i;
+  }
+
+  OpTester test("ScatterND", 18);
+  test.AddAttribute("reduction", "add");
+  test.AddInput<int64_t>("data", {rows, 2}, std::vector<int64_t>(rows * 2, 1));
+  test.AddInput<int64_t>("indices", {num_updates, 1}, indices);
+  test.AddInput<int64_t>("updates", {num_updates, 2}, updates);
+  test.AddOutput<int64_t>("output", {rows, 2}, expected);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
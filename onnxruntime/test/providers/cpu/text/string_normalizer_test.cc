@@ -194,6 +194,30 @@ TEST(ContribOpTest, StringNormalizerInsensitiveFilterOutUpperWithLocale) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(ContribOpTest, StringNormalizerInsensitiveFilterOutLowerManyStrings) {
+  // - case-INSENSITIVE approach
+  // - enough strings to be processed in parallel batches
+  // - a mix of ASCII and non-ASCII strings with stopwords in a different case
+  OpTester test("StringNormalizer", opset_ver, domain);
+  InitTestAttr(test, "LOWER", false, {"MONDAY", "école"}, test_locale);
+  const std::vector<std::string> words = {"Monday", "TUESDAY", "École", "Wednesday Thursday and Friday",
+                                          "ÉCOLE Élémentaire", "monday"};
+  const std::vector<std::string> lowered = {"monday", "tuesday", "école", "wednesday thursday and friday",
+                                            "école élémentaire", "monday"};
+  std::vector<std::string> input;
+  std::vector<std::string> output;
+  for (size_t i = 0; i < 1200; ++i) {
+    const size_t w = i % words.size();
+    input.push_back(words[w]);
+    if (lowered[w] != "monday" && lowered[w] != "école") {
+      output.push_back(lowered[w]);
+    }
+  }
+  test.AddInput<std::string>("T", {static_cast<int64_t>(input.size())}, input);
+  test.AddOutput<std::string>("Y", {static_cast<int64_t>(output.size())}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 TEST(ContribOpTest, StringNormalizerSensitiveFilterOutUpperEmptyCase) {
   // Empty output case
   // - casesensitive approach
@@ -552,6 +552,7 @@ Status TransformGraphForMixedPrecision(Graph& graph,
       for (int i = 0; i < ints_size; ++i) {
         if (element_type->ints(i) == static_cast<int64_t>(ONNX_NAMESPACE::TensorProto_DataType_FLOAT)) {
           element_type->set_ints(i, static_cast<int64_t>(mixed_precision_type));
+          node.MarkAttributesChanged();
           // Need to resolve and populate the new type through the graph.
           graph.SetGraphResolveNeeded();
         }
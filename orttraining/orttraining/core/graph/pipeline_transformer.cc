@@ -917,6 +917,7 @@ common::Status AddPassthroughInitializer(Graph& graph,
     auto& send_attributes = send_nodes[i]->GetMutableAttributes();
     auto& send_element_types = send_attributes["element_types"];
     send_element_types.add_ints(static_cast<int64_t>(dtype));
+    send_nodes[i]->MarkAttributesChanged();
     send_nodes[i]->MutableInputDefs().push_back(current_node_arg);
     send_nodes[i]->MutableInputArgsCount().back()++;
 
@@ -929,6 +930,7 @@ common::Status AddPassthroughInitializer(Graph& graph,
     auto& recv_attributes = recv_nodes[i]->GetMutableAttributes();
     auto& recv_element_types = recv_attributes["element_types"];
     recv_element_types.add_ints(static_cast<int64_t>(dtype));
+    recv_nodes[i]->MarkAttributesChanged();
     recv_nodes[i]->MutableOutputDefs().push_back(current_node_arg);
 
     // update the consumer node's input if the node's group is not in the first partition